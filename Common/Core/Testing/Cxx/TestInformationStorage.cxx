@@ -0,0 +1,159 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestInformationStorage.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that vtkInformation keeps its entries correctly as
+// they are added, replaced and removed in numbers that exceed the storage
+// kept in the object, and across Copy() and Clear().
+
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIterator.h"
+#include "vtkNew.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+const int NumberOfKeys = 100;
+
+// Check that info holds keys[i] with value i + offset for the keys for
+// which present(i) is true, and no other key.
+template <class Predicate>
+bool CheckEntries(vtkInformation* info, vtkInformationIntegerKey** keys,
+                  int offset, Predicate present, const char* step)
+{
+  int expected = 0;
+  for (int i = 0; i < NumberOfKeys; ++i)
+    {
+    if (present(i))
+      {
+      ++expected;
+      if (!info->Has(keys[i]) || info->Get(keys[i]) != i + offset)
+        {
+        cerr << step << ": wrong entry for key " << i << endl;
+        return false;
+        }
+      }
+    else if (info->Has(keys[i]))
+      {
+      cerr << step << ": unexpected entry for key " << i << endl;
+      return false;
+      }
+    }
+
+  vtkNew<vtkInformationIterator> iter;
+  iter->SetInformationWeak(info);
+  int traversed = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+       iter->GoToNextItem())
+    {
+    ++traversed;
+    }
+  if (info->GetNumberOfKeys() != expected || traversed != expected)
+    {
+    cerr << step << ": expected " << expected << " keys, got "
+         << info->GetNumberOfKeys() << " and traversed " << traversed
+         << endl;
+    return false;
+    }
+  return true;
+}
+
+struct All { bool operator()(int) const { return true; } };
+struct Odd { bool operator()(int i) const { return i % 2 == 1; } };
+struct None { bool operator()(int) const { return false; } };
+}
+
+int TestInformationStorage(int, char*[])
+{
+  // Keys are deleted by the key manager at exit.
+  vtkInformationIntegerKey* keys[NumberOfKeys];
+  for (int i = 0; i < NumberOfKeys; ++i)
+    {
+    keys[i] = new vtkInformationIntegerKey("KEY", "TestInformationStorage");
+    }
+
+  vtkNew<vtkInformation> info;
+  for (int i = 0; i < NumberOfKeys; ++i)
+    {
+    keys[i]->Set(info.GetPointer(), i);
+    }
+  if (!CheckEntries(info.GetPointer(), keys, 0, All(), "Set"))
+    {
+    return TEST_FAILURE;
+    }
+
+  for (int i = 0; i < NumberOfKeys; ++i)
+    {
+    keys[i]->Set(info.GetPointer(), i + 1);
+    }
+  if (!CheckEntries(info.GetPointer(), keys, 1, All(), "Replace"))
+    {
+    return TEST_FAILURE;
+    }
+
+  for (int i = 0; i < NumberOfKeys; i += 2)
+    {
+    info->Remove(keys[i]);
+    }
+  if (!CheckEntries(info.GetPointer(), keys, 1, Odd(), "Remove"))
+    {
+    return TEST_FAILURE;
+    }
+
+  // Removing and adding entries repeatedly reuses the storage.
+  for (int pass = 0; pass < 10; ++pass)
+    {
+    for (int i = 0; i < NumberOfKeys; i += 2)
+      {
+      keys[i]->Set(info.GetPointer(), i + 1);
+      }
+    for (int i = 0; i < NumberOfKeys; i += 2)
+      {
+      info->Remove(keys[i]);
+      }
+    }
+  if (!CheckEntries(info.GetPointer(), keys, 1, Odd(), "Churn"))
+    {
+    return TEST_FAILURE;
+    }
+
+  vtkNew<vtkInformation> copy;
+  keys[0]->Set(copy.GetPointer(), -1);
+  copy->Copy(info.GetPointer());
+  if (!CheckEntries(copy.GetPointer(), keys, 1, Odd(), "Copy"))
+    {
+    return TEST_FAILURE;
+    }
+
+  copy->Clear();
+  if (!CheckEntries(copy.GetPointer(), keys, 1, None(), "Clear"))
+    {
+    return TEST_FAILURE;
+    }
+
+  // A small information object after a large one.
+  keys[3]->Set(copy.GetPointer(), 4);
+  keys[5]->Set(copy.GetPointer(), 6);
+  info->Copy(copy.GetPointer());
+  if (info->GetNumberOfKeys() != 2 || info->Get(keys[3]) != 4 ||
+      info->Get(keys[5]) != 6 || info->Has(keys[1]))
+    {
+    cerr << "Copy of a small information object failed" << endl;
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
@@ -16,6 +16,12 @@
 #include <memory.h>
 #include "vtkObjectFactory.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define VTK_BYTE_SWAP_USE_SSE2
+#endif
+
 vtkStandardNewMacro(vtkByteSwap);
 
 //----------------------------------------------------------------------------
@@ -64,10 +70,63 @@ VTK_TEMPLATE_SPECIALIZE struct vtkByteSwapper<8>
     }
 };
 
+#if defined(VTK_BYTE_SWAP_USE_SSE2)
+//----------------------------------------------------------------------------
+// Define swap functions for 16 bytes of segments of each size.  Larger
+// segments have their 2-byte halves reversed first.
+template <size_t s> struct vtkByteSwapperSSE2;
+VTK_TEMPLATE_SPECIALIZE struct vtkByteSwapperSSE2<1>
+{
+  static inline __m128i Swap(__m128i data) { return data; }
+};
+VTK_TEMPLATE_SPECIALIZE struct vtkByteSwapperSSE2<2>
+{
+  static inline __m128i Swap(__m128i data)
+    {
+    return _mm_or_si128(_mm_slli_epi16(data, 8), _mm_srli_epi16(data, 8));
+    }
+};
+VTK_TEMPLATE_SPECIALIZE struct vtkByteSwapperSSE2<4>
+{
+  static inline __m128i Swap(__m128i data)
+    {
+    data = _mm_shufflelo_epi16(data, _MM_SHUFFLE(2,3,0,1));
+    data = _mm_shufflehi_epi16(data, _MM_SHUFFLE(2,3,0,1));
+    return vtkByteSwapperSSE2<2>::Swap(data);
+    }
+};
+VTK_TEMPLATE_SPECIALIZE struct vtkByteSwapperSSE2<8>
+{
+  static inline __m128i Swap(__m128i data)
+    {
+    data = _mm_shufflelo_epi16(data, _MM_SHUFFLE(0,1,2,3));
+    data = _mm_shufflehi_epi16(data, _MM_SHUFFLE(0,1,2,3));
+    return vtkByteSwapperSSE2<2>::Swap(data);
+    }
+};
+#endif
+
 //----------------------------------------------------------------------------
 // Define range swap functions.
 template <class T> inline void vtkByteSwapRange(T* first, size_t num)
 {
+#if defined(VTK_BYTE_SWAP_USE_SSE2)
+  // Swap 16 bytes at a time, then the values left over.
+  if(sizeof(T) > 1)
+    {
+    char* data = reinterpret_cast<char*>(first);
+    size_t numBlocks = (num * sizeof(T)) / 16;
+    for(size_t i=0; i < numBlocks; ++i, data += 16)
+      {
+      __m128i* block = reinterpret_cast<__m128i*>(data);
+      _mm_storeu_si128(block,
+        vtkByteSwapperSSE2<sizeof(T)>::Swap(_mm_loadu_si128(block)));
+      }
+    first += numBlocks * 16 / sizeof(T);
+    num -= numBlocks * 16 / sizeof(T);
+    }
+#endif
+
   // Swap one value at a time.
   T* last = first + num;
   for(T* p=first; p != last; ++p)
@@ -25,7 +25,6 @@
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationIntegerPointerKey.h"
 #include "vtkInformationIntegerVectorKey.h"
-#include "vtkInformationIterator.h"
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationRequestKey.h"
@@ -35,7 +34,6 @@
 #include "vtkInformationVariantKey.h"
 #include "vtkInformationVariantVectorKey.h"
 #include "vtkObjectFactory.h"
-#include "vtkSmartPointer.h"
 #include "vtkVariant.h"
 
 #include <algorithm>
@@ -79,12 +77,11 @@ void vtkInformation::PrintSelf(ostream& os, vtkIndent indent)
 //----------------------------------------------------------------------------
 void vtkInformation::PrintKeys(ostream& os, vtkIndent indent)
 {
-  typedef vtkInformationInternals::MapType MapType;
-  for(MapType::const_iterator i = this->Internal->Map.begin();
-      i != this->Internal->Map.end(); ++i)
+  vtkInformationInternals* internal = this->Internal;
+  for(size_t i = internal->Begin(); i != internal->End(); i = internal->Next(i))
     {
     // Print the key name first.
-    vtkInformationKey* key = i->first;
+    vtkInformationKey* key = internal->GetKey(i);
     os << indent << key->GetName() << ": ";
 
     // Ask the key to print its value.
@@ -114,17 +111,7 @@ void vtkInformation::Modified(vtkInformationKey* key)
 // Return the number of keys as a result of iteration.
 int vtkInformation::GetNumberOfKeys()
 {
-  vtkSmartPointer<vtkInformationIterator> infoIterator =
-    vtkSmartPointer<vtkInformationIterator>::New();
-  infoIterator->SetInformation( this );
-
-  int numberOfKeys = 0;
-  for (infoIterator->InitTraversal(); !infoIterator->IsDoneWithTraversal();
-    infoIterator->GoToNextItem())
-    {
-    numberOfKeys++;
-    }
-  return numberOfKeys;
+  return static_cast<int>(this->Internal->GetSize());
 }
 
 //----------------------------------------------------------------------------
@@ -135,26 +122,25 @@ void vtkInformation::SetAsObjectBase(vtkInformationKey* key,
     {
     return;
     }
-  typedef vtkInformationInternals::MapType MapType;
-  MapType::iterator i = this->Internal->Map.find(key);
-  if(i != this->Internal->Map.end())
+  vtkInformationInternals* internal = this->Internal;
+  size_t i = internal->Find(key);
+  if(i != internal->End())
     {
-    vtkObjectBase* oldvalue = i->second;
+    vtkObjectBase* oldvalue = internal->GetValue(i);
     if(newvalue)
       {
-      i->second = newvalue;
+      internal->SetValue(i, newvalue);
       newvalue->Register(0);
       }
     else
       {
-      this->Internal->Map.erase(i);
+      internal->Erase(i);
       }
     oldvalue->UnRegister(0);
     }
   else if(newvalue)
     {
-    MapType::value_type entry(key, newvalue);
-    this->Internal->Map.insert(entry);
+    internal->Insert(key, newvalue);
     newvalue->Register(0);
     }
   this->Modified(key);
@@ -166,11 +152,10 @@ const vtkObjectBase* vtkInformation::GetAsObjectBase(
 {
   if(key)
     {
-    typedef vtkInformationInternals::MapType MapType;
-    MapType::const_iterator i = this->Internal->Map.find(const_cast<vtkInformationKey*>(key));
-    if(i != this->Internal->Map.end())
+    size_t i = this->Internal->Find(const_cast<vtkInformationKey*>(key));
+    if(i != this->Internal->End())
       {
-      return i->second;
+      return this->Internal->GetValue(i);
       }
     }
   return 0;
@@ -181,11 +166,10 @@ vtkObjectBase* vtkInformation::GetAsObjectBase(vtkInformationKey* key)
 {
   if(key)
     {
-    typedef vtkInformationInternals::MapType MapType;
-    MapType::const_iterator i = this->Internal->Map.find(key);
-    if(i != this->Internal->Map.end())
+    size_t i = this->Internal->Find(key);
+    if(i != this->Internal->End())
       {
-      return i->second;
+      return this->Internal->GetValue(i);
       }
     }
   return 0;
@@ -200,18 +184,19 @@ void vtkInformation::Clear()
 //----------------------------------------------------------------------------
 void vtkInformation::Copy(vtkInformation* from, int deep)
 {
-  vtkInformationInternals* oldInternal = this->Internal;
-  this->Internal = new vtkInformationInternals;
+  // Keep the old entries until the copy is done, as they may hold the
+  // last references to the values being copied.
+  vtkInformationInternals oldInternal;
+  oldInternal.Swap(*this->Internal);
   if(from)
     {
-    typedef vtkInformationInternals::MapType MapType;
-    for(MapType::const_iterator i = from->Internal->Map.begin();
-        i != from->Internal->Map.end(); ++i)
+    vtkInformationInternals* internal = from->Internal;
+    for(size_t i = internal->Begin(); i != internal->End();
+        i = internal->Next(i))
       {
-      this->CopyEntry(from, i->first, deep);
+      this->CopyEntry(from, internal->GetKey(i), deep);
       }
     }
-  delete oldInternal;
 }
 
 //----------------------------------------------------------------------------
@@ -906,11 +891,10 @@ void vtkInformation::ReportReferences(vtkGarbageCollector* collector)
 {
   this->Superclass::ReportReferences(collector);
   // Ask each key/value pair to report any references it holds.
-  typedef vtkInformationInternals::MapType MapType;
-  for(MapType::const_iterator i = this->Internal->Map.begin();
-      i != this->Internal->Map.end(); ++i)
+  vtkInformationInternals* internal = this->Internal;
+  for(size_t i = internal->Begin(); i != internal->End(); i = internal->Next(i))
     {
-    i->first->Report(this, collector);
+    internal->GetKey(i)->Report(this, collector);
     }
 }
 
@@ -920,11 +904,11 @@ void vtkInformation::ReportAsObjectBase(vtkInformationKey* key,
 {
   if(key)
     {
-    typedef vtkInformationInternals::MapType MapType;
-    MapType::iterator i = this->Internal->Map.find(key);
-    if(i != this->Internal->Map.end())
+    size_t i = this->Internal->Find(key);
+    if(i != this->Internal->End())
       {
-      vtkGarbageCollectorReport(collector, i->second, key->GetName());
+      vtkGarbageCollectorReport(collector, this->Internal->GetValue(i),
+                                key->GetName());
       }
     }
 }
@@ -17,6 +17,13 @@
 // vtkInformationInternals is used in internal implementation of
 // vtkInformation. This should only be accessed by friends
 // and sub-classes of that class.
+//
+// The entries are kept in a flat open-addressing table with linear
+// probing. The first slots are stored in the object itself so that
+// information objects with few entries, such as pipeline requests, do
+// not allocate. Entries are addressed by slot index; removed entries
+// leave a marker so that removing an entry does not move the others
+// during a traversal.
 
 #ifndef __vtkInformationInternals_h
 #define __vtkInformationInternals_h
@@ -24,12 +31,7 @@
 #include "vtkInformationKey.h"
 #include "vtkObjectBase.h"
 
-#define VTK_INFORMATION_USE_HASH_MAP
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-# include <vtksys/hash_map.hxx>
-#else
-# include <vtksys/stl/map>
-#endif
+#include <string.h> // For memcpy and memset
 
 //----------------------------------------------------------------------------
 class vtkInformationInternals
@@ -37,37 +39,252 @@ class vtkInformationInternals
 public:
   typedef vtkInformationKey* KeyType;
   typedef vtkObjectBase* DataType;
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  struct HashFun
-  {
-    size_t operator()(KeyType key) const
-      {
-      return static_cast<size_t>(key - KeyType(0));
-      }
-  };
-  typedef vtksys::hash_map<KeyType, DataType, HashFun> MapType;
-#else
-  typedef vtksys_stl::map<KeyType, DataType> MapType;
-#endif
-  MapType Map;
 
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  vtkInformationInternals(): Map(33) {}
-#endif
+  vtkInformationInternals()
+    {
+    this->Keys = this->InlineKeys;
+    this->Values = this->InlineValues;
+    this->Capacity = InlineCapacity;
+    this->Size = 0;
+    this->NumberOfRemoved = 0;
+    memset(this->InlineKeys, 0, sizeof(this->InlineKeys));
+    }
 
   ~vtkInformationInternals()
     {
-    for(MapType::iterator i = this->Map.begin(); i != this->Map.end(); ++i)
+    for(size_t i = this->Begin(); i != this->End(); i = this->Next(i))
       {
-      if(vtkObjectBase* value = i->second)
+      if(vtkObjectBase* value = this->Values[i])
         {
         value->UnRegister(0);
         }
       }
+    this->FreeTable();
+    }
+
+  // Description:
+  // Traversal of the entries: slots from Begin() to End() by Next().
+  size_t Begin() const
+    {
+    return this->Skip(0);
+    }
+  size_t Next(size_t i) const
+    {
+    return this->Skip(i + 1);
+    }
+  size_t End() const
+    {
+    return this->Capacity;
+    }
+
+  // Description:
+  // Number of entries.
+  size_t GetSize() const
+    {
+    return this->Size;
+    }
+
+  KeyType GetKey(size_t i) const
+    {
+    return this->Keys[i];
+    }
+  DataType GetValue(size_t i) const
+    {
+    return this->Values[i];
+    }
+  DataType& GetValue(size_t i)
+    {
+    return this->Values[i];
+    }
+  void SetValue(size_t i, DataType value)
+    {
+    this->Values[i] = value;
+    }
+
+  // Description:
+  // Slot of the entry for a key, or End() if there is none.
+  size_t Find(KeyType key) const
+    {
+    size_t mask = this->Capacity - 1;
+    for(size_t i = this->Hash(key) & mask;; i = (i + 1) & mask)
+      {
+      KeyType k = this->Keys[i];
+      if(k == key)
+        {
+        return i;
+        }
+      if(!k)
+        {
+        return this->End();
+        }
+      }
+    }
+
+  // Description:
+  // Add an entry for a key that has none.
+  void Insert(KeyType key, DataType value)
+    {
+    // Keep at least a quarter of the slots empty so that probing stops.
+    if((this->Size + this->NumberOfRemoved + 1) * 4 > this->Capacity * 3)
+      {
+      this->Rehash((this->Size + 1) * 2 > this->Capacity ?
+                   this->Capacity * 2 : this->Capacity);
+      }
+    size_t mask = this->Capacity - 1;
+    size_t i = this->Hash(key) & mask;
+    while(this->Keys[i] && this->Keys[i] != Removed())
+      {
+      i = (i + 1) & mask;
+      }
+    if(this->Keys[i])
+      {
+      --this->NumberOfRemoved;
+      }
+    this->Keys[i] = key;
+    this->Values[i] = value;
+    ++this->Size;
     }
-};
 
-#undef VTK_INFORMATION_USE_HASH_MAP
+  // Description:
+  // Remove the entry in a slot. The value is not released.
+  void Erase(size_t i)
+    {
+    this->Keys[i] = Removed();
+    this->Values[i] = 0;
+    --this->Size;
+    ++this->NumberOfRemoved;
+    }
+
+  // Description:
+  // Exchange the entries of two tables.
+  void Swap(vtkInformationInternals& other)
+    {
+    vtkInformationInternals* a = this;
+    vtkInformationInternals* b = &other;
+    bool aInline = a->Keys == a->InlineKeys;
+    bool bInline = b->Keys == b->InlineKeys;
+    for(int i = 0; i < InlineCapacity; ++i)
+      {
+      KeyType key = a->InlineKeys[i];
+      a->InlineKeys[i] = b->InlineKeys[i];
+      b->InlineKeys[i] = key;
+      DataType value = a->InlineValues[i];
+      a->InlineValues[i] = b->InlineValues[i];
+      b->InlineValues[i] = value;
+      }
+    KeyType* keys = a->Keys;
+    DataType* values = a->Values;
+    a->Keys = bInline ? a->InlineKeys : b->Keys;
+    a->Values = bInline ? a->InlineValues : b->Values;
+    b->Keys = aInline ? b->InlineKeys : keys;
+    b->Values = aInline ? b->InlineValues : values;
+    size_t tmp = a->Capacity;
+    a->Capacity = b->Capacity;
+    b->Capacity = tmp;
+    tmp = a->Size;
+    a->Size = b->Size;
+    b->Size = tmp;
+    tmp = a->NumberOfRemoved;
+    a->NumberOfRemoved = b->NumberOfRemoved;
+    b->NumberOfRemoved = tmp;
+    }
+
+private:
+  enum { InlineCapacity = 8 };
+
+  // Marker of removed entries. Keys are heap allocated objects, so no
+  // key has this address.
+  static KeyType Removed()
+    {
+    return reinterpret_cast<KeyType>(static_cast<size_t>(1));
+    }
+
+  static size_t Hash(KeyType key)
+    {
+    // Drop the alignment bits and mix the rest into the low bits.
+    size_t h = reinterpret_cast<size_t>(key) >> 4;
+    h *= static_cast<size_t>(2654435769u);
+    return h ^ (h >> 15);
+    }
+
+  size_t Skip(size_t i) const
+    {
+    while(i < this->Capacity &&
+          (!this->Keys[i] || this->Keys[i] == Removed()))
+      {
+      ++i;
+      }
+    return i;
+    }
+
+  void FreeTable()
+    {
+    if(this->Keys != this->InlineKeys)
+      {
+      delete [] this->Keys;
+      delete [] this->Values;
+      }
+    }
+
+  // Move the entries to a table of the given capacity, a power of two,
+  // dropping the removed markers.
+  void Rehash(size_t capacity)
+    {
+    KeyType* oldKeys = this->Keys;
+    DataType* oldValues = this->Values;
+    size_t oldCapacity = this->Capacity;
+    KeyType inlineKeys[InlineCapacity];
+    DataType inlineValues[InlineCapacity];
+    if(oldKeys == this->InlineKeys)
+      {
+      memcpy(inlineKeys, this->InlineKeys, sizeof(inlineKeys));
+      memcpy(inlineValues, this->InlineValues, sizeof(inlineValues));
+      oldKeys = inlineKeys;
+      oldValues = inlineValues;
+      }
+
+    if(capacity <= InlineCapacity)
+      {
+      this->Keys = this->InlineKeys;
+      this->Values = this->InlineValues;
+      capacity = InlineCapacity;
+      }
+    else
+      {
+      this->Keys = new KeyType[capacity];
+      this->Values = new DataType[capacity];
+      }
+    memset(this->Keys, 0, capacity * sizeof(KeyType));
+    this->Capacity = capacity;
+    this->Size = 0;
+    this->NumberOfRemoved = 0;
+
+    for(size_t i = 0; i < oldCapacity; ++i)
+      {
+      if(oldKeys[i] && oldKeys[i] != Removed())
+        {
+        this->Insert(oldKeys[i], oldValues[i]);
+        }
+      }
+    if(oldKeys != inlineKeys)
+      {
+      delete [] oldKeys;
+      delete [] oldValues;
+      }
+    }
+
+  KeyType* Keys;
+  DataType* Values;
+  size_t Capacity;
+  size_t Size;
+  size_t NumberOfRemoved;
+
+  KeyType InlineKeys[InlineCapacity];
+  DataType InlineValues[InlineCapacity];
+
+  vtkInformationInternals(const vtkInformationInternals&);  // Not implemented.
+  void operator=(const vtkInformationInternals&);  // Not implemented.
+};
 
 #endif
 // VTK-HeaderTest-Exclude: vtkInformationInternals.h
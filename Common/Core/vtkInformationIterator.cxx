@@ -24,7 +24,9 @@ vtkStandardNewMacro(vtkInformationIterator);
 class vtkInformationIteratorInternals
 {
 public:
-  vtkInformationInternals::MapType::iterator Iterator;
+  size_t Iterator;
+
+  vtkInformationIteratorInternals() : Iterator(0) {}
 };
 
 //----------------------------------------------------------------------------
@@ -86,7 +88,7 @@ void vtkInformationIterator::GoToFirstItem()
     vtkErrorMacro("No information has been set.");
     return;
     }
-  this->Internal->Iterator = this->Information->Internal->Map.begin();
+  this->Internal->Iterator = this->Information->Internal->Begin();
 }
 
 //----------------------------------------------------------------------------
@@ -98,7 +100,8 @@ void vtkInformationIterator::GoToNextItem()
     return;
     }
 
-  ++this->Internal->Iterator;
+  this->Internal->Iterator =
+    this->Information->Internal->Next(this->Internal->Iterator);
 }
 
 //----------------------------------------------------------------------------
@@ -110,7 +113,7 @@ int vtkInformationIterator::IsDoneWithTraversal()
     return 1;
     }
 
-  if(this->Internal->Iterator == this->Information->Internal->Map.end())
+  if(this->Internal->Iterator >= this->Information->Internal->End())
     {
     return 1;
     }
@@ -125,7 +128,7 @@ vtkInformationKey* vtkInformationIterator::GetCurrentKey()
     return 0;
     }
 
-  return this->Internal->Iterator->first;
+  return this->Information->Internal->GetKey(this->Internal->Iterator);
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPointLocatorBatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+// Compares the batched searches of a locator with its single point
+// searches. Returns the number of mismatches.
+static int CompareBatchSearch(vtkAbstractPointLocator *locator,
+                              vtkPoints *queries)
+{
+  int rval = 0;
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> ids;
+  vtkNew<vtkDoubleArray> dist2;
+  vtkNew<vtkIdList> list;
+  vtkIdType numQueries = queries->GetNumberOfPoints();
+  double x[3], pt[3];
+
+  const int N = 7;
+  locator->BatchFindClosestNPoints(N, queries, offsets.GetPointer(),
+                                   ids.GetPointer(), dist2.GetPointer());
+  if (offsets->GetNumberOfTuples() != numQueries+1 ||
+      ids->GetNumberOfTuples() != numQueries*N ||
+      dist2->GetNumberOfTuples() != ids->GetNumberOfTuples())
+    {
+    cerr << "Wrong output size for BatchFindClosestNPoints\n";
+    return 1;
+    }
+  for (vtkIdType q = 0; q < numQueries; ++q)
+    {
+    queries->GetPoint(q, x);
+    locator->FindClosestNPoints(N, x, list.GetPointer());
+    vtkIdType start = offsets->GetValue(q);
+    if (offsets->GetValue(q+1) - start != list->GetNumberOfIds())
+      {
+      cerr << "Wrong number of neighbors for query " << q << "\n";
+      rval++;
+      continue;
+      }
+    for (vtkIdType i = 0; i < list->GetNumberOfIds(); ++i)
+      {
+      if (ids->GetValue(start+i) != list->GetId(i))
+        {
+        cerr << "Closest N mismatch for query " << q << "\n";
+        rval++;
+        }
+      locator->GetDataSet()->GetPoint(ids->GetValue(start+i), pt);
+      if (dist2->GetValue(start+i) != vtkMath::Distance2BetweenPoints(x, pt))
+        {
+        cerr << "Wrong distance for query " << q << "\n";
+        rval++;
+        }
+      }
+    }
+
+  const double R = 0.1;
+  locator->BatchFindPointsWithinRadius(R, queries, offsets.GetPointer(),
+                                       ids.GetPointer());
+  if (offsets->GetNumberOfTuples() != numQueries+1 ||
+      offsets->GetValue(numQueries) != ids->GetNumberOfTuples())
+    {
+    cerr << "Wrong output size for BatchFindPointsWithinRadius\n";
+    return rval+1;
+    }
+  for (vtkIdType q = 0; q < numQueries; ++q)
+    {
+    queries->GetPoint(q, x);
+    locator->FindPointsWithinRadius(R, x, list.GetPointer());
+    vtkIdType start = offsets->GetValue(q);
+    if (offsets->GetValue(q+1) - start != list->GetNumberOfIds())
+      {
+      cerr << "Wrong number of neighbors within radius for query "
+           << q << "\n";
+      rval++;
+      continue;
+      }
+    for (vtkIdType i = 0; i < list->GetNumberOfIds(); ++i)
+      {
+      if (ids->GetValue(start+i) != list->GetId(i))
+        {
+        cerr << "Radius search mismatch for query " << q << "\n";
+        rval++;
+        }
+      }
+    }
+
+  return rval;
+}
+
+int TestPointLocatorBatch(int, char*[])
+{
+  vtkMath::RandomSeed(1234);
+
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 5000; ++i)
+    {
+    points->InsertNextPoint(vtkMath::Random(), vtkMath::Random(),
+                            vtkMath::Random());
+    }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points.GetPointer());
+
+  // Enough queries to span several batches, some outside the bounds.
+  vtkNew<vtkPoints> queries;
+  for (int i = 0; i < 3000; ++i)
+    {
+    queries->InsertNextPoint(vtkMath::Random(-0.2, 1.2),
+                             vtkMath::Random(-0.2, 1.2),
+                             vtkMath::Random(-0.2, 1.2));
+    }
+
+  int rval = 0;
+
+  vtkNew<vtkPointLocator> pointLocator;
+  pointLocator->SetDataSet(polyData.GetPointer());
+  pointLocator->BuildLocator();
+  rval += CompareBatchSearch(pointLocator.GetPointer(), queries.GetPointer());
+
+  vtkNew<vtkKdTreePointLocator> kdTreeLocator;
+  kdTreeLocator->SetDataSet(polyData.GetPointer());
+  kdTreeLocator->BuildLocator();
+  rval += CompareBatchSearch(kdTreeLocator.GetPointer(), queries.GetPointer());
+
+  // An empty query set produces a single zero offset.
+  vtkNew<vtkPoints> noQueries;
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> ids;
+  pointLocator->BatchFindPointsWithinRadius(0.1, noQueries.GetPointer(),
+                                            offsets.GetPointer(),
+                                            ids.GetPointer());
+  if (offsets->GetNumberOfTuples() != 1 || offsets->GetValue(0) != 0 ||
+      ids->GetNumberOfTuples() != 0)
+    {
+    cerr << "Wrong output for empty query set\n";
+    rval++;
+    }
+
+  return rval == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
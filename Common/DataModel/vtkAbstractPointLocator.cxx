@@ -15,7 +15,128 @@
 #include "vtkAbstractPointLocator.h"
 
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Queries are processed in fixed size batches. Each batch owns a contiguous
+// buffer for the neighbors it finds so that no synchronization is needed
+// while searching; the buffers are packed into the output once the number
+// of neighbors of every query is known.
+const vtkIdType VTK_LOCATOR_BATCH_SIZE = 1024;
+
+typedef std::vector<std::vector<vtkIdType> > vtkLocatorBatchBuffers;
+
+// Searches the queries of a range of batches.
+class vtkLocatorBatchGather
+{
+public:
+  vtkAbstractPointLocator *Locator;
+  vtkPoints *Queries;
+  bool ClosestN;
+  int N;
+  double R;
+  vtkIdType *Counts;
+  vtkLocatorBatchBuffers *Buffers;
+  vtkSMPThreadLocalObject<vtkIdList> Result;
+
+  void operator()(vtkIdType batch, vtkIdType endBatch)
+  {
+    vtkIdList *result = this->Result.Local();
+    vtkIdType numQueries = this->Queries->GetNumberOfPoints();
+    double x[3];
+
+    for ( ; batch < endBatch; ++batch )
+      {
+      std::vector<vtkIdType> &buffer = (*this->Buffers)[batch];
+      buffer.clear();
+      vtkIdType q = batch * VTK_LOCATOR_BATCH_SIZE;
+      vtkIdType qEnd = q + VTK_LOCATOR_BATCH_SIZE;
+      qEnd = ( qEnd < numQueries ? qEnd : numQueries );
+      for ( ; q < qEnd; ++q )
+        {
+        this->Queries->GetPoint(q, x);
+        if ( this->ClosestN )
+          {
+          if ( this->N > 0 )
+            {
+            this->Locator->FindClosestNPoints(this->N, x, result);
+            }
+          else
+            {
+            result->Reset();
+            }
+          }
+        else
+          {
+          this->Locator->FindPointsWithinRadius(this->R, x, result);
+          }
+        vtkIdType num = result->GetNumberOfIds();
+        this->Counts[q] = num;
+        if ( num > 0 )
+          {
+          vtkIdType *ptIds = result->GetPointer(0);
+          buffer.insert(buffer.end(), ptIds, ptIds + num);
+          }
+        }
+      }
+  }
+};
+
+// Copies the neighbors of a range of batches into their final position and
+// optionally computes the squared distances.
+class vtkLocatorBatchPack
+{
+public:
+  vtkDataSet *DataSet;
+  vtkPoints *Queries;
+  const vtkIdType *Offsets;
+  vtkLocatorBatchBuffers *Buffers;
+  vtkIdType *Ids;
+  double *Dist2;
+
+  void operator()(vtkIdType batch, vtkIdType endBatch) const
+  {
+    double x[3], pt[3];
+
+    for ( ; batch < endBatch; ++batch )
+      {
+      const std::vector<vtkIdType> &buffer = (*this->Buffers)[batch];
+      if ( buffer.empty() )
+        {
+        continue;
+        }
+      vtkIdType q = batch * VTK_LOCATOR_BATCH_SIZE;
+      vtkIdType start = this->Offsets[q];
+      std::copy(buffer.begin(), buffer.end(), this->Ids + start);
+      if ( !this->Dist2 )
+        {
+        continue;
+        }
+      vtkIdType numInBatch = static_cast<vtkIdType>(buffer.size());
+      for ( vtkIdType i = 0; i < numInBatch; ++i )
+        {
+        while ( this->Offsets[q+1] <= start + i )
+          {
+          ++q;
+          }
+        this->Queries->GetPoint(q, x);
+        this->DataSet->GetPoint(buffer[i], pt);
+        this->Dist2[start+i] = vtkMath::Distance2BetweenPoints(x, pt);
+        }
+      }
+  }
+};
+}
 
 
 vtkAbstractPointLocator::vtkAbstractPointLocator()
@@ -62,6 +183,98 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(double R, double x,
   this->FindPointsWithinRadius(R,p,result);
 }
 
+void vtkAbstractPointLocator::BatchFindClosestNPoints(int N,
+                                                      vtkPoints *queries,
+                                                      vtkIdTypeArray *offsets,
+                                                      vtkIdTypeArray *ids,
+                                                      vtkDoubleArray *dist2)
+{
+  this->BatchFind(true, N, 0.0, queries, offsets, ids, dist2);
+}
+
+void vtkAbstractPointLocator::BatchFindPointsWithinRadius(double R,
+                                                          vtkPoints *queries,
+                                                          vtkIdTypeArray *offsets,
+                                                          vtkIdTypeArray *ids,
+                                                          vtkDoubleArray *dist2)
+{
+  this->BatchFind(false, 0, R, queries, offsets, ids, dist2);
+}
+
+void vtkAbstractPointLocator::BatchFind(bool closestN, int N, double R,
+                                        vtkPoints *queries,
+                                        vtkIdTypeArray *offsets,
+                                        vtkIdTypeArray *ids,
+                                        vtkDoubleArray *dist2)
+{
+  if ( !offsets || !ids )
+    {
+    vtkErrorMacro(<<"Offsets and ids arrays must be provided");
+    return;
+    }
+  vtkIdType numQueries = ( queries ? queries->GetNumberOfPoints() : 0 );
+
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(numQueries+1);
+  vtkIdType *offs = offsets->GetPointer(0);
+  offs[0] = 0;
+  ids->SetNumberOfComponents(1);
+  if ( dist2 )
+    {
+    dist2->SetNumberOfComponents(1);
+    }
+
+  if ( numQueries < 1 )
+    {
+    ids->SetNumberOfTuples(0);
+    if ( dist2 )
+      {
+      dist2->SetNumberOfTuples(0);
+      }
+    return;
+    }
+
+  // Build once so the concurrent queries only read the search structure.
+  this->BuildLocator();
+
+  vtkIdType numBatches =
+    (numQueries + VTK_LOCATOR_BATCH_SIZE - 1) / VTK_LOCATOR_BATCH_SIZE;
+  vtkLocatorBatchBuffers buffers(numBatches);
+
+  // The count of each query is stored one slot ahead of its offset so that
+  // a running sum converts the counts into offsets in place.
+  vtkLocatorBatchGather gather;
+  gather.Locator = this;
+  gather.Queries = queries;
+  gather.ClosestN = closestN;
+  gather.N = N;
+  gather.R = R;
+  gather.Counts = offs + 1;
+  gather.Buffers = &buffers;
+  vtkSMPTools::For(0, numBatches, 1, gather);
+
+  for ( vtkIdType q = 0; q < numQueries; ++q )
+    {
+    offs[q+1] += offs[q];
+    }
+
+  vtkIdType numIds = offs[numQueries];
+  ids->SetNumberOfTuples(numIds);
+  if ( dist2 )
+    {
+    dist2->SetNumberOfTuples(numIds);
+    }
+
+  vtkLocatorBatchPack pack;
+  pack.DataSet = this->DataSet;
+  pack.Queries = queries;
+  pack.Offsets = offs;
+  pack.Buffers = &buffers;
+  pack.Ids = ids->GetPointer(0);
+  pack.Dist2 = ( dist2 ? dist2->GetPointer(0) : NULL );
+  vtkSMPTools::For(0, numBatches, 1, pack);
+}
+
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
   for(int i=0;i<6;i++)
@@ -27,7 +27,10 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkLocator.h"
 
+class vtkDoubleArray;
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -72,6 +75,26 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z,
                                       vtkIdList *result);
 
+  // Description:
+  // Batched versions of FindClosestNPoints() and FindPointsWithinRadius().
+  // Every point in queries is searched and the results are returned in
+  // compressed sparse row form: offsets receives (number of queries + 1)
+  // values and the neighbors of query i are ids[offsets[i]] up to (but not
+  // including) ids[offsets[i+1]]. For the closest N search the neighbors of
+  // each query are sorted from closest to farthest. If dist2 is non-NULL
+  // it is filled with the squared distance of each returned point, parallel
+  // to ids. Queries are processed concurrently using vtkSMPTools, with the
+  // locator built once up front, so subclasses only need thread safe
+  // single point queries to benefit.
+  virtual void BatchFindClosestNPoints(int N, vtkPoints *queries,
+                                       vtkIdTypeArray *offsets,
+                                       vtkIdTypeArray *ids,
+                                       vtkDoubleArray *dist2=NULL);
+  virtual void BatchFindPointsWithinRadius(double R, vtkPoints *queries,
+                                           vtkIdTypeArray *offsets,
+                                           vtkIdTypeArray *ids,
+                                           vtkDoubleArray *dist2=NULL);
+
   // Description:
   // Provide an accessor to the bounds.
   virtual double *GetBounds() { return this->Bounds; }
@@ -90,6 +113,13 @@ protected:
 
   double Bounds[6]; // bounds of points
 
+  // Description:
+  // Shared implementation of the batched searches. Gathers the closest N
+  // points if closestN is true, otherwise all points within radius R.
+  void BatchFind(bool closestN, int N, double R, vtkPoints *queries,
+                 vtkIdTypeArray *offsets, vtkIdTypeArray *ids,
+                 vtkDoubleArray *dist2);
+
 private:
   vtkAbstractPointLocator(const vtkAbstractPointLocator&);  // Not implemented.
   void operator=(const vtkAbstractPointLocator&);  // Not implemented.
@@ -52,6 +52,10 @@ public:
   // Evaluate the gradient of the box.
   void EvaluateGradient(double x[3], double n[3]);
 
+  // Description:
+  // Evaluating the box is thread safe.
+  bool IsThreadSafe() { return true; }
+
   // Description:
   // Set / get the bounding box using various methods.
   void SetXMin(double p[3]);
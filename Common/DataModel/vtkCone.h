@@ -51,6 +51,10 @@ public:
   // Evaluate cone normal.
   void EvaluateGradient(double x[3], double g[3]);
 
+  // Description:
+  // Evaluating the cone equation is thread safe.
+  bool IsThreadSafe() { return true; }
+
   // Description:
   // Set/Get the cone angle (expressed in degrees).
   vtkSetClampMacro(Angle,double,0.0,89.0);
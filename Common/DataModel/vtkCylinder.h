@@ -51,6 +51,10 @@ public:
   // Evaluate cylinder function gradient.
   void EvaluateGradient(double x[3], double g[3]);
 
+  // Description:
+  // Evaluating the cylinder equation is thread safe.
+  bool IsThreadSafe() { return true; }
+
   // Description:
   // Set/Get cylinder radius.
   vtkSetMacro(Radius,double);
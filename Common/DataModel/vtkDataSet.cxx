@@ -244,6 +244,12 @@ unsigned long int vtkDataSet::GetMTime()
   return ( mtime > result ? mtime : result );
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkDataSet::GetGeometryMTime()
+{
+  return vtkDataObject::GetMTime();
+}
+
 //----------------------------------------------------------------------------
 vtkCell *vtkDataSet::FindAndGetCell (double x[3], vtkCell *cell,
                                      vtkIdType cellId, double tol2, int& subId,
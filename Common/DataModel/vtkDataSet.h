@@ -210,6 +210,17 @@ public:
   // THIS METHOD IS THREAD SAFE
   unsigned long int GetMTime();
 
+  // Description:
+  // Return the modification time of the geometry and topology of the
+  // dataset, ignoring its point and cell data. Filters whose output
+  // structure only depends on the geometry compare it between executions
+  // to find whether only the attributes changed. By default any
+  // modification of the dataset object itself is reported. Replacing a
+  // part of the geometry by an older one may leave it unchanged, so such
+  // filters also compare the parts themselves.
+  // THIS METHOD IS THREAD SAFE
+  virtual unsigned long GetGeometryMTime();
+
   // Description:
   // Return a pointer to this dataset's cell data.
   // THIS METHOD IS THREAD SAFE
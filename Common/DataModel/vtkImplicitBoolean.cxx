@@ -52,6 +52,22 @@ unsigned long int vtkImplicitBoolean::GetMTime()
   return mtime;
 }
 
+// The boolean is thread safe if all of its functions are.
+bool vtkImplicitBoolean::IsThreadSafe()
+{
+  vtkImplicitFunction *f;
+  vtkCollectionSimpleIterator sit;
+  for (this->FunctionList->InitTraversal(sit);
+       (f=this->FunctionList->GetNextImplicitFunction(sit)); )
+    {
+    if ( !f->IsThreadSafe() )
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
 // Add another implicit function to the list of functions.
 void vtkImplicitBoolean::AddFunction(vtkImplicitFunction *f)
 {
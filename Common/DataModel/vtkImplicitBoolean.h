@@ -65,6 +65,10 @@ public:
   // Evaluate gradient of boolean combination.
   void EvaluateGradient(double x[3], double g[3]);
 
+  // Description:
+  // The boolean is thread safe if all the functions it combines are.
+  bool IsThreadSafe();
+
   // Description:
   // Override modified time retrieval because of object dependencies.
   unsigned long GetMTime();
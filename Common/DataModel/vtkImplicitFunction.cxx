@@ -16,10 +16,34 @@
 
 #include "vtkMath.h"
 #include "vtkAbstractTransform.h"
+#include "vtkDataArray.h"
+#include "vtkSMPTools.h"
 #include "vtkTransform.h"
 
 vtkCxxSetObjectMacro(vtkImplicitFunction,Transform,vtkAbstractTransform);
 
+namespace
+{
+// Evaluates the implicit function over a range of tuples.
+class vtkImplicitFunctionValueOp
+{
+public:
+  vtkImplicitFunction *Function;
+  vtkDataArray *Input;
+  vtkDataArray *Output;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId) const
+  {
+    double x[3];
+    for ( ; ptId < endPtId; ++ptId )
+      {
+      this->Input->GetTuple(ptId, x);
+      this->Output->SetComponent(ptId, 0, this->Function->FunctionValue(x));
+      }
+  }
+};
+}
+
 vtkImplicitFunction::vtkImplicitFunction()
 {
   this->Transform = NULL;
@@ -72,6 +96,38 @@ double vtkImplicitFunction::FunctionValue(const double x[3])
   */
 }
 
+// Evaluate the function for an array of positions.
+void vtkImplicitFunction::FunctionValue(vtkDataArray *input,
+                                        vtkDataArray *output)
+{
+  if ( !input || !output || input->GetNumberOfComponents() != 3 )
+    {
+    vtkErrorMacro(<<"Expecting a 3-component input array");
+    return;
+    }
+
+  vtkIdType numPts = input->GetNumberOfTuples();
+  output->SetNumberOfComponents(1);
+  output->SetNumberOfTuples(numPts);
+
+  vtkImplicitFunctionValueOp op;
+  op.Function = this;
+  op.Input = input;
+  op.Output = output;
+  if ( this->IsThreadSafe() )
+    {
+    if ( this->Transform )
+      {
+      this->Transform->Update();
+      }
+    vtkSMPTools::For(0, numPts, op);
+    }
+  else
+    {
+    op(0, numPts);
+    }
+}
+
 // Evaluate function gradient at position x-y-z and pass back vector. Point
 // x[3] is transformed through transform (if provided).
 void vtkImplicitFunction::FunctionGradient(const double x[3], double g[3])
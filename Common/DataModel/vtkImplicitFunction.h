@@ -51,6 +51,7 @@
 #include "vtkObject.h"
 
 class vtkAbstractTransform;
+class vtkDataArray;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkImplicitFunction : public vtkObject
 {
@@ -70,6 +71,14 @@ public:
   double FunctionValue(double x, double y, double z) {
     double xyz[3] = {x, y, z}; return this->FunctionValue(xyz); };
 
+  // Description:
+  // Evaluate the function at each tuple of input (a 3-component array of
+  // positions) and store the values in output, which is resized to hold
+  // one component per input tuple. Points are transformed as in
+  // FunctionValue(). When IsThreadSafe() returns true the evaluation is
+  // done in parallel with vtkSMPTools.
+  void FunctionValue(vtkDataArray *input, vtkDataArray *output);
+
   // Description:
   // Evaluate function gradient at position x-y-z and pass back vector. Point
   // x[3] is transformed through transform (if provided).
@@ -103,6 +112,15 @@ public:
   // any derived class.
   virtual void EvaluateGradient(double x[3], double g[3]) = 0;
 
+  // Description:
+  // Return true if EvaluateFunction() and EvaluateGradient() may be
+  // called concurrently from several threads (as long as the function is
+  // not modified meanwhile). Filters such as vtkSampleFunction use this
+  // to decide whether to evaluate the function in parallel. The default
+  // is false; subclasses whose evaluation does not modify any state
+  // override it.
+  virtual bool IsThreadSafe() { return false; }
+
 protected:
   vtkImplicitFunction();
   ~vtkImplicitFunction();
@@ -45,6 +45,10 @@ public:
   // Evaluate function gradient at point x[3].
   void EvaluateGradient(double x[3], double g[3]);
 
+  // Description:
+  // Evaluating the plane equation is thread safe.
+  bool IsThreadSafe() { return true; }
+
   // Description:
   // Set/get plane normal. Plane is defined by point and normal.
   vtkSetVector3Macro(Normal,double);
@@ -59,6 +59,10 @@ public:
   // Evaluate planes gradient.
   void EvaluateGradient(double x[3], double n[3]);
 
+  // Description:
+  // Evaluation only reads the points and normals, so it is thread safe.
+  bool IsThreadSafe() { return true; }
+
   // Description:
   // Specify a list of points defining points through which the planes pass.
   virtual void SetPoints(vtkPoints*);
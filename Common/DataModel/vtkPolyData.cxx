@@ -1772,6 +1772,22 @@ unsigned long vtkPolyData::GetActualMemorySize()
   return size;
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkPolyData::GetGeometryMTime()
+{
+  vtkObject* parts[5] = {this->Points, this->Verts, this->Lines, this->Polys,
+                         this->Strips};
+  unsigned long mtime = 0;
+  for (int i = 0; i < 5; i++)
+    {
+    if ( parts[i] && parts[i]->GetMTime() > mtime )
+      {
+      mtime = parts[i]->GetMTime();
+      }
+    }
+  return mtime;
+}
+
 //----------------------------------------------------------------------------
 void vtkPolyData::ShallowCopy(vtkDataObject *dataObject)
 {
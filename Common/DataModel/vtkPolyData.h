@@ -378,6 +378,11 @@ public:
   // IS THREAD SAFE.
   unsigned long GetActualMemorySize();
 
+  // Description:
+  // Return the modification time of the points and cells, ignoring the
+  // point and cell data.
+  virtual unsigned long GetGeometryMTime();
+
   // Description:
   // Shallow and Deep copy.
   void ShallowCopy(vtkDataObject *src);
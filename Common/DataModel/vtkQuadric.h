@@ -44,6 +44,10 @@ public:
   // Evaluate the gradient to the quadric equation.
   void EvaluateGradient(double x[3], double g[3]);
 
+  // Description:
+  // Evaluating the quadric is thread safe.
+  bool IsThreadSafe() { return true; }
+
   // Description
   // Set / get the 10 coefficients of the quadric equation.
   void SetCoefficients(double a[10]);
@@ -45,6 +45,10 @@ public:
   // Evaluate sphere gradient.
   void EvaluateGradient(double x[3], double n[3]);
 
+  // Description:
+  // Evaluating the sphere equation is thread safe.
+  bool IsThreadSafe() { return true; }
+
   // Description:
   // Set / get the radius of the sphere. The default is 0.5.
   vtkSetMacro(Radius,double);
@@ -61,6 +61,10 @@ public:
     {return this->vtkImplicitFunction::EvaluateFunction(x, y, z); } ;
   void EvaluateGradient(double x[3], double g[3]);
 
+  // Description:
+  // Evaluating the superquadric is thread safe.
+  bool IsThreadSafe() { return true; }
+
   // Description:
   // Set the center of the superquadric. Default is 0,0,0.
   vtkSetVector3Macro(Center,double);
@@ -1575,6 +1575,22 @@ unsigned long vtkUnstructuredGrid::GetActualMemorySize()
   return size;
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkUnstructuredGrid::GetGeometryMTime()
+{
+  vtkObject* parts[6] = {this->Points, this->Connectivity, this->Types,
+                         this->Locations, this->Faces, this->FaceLocations};
+  unsigned long mtime = 0;
+  for (int i = 0; i < 6; i++)
+    {
+    if ( parts[i] && parts[i]->GetMTime() > mtime )
+      {
+      mtime = parts[i]->GetMTime();
+      }
+    }
+  return mtime;
+}
+
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::ShallowCopy(vtkDataObject *dataObject)
 {
@@ -209,6 +209,11 @@ public:
   // IS THREAD SAFE.
   unsigned long GetActualMemorySize();
 
+  // Description:
+  // Return the modification time of the points and cells, ignoring the
+  // point and cell data.
+  virtual unsigned long GetGeometryMTime();
+
   // Description:
   // Shallow and Deep copy.
   virtual void ShallowCopy(vtkDataObject *src);
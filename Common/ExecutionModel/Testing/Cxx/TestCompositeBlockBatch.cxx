@@ -0,0 +1,167 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompositeBlockBatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that vtkCompositeDataPipeline executes simple
+// algorithms that set BLOCK_BATCH_SIZE() once per batch of consecutive
+// blocks of the same type, and places the outputs of a batch in the
+// blocks they were computed from.
+
+#include "vtkCompositeDataPipeline.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationObjectBaseVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Produces a polydata with as many points as its input.
+class BatchAlgorithm : public vtkPolyDataAlgorithm
+{
+public:
+  static BatchAlgorithm *New();
+  vtkTypeMacro(BatchAlgorithm,vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions;
+  int NumberOfBatches;
+
+protected:
+  BatchAlgorithm()
+  {
+    this->NumberOfExecutions = 0;
+    this->NumberOfBatches = 0;
+  }
+
+  virtual int FillInputPortInformation(int, vtkInformation* info)
+  {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+    info->Set(vtkCompositeDataPipeline::BLOCK_BATCH_SIZE(), 4);
+    return 1;
+  }
+
+  static void Process(vtkDataSet* input, vtkPolyData* output)
+  {
+    vtkPoints* points = vtkPoints::New();
+    points->SetNumberOfPoints(input->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+      {
+      points->SetPoint(i, input->GetPoint(i));
+      }
+    output->SetPoints(points);
+    points->Delete();
+  }
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+  {
+    this->NumberOfExecutions++;
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkInformationObjectBaseVectorKey* batch =
+      vtkCompositeDataPipeline::BLOCK_BATCH();
+    if (!inInfo->Has(batch))
+      {
+      this->Process(vtkDataSet::GetData(inInfo), vtkPolyData::GetData(outInfo));
+      return 1;
+      }
+
+    this->NumberOfBatches++;
+    for (int i = 0; i < batch->Size(inInfo); ++i)
+      {
+      vtkPolyData* output = vtkPolyData::New();
+      this->Process(vtkDataSet::SafeDownCast(batch->Get(inInfo, i)), output);
+      batch->Append(outInfo, output);
+      output->Delete();
+      }
+    return 1;
+  }
+};
+vtkStandardNewMacro(BatchAlgorithm);
+
+int TestCompositeBlockBatch(int, char*[])
+{
+  // Five polydata, an empty block, three polydata, an image, two polydata.
+  vtkNew<vtkMultiBlockDataSet> input;
+  int sizes[12] = {1, 2, 3, 4, 5, -1, 6, 7, 8, -2, 9, 10};
+  for (unsigned int i = 0; i < 12; ++i)
+    {
+    if (sizes[i] == -1)
+      {
+      input->SetBlock(i, 0);
+      }
+    else if (sizes[i] == -2)
+      {
+      vtkNew<vtkImageData> image;
+      image->SetDimensions(3, 3, 1);
+      input->SetBlock(i, image.GetPointer());
+      }
+    else
+      {
+      vtkNew<vtkPoints> points;
+      points->SetNumberOfPoints(sizes[i]);
+      for (vtkIdType j = 0; j < sizes[i]; ++j)
+        {
+        points->SetPoint(j, j, i, 0.0);
+        }
+      vtkNew<vtkPolyData> polyData;
+      polyData->SetPoints(points.GetPointer());
+      input->SetBlock(i, polyData.GetPointer());
+      }
+    }
+
+  vtkNew<BatchAlgorithm> algorithm;
+  algorithm->SetInputData(input.GetPointer());
+  algorithm->Update();
+
+  int success = 1;
+
+  // Empty blocks are skipped: batches of blocks 0-3, 4 and 6-8, 10-11;
+  // the image on its own.
+  if (algorithm->NumberOfExecutions != 4 || algorithm->NumberOfBatches != 3)
+    {
+    cerr << "Expected 4 executions with 3 batches, got "
+         << algorithm->NumberOfExecutions << " and "
+         << algorithm->NumberOfBatches << endl;
+    success = 0;
+    }
+
+  vtkMultiBlockDataSet* output =
+    vtkMultiBlockDataSet::SafeDownCast(algorithm->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfBlocks() != 12)
+    {
+    cerr << "Expected a multiblock output with 12 blocks" << endl;
+    return TEST_FAILURE;
+    }
+  for (unsigned int i = 0; i < 12; ++i)
+    {
+    vtkPolyData* block = vtkPolyData::SafeDownCast(output->GetBlock(i));
+    vtkIdType expected = sizes[i] == -2 ? 9 : sizes[i];
+    if (sizes[i] == -1 ? block != 0 :
+        (!block || block->GetNumberOfPoints() != expected ||
+         (sizes[i] > 0 && block->GetPoint(0)[1] != i)))
+      {
+      cerr << "Unexpected output for block " << i << endl;
+      success = 0;
+      }
+    }
+
+  return success ? TEST_SUCCESS : TEST_FAILURE;
+}
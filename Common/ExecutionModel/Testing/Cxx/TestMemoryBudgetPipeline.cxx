@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMemoryBudgetPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkMemoryBudgetPipeline releases intermediate
+// outputs to stay within the limit of its vtkPipelineMemoryBudget, that
+// final outputs are kept, and that released outputs are recomputed when
+// they are needed again.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMemoryBudgetPipeline.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineMemoryBudget.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Produces a cloud of points when NumberOfInputPorts is 0, otherwise
+// translates a deep copy of its input.
+class MemoryBudgetAlgorithm : public vtkPolyDataAlgorithm
+{
+public:
+  static MemoryBudgetAlgorithm *New();
+  vtkTypeMacro(MemoryBudgetAlgorithm,vtkPolyDataAlgorithm);
+
+  vtkSetMacro(Offset,double);
+
+  void SetSource()
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  double Offset;
+  int NumberOfExecutions;
+
+protected:
+  MemoryBudgetAlgorithm()
+  {
+    this->Offset = 1.0;
+    this->NumberOfExecutions = 0;
+  }
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkPoints* points = vtkPoints::New();
+    if (this->GetNumberOfInputPorts() == 0)
+      {
+      points->SetNumberOfPoints(100000);
+      for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+        {
+        points->SetPoint(i, i, 0.0, 0.0);
+        }
+      }
+    else
+      {
+      vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+      points->DeepCopy(input->GetPoints());
+      for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+        {
+        double x[3];
+        points->GetPoint(i, x);
+        x[1] += this->Offset;
+        points->SetPoint(i, x);
+        }
+      }
+    output->SetPoints(points);
+    points->Delete();
+    this->NumberOfExecutions++;
+    return 1;
+  }
+
+private:
+  MemoryBudgetAlgorithm(const MemoryBudgetAlgorithm&);
+  void operator=(const MemoryBudgetAlgorithm&);
+};
+vtkStandardNewMacro(MemoryBudgetAlgorithm);
+
+static int Check(const char* what, int value, int expected)
+{
+  if (value != expected)
+    {
+    cerr << what << ": expected " << expected << ", got " << value << endl;
+    return 0;
+    }
+  return 1;
+}
+
+int TestMemoryBudgetPipeline(int, char*[])
+{
+  int success = 1;
+
+  // A source followed by three filters, all sharing one budget.
+  const int numAlgorithms = 4;
+  vtkNew<vtkPipelineMemoryBudget> budget;
+  vtkNew<MemoryBudgetAlgorithm> algorithms[numAlgorithms];
+  int i;
+  for (i = 0; i < numAlgorithms; ++i)
+    {
+    vtkNew<vtkMemoryBudgetPipeline> executive;
+    executive->SetMemoryBudget(budget.GetPointer());
+    algorithms[i]->SetExecutive(executive.GetPointer());
+    if (i == 0)
+      {
+      algorithms[i]->SetSource();
+      }
+    else
+      {
+      algorithms[i]->SetInputConnection(algorithms[i-1]->GetOutputPort());
+      }
+    }
+  MemoryBudgetAlgorithm* sink = algorithms[numAlgorithms-1].GetPointer();
+
+  // Without a limit everything is kept and only modified algorithms
+  // re-execute.
+  sink->Update();
+  unsigned long outputSize = sink->GetOutput()->GetActualMemorySize();
+  success &= Check("Released outputs", budget->GetNumberOfReleasedOutputs(), 0);
+  sink->SetOffset(2.0);
+  sink->Update();
+  for (i = 0; i < numAlgorithms; ++i)
+    {
+    success &= Check("Executions", algorithms[i]->NumberOfExecutions,
+                     i == numAlgorithms - 1 ? 2 : 1);
+    }
+
+  // With a limit of two and a half outputs, two of the four outputs are
+  // released while the pipeline executes, but never the final output.
+  budget->SetMemoryLimit(5 * outputSize / 2);
+  algorithms[0]->Modified();
+  sink->Update();
+  success &= Check("Released outputs", budget->GetNumberOfReleasedOutputs(), 2);
+  if (budget->GetTotalMemorySize() > budget->GetMemoryLimit())
+    {
+    cerr << "Total memory size " << budget->GetTotalMemorySize()
+         << " exceeds the limit " << budget->GetMemoryLimit() << endl;
+    success = 0;
+    }
+  success &= Check("Final output released",
+                   sink->GetOutput()->GetDataReleased(), 0);
+  success &= Check("Number of points", static_cast<int>(
+                     sink->GetOutput()->GetNumberOfPoints()), 100000);
+
+  // With a tiny limit all intermediate outputs are released, and they are
+  // recomputed when the end of the pipeline needs to execute again.
+  budget->SetMemoryLimit(1);
+  budget->ReleaseOutputs();
+  for (i = 0; i < numAlgorithms - 1; ++i)
+    {
+    success &= Check("Intermediate output released",
+                     algorithms[i]->GetOutput()->GetDataReleased(), 1);
+    }
+  sink->Update();
+  success &= Check("Executions without changes", sink->NumberOfExecutions, 3);
+  sink->SetOffset(3.0);
+  sink->Update();
+  for (i = 0; i < numAlgorithms; ++i)
+    {
+    success &= Check("Executions", algorithms[i]->NumberOfExecutions,
+                     i == numAlgorithms - 1 ? 4 : 3);
+    }
+  double x[3];
+  sink->GetOutput()->GetPoint(10, x);
+  if (x[0] != 10.0 || x[1] != 5.0)
+    {
+    cerr << "Unexpected point (" << x[0] << ", " << x[1] << ")" << endl;
+    success = 0;
+    }
+
+  return success ? TEST_SUCCESS : TEST_FAILURE;
+}
@@ -0,0 +1,265 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that vtkProfilingPipeline executives created from the
+// default executive prototype record the passes and executions of a
+// pipeline in a shared vtkPipelineProfiler, nested as the upstream call
+// tree, that the events are written as Chrome trace-event JSON, and that
+// deleted algorithms are forgotten.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkProfilingPipeline.h"
+#include "vtkSmartPointer.h"
+
+#include <sstream>
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Produces a line of points when NumberOfInputPorts is 0, otherwise
+// translates a deep copy of its input.
+class ProfiledAlgorithm : public vtkPolyDataAlgorithm
+{
+public:
+  static ProfiledAlgorithm *New();
+  vtkTypeMacro(ProfiledAlgorithm,vtkPolyDataAlgorithm);
+
+  void SetSource()
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+protected:
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkPoints* points = vtkPoints::New();
+    if (this->GetNumberOfInputPorts() == 0)
+      {
+      points->SetNumberOfPoints(10000);
+      for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+        {
+        points->SetPoint(i, i, 0.0, 0.0);
+        }
+      }
+    else
+      {
+      vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+      points->DeepCopy(input->GetPoints());
+      for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+        {
+        double x[3];
+        points->GetPoint(i, x);
+        x[1] += 1.0;
+        points->SetPoint(i, x);
+        }
+      }
+    output->SetPoints(points);
+    points->Delete();
+    return 1;
+  }
+};
+vtkStandardNewMacro(ProfiledAlgorithm);
+
+namespace
+{
+// Index of the event of an algorithm with the given name, or -1.
+int FindEvent(vtkPipelineProfiler* profiler, vtkAlgorithm* algorithm,
+              const char* name)
+{
+  for (int i = 0; i < profiler->GetNumberOfEvents(); ++i)
+    {
+    if (profiler->GetEventAlgorithm(i) == algorithm &&
+        std::string(profiler->GetEventName(i)) == name)
+      {
+      return i;
+      }
+    }
+  return -1;
+}
+
+bool IsAncestor(vtkPipelineProfiler* profiler, int ancestor, int event)
+{
+  for (int i = profiler->GetEventParent(event); i >= 0;
+       i = profiler->GetEventParent(i))
+    {
+    if (i == ancestor)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+}
+
+int TestPipelineProfiler(int, char*[])
+{
+  vtkNew<vtkPipelineProfiler> profiler;
+  vtkProfilingPipeline::SetDefaultProfiler(profiler.GetPointer());
+  vtkSmartPointer<vtkProfilingPipeline> prototype =
+    vtkSmartPointer<vtkProfilingPipeline>::New();
+  vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+
+  vtkNew<ProfiledAlgorithm> source;
+  source->SetSource();
+  vtkNew<ProfiledAlgorithm> filter;
+  filter->SetInputConnection(source->GetOutputPort());
+
+  vtkAlgorithm::SetDefaultExecutivePrototype(0);
+  vtkProfilingPipeline::SetDefaultProfiler(0);
+
+  int success = 1;
+  if (!vtkProfilingPipeline::SafeDownCast(filter->GetExecutive()) ||
+      vtkProfilingPipeline::SafeDownCast(filter->GetExecutive())
+        ->GetProfiler() != profiler.GetPointer())
+    {
+    cerr << "The filter executive does not report to the profiler" << endl;
+    return TEST_FAILURE;
+    }
+
+  filter->Update();
+
+  if (profiler->GetNumberOfExecutions(source.GetPointer()) != 1 ||
+      profiler->GetNumberOfExecutions(filter.GetPointer()) != 1)
+    {
+    cerr << "Expected one execution of each algorithm, got "
+         << profiler->GetNumberOfExecutions(source.GetPointer()) << " and "
+         << profiler->GetNumberOfExecutions(filter.GetPointer()) << endl;
+    success = 0;
+    }
+
+  // The upstream call tree.
+  int filterData = FindEvent(profiler.GetPointer(), filter.GetPointer(),
+                             "REQUEST_DATA");
+  int sourceData = FindEvent(profiler.GetPointer(), source.GetPointer(),
+                             "REQUEST_DATA");
+  int filterExecute = FindEvent(profiler.GetPointer(), filter.GetPointer(),
+                                "Execute");
+  int sourceInformation = FindEvent(profiler.GetPointer(),
+                                    source.GetPointer(),
+                                    "REQUEST_INFORMATION");
+  if (filterData < 0 || sourceData < 0 || filterExecute < 0 ||
+      sourceInformation < 0)
+    {
+    cerr << "Missing events" << endl;
+    return TEST_FAILURE;
+    }
+  if (!IsAncestor(profiler.GetPointer(), filterData, sourceData) ||
+      profiler->GetEventParent(filterExecute) != filterData ||
+      IsAncestor(profiler.GetPointer(), filterData, sourceInformation))
+    {
+    cerr << "Events are not nested as the upstream call tree" << endl;
+    success = 0;
+    }
+  if (profiler->GetEventWallTime(filterData) <
+      profiler->GetEventWallTime(sourceData))
+    {
+    cerr << "A request is shorter than the requests it forwarded" << endl;
+    success = 0;
+    }
+
+  // 10000 points of 3 floats hold at least 117 KiB.
+  if (profiler->GetEventOutputMemory(filterExecute) < 117 ||
+      profiler->GetExecutionOutputMemory(filter.GetPointer()) < 117 ||
+      profiler->GetEventNumberOfThreads(filterExecute) < 1 ||
+      profiler->GetEventOutputMemory(filterData) != -1)
+    {
+    cerr << "Unexpected execution statistics: "
+         << profiler->GetEventOutputMemory(filterExecute) << " KiB, "
+         << profiler->GetEventNumberOfThreads(filterExecute) << " threads"
+         << endl;
+    success = 0;
+    }
+
+  // Nothing executes again when the pipeline is up to date.
+  filter->Update();
+  if (profiler->GetNumberOfExecutions(source.GetPointer()) != 1 ||
+      profiler->GetNumberOfExecutions(filter.GetPointer()) != 1)
+    {
+    cerr << "Up to date algorithms executed again" << endl;
+    success = 0;
+    }
+
+  std::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  std::string json = trace.str();
+  if (json.find("{\"traceEvents\":[") != 0 ||
+      json.find("\"name\":\"ProfiledAlgorithm 1\",\"cat\":\"Execute\","
+                "\"ph\":\"X\"") == std::string::npos ||
+      json.find("\"output_kib\":") == std::string::npos)
+    {
+    cerr << "Unexpected trace:" << endl << json << endl;
+    success = 0;
+    }
+
+  std::ostringstream summary;
+  profiler->PrintSummary(summary);
+  if (summary.str().find("ProfiledAlgorithm 0: 1 executions") ==
+      std::string::npos)
+    {
+    cerr << "Unexpected summary:" << endl << summary.str() << endl;
+    success = 0;
+    }
+
+  profiler->Initialize();
+  if (profiler->GetNumberOfEvents() != 0 ||
+      profiler->GetNumberOfExecutions(filter.GetPointer()) != 0)
+    {
+    cerr << "Initialize did not discard the events" << endl;
+    success = 0;
+    }
+
+  // Algorithms deleted between updates keep their statistics apart from
+  // those of the algorithms created after them.
+  for (int i = 0; i < 2; ++i)
+    {
+    vtkProfilingPipeline* executive = vtkProfilingPipeline::New();
+    executive->SetProfiler(profiler.GetPointer());
+    ProfiledAlgorithm* temporary = ProfiledAlgorithm::New();
+    temporary->SetSource();
+    temporary->SetExecutive(executive);
+    executive->Delete();
+    temporary->Update();
+    vtkAlgorithm* deleted = temporary;
+    temporary->Delete();
+    if (profiler->GetNumberOfExecutions(deleted) != 0 ||
+        profiler->GetEventAlgorithm(profiler->GetNumberOfEvents() - 1))
+      {
+      cerr << "A deleted algorithm is still known" << endl;
+      success = 0;
+      }
+    }
+  std::ostringstream deletedSummary;
+  profiler->PrintSummary(deletedSummary);
+  if (deletedSummary.str().find("ProfiledAlgorithm 0: 1 executions") ==
+        std::string::npos ||
+      deletedSummary.str().find("ProfiledAlgorithm 1: 1 executions") ==
+        std::string::npos)
+    {
+    cerr << "Unexpected summary:" << endl << deletedSummary.str() << endl;
+    success = 0;
+    }
+
+  return success ? TEST_SUCCESS : TEST_FAILURE;
+}
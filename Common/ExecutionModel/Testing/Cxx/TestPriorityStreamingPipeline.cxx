@@ -0,0 +1,336 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPriorityStreamingPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that vtkPriorityStreamingPipeline hands pieces to a
+// streaming algorithm in priority order and skips the pieces that
+// vtkCutter and vtkContourFilter find cannot contribute.
+
+#include "vtkCellArray.h"
+#include "vtkContourFilter.h"
+#include "vtkCutter.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFloatArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkPriorityStreamingPipeline.h"
+#include "vtkStreamerBase.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Produces piece i of n as a quad spanning [i, i + 1] along x, with a
+// point scalar equal to x, and describes its pieces when asked.
+class PrioritySlabSource : public vtkPolyDataAlgorithm
+{
+public:
+  static PrioritySlabSource *New();
+  vtkTypeMacro(PrioritySlabSource,vtkPolyDataAlgorithm);
+
+  virtual int ProcessRequest(vtkInformation* request,
+                             vtkInformationVector** inputVector,
+                             vtkInformationVector* outputVector)
+  {
+    if (request->Has(vtkPriorityStreamingPipeline::REQUEST_PIECE_PRIORITY()))
+      {
+      vtkInformation* outInfo = outputVector->GetInformationObject(0);
+      int piece = outInfo->Get(
+        vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+      int numPieces = outInfo->Get(
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+      double bounds[6] = { piece, piece + 1.0, 0.0, 1.0, 0.0, 0.0 };
+      outInfo->Set(vtkPriorityStreamingPipeline::PIECE_BOUNDS(), bounds, 6);
+      double range[2] = { piece, piece + 1.0 };
+      vtkPriorityStreamingPipeline::AddPieceArrayRange(
+        outInfo, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Scalars", 1,
+        range, vtkDataSetAttributes::SCALARS);
+      if (this->IncreasingPriorities)
+        {
+        outInfo->Set(vtkPriorityStreamingPipeline::PRIORITY(),
+                     (piece + 1.0) / numPieces);
+        }
+      return 1;
+      }
+    return this->Superclass::ProcessRequest(request, inputVector,
+                                            outputVector);
+  }
+
+  int IncreasingPriorities;
+  std::vector<int> ExecutedPieces;
+
+protected:
+  PrioritySlabSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->IncreasingPriorities = 0;
+  }
+
+  virtual int RequestInformation(vtkInformation*,
+                                 vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+  {
+    outputVector->GetInformationObject(0)->Set(
+      vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    int piece = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    this->ExecutedPieces.push_back(piece);
+
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkFloatArray> scalars;
+    scalars->SetName("Scalars");
+    for (int i = 0; i < 4; ++i)
+      {
+      double x = piece + (i == 1 || i == 2 ? 1.0 : 0.0);
+      points->InsertNextPoint(x, i < 2 ? 0.0 : 1.0, 0.0);
+      scalars->InsertNextValue(x);
+      }
+    vtkNew<vtkCellArray> polys;
+    vtkIdType quad[4] = { 0, 1, 2, 3 };
+    polys->InsertNextCell(4, quad);
+    output->SetPoints(points.GetPointer());
+    output->SetPolys(polys.GetPointer());
+    output->GetPointData()->SetScalars(scalars.GetPointer());
+    return 1;
+  }
+
+private:
+  PrioritySlabSource(const PrioritySlabSource&);
+  void operator=(const PrioritySlabSource&);
+};
+vtkStandardNewMacro(PrioritySlabSource);
+
+// Requests its input in 8 pieces and records the number of cells of
+// each.
+class PriorityPieceCollector : public vtkStreamerBase
+{
+public:
+  static PriorityPieceCollector *New();
+  vtkTypeMacro(PriorityPieceCollector,vtkStreamerBase);
+
+  std::vector<int> RequestedPieces;
+  std::vector<vtkIdType> NumberOfCells;
+
+protected:
+  PriorityPieceCollector()
+  {
+    this->SetNumberOfInputPorts(1);
+    this->SetNumberOfOutputPorts(1);
+    this->NumberOfPasses = 8;
+  }
+
+  virtual int FillInputPortInformation(int, vtkInformation* info)
+  {
+    info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+    return 1;
+  }
+
+  virtual int FillOutputPortInformation(int, vtkInformation* info)
+  {
+    info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkPolyData");
+    return 1;
+  }
+
+  virtual int RequestUpdateExtent(vtkInformation*,
+                                  vtkInformationVector** inputVector,
+                                  vtkInformationVector*)
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+                static_cast<int>(this->CurrentIndex));
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+                static_cast<int>(this->NumberOfPasses));
+    return 1;
+  }
+
+  virtual int ExecutePass(vtkInformationVector** inputVector,
+                          vtkInformationVector*)
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    this->RequestedPieces.push_back(
+      inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()));
+    this->NumberOfCells.push_back(
+      vtkPolyData::GetData(inInfo)->GetNumberOfCells());
+    return 1;
+  }
+
+private:
+  PriorityPieceCollector(const PriorityPieceCollector&);
+  void operator=(const PriorityPieceCollector&);
+};
+vtkStandardNewMacro(PriorityPieceCollector);
+
+// Checks that only the given piece produced cells, and that it came
+// first.
+static int CheckSinglePiece(const char* what, PrioritySlabSource* source,
+                            PriorityPieceCollector* collector,
+                            vtkPriorityStreamingPipeline* executive,
+                            int piece)
+{
+  int success = 1;
+  if (source->ExecutedPieces.size() != 1 ||
+      source->ExecutedPieces[0] != piece)
+    {
+    cerr << what << ": the source executed " << source->ExecutedPieces.size()
+         << " pieces instead of piece " << piece << endl;
+    success = 0;
+    }
+  if (collector->RequestedPieces.size() != 8 ||
+      collector->RequestedPieces[0] != piece)
+    {
+    cerr << what << ": expected 8 passes starting with piece " << piece
+         << endl;
+    success = 0;
+    }
+  for (size_t i = 0; i < collector->NumberOfCells.size(); ++i)
+    {
+    if ((collector->NumberOfCells[i] > 0) != (i == 0))
+      {
+      cerr << what << ": pass " << i << " has "
+           << collector->NumberOfCells[i] << " cells" << endl;
+      success = 0;
+      }
+    }
+  if (executive->GetNumberOfCulledPieces() != 7)
+    {
+    cerr << what << ": expected 7 culled pieces, got "
+         << executive->GetNumberOfCulledPieces() << endl;
+    success = 0;
+    }
+  return success;
+}
+
+int TestPriorityStreamingPipeline(int, char*[])
+{
+  int success = 1;
+
+  // Pieces are processed from the highest to the lowest priority.
+  {
+  vtkNew<PrioritySlabSource> source;
+  source->IncreasingPriorities = 1;
+  vtkNew<PriorityPieceCollector> collector;
+  vtkNew<vtkPriorityStreamingPipeline> executive;
+  collector->SetExecutive(executive.GetPointer());
+  collector->SetInputConnection(source->GetOutputPort());
+  collector->Update();
+  if (collector->RequestedPieces.size() != 8 ||
+      executive->GetNumberOfCulledPieces() != 0)
+    {
+    cerr << "Expected 8 pieces, none culled" << endl;
+    success = 0;
+    }
+  for (size_t i = 0; i < collector->RequestedPieces.size(); ++i)
+    {
+    if (collector->RequestedPieces[i] != 7 - static_cast<int>(i) ||
+        source->ExecutedPieces[i] != collector->RequestedPieces[i])
+      {
+      cerr << "Pass " << i << " got piece " << collector->RequestedPieces[i]
+           << endl;
+      success = 0;
+      }
+    }
+  }
+
+  // Only the piece crossed by the cut plane is executed.
+  {
+  vtkNew<PrioritySlabSource> source;
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(2.5, 0.0, 0.0);
+  plane->SetNormal(1.0, 0.0, 0.0);
+  vtkNew<vtkCutter> cutter;
+  cutter->SetCutFunction(plane.GetPointer());
+  cutter->SetInputConnection(source->GetOutputPort());
+  vtkNew<PriorityPieceCollector> collector;
+  vtkNew<vtkPriorityStreamingPipeline> executive;
+  collector->SetExecutive(executive.GetPointer());
+  collector->SetInputConnection(cutter->GetOutputPort());
+  collector->Update();
+  success &= CheckSinglePiece("Cutter", source.GetPointer(),
+                              collector.GetPointer(), executive.GetPointer(),
+                              2);
+  }
+
+  // Only the piece whose scalar range contains the contour value is
+  // executed.
+  {
+  vtkNew<PrioritySlabSource> source;
+  vtkNew<vtkContourFilter> contour;
+  contour->SetValue(0, 5.5);
+  contour->SetInputConnection(source->GetOutputPort());
+  vtkNew<PriorityPieceCollector> collector;
+  vtkNew<vtkPriorityStreamingPipeline> executive;
+  collector->SetExecutive(executive.GetPointer());
+  collector->SetInputConnection(contour->GetOutputPort());
+  collector->Update();
+  success &= CheckSinglePiece("Contour", source.GetPointer(),
+                              collector.GetPointer(), executive.GetPointer(),
+                              5);
+
+  // Computing a priority leaves the update requests unchanged.
+  vtkInformation* outInfo = source->GetOutputInformation(0);
+  int piece =
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  if (executive->ComputePriority(0, 0, 3, 8, 0) != 0.0 ||
+      executive->ComputePriority(0, 0, 5, 8, 0) != 1.0 ||
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()) !=
+      piece)
+    {
+    cerr << "ComputePriority failed" << endl;
+    success = 0;
+    }
+  }
+
+  // Bounds of image pieces are derived from their extent.
+  {
+  vtkNew<vtkInformation> info;
+  int wholeExtent[6] = { 0, 10, 0, 10, 0, 10 };
+  double origin[3] = { 1.0, 2.0, 3.0 };
+  double spacing[3] = { 0.5, 0.5, 0.5 };
+  info->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExtent, 6);
+  info->Set(vtkDataObject::ORIGIN(), origin, 3);
+  info->Set(vtkDataObject::SPACING(), spacing, 3);
+  info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), 1);
+  info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), 2);
+  info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(),
+            0);
+  double bounds[6];
+  if (!vtkPriorityStreamingPipeline::GetPieceBounds(info.GetPointer(),
+                                                    bounds) ||
+      bounds[0] != 1.0 || bounds[1] != 6.0 || bounds[2] != 2.0 ||
+      bounds[3] != 7.0 || bounds[4] != 5.5 || bounds[5] != 8.0)
+    {
+    cerr << "Wrong image piece bounds" << endl;
+    success = 0;
+    }
+  }
+
+  return success ? TEST_SUCCESS : TEST_FAILURE;
+}
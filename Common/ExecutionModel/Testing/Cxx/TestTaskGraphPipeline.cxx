@@ -0,0 +1,201 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTaskGraphPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// This test verifies that vtkTaskGraphPipeline updates the independent
+// inputs of an append filter as groups, that inputs sharing an upstream
+// algorithm are grouped together, and that only modified branches
+// re-execute.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkTaskGraphPipeline.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Produces a fixed number of vertices.
+class TaskGraphSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TaskGraphSource *New();
+  vtkTypeMacro(TaskGraphSource,vtkPolyDataAlgorithm);
+
+  vtkSetMacro(NumberOfPoints,int);
+
+  int NumberOfPoints;
+  int NumberOfExecutions;
+
+protected:
+  TaskGraphSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfPoints = 1;
+    this->NumberOfExecutions = 0;
+    vtkTaskGraphPipeline::SetReentrant(this, 1);
+  }
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkPoints* points = vtkPoints::New();
+    vtkCellArray* verts = vtkCellArray::New();
+    for (vtkIdType i = 0; i < this->NumberOfPoints; ++i)
+      {
+      points->InsertNextPoint(i, 0.0, 0.0);
+      verts->InsertNextCell(1, &i);
+      }
+    output->SetPoints(points);
+    output->SetVerts(verts);
+    points->Delete();
+    verts->Delete();
+    this->NumberOfExecutions++;
+    return 1;
+  }
+
+private:
+  TaskGraphSource(const TaskGraphSource&);
+  void operator=(const TaskGraphSource&);
+};
+vtkStandardNewMacro(TaskGraphSource);
+
+// Passes its input through.
+class TaskGraphFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static TaskGraphFilter *New();
+  vtkTypeMacro(TaskGraphFilter,vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  TaskGraphFilter()
+  {
+    this->NumberOfExecutions = 0;
+    vtkTaskGraphPipeline::SetReentrant(this, 1);
+  }
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+  {
+    vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    output->ShallowCopy(input);
+    this->NumberOfExecutions++;
+    return 1;
+  }
+
+private:
+  TaskGraphFilter(const TaskGraphFilter&);
+  void operator=(const TaskGraphFilter&);
+};
+vtkStandardNewMacro(TaskGraphFilter);
+
+static int Check(const char* what, int value, int expected)
+{
+  if (value != expected)
+    {
+    cerr << what << ": expected " << expected << ", got " << value << endl;
+    return 0;
+    }
+  return 1;
+}
+
+int TestTaskGraphPipeline(int, char*[])
+{
+  int success = 1;
+
+  // Four independent branches fanned into an append filter.
+  const int numBranches = 4;
+  vtkNew<TaskGraphSource> sources[numBranches];
+  vtkNew<TaskGraphFilter> filters[numBranches];
+  vtkNew<vtkAppendPolyData> append;
+  vtkNew<vtkTaskGraphPipeline> executive;
+  append->SetExecutive(executive.GetPointer());
+  int i;
+  for (i = 0; i < numBranches; ++i)
+    {
+    sources[i]->SetNumberOfPoints(10 * (i + 1));
+    filters[i]->SetInputConnection(sources[i]->GetOutputPort());
+    append->AddInputConnection(filters[i]->GetOutputPort());
+    }
+  append->Update();
+
+  success &= Check("Number of points", static_cast<int>(
+                     append->GetOutput()->GetNumberOfPoints()), 100);
+  success &= Check("Number of concurrent groups",
+                   executive->GetNumberOfConcurrentGroups(), numBranches);
+  for (i = 0; i < numBranches; ++i)
+    {
+    success &= Check("Source executions", sources[i]->NumberOfExecutions, 1);
+    success &= Check("Filter executions", filters[i]->NumberOfExecutions, 1);
+    }
+
+  // Only the modified branch re-executes.
+  sources[2]->SetNumberOfPoints(5);
+  append->Update();
+  success &= Check("Number of points", static_cast<int>(
+                     append->GetOutput()->GetNumberOfPoints()), 75);
+  for (i = 0; i < numBranches; ++i)
+    {
+    success &= Check("Source executions", sources[i]->NumberOfExecutions,
+                     i == 2 ? 2 : 1);
+    }
+
+  // A non-reentrant branch is updated sequentially.
+  vtkTaskGraphPipeline::SetReentrant(filters[0].GetPointer(), 0);
+  sources[0]->SetNumberOfPoints(20);
+  sources[1]->SetNumberOfPoints(30);
+  append->Update();
+  success &= Check("Number of points", static_cast<int>(
+                     append->GetOutput()->GetNumberOfPoints()), 95);
+  success &= Check("Number of concurrent groups",
+                   executive->GetNumberOfConcurrentGroups(), numBranches - 1);
+
+  // Two branches sharing a source form a single group: a diamond plus one
+  // independent branch gives two groups.
+  vtkNew<TaskGraphSource> shared;
+  shared->SetNumberOfPoints(7);
+  vtkNew<TaskGraphFilter> left;
+  vtkNew<TaskGraphFilter> right;
+  left->SetInputConnection(shared->GetOutputPort());
+  right->SetInputConnection(shared->GetOutputPort());
+  vtkNew<TaskGraphSource> other;
+  other->SetNumberOfPoints(3);
+  vtkNew<vtkAppendPolyData> diamond;
+  vtkNew<vtkTaskGraphPipeline> diamondExecutive;
+  diamond->SetExecutive(diamondExecutive.GetPointer());
+  diamond->AddInputConnection(left->GetOutputPort());
+  diamond->AddInputConnection(other->GetOutputPort());
+  diamond->AddInputConnection(right->GetOutputPort());
+  diamond->Update();
+
+  success &= Check("Number of points", static_cast<int>(
+                     diamond->GetOutput()->GetNumberOfPoints()), 17);
+  success &= Check("Number of concurrent groups",
+                   diamondExecutive->GetNumberOfConcurrentGroups(), 2);
+  success &= Check("Shared source executions", shared->NumberOfExecutions, 1);
+
+  return success ? TEST_SUCCESS : TEST_FAILURE;
+}
@@ -27,6 +27,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkInformationIntegerVectorKey.h"
 #include "vtkInformationKey.h"
 #include "vtkInformationObjectBaseKey.h"
+#include "vtkInformationObjectBaseVectorKey.h"
 #include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
@@ -38,6 +39,8 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkTrivialProducer.h"
 #include "vtkUniformGrid.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkCompositeDataPipeline);
 
 vtkInformationKeyMacro(vtkCompositeDataPipeline, LOAD_REQUESTED_BLOCKS, Integer);
@@ -45,6 +48,9 @@ vtkInformationKeyMacro(vtkCompositeDataPipeline, COMPOSITE_DATA_META_DATA, Objec
 vtkInformationKeyMacro(vtkCompositeDataPipeline, UPDATE_COMPOSITE_INDICES, IntegerVector);
 vtkInformationKeyMacro(vtkCompositeDataPipeline, COMPOSITE_INDICES, IntegerVector);
 vtkInformationKeyMacro(vtkCompositeDataPipeline, SUPPRESS_RESET_PI, Integer);
+vtkInformationKeyMacro(vtkCompositeDataPipeline, BLOCK_BATCH_SIZE, Integer);
+vtkInformationKeyRestrictedMacro(vtkCompositeDataPipeline, BLOCK_BATCH,
+                                 ObjectBaseVector, "vtkDataObject");
 
 //----------------------------------------------------------------------------
 vtkCompositeDataPipeline::vtkCompositeDataPipeline()
@@ -287,27 +293,92 @@ void vtkCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* iter,
   vtkInformation* inInfo  =inInfoVec[compositePort]->GetInformationObject(connection);
   vtkInformation* outInfo = outInfoVec->GetInformationObject(0); //assumed to be 0
 
-  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  int batchSize = 1;
+  vtkInformation* inPortInfo =
+    this->Algorithm->GetInputPortInformation(compositePort);
+  if (inPortInfo->Has(BLOCK_BATCH_SIZE()))
+    {
+    batchSize = inPortInfo->Get(BLOCK_BATCH_SIZE());
+    }
+
+  if (batchSize <= 1)
     {
-    vtkDataObject* dobj = iter->GetCurrentDataObject();
-    if (dobj)
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
       {
-      // Note that since VisitOnlyLeaves is ON on the iterator,
-      // this method is called only for leaves, hence, we are assured that
-      // neither dobj nor outObj are vtkCompositeDataSet subclasses.
-      vtkDataObject* outObj =
-        this->ExecuteSimpleAlgorithmForBlock(inInfoVec,
-                                             outInfoVec,
-                                             inInfo,
-                                             outInfo,
-                                             request,
-                                             dobj);
-      if (outObj)
+      vtkDataObject* dobj = iter->GetCurrentDataObject();
+      if (dobj)
         {
-        compositeOutput->SetDataSet(iter, outObj);
-        outObj->FastDelete();
+        // Note that since VisitOnlyLeaves is ON on the iterator,
+        // this method is called only for leaves, hence, we are assured that
+        // neither dobj nor outObj are vtkCompositeDataSet subclasses.
+        vtkDataObject* outObj =
+          this->ExecuteSimpleAlgorithmForBlock(inInfoVec,
+                                               outInfoVec,
+                                               inInfo,
+                                               outInfo,
+                                               request,
+                                               dobj);
+        if (outObj)
+          {
+          compositeOutput->SetDataSet(iter, outObj);
+          outObj->FastDelete();
+          }
         }
       }
+    return;
+    }
+
+  // Gather the leaves, then execute runs of consecutive blocks of the same
+  // type together.
+  std::vector<vtkDataObject*> blocks;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+    blocks.push_back(iter->GetCurrentDataObject());
+    }
+  size_t numberOfBlocks = blocks.size();
+  std::vector<vtkDataObject*> outputs(numberOfBlocks, 0);
+
+  size_t first = 0;
+  while (first < numberOfBlocks)
+    {
+    if (!blocks[first])
+      {
+      ++first;
+      continue;
+      }
+    size_t last = first + 1;
+    while (last < numberOfBlocks &&
+           last - first < static_cast<size_t>(batchSize) && blocks[last] &&
+           blocks[last]->GetDataObjectType() ==
+             blocks[first]->GetDataObjectType())
+      {
+      ++last;
+      }
+    if (last - first == 1)
+      {
+      outputs[first] =
+        this->ExecuteSimpleAlgorithmForBlock(inInfoVec, outInfoVec, inInfo,
+                                             outInfo, request, blocks[first]);
+      }
+    else
+      {
+      this->ExecuteSimpleAlgorithmForBatch(inInfoVec, outInfoVec, inInfo,
+                                           outInfo, request, &blocks[first],
+                                           static_cast<int>(last - first),
+                                           &outputs[first]);
+      }
+    first = last;
+    }
+
+  size_t i = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal() &&
+         i < numberOfBlocks; iter->GoToNextItem(), ++i)
+    {
+    if (outputs[i])
+      {
+      compositeOutput->SetDataSet(iter, outputs[i]);
+      outputs[i]->FastDelete();
+      }
     }
 }
 
@@ -362,9 +433,9 @@ void vtkCompositeDataPipeline::ExecuteSimpleAlgorithm(
     compositeOutput->PrepareForNewData();
     compositeOutput->CopyStructure(input);
 
-    vtkSmartPointer<vtkInformation> r =
-      vtkSmartPointer<vtkInformation>::New();
-
+    // The request is reused for every block.
+    vtkInformation* r = this->GenericRequest;
+    r->Clear();
     r->Set(FROM_OUTPUT_PORT(), PRODUCER()->GetPort(outInfo));
 
     // The request is forwarded upstream through the pipeline.
@@ -447,6 +518,77 @@ vtkDataObject* vtkCompositeDataPipeline::ExecuteSimpleAlgorithmForBlock(
     vtkTrivialProducer::FillOutputDataInformation(dobj, inInfo);
     }
 
+  this->ExecuteSimpleAlgorithmPasses(inInfoVec, outInfoVec, outInfo, request);
+
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output)
+    {
+    return 0;
+    }
+  vtkDataObject* outputCopy = output->NewInstance();
+  outputCopy->ShallowCopy(output);
+  return outputCopy;
+}
+
+//----------------------------------------------------------------------------
+int vtkCompositeDataPipeline::ExecuteSimpleAlgorithmForBatch(
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec,
+  vtkInformation* inInfo,
+  vtkInformation* outInfo,
+  vtkInformation* request,
+  vtkDataObject** blocks,
+  int numberOfBlocks,
+  vtkDataObject** outputs)
+{
+  vtkDebugMacro(<< "ExecuteSimpleAlgorithmForBatch " << numberOfBlocks);
+
+  // The meta-data passes see the first block, the algorithm gets them all.
+  inInfo->Remove(vtkDataObject::DATA_OBJECT());
+  inInfo->Set(vtkDataObject::DATA_OBJECT(), blocks[0]);
+  vtkTrivialProducer::FillOutputDataInformation(blocks[0], inInfo);
+  BLOCK_BATCH()->Clear(inInfo);
+  for (int i=0; i < numberOfBlocks; ++i)
+    {
+    BLOCK_BATCH()->Append(inInfo, blocks[i]);
+    }
+  BLOCK_BATCH()->Clear(outInfo);
+
+  this->ExecuteSimpleAlgorithmPasses(inInfoVec, outInfoVec, outInfo, request);
+
+  int numberOfOutputs = BLOCK_BATCH()->Size(outInfo);
+  if (numberOfOutputs != numberOfBlocks)
+    {
+    vtkErrorMacro(<< this->Algorithm->GetClassName() << " produced "
+                  << numberOfOutputs << " outputs for a batch of "
+                  << numberOfBlocks << " blocks.");
+    }
+  int count = 0;
+  for (int i=0; i < numberOfBlocks; ++i)
+    {
+    outputs[i] = 0;
+    vtkDataObject* output = i < numberOfOutputs ?
+      static_cast<vtkDataObject*>(BLOCK_BATCH()->Get(outInfo, i)) : 0;
+    if (output)
+      {
+      output->Register(0);
+      outputs[i] = output;
+      ++count;
+      }
+    }
+
+  inInfo->Remove(BLOCK_BATCH());
+  outInfo->Remove(BLOCK_BATCH());
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkCompositeDataPipeline::ExecuteSimpleAlgorithmPasses(
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec,
+  vtkInformation* outInfo,
+  vtkInformation* request)
+{
   request->Set(REQUEST_DATA_OBJECT());
   outInfo->Set(SUPPRESS_RESET_PI(), 1);
   this->Superclass::ExecuteDataObject(request, inInfoVec, outInfoVec);
@@ -514,18 +656,8 @@ vtkDataObject* vtkCompositeDataPipeline::ExecuteSimpleAlgorithmForBlock(
         storedPiece);
       }
     }
-
-  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
-  if (!output)
-    {
-    return 0;
-    }
-  vtkDataObject* outputCopy = output->NewInstance();
-  outputCopy->ShallowCopy(output);
-  return outputCopy;
 }
 
-
 //----------------------------------------------------------------------------
 int vtkCompositeDataPipeline::NeedToExecuteData(
   int outputPort,
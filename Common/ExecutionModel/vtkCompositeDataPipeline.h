@@ -35,6 +35,15 @@
 // it will invoke the  vtkStreamingDemandDrivenPipeline passes in a loop,
 // passing a different block each time and will collect the results in a
 // composite dataset.
+//
+// Simple filters that can process several blocks at once may set
+// BLOCK_BATCH_SIZE() in the information of their input port. The
+// executive then runs the passes above once for each batch of consecutive
+// blocks of the same type instead of once per block: the input information
+// holds the first block as DATA_OBJECT() and all the blocks of the batch
+// in BLOCK_BATCH(), and the algorithm appends one output per block to the
+// BLOCK_BATCH() of its output information. The meta-data passes see only
+// the first block of each batch.
 // .SECTION See also
 //  vtkCompositeDataSet
 
@@ -52,6 +61,7 @@ class vtkInformationObjectBaseKey;
 class vtkInformationStringKey;
 class vtkInformationDataObjectKey;
 class vtkInformationIntegerKey;
+class vtkInformationObjectBaseVectorKey;
 
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkCompositeDataPipeline :
   public vtkStreamingDemandDrivenPipeline
@@ -105,6 +115,18 @@ public:
   // *** THIS IS AN EXPERIMENTAL FEATURE. IT MAY CHANGE WITHOUT NOTICE ***
   static vtkInformationIntegerVectorKey* COMPOSITE_INDICES();
 
+  // Description:
+  // BLOCK_BATCH_SIZE() is set in the input port information of simple
+  // algorithms that can process several blocks of a composite input in one
+  // REQUEST_DATA. It is the largest number of blocks per batch.
+  static vtkInformationIntegerKey* BLOCK_BATCH_SIZE();
+
+  // Description:
+  // BLOCK_BATCH() holds the blocks of the current batch in the input
+  // information, and the outputs computed from them, in the same order, in
+  // the output information. Blocks of a batch have the same type.
+  static vtkInformationObjectBaseVectorKey* BLOCK_BATCH();
+
 
 protected:
   vtkCompositeDataPipeline();
@@ -171,6 +193,26 @@ protected:
     vtkInformation* request,
     vtkDataObject* dobj);
 
+  // Execute the algorithm once for blocks[0] to blocks[numberOfBlocks-1],
+  // which have the same type, and store the outputs in outputs. Returns
+  // the number of outputs produced.
+  int ExecuteSimpleAlgorithmForBatch(
+    vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec,
+    vtkInformation* inInfo,
+    vtkInformation* outInfo,
+    vtkInformation* request,
+    vtkDataObject** blocks,
+    int numberOfBlocks,
+    vtkDataObject** outputs);
+
+  // Run the passes of a simple algorithm for the data object set in the
+  // input information.
+  void ExecuteSimpleAlgorithmPasses(vtkInformationVector** inInfoVec,
+                                    vtkInformationVector* outInfoVec,
+                                    vtkInformation* outInfo,
+                                    vtkInformation* request);
+
   bool ShouldIterateOverInput(vtkInformationVector** inInfoVec,
                               int& compositePort);
 
@@ -0,0 +1,140 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryBudgetPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryBudgetPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineMemoryBudget.h"
+#include "vtkTimerLog.h"
+
+vtkStandardNewMacro(vtkMemoryBudgetPipeline);
+
+//----------------------------------------------------------------------------
+vtkMemoryBudgetPipeline::vtkMemoryBudgetPipeline()
+{
+  this->MemoryBudget = 0;
+  this->ExecutionTime = -1.0;
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryBudgetPipeline::~vtkMemoryBudgetPipeline()
+{
+  this->SetMemoryBudget(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryBudgetPipeline::SetMemoryBudget(vtkPipelineMemoryBudget* budget)
+{
+  if (this->MemoryBudget == budget)
+    {
+    return;
+    }
+  if (this->MemoryBudget)
+    {
+    this->MemoryBudget->RemoveExecutive(this);
+    this->MemoryBudget->UnRegister(this);
+    }
+  this->MemoryBudget = budget;
+  if (this->MemoryBudget)
+    {
+    this->MemoryBudget->Register(this);
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryBudgetPipeline::ProcessRequest(vtkInformation* request,
+                                            vtkInformationVector** inInfoVec,
+                                            vtkInformationVector* outInfoVec)
+{
+  if (!this->MemoryBudget || !this->Algorithm ||
+      !request->Has(REQUEST_DATA()))
+    {
+    return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+    }
+
+  int outputPort = -1;
+  if (request->Has(FROM_OUTPUT_PORT()))
+    {
+    outputPort = request->Get(FROM_OUTPUT_PORT());
+    }
+
+  // The inputs of this executive are in use until the update completes.
+  this->ExecutionTime = -1.0;
+  this->MemoryBudget->BeginUpdate(this);
+  int result =
+    this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+  this->MemoryBudget->EndUpdate(this);
+
+  if (result)
+    {
+    for (int i=0; i < this->Algorithm->GetNumberOfOutputPorts(); ++i)
+      {
+      if (this->ExecutionTime >= 0.0)
+        {
+        this->MemoryBudget->OutputGenerated(this, i, this->ExecutionTime);
+        }
+      else if (outputPort < 0 || outputPort == i)
+        {
+        this->MemoryBudget->OutputNeeded(this, i);
+        }
+      }
+    this->MemoryBudget->ReleaseOutputs();
+    }
+
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryBudgetPipeline::NeedToExecuteData(int outputPort,
+                                               vtkInformationVector** inInfoVec,
+                                               vtkInformationVector* outInfoVec)
+{
+  // Outputs released by the budget must be recomputed.
+  if (outputPort >= 0)
+    {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(outputPort);
+    vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (data && data->GetDataReleased())
+      {
+      return 1;
+      }
+    }
+  return this->Superclass::NeedToExecuteData(outputPort, inInfoVec,
+                                             outInfoVec);
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryBudgetPipeline::ExecuteData(vtkInformation* request,
+                                         vtkInformationVector** inInfoVec,
+                                         vtkInformationVector* outInfoVec)
+{
+  double start = vtkTimerLog::GetUniversalTime();
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  double elapsed = vtkTimerLog::GetUniversalTime() - start;
+  this->ExecutionTime = (this->ExecutionTime > 0.0 ? this->ExecutionTime : 0.0)
+    + elapsed;
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryBudgetPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MemoryBudget: " << this->MemoryBudget << endl;
+}
@@ -0,0 +1,83 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryBudgetPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMemoryBudgetPipeline - Executive that keeps outputs within a memory budget
+// .SECTION Description
+// vtkMemoryBudgetPipeline is a vtkCompositeDataPipeline that reports its
+// outputs to a vtkPipelineMemoryBudget. After each REQUEST_DATA the
+// executive records whether its outputs were recomputed, and how long
+// that took, or reused, and then lets the budget release intermediate
+// outputs of the pipeline to stay under its memory limit. Released
+// outputs are recomputed when they are needed again.
+//
+// All the executives of a pipeline should share the same budget: create
+// one vtkMemoryBudgetPipeline per algorithm, give them the same
+// vtkPipelineMemoryBudget and assign them with vtkAlgorithm::SetExecutive()
+// before connecting the pipeline. Algorithms driven by other executives
+// are left alone. Without a budget this executive behaves as its
+// superclass.
+//
+// .SECTION See Also
+// vtkPipelineMemoryBudget vtkCompositeDataPipeline
+
+#ifndef __vtkMemoryBudgetPipeline_h
+#define __vtkMemoryBudgetPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkPipelineMemoryBudget;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkMemoryBudgetPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkMemoryBudgetPipeline* New();
+  vtkTypeMacro(vtkMemoryBudgetPipeline,vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // The budget this executive reports its outputs to.
+  virtual void SetMemoryBudget(vtkPipelineMemoryBudget*);
+  vtkGetObjectMacro(MemoryBudget,vtkPipelineMemoryBudget);
+
+  // Description:
+  // Generalized interface for asking the executive to fulfill update
+  // requests.
+  virtual int ProcessRequest(vtkInformation* request,
+                             vtkInformationVector** inInfo,
+                             vtkInformationVector* outInfo);
+
+protected:
+  vtkMemoryBudgetPipeline();
+  ~vtkMemoryBudgetPipeline();
+
+  virtual int NeedToExecuteData(int outputPort,
+                                vtkInformationVector** inInfoVec,
+                                vtkInformationVector* outInfoVec);
+  virtual int ExecuteData(vtkInformation* request,
+                          vtkInformationVector** inInfoVec,
+                          vtkInformationVector* outInfoVec);
+
+  vtkPipelineMemoryBudget* MemoryBudget;
+
+  // Time spent executing the algorithm during the current update, or a
+  // negative value if it did not execute.
+  double ExecutionTime;
+
+private:
+  vtkMemoryBudgetPipeline(const vtkMemoryBudgetPipeline&);  // Not implemented.
+  void operator=(const vtkMemoryBudgetPipeline&);  // Not implemented.
+};
+
+#endif
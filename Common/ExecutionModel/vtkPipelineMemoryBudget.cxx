@@ -0,0 +1,283 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineMemoryBudget.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineMemoryBudget.h"
+
+#include "vtkDataObject.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortVectorKey.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+
+#include <map>
+#include <utility>
+
+vtkStandardNewMacro(vtkPipelineMemoryBudget);
+
+//----------------------------------------------------------------------------
+struct vtkPipelineMemoryBudgetEntry
+{
+  vtkDataObject* Data;
+  unsigned long Size;
+  double Cost;
+  double Priority;
+};
+
+class vtkPipelineMemoryBudgetInternals
+{
+public:
+  typedef std::pair<vtkExecutive*, int> KeyType;
+  typedef std::map<KeyType, vtkPipelineMemoryBudgetEntry> EntriesType;
+
+  // The outputs kept in memory.
+  EntriesType Entries;
+
+  // The executives being updated, with their nesting depth.
+  std::map<vtkExecutive*, int> Updating;
+
+  // GreedyDual-Size inflation value: the priority of the last released
+  // output.
+  double Inflation;
+
+  vtkSimpleCriticalSection Lock;
+
+  vtkPipelineMemoryBudgetInternals() : Inflation(0.0) {}
+
+  static vtkDataObject* GetOutput(vtkExecutive* executive, int port)
+  {
+    vtkInformation* info = executive->GetOutputInformation(port);
+    return info ? info->Get(vtkDataObject::DATA_OBJECT()) : 0;
+  }
+
+  double GetPriority(const vtkPipelineMemoryBudgetEntry& entry) const
+  {
+    return this->Inflation +
+      entry.Cost / static_cast<double>(entry.Size > 0 ? entry.Size : 1);
+  }
+
+  // An output can be released when it has consumers and none of them
+  // is being updated.
+  bool CanRelease(const KeyType& key) const
+  {
+    if (this->Updating.find(key.first) != this->Updating.end())
+      {
+      return false;
+      }
+    vtkInformation* info = key.first->GetOutputInformation(key.second);
+    int numConsumers = info ? vtkExecutive::CONSUMERS()->Length(info) : 0;
+    if (numConsumers == 0)
+      {
+      return false;
+      }
+    vtkExecutive** consumers = vtkExecutive::CONSUMERS()->GetExecutives(info);
+    for (int i = 0; i < numConsumers; ++i)
+      {
+      if (this->Updating.find(consumers[i]) != this->Updating.end())
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+};
+
+//----------------------------------------------------------------------------
+vtkPipelineMemoryBudget::vtkPipelineMemoryBudget()
+{
+  this->MemoryLimit = 0;
+  this->NumberOfReleasedOutputs = 0;
+  this->Internals = new vtkPipelineMemoryBudgetInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineMemoryBudget::~vtkPipelineMemoryBudget()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPipelineMemoryBudget::GetTotalMemorySize()
+{
+  this->Internals->Lock.Lock();
+  unsigned long total = 0;
+  vtkPipelineMemoryBudgetInternals::EntriesType::iterator it;
+  for (it = this->Internals->Entries.begin();
+       it != this->Internals->Entries.end(); ++it)
+    {
+    total += it->second.Size;
+    }
+  this->Internals->Lock.Unlock();
+  return total;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::OutputGenerated(vtkExecutive* executive,
+                                              int port, double cost)
+{
+  vtkDataObject* data =
+    vtkPipelineMemoryBudgetInternals::GetOutput(executive, port);
+  vtkPipelineMemoryBudgetInternals::KeyType key(executive, port);
+
+  this->Internals->Lock.Lock();
+  if (!data)
+    {
+    this->Internals->Entries.erase(key);
+    }
+  else
+    {
+    vtkPipelineMemoryBudgetEntry& entry = this->Internals->Entries[key];
+    entry.Data = data;
+    entry.Size = data->GetActualMemorySize();
+    entry.Cost = cost;
+    entry.Priority = this->Internals->GetPriority(entry);
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::OutputNeeded(vtkExecutive* executive, int port)
+{
+  vtkPipelineMemoryBudgetInternals::KeyType key(executive, port);
+
+  this->Internals->Lock.Lock();
+  vtkPipelineMemoryBudgetInternals::EntriesType::iterator it =
+    this->Internals->Entries.find(key);
+  if (it != this->Internals->Entries.end())
+    {
+    it->second.Priority = this->Internals->GetPriority(it->second);
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::BeginUpdate(vtkExecutive* executive)
+{
+  this->Internals->Lock.Lock();
+  ++this->Internals->Updating[executive];
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::EndUpdate(vtkExecutive* executive)
+{
+  this->Internals->Lock.Lock();
+  std::map<vtkExecutive*, int>::iterator it =
+    this->Internals->Updating.find(executive);
+  if (it != this->Internals->Updating.end() && --it->second == 0)
+    {
+    this->Internals->Updating.erase(it);
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::RemoveExecutive(vtkExecutive* executive)
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineMemoryBudgetInternals::EntriesType::iterator it =
+    this->Internals->Entries.begin();
+  while (it != this->Internals->Entries.end())
+    {
+    if (it->first.first == executive)
+      {
+      this->Internals->Entries.erase(it++);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+  this->Internals->Updating.erase(executive);
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::ReleaseOutputs()
+{
+  if (this->MemoryLimit > 0)
+    {
+    this->ReleaseOutputsAbove(this->MemoryLimit);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::ReleaseAllOutputs()
+{
+  this->ReleaseOutputsAbove(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::ReleaseOutputsAbove(unsigned long limit)
+{
+  typedef vtkPipelineMemoryBudgetInternals::EntriesType EntriesType;
+  this->Internals->Lock.Lock();
+
+  // Forget outputs that were replaced or released by someone else.
+  unsigned long total = 0;
+  EntriesType::iterator it = this->Internals->Entries.begin();
+  while (it != this->Internals->Entries.end())
+    {
+    vtkDataObject* data = vtkPipelineMemoryBudgetInternals::GetOutput(
+      it->first.first, it->first.second);
+    if (data != it->second.Data || data->GetDataReleased())
+      {
+      this->Internals->Entries.erase(it++);
+      }
+    else
+      {
+      total += it->second.Size;
+      ++it;
+      }
+    }
+
+  // Release the outputs with the lowest priority first.
+  while (total > limit)
+    {
+    EntriesType::iterator victim = this->Internals->Entries.end();
+    for (it = this->Internals->Entries.begin();
+         it != this->Internals->Entries.end(); ++it)
+      {
+      if ((victim == this->Internals->Entries.end() ||
+           it->second.Priority < victim->second.Priority) &&
+          this->Internals->CanRelease(it->first))
+        {
+        victim = it;
+        }
+      }
+    if (victim == this->Internals->Entries.end())
+      {
+      break;
+      }
+    vtkDebugMacro(<< "Releasing output " << victim->first.second << " of "
+                  << victim->first.first->GetAlgorithm()->GetClassName()
+                  << " (" << victim->second.Size << " KiB)");
+    this->Internals->Inflation = victim->second.Priority;
+    victim->second.Data->ReleaseData();
+    total -= victim->second.Size;
+    this->Internals->Entries.erase(victim);
+    ++this->NumberOfReleasedOutputs;
+    }
+
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
+  os << indent << "NumberOfReleasedOutputs: "
+     << this->NumberOfReleasedOutputs << endl;
+}
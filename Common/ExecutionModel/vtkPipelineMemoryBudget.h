@@ -0,0 +1,111 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineMemoryBudget.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPipelineMemoryBudget - Memory limit shared by pipeline executives
+// .SECTION Description
+// vtkPipelineMemoryBudget keeps track of the intermediate outputs of the
+// vtkMemoryBudgetPipeline executives that share it and releases some of
+// them whenever their total size exceeds MemoryLimit. An intermediate
+// output is an output that has at least one consumer; outputs that are
+// not connected to anything are never released. Released outputs are
+// recomputed by their executive the next time they are needed, as with
+// vtkDemandDrivenPipeline::SetReleaseDataFlag().
+//
+// The outputs to release are chosen with the GreedyDual-Size policy: each
+// output gets a priority equal to the time it took to compute divided by
+// its size, offset by an inflation value that grows every time an output
+// is released. Outputs that are cheap to recompute for the memory they
+// hold and that have not been needed recently are released first.
+// Outputs that are being used by an executing algorithm are never
+// released.
+//
+// .SECTION Caveats
+// Sizes are measured with vtkDataObject::GetActualMemorySize() once the
+// output is generated. Arrays shared between outputs through shallow
+// copies are counted once per output, so the total may overestimate the
+// memory actually in use.
+//
+// .SECTION See Also
+// vtkMemoryBudgetPipeline vtkDemandDrivenPipeline
+
+#ifndef __vtkPipelineMemoryBudget_h
+#define __vtkPipelineMemoryBudget_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkExecutive;
+class vtkPipelineMemoryBudgetInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineMemoryBudget : public vtkObject
+{
+public:
+  static vtkPipelineMemoryBudget* New();
+  vtkTypeMacro(vtkPipelineMemoryBudget,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Maximum total size, in kibibytes, of the intermediate outputs kept in
+  // memory. A value of 0 means that there is no limit. The default is 0.
+  vtkSetMacro(MemoryLimit,unsigned long);
+  vtkGetMacro(MemoryLimit,unsigned long);
+
+  // Description:
+  // Total size, in kibibytes, of the intermediate outputs currently kept
+  // in memory.
+  unsigned long GetTotalMemorySize();
+
+  // Description:
+  // Number of outputs released since the budget was created.
+  vtkGetMacro(NumberOfReleasedOutputs,int);
+
+  // Description:
+  // Release intermediate outputs until their total size is within
+  // MemoryLimit. This is called by the executives after each update.
+  void ReleaseOutputs();
+
+  // Description:
+  // Release all the intermediate outputs that are not in use.
+  void ReleaseAllOutputs();
+
+  // Description:
+  // Methods used by vtkMemoryBudgetPipeline to report the state of its
+  // outputs. OutputGenerated() is called when an output was computed, in
+  // cost seconds. OutputNeeded() is called when an output is used again
+  // without being recomputed. BeginUpdate() and EndUpdate() bracket the
+  // update of an executive, during which its inputs are in use.
+  // RemoveExecutive() forgets all outputs of an executive.
+  void OutputGenerated(vtkExecutive* executive, int port, double cost);
+  void OutputNeeded(vtkExecutive* executive, int port);
+  void BeginUpdate(vtkExecutive* executive);
+  void EndUpdate(vtkExecutive* executive);
+  void RemoveExecutive(vtkExecutive* executive);
+
+protected:
+  vtkPipelineMemoryBudget();
+  ~vtkPipelineMemoryBudget();
+
+  void ReleaseOutputsAbove(unsigned long limit);
+
+  unsigned long MemoryLimit;
+  int NumberOfReleasedOutputs;
+
+private:
+  vtkPipelineMemoryBudgetInternals* Internals;
+
+  vtkPipelineMemoryBudget(const vtkPipelineMemoryBudget&);  // Not implemented.
+  void operator=(const vtkPipelineMemoryBudget&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,498 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCallbackCommand.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+//----------------------------------------------------------------------------
+struct vtkPipelineProfilerEvent
+{
+  vtkAlgorithm* Algorithm; // null once the algorithm is deleted
+  int Statistics;          // index of the statistics of the algorithm
+  std::string Name;
+  int Parent;
+  int Thread;
+  double Start;
+  double CPUStart;
+  double WallTime;
+  double CPUTime;
+  long OutputMemory;
+  int NumberOfThreads;
+};
+
+struct vtkPipelineProfilerStatistics
+{
+  std::string Label;
+  int Executions;
+  double WallTime;
+  double CPUTime;
+  long OutputMemory;
+};
+
+class vtkPipelineProfilerInternals
+{
+public:
+  vtkPipelineProfilerInternals()
+  {
+    this->DeleteCommand = vtkCallbackCommand::New();
+    this->DeleteCommand->SetCallback(
+      &vtkPipelineProfilerInternals::AlgorithmDeleted);
+    this->DeleteCommand->SetClientData(this);
+  }
+
+  ~vtkPipelineProfilerInternals()
+  {
+    this->Clear();
+    this->DeleteCommand->Delete();
+  }
+
+  std::vector<vtkPipelineProfilerEvent> Events;
+
+  // The threads that recorded events, each with the stack of its open
+  // events. The index of a thread is its id in the trace.
+  std::vector<vtkMultiThreaderIDType> ThreadIds;
+  std::vector<std::vector<int> > OpenEvents;
+
+  // The statistics of every algorithm seen, and the index of those of
+  // the algorithms still alive with the tag of their DeleteEvent
+  // observer. A deleted algorithm is forgotten, so that another one
+  // allocated at the same address gets its own statistics.
+  std::vector<vtkPipelineProfilerStatistics> Statistics;
+  std::map<vtkAlgorithm*, std::pair<int, unsigned long> > Algorithms;
+  std::map<std::string, int> ClassCounts;
+  vtkCallbackCommand* DeleteCommand;
+
+  // Universal time of the origin of the events.
+  double Origin;
+
+  vtkSimpleCriticalSection Lock;
+
+  int GetThread()
+  {
+    vtkMultiThreaderIDType id = vtkMultiThreader::GetCurrentThreadID();
+    for (size_t i=0; i < this->ThreadIds.size(); ++i)
+      {
+      if (this->ThreadIds[i] == id)
+        {
+        return static_cast<int>(i);
+        }
+      }
+    this->ThreadIds.push_back(id);
+    this->OpenEvents.resize(this->ThreadIds.size());
+    return static_cast<int>(this->ThreadIds.size()) - 1;
+  }
+
+  // Algorithms are labeled with their class name and their rank among
+  // the algorithms of that class seen by the profiler.
+  int GetStatistics(vtkAlgorithm* algorithm)
+  {
+    std::map<vtkAlgorithm*, std::pair<int, unsigned long> >::iterator it =
+      this->Algorithms.find(algorithm);
+    if (it != this->Algorithms.end())
+      {
+      return it->second.first;
+      }
+    std::string className = algorithm->GetClassName();
+    std::ostringstream label;
+    label << className << " " << this->ClassCounts[className]++;
+    vtkPipelineProfilerStatistics stats;
+    stats.Label = label.str();
+    stats.Executions = 0;
+    stats.WallTime = 0.0;
+    stats.CPUTime = 0.0;
+    stats.OutputMemory = -1;
+    int index = static_cast<int>(this->Statistics.size());
+    this->Statistics.push_back(stats);
+    unsigned long tag =
+      algorithm->AddObserver(vtkCommand::DeleteEvent, this->DeleteCommand);
+    this->Algorithms[algorithm] = std::make_pair(index, tag);
+    return index;
+  }
+
+  static void AlgorithmDeleted(vtkObject* caller, unsigned long,
+                               void* clientData, void*)
+  {
+    vtkPipelineProfilerInternals* self =
+      static_cast<vtkPipelineProfilerInternals*>(clientData);
+    vtkAlgorithm* algorithm = static_cast<vtkAlgorithm*>(caller);
+    self->Lock.Lock();
+    for (size_t i=0; i < self->Events.size(); ++i)
+      {
+      if (self->Events[i].Algorithm == algorithm)
+        {
+        self->Events[i].Algorithm = 0;
+        }
+      }
+    self->Algorithms.erase(algorithm);
+    self->Lock.Unlock();
+  }
+
+  // Forget everything recorded and stop observing the algorithms.
+  void Clear()
+  {
+    std::map<vtkAlgorithm*, std::pair<int, unsigned long> >::iterator it;
+    for (it = this->Algorithms.begin(); it != this->Algorithms.end(); ++it)
+      {
+      it->first->RemoveObserver(it->second.second);
+      }
+    this->Events.clear();
+    this->ThreadIds.clear();
+    this->OpenEvents.clear();
+    this->Statistics.clear();
+    this->Algorithms.clear();
+    this->ClassCounts.clear();
+  }
+
+  const vtkPipelineProfilerEvent* GetEvent(int i) const
+  {
+    if (i < 0 || i >= static_cast<int>(this->Events.size()))
+      {
+      return 0;
+      }
+    return &this->Events[i];
+  }
+
+  const vtkPipelineProfilerStatistics* Find(vtkAlgorithm* algorithm) const
+  {
+    std::map<vtkAlgorithm*, std::pair<int, unsigned long> >::const_iterator
+      it = this->Algorithms.find(algorithm);
+    return it != this->Algorithms.end() ?
+      &this->Statistics[it->second.first] : 0;
+  }
+};
+
+namespace
+{
+struct SlowerFirst
+{
+  bool operator()(const vtkPipelineProfilerStatistics* a,
+                  const vtkPipelineProfilerStatistics* b) const
+  {
+    return a->WallTime > b->WallTime;
+  }
+};
+
+void WriteJSONString(ostream& os, const std::string& str)
+{
+  os << '"';
+  for (size_t i=0; i < str.size(); ++i)
+    {
+    char c = str[i];
+    if (c == '"' || c == '\\')
+      {
+      os << '\\' << c;
+      }
+    else if (static_cast<unsigned char>(c) < 0x20)
+      {
+      os << ' ';
+      }
+    else
+      {
+      os << c;
+      }
+    }
+  os << '"';
+}
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+{
+  this->Internals = new vtkPipelineProfilerInternals;
+  this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::Initialize()
+{
+  this->Internals->Lock.Lock();
+  this->Internals->Clear();
+  this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+  this->Internals->Lock.Unlock();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::StartEvent(vtkAlgorithm* algorithm,
+                                     const char* name)
+{
+  if (!algorithm)
+    {
+    return;
+    }
+
+  vtkPipelineProfilerInternals* internals = this->Internals;
+  internals->Lock.Lock();
+  int thread = internals->GetThread();
+  std::vector<int>& open = internals->OpenEvents[thread];
+
+  vtkPipelineProfilerEvent event;
+  event.Algorithm = algorithm;
+  event.Statistics = internals->GetStatistics(algorithm);
+  event.Name = name ? name : "";
+  event.Parent = open.empty() ? -1 : open.back();
+  event.Thread = thread;
+  event.WallTime = 0.0;
+  event.CPUTime = 0.0;
+  event.OutputMemory = -1;
+  event.NumberOfThreads = 0;
+  open.push_back(static_cast<int>(internals->Events.size()));
+  internals->Events.push_back(event);
+
+  // Read the clocks last so that the bookkeeping is not measured.
+  vtkPipelineProfilerEvent& added = internals->Events.back();
+  added.Start = vtkTimerLog::GetUniversalTime();
+  added.CPUStart = vtkTimerLog::GetCPUTime();
+  internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::EndEvent(long outputMemory, int numberOfThreads)
+{
+  double end = vtkTimerLog::GetUniversalTime();
+  double cpuEnd = vtkTimerLog::GetCPUTime();
+
+  vtkPipelineProfilerInternals* internals = this->Internals;
+  internals->Lock.Lock();
+  std::vector<int>& open = internals->OpenEvents[internals->GetThread()];
+  if (open.empty())
+    {
+    internals->Lock.Unlock();
+    vtkErrorMacro("EndEvent called without a matching StartEvent.");
+    return;
+    }
+  vtkPipelineProfilerEvent& event = internals->Events[open.back()];
+  open.pop_back();
+  event.WallTime = end - event.Start;
+  event.CPUTime = cpuEnd - event.CPUStart;
+  event.OutputMemory = outputMemory;
+  event.NumberOfThreads = numberOfThreads;
+
+  if (numberOfThreads > 0)
+    {
+    vtkPipelineProfilerStatistics& stats =
+      internals->Statistics[event.Statistics];
+    stats.Executions++;
+    stats.WallTime += event.WallTime;
+    stats.CPUTime += event.CPUTime;
+    stats.OutputMemory = outputMemory;
+    }
+  internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetNumberOfEvents()
+{
+  return static_cast<int>(this->Internals->Events.size());
+}
+
+//----------------------------------------------------------------------------
+vtkAlgorithm* vtkPipelineProfiler::GetEventAlgorithm(int i)
+{
+  const vtkPipelineProfilerEvent* event = this->Internals->GetEvent(i);
+  return event ? event->Algorithm : 0;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPipelineProfiler::GetEventName(int i)
+{
+  const vtkPipelineProfilerEvent* event = this->Internals->GetEvent(i);
+  return event ? event->Name.c_str() : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetEventParent(int i)
+{
+  const vtkPipelineProfilerEvent* event = this->Internals->GetEvent(i);
+  return event ? event->Parent : -1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetEventThread(int i)
+{
+  const vtkPipelineProfilerEvent* event = this->Internals->GetEvent(i);
+  return event ? event->Thread : -1;
+}
+
+//----------------------------------------------------------------------------
+double vtkPipelineProfiler::GetEventStartTime(int i)
+{
+  const vtkPipelineProfilerEvent* event = this->Internals->GetEvent(i);
+  return event ? event->Start - this->Internals->Origin : 0.0;
+}
+
+//----------------------------------------------------------------------------
+double vtkPipelineProfiler::GetEventWallTime(int i)
+{
+  const vtkPipelineProfilerEvent* event = this->Internals->GetEvent(i);
+  return event ? event->WallTime : 0.0;
+}
+
+//----------------------------------------------------------------------------
+double vtkPipelineProfiler::GetEventCPUTime(int i)
+{
+  const vtkPipelineProfilerEvent* event = this->Internals->GetEvent(i);
+  return event ? event->CPUTime : 0.0;
+}
+
+//----------------------------------------------------------------------------
+long vtkPipelineProfiler::GetEventOutputMemory(int i)
+{
+  const vtkPipelineProfilerEvent* event = this->Internals->GetEvent(i);
+  return event ? event->OutputMemory : -1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetEventNumberOfThreads(int i)
+{
+  const vtkPipelineProfilerEvent* event = this->Internals->GetEvent(i);
+  return event ? event->NumberOfThreads : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetNumberOfExecutions(vtkAlgorithm* algorithm)
+{
+  const vtkPipelineProfilerStatistics* stats =
+    this->Internals->Find(algorithm);
+  return stats ? stats->Executions : 0;
+}
+
+//----------------------------------------------------------------------------
+double vtkPipelineProfiler::GetExecutionWallTime(vtkAlgorithm* algorithm)
+{
+  const vtkPipelineProfilerStatistics* stats =
+    this->Internals->Find(algorithm);
+  return stats ? stats->WallTime : 0.0;
+}
+
+//----------------------------------------------------------------------------
+double vtkPipelineProfiler::GetExecutionCPUTime(vtkAlgorithm* algorithm)
+{
+  const vtkPipelineProfilerStatistics* stats =
+    this->Internals->Find(algorithm);
+  return stats ? stats->CPUTime : 0.0;
+}
+
+//----------------------------------------------------------------------------
+long vtkPipelineProfiler::GetExecutionOutputMemory(vtkAlgorithm* algorithm)
+{
+  const vtkPipelineProfilerStatistics* stats =
+    this->Internals->Find(algorithm);
+  return stats ? stats->OutputMemory : -1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::WriteChromeTrace(const char* filename)
+{
+  if (!filename)
+    {
+    vtkErrorMacro("No file name given.");
+    return 0;
+    }
+  ofstream os(filename);
+  if (!os)
+    {
+    vtkErrorMacro("Cannot open " << filename << " for writing.");
+    return 0;
+    }
+  this->WriteChromeTrace(os);
+  return os.good() ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::WriteChromeTrace(ostream& os)
+{
+  vtkPipelineProfilerInternals* internals = this->Internals;
+  internals->Lock.Lock();
+
+  // Complete ("X") events, with times in microseconds. Events nest by
+  // time on each thread, which is how the viewers show the call tree.
+  os << "{\"traceEvents\":[";
+  for (size_t i=0; i < internals->Events.size(); ++i)
+    {
+    const vtkPipelineProfilerEvent& event = internals->Events[i];
+    os << (i > 0 ? ",\n" : "\n") << "{\"name\":";
+    WriteJSONString(os, internals->Statistics[event.Statistics].Label);
+    os << ",\"cat\":";
+    WriteJSONString(os, event.Name);
+    os << ",\"ph\":\"X\",\"ts\":"
+       << (event.Start - internals->Origin) * 1.0e6
+       << ",\"dur\":" << event.WallTime * 1.0e6
+       << ",\"pid\":0,\"tid\":" << event.Thread
+       << ",\"args\":{\"cpu_ms\":" << event.CPUTime * 1.0e3;
+    if (event.NumberOfThreads > 0)
+      {
+      os << ",\"output_kib\":" << event.OutputMemory
+         << ",\"threads\":" << event.NumberOfThreads;
+      }
+    os << "}}";
+    }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSummary(ostream& os)
+{
+  vtkPipelineProfilerInternals* internals = this->Internals;
+  internals->Lock.Lock();
+
+  std::vector<const vtkPipelineProfilerStatistics*> sorted;
+  for (size_t i=0; i < internals->Statistics.size(); ++i)
+    {
+    if (internals->Statistics[i].Executions > 0)
+      {
+      sorted.push_back(&internals->Statistics[i]);
+      }
+    }
+  std::sort(sorted.begin(), sorted.end(), SlowerFirst());
+
+  for (size_t i=0; i < sorted.size(); ++i)
+    {
+    const vtkPipelineProfilerStatistics* stats = sorted[i];
+    os << stats->Label << ": " << stats->Executions << " executions, "
+       << stats->WallTime << " s wall, " << stats->CPUTime << " s CPU, "
+       << stats->OutputMemory << " KiB output\n";
+    }
+
+  internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << endl;
+}
@@ -0,0 +1,124 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPipelineProfiler - Records the execution of a pipeline
+// .SECTION Description
+// vtkPipelineProfiler collects timing events from the vtkProfilingPipeline
+// executives that share it. Every pipeline pass an executive handles
+// (REQUEST_DATA_OBJECT, REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT,
+// REQUEST_DATA, ...) is recorded as an event, and every execution of an
+// algorithm as a nested "Execute" event. Events started while another
+// event is open on the same thread are its children, so the events form
+// the upstream call tree of each update: the REQUEST_DATA of a filter
+// contains the REQUEST_DATA of its inputs, then its own execution.
+//
+// Each event records its wall clock and CPU time. Execution events also
+// record the memory held by the outputs of the algorithm and the number
+// of threads it used. The events can be written as Chrome trace-event
+// JSON, which chrome://tracing and Perfetto display as a timeline, and
+// are summarized per algorithm by PrintSummary().
+//
+// .SECTION Caveats
+// CPU time is measured with vtkTimerLog::GetCPUTime(), which accounts for
+// the whole process: it includes the work of other threads running at the
+// same time. The number of threads is the NumberOfThreads of
+// vtkThreadedImageAlgorithm subclasses; for other algorithms it is
+// estimated as the ratio of CPU time to wall clock time, which is only
+// meaningful for executions long enough to be measured.
+//
+// .SECTION See Also
+// vtkProfilingPipeline vtkExecutionTimer vtkTimerLog
+
+#ifndef __vtkPipelineProfiler_h
+#define __vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkPipelineProfilerInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler* New();
+  vtkTypeMacro(vtkPipelineProfiler,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Discard the recorded events and statistics. Event times are relative
+  // to the last call to Initialize(), or to the creation of the profiler.
+  void Initialize();
+
+  // Description:
+  // Start an event for an algorithm. This is called by the executives
+  // when they start a pass or an execution.
+  void StartEvent(vtkAlgorithm* algorithm, const char* name);
+
+  // Description:
+  // End the last event started on the calling thread. outputMemory is
+  // the size, in kibibytes, of the outputs generated by an execution and
+  // numberOfThreads the number of threads it used; both are only given
+  // for executions.
+  void EndEvent(long outputMemory = -1, int numberOfThreads = 0);
+
+  // Description:
+  // Access the recorded events, in the order they were started.
+  // GetEventParent() returns the index of the enclosing event, or -1 for
+  // the root of an update. Times are in seconds; output memory is -1 for
+  // pass events. GetEventAlgorithm() returns NULL once the algorithm has
+  // been deleted.
+  int GetNumberOfEvents();
+  vtkAlgorithm* GetEventAlgorithm(int i);
+  const char* GetEventName(int i);
+  int GetEventParent(int i);
+  int GetEventThread(int i);
+  double GetEventStartTime(int i);
+  double GetEventWallTime(int i);
+  double GetEventCPUTime(int i);
+  long GetEventOutputMemory(int i);
+  int GetEventNumberOfThreads(int i);
+
+  // Description:
+  // Statistics accumulated over the executions of an algorithm: number of
+  // executions, total wall clock and CPU time in seconds, and the output
+  // memory, in kibibytes, of the last execution. The statistics of
+  // deleted algorithms are only reported by PrintSummary().
+  int GetNumberOfExecutions(vtkAlgorithm* algorithm);
+  double GetExecutionWallTime(vtkAlgorithm* algorithm);
+  double GetExecutionCPUTime(vtkAlgorithm* algorithm);
+  long GetExecutionOutputMemory(vtkAlgorithm* algorithm);
+
+  // Description:
+  // Write the events as Chrome trace-event JSON. The file version returns
+  // 0 if the file cannot be written.
+  int WriteChromeTrace(const char* filename);
+  void WriteChromeTrace(ostream& os);
+
+  // Description:
+  // Print the statistics of every algorithm, the slowest first.
+  void PrintSummary(ostream& os);
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler();
+
+private:
+  vtkPipelineProfilerInternals* Internals;
+
+  vtkPipelineProfiler(const vtkPipelineProfiler&);  // Not implemented.
+  void operator=(const vtkPipelineProfiler&);  // Not implemented.
+};
+
+#endif
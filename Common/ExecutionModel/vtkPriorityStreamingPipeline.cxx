@@ -0,0 +1,541 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPriorityStreamingPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPriorityStreamingPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkExtentTranslator.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationInformationVectorKey.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkPriorityStreamingPipeline);
+
+vtkInformationKeyMacro(vtkPriorityStreamingPipeline, REQUEST_PIECE_PRIORITY, Request);
+vtkInformationKeyMacro(vtkPriorityStreamingPipeline, PRIORITY, Double);
+vtkInformationKeyRestrictedMacro(vtkPriorityStreamingPipeline, PIECE_BOUNDS, DoubleVector, 6);
+vtkInformationKeyMacro(vtkPriorityStreamingPipeline, PIECE_ARRAY_RANGES, InformationVector);
+
+//----------------------------------------------------------------------------
+// Order of the pieces within the piece produced by the algorithm.
+class vtkPriorityStreamingPipelineInternals
+{
+public:
+  vtkPriorityStreamingPipelineInternals()
+  {
+    this->FirstPiece = -1;
+    this->NumberOfPieces = 0;
+    this->GhostLevels = 0;
+  }
+
+  int FirstPiece;
+  int NumberOfPieces;
+  int GhostLevels;
+  std::vector<int> Order;
+  std::vector<double> Priorities;
+};
+
+namespace
+{
+// Sorts piece indices by decreasing priority.
+struct vtkPriorityStreamingPipelineCompare
+{
+  const std::vector<double>* Priorities;
+  bool operator()(int a, int b) const
+  {
+    return (*this->Priorities)[a] > (*this->Priorities)[b];
+  }
+};
+
+// Sends REQUEST_PIECE_PRIORITY through the pipeline upstream of an output,
+// remembering the update requests it overwrites.
+class vtkPriorityStreamingPipelineTraversal
+{
+public:
+  vtkPriorityStreamingPipelineTraversal(int piece, int numberOfPieces,
+                                        int ghostLevels)
+  {
+    this->Piece = piece;
+    this->NumberOfPieces = numberOfPieces;
+    this->GhostLevels = ghostLevels;
+    this->Request = vtkSmartPointer<vtkInformation>::New();
+    this->Request->Set(
+      vtkPriorityStreamingPipeline::REQUEST_PIECE_PRIORITY());
+  }
+
+  ~vtkPriorityStreamingPipelineTraversal()
+  {
+    // Restore the update requests.
+    for (size_t i = 0; i < this->Saved.size(); ++i)
+      {
+      vtkInformation* info = this->Saved[i].first;
+      vtkInformation* saved = this->Saved[i].second;
+      info->CopyEntry(saved,
+        vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+      info->CopyEntry(saved,
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+      info->CopyEntry(saved,
+        vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+      }
+  }
+
+  double ComputePriority(vtkExecutive* executive, int port)
+  {
+    std::pair<vtkExecutive*, int> key(executive, port);
+    std::map<std::pair<vtkExecutive*, int>, double>::iterator found =
+      this->Priorities.find(key);
+    if (found != this->Priorities.end())
+      {
+      return found->second;
+      }
+
+    // Request the piece on this output.
+    vtkInformation* outInfo = executive->GetOutputInformation(port);
+    vtkSmartPointer<vtkInformation> saved =
+      vtkSmartPointer<vtkInformation>::New();
+    saved->CopyEntry(outInfo,
+      vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    saved->CopyEntry(outInfo,
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    saved->CopyEntry(outInfo,
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    this->Saved.push_back(std::make_pair(outInfo, saved));
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+                 this->Piece);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+                 this->NumberOfPieces);
+    outInfo->Set(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(),
+      this->GhostLevels);
+
+    // Sources are done first.
+    vtkAlgorithm* algorithm = executive->GetAlgorithm();
+    double priority = -1.0;
+    for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+      {
+      for (int j = 0; j < executive->GetNumberOfInputConnections(i); ++j)
+        {
+        vtkInformation* inInfo = executive->GetInputInformation(i, j);
+        vtkExecutive* producer;
+        int producerPort;
+        vtkExecutive::PRODUCER()->Get(inInfo, producer, producerPort);
+        if (producer)
+          {
+          priority = std::max(priority,
+                              this->ComputePriority(producer, producerPort));
+          }
+        }
+      }
+    if (priority < 0.0)
+      {
+      priority = 1.0;
+      }
+
+    vtkInformationVector* outInfoVec = executive->GetOutputInformation();
+    for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+      {
+      vtkInformation* info = outInfoVec->GetInformationObject(i);
+      info->Set(vtkPriorityStreamingPipeline::PRIORITY(), priority);
+      info->Remove(vtkPriorityStreamingPipeline::PIECE_BOUNDS());
+      info->Remove(vtkPriorityStreamingPipeline::PIECE_ARRAY_RANGES());
+      }
+
+    if (algorithm)
+      {
+      this->Request->Set(vtkExecutive::FROM_OUTPUT_PORT(), port);
+      algorithm->ProcessRequest(this->Request,
+                                executive->GetInputInformation(),
+                                outInfoVec);
+      priority = outInfo->Get(vtkPriorityStreamingPipeline::PRIORITY());
+      }
+
+    this->Priorities[key] = priority;
+    return priority;
+  }
+
+private:
+  int Piece;
+  int NumberOfPieces;
+  int GhostLevels;
+  vtkSmartPointer<vtkInformation> Request;
+  std::map<std::pair<vtkExecutive*, int>, double> Priorities;
+  std::vector<std::pair<vtkInformation*, vtkSmartPointer<vtkInformation> > >
+    Saved;
+};
+}
+
+//----------------------------------------------------------------------------
+vtkPriorityStreamingPipeline::vtkPriorityStreamingPipeline()
+{
+  this->NumberOfCulledPieces = 0;
+  this->CurrentPieceCulled = 0;
+  this->Internals = new vtkPriorityStreamingPipelineInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkPriorityStreamingPipeline::~vtkPriorityStreamingPipeline()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPriorityStreamingPipeline::AddPieceArrayRange(vtkInformation* info,
+                                                      int association,
+                                                      const char* name,
+                                                      int numberOfComponents,
+                                                      double* ranges,
+                                                      int attributeType)
+{
+  vtkInformationVector* arrays = info->Get(PIECE_ARRAY_RANGES());
+  if (!arrays)
+    {
+    arrays = vtkInformationVector::New();
+    info->Set(PIECE_ARRAY_RANGES(), arrays);
+    arrays->Delete();
+    }
+
+  vtkInformation* arrayInfo = vtkInformation::New();
+  arrayInfo->Set(vtkDataObject::FIELD_ASSOCIATION(), association);
+  if (name)
+    {
+    arrayInfo->Set(vtkDataObject::FIELD_NAME(), name);
+    }
+  arrayInfo->Set(vtkDataObject::FIELD_RANGE(), ranges,
+                 2 * numberOfComponents);
+  if (attributeType >= 0)
+    {
+    arrayInfo->Set(vtkDataObject::FIELD_ACTIVE_ATTRIBUTE(),
+                   1 << attributeType);
+    }
+  arrays->Append(arrayInfo);
+  arrayInfo->Delete();
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityStreamingPipeline::GetPieceArrayRange(vtkInformation* info,
+                                                     vtkInformation* arrayInfo,
+                                                     int component,
+                                                     double range[2])
+{
+  vtkInformationVector* arrays = info->Get(PIECE_ARRAY_RANGES());
+  if (!arrays || !arrayInfo || component < 0)
+    {
+    return 0;
+    }
+
+  int association = arrayInfo->Get(vtkDataObject::FIELD_ASSOCIATION());
+  const char* name = arrayInfo->Get(vtkDataObject::FIELD_NAME());
+  int attributeType = -1;
+  if (!name)
+    {
+    if (!arrayInfo->Has(vtkDataObject::FIELD_ATTRIBUTE_TYPE()))
+      {
+      return 0;
+      }
+    attributeType = arrayInfo->Get(vtkDataObject::FIELD_ATTRIBUTE_TYPE());
+    }
+
+  // Points are searched before cells as vtkAlgorithm does.
+  int associations[2] = { association, -1 };
+  if (association == vtkDataObject::FIELD_ASSOCIATION_POINTS_THEN_CELLS)
+    {
+    associations[0] = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+    associations[1] = vtkDataObject::FIELD_ASSOCIATION_CELLS;
+    }
+
+  for (int a = 0; a < 2 && associations[a] >= 0; ++a)
+    {
+    for (int i = 0; i < arrays->GetNumberOfInformationObjects(); ++i)
+      {
+      vtkInformation* entry = arrays->GetInformationObject(i);
+      if (entry->Get(vtkDataObject::FIELD_ASSOCIATION()) != associations[a])
+        {
+        continue;
+        }
+      if (name)
+        {
+        const char* entryName = entry->Get(vtkDataObject::FIELD_NAME());
+        if (!entryName || strcmp(entryName, name) != 0)
+          {
+          continue;
+          }
+        }
+      else if (!(entry->Get(vtkDataObject::FIELD_ACTIVE_ATTRIBUTE()) &
+                 (1 << attributeType)))
+        {
+        continue;
+        }
+      if (entry->Length(vtkDataObject::FIELD_RANGE()) < 2 * (component + 1))
+        {
+        return 0;
+        }
+      double* ranges = entry->Get(vtkDataObject::FIELD_RANGE());
+      range[0] = ranges[2 * component];
+      range[1] = ranges[2 * component + 1];
+      return 1;
+      }
+    }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityStreamingPipeline::GetPieceBounds(vtkInformation* info,
+                                                 double bounds[6])
+{
+  if (info->Has(PIECE_BOUNDS()))
+    {
+    info->Get(PIECE_BOUNDS(), bounds);
+    return 1;
+    }
+
+  if (!info->Has(WHOLE_EXTENT()) ||
+      !info->Has(vtkDataObject::ORIGIN()) ||
+      !info->Has(vtkDataObject::SPACING()))
+    {
+    return 0;
+    }
+
+  int wholeExtent[6];
+  int extent[6];
+  info->Get(WHOLE_EXTENT(), wholeExtent);
+  int piece = info->Get(UPDATE_PIECE_NUMBER());
+  int numPieces = info->Get(UPDATE_NUMBER_OF_PIECES());
+  if (numPieces > 1)
+    {
+    vtkExtentTranslator* et = vtkExtentTranslator::New();
+    int success = et->PieceToExtentThreadSafe(
+      piece, numPieces, info->Get(UPDATE_NUMBER_OF_GHOST_LEVELS()),
+      wholeExtent, extent, vtkExtentTranslator::BLOCK_MODE, 0);
+    et->Delete();
+    if (!success)
+      {
+      return 0;
+      }
+    }
+  else
+    {
+    std::copy(wholeExtent, wholeExtent + 6, extent);
+    }
+
+  double* origin = info->Get(vtkDataObject::ORIGIN());
+  double* spacing = info->Get(vtkDataObject::SPACING());
+  for (int i = 0; i < 3; ++i)
+    {
+    double a = origin[i] + extent[2 * i] * spacing[i];
+    double b = origin[i] + extent[2 * i + 1] * spacing[i];
+    bounds[2 * i] = std::min(a, b);
+    bounds[2 * i + 1] = std::max(a, b);
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+double vtkPriorityStreamingPipeline::ComputePriority(int port, int connection,
+                                                     int piece,
+                                                     int numberOfPieces,
+                                                     int ghostLevels)
+{
+  if (port < 0 || port >= this->GetNumberOfInputPorts() ||
+      connection < 0 || connection >= this->GetNumberOfInputConnections(port))
+    {
+    vtkErrorMacro("No input connection " << connection << " on port "
+                  << port);
+    return 1.0;
+    }
+
+  vtkExecutive* producer;
+  int producerPort;
+  vtkExecutive::PRODUCER()->Get(this->GetInputInformation(port, connection),
+                                producer, producerPort);
+  if (!producer)
+    {
+    return 1.0;
+    }
+
+  vtkPriorityStreamingPipelineTraversal traversal(piece, numberOfPieces,
+                                                  ghostLevels);
+  return traversal.ComputePriority(producer, producerPort);
+}
+
+//----------------------------------------------------------------------------
+void vtkPriorityStreamingPipeline::OrderPieces(
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec)
+{
+  this->CurrentPieceCulled = 0;
+  if (this->GetNumberOfInputPorts() < 1 ||
+      inInfoVec[0]->GetNumberOfInformationObjects() < 1)
+    {
+    return;
+    }
+
+  vtkInformation* inInfo = inInfoVec[0]->GetInformationObject(0);
+  if (!inInfo->Has(UPDATE_PIECE_NUMBER()) ||
+      !inInfo->Has(UPDATE_NUMBER_OF_PIECES()))
+    {
+    return;
+    }
+  int piece = inInfo->Get(UPDATE_PIECE_NUMBER());
+  int numPieces = inInfo->Get(UPDATE_NUMBER_OF_PIECES());
+  int ghostLevels = inInfo->Get(UPDATE_NUMBER_OF_GHOST_LEVELS());
+
+  // Find the range of input pieces making the output piece.
+  int outPiece = 0;
+  int outNumPieces = 1;
+  if (outInfoVec->GetNumberOfInformationObjects() > 0)
+    {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(0);
+    if (outInfo->Has(UPDATE_NUMBER_OF_PIECES()))
+      {
+      outPiece = outInfo->Get(UPDATE_PIECE_NUMBER());
+      outNumPieces = outInfo->Get(UPDATE_NUMBER_OF_PIECES());
+      }
+    }
+  if (outNumPieces < 1 || numPieces < outNumPieces ||
+      numPieces % outNumPieces != 0)
+    {
+    return;
+    }
+  int n = numPieces / outNumPieces;
+  int firstPiece = outPiece * n;
+  int index = piece - firstPiece;
+  if (index < 0 || index >= n)
+    {
+    return;
+    }
+
+  // Order the pieces when the first one is requested.
+  vtkPriorityStreamingPipelineInternals* internals = this->Internals;
+  if (index == 0 ||
+      internals->FirstPiece != firstPiece ||
+      internals->NumberOfPieces != numPieces ||
+      internals->GhostLevels != ghostLevels)
+    {
+    internals->FirstPiece = firstPiece;
+    internals->NumberOfPieces = numPieces;
+    internals->GhostLevels = ghostLevels;
+    internals->Priorities.resize(n);
+    internals->Order.resize(n);
+    this->NumberOfCulledPieces = 0;
+    for (int i = 0; i < n; ++i)
+      {
+      internals->Priorities[i] =
+        this->ComputePriority(0, 0, firstPiece + i, numPieces, ghostLevels);
+      internals->Order[i] = i;
+      if (internals->Priorities[i] <= 0.0)
+        {
+        this->NumberOfCulledPieces++;
+        }
+      }
+    vtkPriorityStreamingPipelineCompare compare;
+    compare.Priorities = &internals->Priorities;
+    std::stable_sort(internals->Order.begin(), internals->Order.end(),
+                     compare);
+    vtkDebugMacro("Ordered " << n << " pieces, "
+                  << this->NumberOfCulledPieces << " culled");
+    }
+
+  int orderedPiece = internals->Order[index];
+  inInfo->Set(UPDATE_PIECE_NUMBER(), firstPiece + orderedPiece);
+  this->CurrentPieceCulled = internals->Priorities[orderedPiece] <= 0.0;
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityStreamingPipeline::CallAlgorithm(vtkInformation* request,
+                                                int direction,
+                                                vtkInformationVector** inInfo,
+                                                vtkInformationVector* outInfo)
+{
+  int result =
+    this->Superclass::CallAlgorithm(request, direction, inInfo, outInfo);
+  if (result && request->Has(REQUEST_UPDATE_EXTENT()))
+    {
+    this->OrderPieces(inInfo, outInfo);
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityStreamingPipeline::ForwardUpstream(vtkInformation* request)
+{
+  // Culled pieces are not requested upstream.
+  if (this->CurrentPieceCulled &&
+      (request->Has(REQUEST_UPDATE_EXTENT()) || request->Has(REQUEST_DATA())))
+    {
+    return 1;
+    }
+  return this->Superclass::ForwardUpstream(request);
+}
+
+//----------------------------------------------------------------------------
+int vtkPriorityStreamingPipeline::ExecuteData(vtkInformation* request,
+                                              vtkInformationVector** inInfoVec,
+                                              vtkInformationVector* outInfoVec)
+{
+  if (!this->CurrentPieceCulled)
+    {
+    return this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+    }
+
+  // Execute the algorithm with an empty input in place of the culled
+  // piece.
+  int numPorts = this->GetNumberOfInputPorts();
+  std::vector<vtkSmartPointer<vtkInformationVector> > vectors(numPorts);
+  std::vector<vtkInformationVector*> inputs(numPorts);
+  for (int i = 0; i < numPorts; ++i)
+    {
+    vectors[i] = vtkSmartPointer<vtkInformationVector>::New();
+    for (int j = 0; j < inInfoVec[i]->GetNumberOfInformationObjects(); ++j)
+      {
+      vectors[i]->SetInformationObject(j, inInfoVec[i]->GetInformationObject(j));
+      }
+    inputs[i] = vectors[i];
+    }
+
+  vtkInformation* inInfo = inInfoVec[0]->GetInformationObject(0);
+  vtkSmartPointer<vtkInformation> emptyInfo =
+    vtkSmartPointer<vtkInformation>::New();
+  emptyInfo->Copy(inInfo);
+  vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (input)
+    {
+    vtkDataObject* empty = input->NewInstance();
+    emptyInfo->Set(vtkDataObject::DATA_OBJECT(), empty);
+    empty->Delete();
+    }
+  vectors[0]->SetInformationObject(0, emptyInfo);
+
+  return this->Superclass::ExecuteData(request, &inputs[0], outInfoVec);
+}
+
+//----------------------------------------------------------------------------
+void vtkPriorityStreamingPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "NumberOfCulledPieces: " << this->NumberOfCulledPieces
+     << "\n";
+}
@@ -0,0 +1,169 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPriorityStreamingPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPriorityStreamingPipeline - Executive that streams pieces by priority
+// .SECTION Description
+// vtkPriorityStreamingPipeline is an executive for streaming algorithms,
+// such as vtkPolyDataStreamer, that request the pieces of their input one
+// after the other. Before the first piece is requested, it asks the
+// upstream pipeline for the priority of every piece, then hands the
+// pieces to the algorithm from the highest to the lowest priority. Pieces
+// with a zero priority cannot contribute to the result: their upstream
+// pipeline is not updated and the algorithm receives an empty input for
+// them instead.
+//
+// Priorities are computed with the REQUEST_PIECE_PRIORITY() request. It
+// travels upstream with the piece set in the UPDATE_PIECE_NUMBER(),
+// UPDATE_NUMBER_OF_PIECES() and UPDATE_NUMBER_OF_GHOST_LEVELS() keys of
+// every output information, and every algorithm then receives it, from
+// the sources down. Before an algorithm receives it, the PRIORITY() of
+// its outputs is set to the largest priority of its inputs, or to 1 for
+// sources, and the piece meta-information of its outputs is cleared.
+// Algorithms may then describe the piece with PIECE_BOUNDS() and
+// PIECE_ARRAY_RANGES() (typically readers and sources), and lower its
+// PRIORITY() (filters that know they produce nothing from the piece, or
+// view-dependent algorithms). For instance vtkContourFilter culls pieces
+// whose scalar range contains no contour value and vtkCutter culls pieces
+// whose bounds its plane does not cross.
+//
+// Only the first connection of the first input port is streamed. Pieces
+// are ordered within the piece the algorithm produces: an algorithm
+// producing piece p of P that requests piece p * N + i of P * N on its
+// input gets the i-th piece of highest priority among p * N to p * N + N - 1.
+// The order is computed when the algorithm requests its first piece
+// (i = 0) and used for the rest of the pass.
+//
+// .SECTION Caveats
+// The upstream pipeline is assumed to request the same piece of its
+// inputs as of its outputs, which holds for most filters. Piece
+// meta-information describes the output of the algorithm that sets it
+// and is not passed through algorithms that do not understand the
+// request, since they may move points or change arrays.
+//
+// .SECTION See Also
+// vtkStreamerBase vtkPolyDataStreamer vtkStreamingDemandDrivenPipeline
+
+#ifndef __vtkPriorityStreamingPipeline_h
+#define __vtkPriorityStreamingPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkInformationDoubleKey;
+class vtkInformationDoubleVectorKey;
+class vtkInformationInformationVectorKey;
+class vtkPriorityStreamingPipelineInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPriorityStreamingPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkPriorityStreamingPipeline* New();
+  vtkTypeMacro(vtkPriorityStreamingPipeline,vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Key defining a request to compute the priority and meta-information
+  // of the piece requested on an output.
+  static vtkInformationRequestKey* REQUEST_PIECE_PRIORITY();
+
+  // Description:
+  // Priority of the requested piece, between 0 and 1. A piece with a zero
+  // priority does not contribute to the output and can be skipped.
+  static vtkInformationDoubleKey* PRIORITY();
+
+  // Description:
+  // Bounds (xmin, xmax, ymin, ymax, zmin, zmax) of the requested piece.
+  static vtkInformationDoubleVectorKey* PIECE_BOUNDS();
+
+  // Description:
+  // Ranges of the arrays of the requested piece. Each entry has the
+  // vtkDataObject::FIELD_ASSOCIATION(), FIELD_NAME() and FIELD_RANGE()
+  // of an array, FIELD_RANGE() holding the range of each component in
+  // order, and the vtkDataObject::FIELD_ACTIVE_ATTRIBUTE() flags of the
+  // array when it is an active attribute.
+  static vtkInformationInformationVectorKey* PIECE_ARRAY_RANGES();
+
+  // Description:
+  // Add an entry to the PIECE_ARRAY_RANGES() of an output information.
+  // ranges holds the range of each component. attributeType is a
+  // vtkDataSetAttributes::AttributeTypes value if the array is the active
+  // attribute of that type, -1 otherwise.
+  static void AddPieceArrayRange(vtkInformation* info, int association,
+                                 const char* name, int numberOfComponents,
+                                 double* ranges,
+                                 int attributeType = -1);
+
+  // Description:
+  // Get the range of a component of the array described by arrayInfo,
+  // as returned by vtkAlgorithm::GetInputArrayInformation(), in the
+  // PIECE_ARRAY_RANGES() of an input information. Returns 0 if the range
+  // is unknown.
+  static int GetPieceArrayRange(vtkInformation* info,
+                                vtkInformation* arrayInfo,
+                                int component, double range[2]);
+
+  // Description:
+  // Get the bounds of the piece requested on an input information. They
+  // are the PIECE_BOUNDS() if set, or are derived from the WHOLE_EXTENT(),
+  // ORIGIN() and SPACING() of image data, which the pipeline splits into
+  // pieces with vtkExtentTranslator. Returns 0 if the bounds are unknown.
+  static int GetPieceBounds(vtkInformation* info, double bounds[6]);
+
+  // Description:
+  // Compute the priority of a piece of an input connection of the
+  // algorithm. The update requests of the upstream pipeline are
+  // restored afterwards.
+  double ComputePriority(int port, int connection, int piece,
+                         int numberOfPieces, int ghostLevels);
+
+  // Description:
+  // Number of pieces found to have a zero priority when the pieces were
+  // last ordered.
+  vtkGetMacro(NumberOfCulledPieces,int);
+
+  // Description:
+  // Orders the pieces requested by the algorithm after it handled
+  // REQUEST_UPDATE_EXTENT.
+  virtual int CallAlgorithm(vtkInformation* request, int direction,
+                            vtkInformationVector** inInfo,
+                            vtkInformationVector* outInfo);
+
+protected:
+  vtkPriorityStreamingPipeline();
+  ~vtkPriorityStreamingPipeline();
+
+  virtual int ForwardUpstream(vtkInformation* request);
+  virtual int ExecuteData(vtkInformation* request,
+                          vtkInformationVector** inInfoVec,
+                          vtkInformationVector* outInfoVec);
+
+  // Description:
+  // Map the piece requested by the algorithm to the piece of that rank
+  // in priority order.
+  void OrderPieces(vtkInformationVector** inInfoVec,
+                   vtkInformationVector* outInfoVec);
+
+  int NumberOfCulledPieces;
+
+  // Whether the piece currently requested on the input is culled.
+  int CurrentPieceCulled;
+
+private:
+  vtkPriorityStreamingPipelineInternals* Internals;
+
+  vtkPriorityStreamingPipeline(const vtkPriorityStreamingPipeline&);  // Not implemented.
+  void operator=(const vtkPriorityStreamingPipeline&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkProfilingPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkProfilingPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkThreadedImageAlgorithm.h"
+#include "vtkTimerLog.h"
+
+vtkStandardNewMacro(vtkProfilingPipeline);
+
+vtkPipelineProfiler* vtkProfilingPipeline::DefaultProfiler = 0;
+
+//----------------------------------------------------------------------------
+vtkProfilingPipeline::vtkProfilingPipeline()
+{
+  this->Profiler = 0;
+  this->SetProfiler(vtkProfilingPipeline::DefaultProfiler);
+}
+
+//----------------------------------------------------------------------------
+vtkProfilingPipeline::~vtkProfilingPipeline()
+{
+  this->SetProfiler(0);
+}
+
+//----------------------------------------------------------------------------
+vtkCxxSetObjectMacro(vtkProfilingPipeline,Profiler,vtkPipelineProfiler);
+
+//----------------------------------------------------------------------------
+void vtkProfilingPipeline::SetDefaultProfiler(vtkPipelineProfiler* profiler)
+{
+  if (vtkProfilingPipeline::DefaultProfiler == profiler)
+    {
+    return;
+    }
+  if (vtkProfilingPipeline::DefaultProfiler)
+    {
+    vtkProfilingPipeline::DefaultProfiler->UnRegister(0);
+    }
+  vtkProfilingPipeline::DefaultProfiler = profiler;
+  if (profiler)
+    {
+    profiler->Register(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler* vtkProfilingPipeline::GetDefaultProfiler()
+{
+  return vtkProfilingPipeline::DefaultProfiler;
+}
+
+//----------------------------------------------------------------------------
+int vtkProfilingPipeline::ProcessRequest(vtkInformation* request,
+                                         vtkInformationVector** inInfoVec,
+                                         vtkInformationVector* outInfoVec)
+{
+  if (!this->Profiler || !this->Algorithm)
+    {
+    return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+    }
+
+  // Requests forwarded upstream while this one is processed are recorded
+  // as its children.
+  vtkInformationRequestKey* key = request->GetRequest();
+  vtkPipelineProfiler* profiler = this->Profiler;
+  profiler->Register(this);
+  profiler->StartEvent(this->Algorithm, key ? key->GetName() : "UNKNOWN");
+  int result =
+    this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+  profiler->EndEvent();
+  profiler->UnRegister(this);
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkProfilingPipeline::ExecuteData(vtkInformation* request,
+                                      vtkInformationVector** inInfoVec,
+                                      vtkInformationVector* outInfoVec)
+{
+  if (!this->Profiler || !this->Algorithm)
+    {
+    return this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+    }
+
+  vtkPipelineProfiler* profiler = this->Profiler;
+  profiler->Register(this);
+  double start = vtkTimerLog::GetUniversalTime();
+  double cpuStart = vtkTimerLog::GetCPUTime();
+  profiler->StartEvent(this->Algorithm, "Execute");
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  double wallTime = vtkTimerLog::GetUniversalTime() - start;
+  double cpuTime = vtkTimerLog::GetCPUTime() - cpuStart;
+
+  long outputMemory = 0;
+  for (int i=0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+    {
+    vtkDataObject* output =
+      outInfoVec->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+    if (output)
+      {
+      outputMemory += static_cast<long>(output->GetActualMemorySize());
+      }
+    }
+
+  profiler->EndEvent(outputMemory,
+                     this->GetNumberOfThreadsUsed(wallTime, cpuTime));
+  profiler->UnRegister(this);
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkProfilingPipeline::GetNumberOfThreadsUsed(double wallTime,
+                                                 double cpuTime)
+{
+  vtkThreadedImageAlgorithm* threaded =
+    vtkThreadedImageAlgorithm::SafeDownCast(this->Algorithm);
+  if (threaded)
+    {
+    return threaded->GetNumberOfThreads();
+    }
+
+  // Other algorithms may use vtkSMPTools, which does not say how many
+  // threads it ran. Executions shorter than the resolution of the CPU
+  // clock cannot be estimated.
+  if (wallTime < 0.01 || cpuTime <= wallTime)
+    {
+    return 1;
+    }
+  return static_cast<int>(cpuTime / wallTime + 0.5);
+}
+
+//----------------------------------------------------------------------------
+void vtkProfilingPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Profiler: " << this->Profiler << endl;
+}
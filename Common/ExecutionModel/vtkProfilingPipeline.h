@@ -0,0 +1,98 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkProfilingPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkProfilingPipeline - Executive that reports to a vtkPipelineProfiler
+// .SECTION Description
+// vtkProfilingPipeline is a vtkCompositeDataPipeline that records every
+// request it processes, and every execution of its algorithm, in a
+// vtkPipelineProfiler. Without a profiler it behaves as its superclass.
+//
+// To profile a whole pipeline, set the default profiler and make
+// vtkProfilingPipeline the default executive before creating the
+// algorithms:
+//
+// \code
+// vtkProfilingPipeline::SetDefaultProfiler(profiler);
+// vtkProfilingPipeline* prototype = vtkProfilingPipeline::New();
+// vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+// prototype->Delete();
+// ... create and update the pipeline ...
+// vtkAlgorithm::SetDefaultExecutivePrototype(0);
+// vtkProfilingPipeline::SetDefaultProfiler(0);
+// profiler->WriteChromeTrace("pipeline.json");
+// \endcode
+//
+// Algorithms driven by other executives are not recorded, but the time
+// they spend is included in the events of their consumers.
+//
+// .SECTION See Also
+// vtkPipelineProfiler vtkCompositeDataPipeline
+
+#ifndef __vtkProfilingPipeline_h
+#define __vtkProfilingPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkPipelineProfiler;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkProfilingPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkProfilingPipeline* New();
+  vtkTypeMacro(vtkProfilingPipeline,vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // The profiler this executive reports to. It is initialized with the
+  // default profiler.
+  virtual void SetProfiler(vtkPipelineProfiler*);
+  vtkGetObjectMacro(Profiler,vtkPipelineProfiler);
+
+  // Description:
+  // Profiler given to the executives created afterwards. Set it back to
+  // NULL to release it.
+  static void SetDefaultProfiler(vtkPipelineProfiler*);
+  static vtkPipelineProfiler* GetDefaultProfiler();
+
+  // Description:
+  // Generalized interface for asking the executive to fulfill update
+  // requests.
+  virtual int ProcessRequest(vtkInformation* request,
+                             vtkInformationVector** inInfo,
+                             vtkInformationVector* outInfo);
+
+protected:
+  vtkProfilingPipeline();
+  ~vtkProfilingPipeline();
+
+  virtual int ExecuteData(vtkInformation* request,
+                          vtkInformationVector** inInfoVec,
+                          vtkInformationVector* outInfoVec);
+
+  // Description:
+  // Number of threads the algorithm used for an execution that took the
+  // given wall clock and CPU times.
+  int GetNumberOfThreadsUsed(double wallTime, double cpuTime);
+
+  vtkPipelineProfiler* Profiler;
+
+  static vtkPipelineProfiler* DefaultProfiler;
+
+private:
+  vtkProfilingPipeline(const vtkProfilingPipeline&);  // Not implemented.
+  void operator=(const vtkProfilingPipeline&);  // Not implemented.
+};
+
+#endif
@@ -76,6 +76,8 @@ vtkStreamingDemandDrivenPipeline::vtkStreamingDemandDrivenPipeline()
 {
   this->ContinueExecuting = 0;
   this->UpdateExtentRequest = 0;
+  this->UpdateTimeRequest = 0;
+  this->TimeDependentInformationRequest = 0;
   this->LastPropogateUpdateExtentShortCircuited = 0;
 }
 
@@ -86,6 +88,14 @@ vtkStreamingDemandDrivenPipeline::~vtkStreamingDemandDrivenPipeline()
     {
     this->UpdateExtentRequest->Delete();
     }
+  if (this->UpdateTimeRequest)
+    {
+    this->UpdateTimeRequest->Delete();
+    }
+  if (this->TimeDependentInformationRequest)
+    {
+    this->TimeDependentInformationRequest->Delete();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -701,21 +711,20 @@ int vtkStreamingDemandDrivenPipeline::PropagateTime(int outputPort)
     }
 
   // Setup the request for update extent propagation.
-  vtkSmartPointer<vtkInformation> updateTimeRequest = vtkSmartPointer<vtkInformation>::New();
-
-  //if (!this->UpdateExtentRequest)
+  if (!this->UpdateTimeRequest)
     {
-    updateTimeRequest->Set(REQUEST_UPDATE_TIME());
+    this->UpdateTimeRequest = vtkInformation::New();
+    this->UpdateTimeRequest->Set(REQUEST_UPDATE_TIME());
     // The request is forwarded upstream through the pipeline.
-    updateTimeRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+    this->UpdateTimeRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
     // Algorithms process this request before it is forwarded.
-    updateTimeRequest->Set(vtkExecutive::ALGORITHM_BEFORE_FORWARD(), 1);
+    this->UpdateTimeRequest->Set(vtkExecutive::ALGORITHM_BEFORE_FORWARD(), 1);
     }
 
-  updateTimeRequest->Set(FROM_OUTPUT_PORT(), outputPort);
+  this->UpdateTimeRequest->Set(FROM_OUTPUT_PORT(), outputPort);
 
   // Send the request.
-  return this->ProcessRequest(updateTimeRequest,
+  return this->ProcessRequest(this->UpdateTimeRequest,
                               this->GetInputInformation(),
                               this->GetOutputInformation());
 }
@@ -729,17 +738,20 @@ int vtkStreamingDemandDrivenPipeline::UpdateTimeDependentInformation(int port)
     return 0;
     }
   // Setup the request for information.
-  vtkSmartPointer<vtkInformation> timeRequest = vtkSmartPointer<vtkInformation>::New();
-  timeRequest->Set(REQUEST_TIME_DEPENDENT_INFORMATION());
-  // The request is forwarded upstream through the pipeline.
-  timeRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
-  // Algorithms process this request after it is forwarded.
-  timeRequest->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
+  if (!this->TimeDependentInformationRequest)
+    {
+    this->TimeDependentInformationRequest = vtkInformation::New();
+    this->TimeDependentInformationRequest->Set(REQUEST_TIME_DEPENDENT_INFORMATION());
+    // The request is forwarded upstream through the pipeline.
+    this->TimeDependentInformationRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+    // Algorithms process this request after it is forwarded.
+    this->TimeDependentInformationRequest->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
+    }
 
-  timeRequest->Set(FROM_OUTPUT_PORT(), port);
+  this->TimeDependentInformationRequest->Set(FROM_OUTPUT_PORT(), port);
 
   // Send the request.
-  return this->ProcessRequest(timeRequest,
+  return this->ProcessRequest(this->TimeDependentInformationRequest,
                               this->GetInputInformation(),
                               this->GetOutputInformation());
 }
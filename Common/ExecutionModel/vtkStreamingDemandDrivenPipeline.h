@@ -252,6 +252,8 @@ protected:
   int ContinueExecuting;
 
   vtkInformation *UpdateExtentRequest;
+  vtkInformation *UpdateTimeRequest;
+  vtkInformation *TimeDependentInformationRequest;
 
   // did the most recent PUE do anything ?
   int LastPropogateUpdateExtentShortCircuited;
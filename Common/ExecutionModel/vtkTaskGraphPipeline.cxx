@@ -0,0 +1,300 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTaskGraphPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkTaskGraphPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+vtkStandardNewMacro(vtkTaskGraphPipeline);
+
+vtkInformationKeyMacro(vtkTaskGraphPipeline, REENTRANT, Integer);
+
+namespace
+{
+// An input connection: the executive producing it and its output port.
+struct vtkTaskGraphConnection
+{
+  vtkExecutive* Executive;
+  int Port;
+};
+
+typedef std::vector<vtkTaskGraphConnection> vtkTaskGraphGroup;
+
+// Forwards a request to the input connections of each group in a range.
+// Each invocation works on its own copy of the request so that the
+// FROM_OUTPUT_PORT() entries of concurrent groups do not collide.
+class vtkTaskGraphGroupOp
+{
+public:
+  vtkInformation* Request;
+  const std::vector<vtkTaskGraphGroup>* Groups;
+  std::vector<int>* Results;
+
+  void operator()(vtkIdType group, vtkIdType endGroup) const
+  {
+    vtkInformation* request = vtkInformation::New();
+    for ( ; group < endGroup; ++group)
+      {
+      // The request key is not part of the copied entries.
+      request->Copy(this->Request);
+      request->SetRequest(this->Request->GetRequest());
+      const vtkTaskGraphGroup& connections = (*this->Groups)[group];
+      int result = 1;
+      for (size_t c = 0; c < connections.size(); ++c)
+        {
+        vtkExecutive* e = connections[c].Executive;
+        request->Set(vtkExecutive::FROM_OUTPUT_PORT(), connections[c].Port);
+        if (!e->ProcessRequest(request,
+                               e->GetInputInformation(),
+                               e->GetOutputInformation()))
+          {
+          result = 0;
+          }
+        }
+      (*this->Results)[group] = result;
+      }
+    request->Delete();
+  }
+};
+
+// Union-find root with path halving.
+size_t vtkTaskGraphFindRoot(std::vector<size_t>& parent, size_t i)
+{
+  while (parent[i] != i)
+    {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+    }
+  return i;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkTaskGraphPipeline::vtkTaskGraphPipeline()
+{
+  this->NumberOfConcurrentGroups = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTaskGraphPipeline::~vtkTaskGraphPipeline()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkTaskGraphPipeline::SetReentrant(vtkAlgorithm* algorithm,
+                                        int reentrant)
+{
+  if (algorithm)
+    {
+    algorithm->GetInformation()->Set(REENTRANT(), reentrant);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkTaskGraphPipeline::GetReentrant(vtkAlgorithm* algorithm)
+{
+  if (!algorithm || !algorithm->GetInformation()->Has(REENTRANT()))
+    {
+    return 0;
+    }
+  return algorithm->GetInformation()->Get(REENTRANT());
+}
+
+//----------------------------------------------------------------------------
+int vtkTaskGraphPipeline::ForwardUpstream(vtkInformation* request)
+{
+  // Only the data pass is dispatched concurrently.
+  if (!request->Has(REQUEST_DATA()) || this->SharedInputInformation)
+    {
+    return this->Superclass::ForwardUpstream(request);
+    }
+  this->NumberOfConcurrentGroups = 0;
+
+  // Collect the producers of all input connections.
+  std::vector<vtkTaskGraphConnection> connections;
+  for (int i=0; i < this->GetNumberOfInputPorts(); ++i)
+    {
+    int nic = this->Algorithm->GetNumberOfInputConnections(i);
+    vtkInformationVector* inVector = this->GetInputInformation()[i];
+    for (int j=0; j < nic; ++j)
+      {
+      vtkInformation* info = inVector->GetInformationObject(j);
+      vtkTaskGraphConnection connection;
+      vtkExecutive::PRODUCER()->Get(info, connection.Executive,
+                                    connection.Port);
+      if (connection.Executive)
+        {
+        connections.push_back(connection);
+        }
+      }
+    }
+  size_t numConnections = connections.size();
+  if (numConnections < 2)
+    {
+    return this->Superclass::ForwardUpstream(request);
+    }
+
+  // Walk the upstream pipeline of each connection. Connections that reach
+  // a common algorithm are merged into the same group, and a group can run
+  // concurrently only if all of its algorithms are reentrant.
+  std::vector<size_t> parent(numConnections);
+  std::vector<int> reentrant(numConnections, 1);
+  std::map<vtkAlgorithm*, size_t> owner;
+  size_t c;
+  for (c = 0; c < numConnections; ++c)
+    {
+    parent[c] = c;
+    std::set<vtkExecutive*> visited;
+    std::vector<vtkExecutive*> stack(1, connections[c].Executive);
+    while (!stack.empty())
+      {
+      vtkExecutive* e = stack.back();
+      stack.pop_back();
+      if (!visited.insert(e).second)
+        {
+        continue;
+        }
+      vtkAlgorithm* algorithm = e->GetAlgorithm();
+      if (!vtkTaskGraphPipeline::GetReentrant(algorithm))
+        {
+        reentrant[c] = 0;
+        }
+      std::map<vtkAlgorithm*, size_t>::iterator it = owner.find(algorithm);
+      if (it == owner.end())
+        {
+        owner[algorithm] = c;
+        }
+      else
+        {
+        parent[vtkTaskGraphFindRoot(parent, c)] =
+          vtkTaskGraphFindRoot(parent, it->second);
+        }
+      for (int i=0; i < algorithm->GetNumberOfInputPorts(); ++i)
+        {
+        for (int j=0; j < algorithm->GetNumberOfInputConnections(i); ++j)
+          {
+          if (vtkExecutive* input = e->GetInputExecutive(i, j))
+            {
+            stack.push_back(input);
+            }
+          }
+        }
+      }
+    }
+
+  // Form the groups, keeping the connection order within each group.
+  std::vector<vtkTaskGraphGroup> groups;
+  std::vector<int> groupReentrant;
+  std::map<size_t, size_t> groupOfRoot;
+  for (c = 0; c < numConnections; ++c)
+    {
+    size_t root = vtkTaskGraphFindRoot(parent, c);
+    std::map<size_t, size_t>::iterator it = groupOfRoot.find(root);
+    if (it == groupOfRoot.end())
+      {
+      it = groupOfRoot.insert(std::make_pair(root, groups.size())).first;
+      groups.push_back(vtkTaskGraphGroup());
+      groupReentrant.push_back(1);
+      }
+    groups[it->second].push_back(connections[c]);
+    groupReentrant[it->second] &= reentrant[c];
+    }
+
+  std::vector<vtkTaskGraphGroup> concurrentGroups;
+  vtkTaskGraphGroup sequential;
+  size_t g;
+  for (g = 0; g < groups.size(); ++g)
+    {
+    if (groupReentrant[g])
+      {
+      concurrentGroups.push_back(groups[g]);
+      }
+    else
+      {
+      sequential.insert(sequential.end(), groups[g].begin(), groups[g].end());
+      }
+    }
+  if (concurrentGroups.size() < 2)
+    {
+    for (g = 0; g < concurrentGroups.size(); ++g)
+      {
+      sequential.insert(sequential.end(), concurrentGroups[g].begin(),
+                        concurrentGroups[g].end());
+      }
+    concurrentGroups.clear();
+    }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+    {
+    return 0;
+    }
+  int port = request->Get(FROM_OUTPUT_PORT());
+
+  int result = 1;
+  if (!concurrentGroups.empty())
+    {
+    vtkDebugMacro(<< "Updating " << concurrentGroups.size()
+                  << " groups of inputs concurrently");
+    std::vector<int> results(concurrentGroups.size(), 1);
+    vtkTaskGraphGroupOp op;
+    op.Request = request;
+    op.Groups = &concurrentGroups;
+    op.Results = &results;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(concurrentGroups.size()), 1,
+                     op);
+    for (g = 0; g < results.size(); ++g)
+      {
+      result = results[g] ? result : 0;
+      }
+    this->NumberOfConcurrentGroups = static_cast<int>(concurrentGroups.size());
+    }
+
+  for (c = 0; c < sequential.size(); ++c)
+    {
+    vtkExecutive* e = sequential[c].Executive;
+    request->Set(FROM_OUTPUT_PORT(), sequential[c].Port);
+    if (!e->ProcessRequest(request,
+                           e->GetInputInformation(),
+                           e->GetOutputInformation()))
+      {
+      result = 0;
+      }
+    request->Set(FROM_OUTPUT_PORT(), port);
+    }
+
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+    {
+    return 0;
+    }
+
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkTaskGraphPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfConcurrentGroups: "
+     << this->NumberOfConcurrentGroups << endl;
+}
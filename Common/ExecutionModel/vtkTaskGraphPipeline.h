@@ -0,0 +1,91 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTaskGraphPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkTaskGraphPipeline - Executive that updates independent inputs concurrently
+// .SECTION Description
+// vtkTaskGraphPipeline is a vtkCompositeDataPipeline that forwards
+// REQUEST_DATA to its input connections concurrently. When the algorithm
+// it drives has several inputs (for example an append filter fed by
+// several branches), the upstream pipeline of each input connection is
+// collected. Connections whose upstream pipelines share an algorithm are
+// grouped, since they cannot run at the same time. The groups are then
+// dispatched with vtkSMPTools::For, each group updating its connections
+// in order, and the algorithm executes once all of its inputs are up to
+// date. Other requests are forwarded as in the superclass.
+//
+// Concurrency is opt-in. A group runs concurrently only if every
+// algorithm of its upstream pipeline has the REENTRANT() key set to a
+// non-zero value in its information object, which states that the
+// algorithm keeps all of its pipeline state in its own information
+// objects and does not touch global state when executing. Other groups
+// are updated on the calling thread as before. Setting this executive on
+// upstream algorithms as well makes nested fan-ins concurrent too.
+//
+// .SECTION Caveats
+// Progress and other events of the upstream algorithms are invoked from
+// worker threads while the groups run concurrently; observers must be
+// thread safe. Nothing runs concurrently with the sequential SMP backend.
+//
+// .SECTION See Also
+// vtkCompositeDataPipeline vtkThreadedCompositeDataPipeline vtkSMPTools
+
+#ifndef __vtkTaskGraphPipeline_h
+#define __vtkTaskGraphPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkAlgorithm;
+class vtkInformationIntegerKey;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkTaskGraphPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkTaskGraphPipeline* New();
+  vtkTypeMacro(vtkTaskGraphPipeline,vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Key set in the information object of an algorithm (see
+  // vtkAlgorithm::GetInformation()) to declare that it can process
+  // requests concurrently with other, unrelated algorithms.
+  static vtkInformationIntegerKey* REENTRANT();
+
+  // Description:
+  // Convenience methods to set and query the REENTRANT() key of an
+  // algorithm.
+  static void SetReentrant(vtkAlgorithm* algorithm, int reentrant);
+  static int GetReentrant(vtkAlgorithm* algorithm);
+
+  // Description:
+  // Number of groups of input connections that were updated concurrently
+  // during the last REQUEST_DATA forwarded by this executive. This is zero
+  // when the inputs were updated sequentially.
+  vtkGetMacro(NumberOfConcurrentGroups,int);
+
+protected:
+  vtkTaskGraphPipeline();
+  ~vtkTaskGraphPipeline();
+
+  virtual int ForwardUpstream(vtkInformation* request);
+  using vtkCompositeDataPipeline::ForwardUpstream;
+
+  int NumberOfConcurrentGroups;
+
+private:
+  vtkTaskGraphPipeline(const vtkTaskGraphPipeline&);  // Not implemented.
+  void operator=(const vtkTaskGraphPipeline&);  // Not implemented.
+};
+
+#endif
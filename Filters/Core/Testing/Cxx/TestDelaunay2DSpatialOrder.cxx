@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunay2DSpatialOrder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Triangulates a random terrain with a constrained polyline using both
+// point insertion orders and checks that the results agree.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay2D.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cmath>
+
+static bool HasEdge(vtkPolyData *mesh, vtkIdType p1, vtkIdType p2)
+{
+  vtkNew<vtkIdList> cells;
+  mesh->GetCellEdgeNeighbors(-1, p1, p2, cells.GetPointer());
+  return cells->GetNumberOfIds() > 0;
+}
+
+int TestDelaunay2DSpatialOrder(int, char*[])
+{
+  vtkMath::RandomSeed(8775070);
+
+  // A height field sampled at random locations. The first points form a
+  // polyline that is used as a constraint.
+  const int numConstraintPts = 20;
+  const int numPts = 20000;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell(numConstraintPts);
+  double x[3];
+  for (int i = 0; i < numPts; ++i)
+    {
+    if (i < numConstraintPts)
+      {
+      x[0] = 0.1 + 0.8 * i / (numConstraintPts - 1);
+      x[1] = 0.5 + 0.1 * sin(6.0 * x[0]);
+      lines->InsertCellPoint(i);
+      }
+    else
+      {
+      x[0] = vtkMath::Random();
+      x[1] = vtkMath::Random();
+      }
+    x[2] = 0.2 * sin(10.0 * x[0]) * cos(10.0 * x[1]);
+    points->InsertNextPoint(x);
+    }
+
+  vtkNew<vtkPolyData> terrain;
+  terrain->SetPoints(points.GetPointer());
+  vtkNew<vtkPolyData> constraints;
+  constraints->SetPoints(points.GetPointer());
+  constraints->SetLines(lines.GetPointer());
+
+  vtkNew<vtkDelaunay2D> inputOrder;
+  inputOrder->SetInputData(terrain.GetPointer());
+  inputOrder->SetSourceData(constraints.GetPointer());
+  inputOrder->SetPointInsertionOrderToInputOrder();
+  inputOrder->Update();
+
+  vtkNew<vtkDelaunay2D> spatialOrder;
+  spatialOrder->SetInputData(terrain.GetPointer());
+  spatialOrder->SetSourceData(constraints.GetPointer());
+  spatialOrder->SetPointInsertionOrderToSpatialOrder();
+  spatialOrder->Update();
+
+  vtkPolyData *output1 = inputOrder->GetOutput();
+  vtkPolyData *output2 = spatialOrder->GetOutput();
+  cout << "Input order: " << output1->GetNumberOfPolys() << " triangles\n";
+  cout << "Spatial order: " << output2->GetNumberOfPolys() << " triangles\n";
+
+  if (output2->GetNumberOfPoints() != numPts)
+    {
+    cerr << "Expected " << numPts << " output points, got "
+         << output2->GetNumberOfPoints() << "\n";
+    return EXIT_FAILURE;
+    }
+  if (output2->GetNumberOfPolys() != output1->GetNumberOfPolys())
+    {
+    cerr << "The insertion orders produced different triangle counts\n";
+    return EXIT_FAILURE;
+    }
+
+  // Every point is used and the constrained edges are recovered.
+  output2->BuildLinks();
+  vtkNew<vtkIdList> cells;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+    output2->GetPointCells(ptId, cells.GetPointer());
+    if (cells->GetNumberOfIds() == 0)
+      {
+      cerr << "Point " << ptId << " is not connected\n";
+      return EXIT_FAILURE;
+      }
+    }
+  for (vtkIdType ptId = 0; ptId < numConstraintPts - 1; ++ptId)
+    {
+    if (!HasEdge(output2, ptId, ptId + 1))
+      {
+      cerr << "Constrained edge (" << ptId << "," << ptId + 1
+           << ") is missing\n";
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
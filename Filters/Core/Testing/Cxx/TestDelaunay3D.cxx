@@ -17,8 +17,11 @@
 #include <vtkDelaunay3D.h>
 #include <vtkMinimalStandardRandomSequence.h>
 #include <vtkSmartPointer.h>
+#include <vtkTetra.h>
 #include <vtkUnstructuredGrid.h>
 
+#include <cmath>
+
 namespace
 {
 void InitializeUnstructuredGrid(vtkUnstructuredGrid *unstructuredGrid, int dataType)
@@ -84,6 +87,73 @@ int Delaunay3D(int dataType, int outputPointsPrecision)
 
   return points->GetDataType();
 }
+
+// Sum of the volumes of the tetrahedra of a triangulation.
+double TetrahedralizedVolume(vtkUnstructuredGrid *grid)
+{
+  double volume = 0.0;
+  double p[4][3];
+  vtkIdType npts, *pts;
+  for(vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+    {
+    grid->GetCellPoints(cellId, npts, pts);
+    for(int i = 0; i < 4; ++i)
+      {
+      grid->GetPoint(pts[i], p[i]);
+      }
+    volume += fabs(vtkTetra::ComputeVolume(p[0], p[1], p[2], p[3]));
+    }
+  return volume;
+}
+
+// Triangulates the same random points in input and in spatial insertion
+// order; both must tessellate the same volume.
+int Delaunay3DSpatialOrder()
+{
+  vtkSmartPointer<vtkMinimalStandardRandomSequence> randomSequence
+    = vtkSmartPointer<vtkMinimalStandardRandomSequence>::New();
+  randomSequence->SetSeed(2);
+
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  for(int i = 0; i < 5000; ++i)
+    {
+    double point[3];
+    for(int j = 0; j < 3; ++j)
+      {
+      randomSequence->Next();
+      point[j] = randomSequence->GetValue();
+      }
+    points->InsertNextPoint(point);
+    }
+  vtkSmartPointer<vtkUnstructuredGrid> input
+    = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  input->SetPoints(points);
+
+  vtkSmartPointer<vtkDelaunay3D> delaunay
+    = vtkSmartPointer<vtkDelaunay3D>::New();
+  delaunay->SetInputData(input);
+  delaunay->Update();
+  double inputOrderVolume = TetrahedralizedVolume(delaunay->GetOutput());
+
+  delaunay->SetPointInsertionOrderToSpatialOrder();
+  delaunay->Update();
+  vtkUnstructuredGrid *output = delaunay->GetOutput();
+  double spatialOrderVolume = TetrahedralizedVolume(output);
+
+  if(output->GetNumberOfPoints() != points->GetNumberOfPoints() ||
+     output->GetNumberOfCells() == 0)
+    {
+    cerr << "Spatial insertion order produced a wrong triangulation\n";
+    return EXIT_FAILURE;
+    }
+  if(fabs(inputOrderVolume - spatialOrderVolume) > 0.01 * inputOrderVolume)
+    {
+    cerr << "Volumes differ between insertion orders: "
+         << inputOrderVolume << " vs " << spatialOrderVolume << "\n";
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
 }
 
 int TestDelaunay3D(int vtkNotUsed(argc), char *vtkNotUsed(argv)[])
@@ -130,5 +200,5 @@ int TestDelaunay3D(int vtkNotUsed(argc), char *vtkNotUsed(argv)[])
     return EXIT_FAILURE;
     }
 
-  return EXIT_SUCCESS;
+  return Delaunay3DSpatialOrder();
 }
@@ -13,6 +13,7 @@
 =========================================================================*/
 #include <vtkSmartPointer.h>
 
+#include <vtkDoubleArray.h>
 #include <vtkImplicitPolyDataDistance.h>
 #include <vtkPlaneSource.h>
 
@@ -78,10 +79,31 @@ int TestImplicitPolyDataDistance(int, char*[])
 
   distance->Print(std::cout);
 
+  // The batched evaluation must match the single point evaluation
+  vtkSmartPointer<vtkDoubleArray> positions =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  positions->SetNumberOfComponents(3);
+  for (it = probes.begin(); it != probes.end(); ++it)
+    {
+    positions->InsertNextTuple(*it);
+    }
+  vtkSmartPointer<vtkDoubleArray> values =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  distance->FunctionValue(positions, values);
+  int status = EXIT_SUCCESS;
+  for (vtkIdType i = 0; i < positions->GetNumberOfTuples(); ++i)
+    {
+    if (values->GetValue(i) != distance->FunctionValue(probes[i]))
+      {
+      std::cout << "Batched value differs at probe " << i << std::endl;
+      status = EXIT_FAILURE;
+      }
+    }
+
   it = probes.begin();
   for ( ; it != probes.end(); ++it)
     {
     delete [] *it;
     }
-  return EXIT_SUCCESS;
+  return status;
 }
@@ -33,6 +33,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
+#include "vtkPriorityStreamingPipeline.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
 #include "vtkSimpleScalarTree.h"
@@ -711,6 +712,47 @@ int vtkContourFilter::FillInputPortInformation(int, vtkInformation *info)
   return 1;
 }
 
+int vtkContourFilter::ProcessRequest(vtkInformation* request,
+                                     vtkInformationVector** inputVector,
+                                     vtkInformationVector* outputVector)
+{
+  if (request->Has(vtkPriorityStreamingPipeline::REQUEST_PIECE_PRIORITY()))
+    {
+    return this->RequestPiecePriority(request, inputVector, outputVector);
+    }
+
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+int vtkContourFilter::RequestPiecePriority(vtkInformation*,
+                                           vtkInformationVector** inputVector,
+                                           vtkInformationVector* outputVector)
+{
+  // Only the first component is contoured on all input types.
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  double range[2];
+  if (!inInfo || this->GetArrayComponent() != 0 ||
+      !vtkPriorityStreamingPipeline::GetPieceArrayRange(
+        inInfo, this->GetInputArrayInformation(0), 0, range))
+    {
+    return 1;
+    }
+
+  int numContours = this->ContourValues->GetNumberOfContours();
+  for (int i = 0; i < numContours; ++i)
+    {
+    double value = this->ContourValues->GetValue(i);
+    if (value >= range[0] && value <= range[1])
+      {
+      return 1;
+      }
+    }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  outInfo->Set(vtkPriorityStreamingPipeline::PRIORITY(), 0.0);
+  return 1;
+}
+
 void vtkContourFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
@@ -159,6 +159,12 @@ public:
   void SetOutputPointsPrecision(int precision);
   int GetOutputPointsPrecision() const;
 
+  // Description:
+  // see vtkAlgorithm for details
+  virtual int ProcessRequest(vtkInformation*,
+                             vtkInformationVector**,
+                             vtkInformationVector*);
+
 protected:
   vtkContourFilter();
   ~vtkContourFilter();
@@ -173,6 +179,13 @@ protected:
                                   vtkInformationVector*);
   virtual int FillInputPortInformation(int port, vtkInformation *info);
 
+  // Description:
+  // Cull pieces whose scalar range contains no contour value, see
+  // vtkPriorityStreamingPipeline.
+  virtual int RequestPiecePriority(vtkInformation*,
+                                   vtkInformationVector**,
+                                   vtkInformationVector*);
+
   vtkContourValues *ContourValues;
   int ComputeNormals;
   int ComputeGradients;
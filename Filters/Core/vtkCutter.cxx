@@ -27,12 +27,14 @@
 #include "vtkImplicitFunction.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLinearTransform.h"
 #include "vtkMergePoints.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkPriorityStreamingPipeline.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
 #include "vtkSmartPointer.h"
@@ -1013,6 +1015,68 @@ int vtkCutter::RequestUpdateExtent(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkCutter::ProcessRequest(vtkInformation* request,
+                              vtkInformationVector** inputVector,
+                              vtkInformationVector* outputVector)
+{
+  if (request->Has(vtkPriorityStreamingPipeline::REQUEST_PIECE_PRIORITY()))
+    {
+    return this->RequestPiecePriority(request, inputVector, outputVector);
+    }
+
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkCutter::RequestPiecePriority(
+  vtkInformation *,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // A plane, even transformed by a linear transform, is a linear function,
+  // so its values over the piece lie between its values at the corners of
+  // the piece bounds.
+  vtkPlane *plane = vtkPlane::SafeDownCast(this->CutFunction);
+  if (!plane || (plane->GetTransform() &&
+                 !vtkLinearTransform::SafeDownCast(plane->GetTransform())))
+    {
+    return 1;
+    }
+
+  double bounds[6];
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  if (!inInfo ||
+      !vtkPriorityStreamingPipeline::GetPieceBounds(inInfo, bounds))
+    {
+    return 1;
+    }
+
+  double range[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  for (int i = 0; i < 8; ++i)
+    {
+    double x[3] = { bounds[i & 1], bounds[2 + ((i >> 1) & 1)],
+                    bounds[4 + ((i >> 2) & 1)] };
+    double value = plane->FunctionValue(x);
+    range[0] = std::min(range[0], value);
+    range[1] = std::max(range[1], value);
+    }
+
+  int numContours = this->ContourValues->GetNumberOfContours();
+  for (int i = 0; i < numContours; ++i)
+    {
+    double value = this->ContourValues->GetValue(i);
+    if (value >= range[0] && value <= range[1])
+      {
+      return 1;
+      }
+    }
+
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  outInfo->Set(vtkPriorityStreamingPipeline::PRIORITY(), 0.0);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkCutter::FillInputPortInformation(int, vtkInformation *info)
 {
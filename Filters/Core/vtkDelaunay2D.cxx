@@ -25,6 +25,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSpatialPointOrder.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangle.h"
 #include "vtkTransform.h"
@@ -42,6 +43,7 @@ vtkDelaunay2D::vtkDelaunay2D()
   this->Offset = 1.0;
   this->Transform = NULL;
   this->ProjectionPlaneMode = VTK_DELAUNAY_XY_PLANE;
+  this->PointInsertionOrder = vtkDelaunay2D::INPUT_ORDER;
 
   // optional 2nd input
   this->SetNumberOfInputPorts(2);
@@ -297,7 +299,7 @@ int vtkDelaunay2D::RequestData(
 
   vtkIdType numPoints, i;
   vtkIdType numTriangles = 0;
-  vtkIdType ptId, tri[4], nei[3];
+  vtkIdType ptId, ptNum, tri[4], nei[3];
   vtkIdType p1 = 0;
   vtkIdType p2 = 0;
   vtkIdType p3 = 0;
@@ -407,6 +409,15 @@ int vtkDelaunay2D::RequestData(
   radius = this->Offset * tol;
   tol *= this->Tolerance;
 
+  // Optionally compute a spatially coherent insertion order (before the
+  // bounding points are added). Only the visiting order changes.
+  vtkIdType *order = NULL;
+  if ( this->PointInsertionOrder == vtkDelaunay2D::SPATIAL_ORDER )
+    {
+    order = new vtkIdType[numPoints];
+    vtkSpatialPointOrder::ComputeBRIO(points, 2, order);
+    }
+
   for (ptId=0; ptId<8; ptId++)
     {
     x[0] = center[0]
@@ -447,8 +458,9 @@ int vtkDelaunay2D::RequestData(
   // satisfy criterion have their edges swapped. This continues recursively
   // until all triangles have been shown to be Delaunay.
   //
-  for (ptId=0; ptId < numPoints; ptId++)
+  for (ptNum=0; ptNum < numPoints; ptNum++)
     {
+    ptId = ( order ? order[ptNum] : ptNum );
     this->GetPoint(ptId,x);
     nei[0] = (-1); //where we are coming from...nowhere initially
 
@@ -529,10 +541,10 @@ int vtkDelaunay2D::RequestData(
       tri[0] = 0; //no triangle found
       }
 
-    if ( ! (ptId % 1000) )
+    if ( ! (ptNum % 1000) )
       {
-      vtkDebugMacro(<<"point #" << ptId);
-      this->UpdateProgress (static_cast<double>(ptId)/numPoints);
+      vtkDebugMacro(<<"point #" << ptNum);
+      this->UpdateProgress (static_cast<double>(ptNum)/numPoints);
       if (this->GetAbortExecute())
         {
         break;
@@ -540,6 +552,7 @@ int vtkDelaunay2D::RequestData(
       }
 
     }//for all points
+  delete [] order;
 
   vtkDebugMacro(<<"Triangulated " << numPoints <<" points, "
                 << this->NumberOfDuplicatePoints
@@ -1459,4 +1472,5 @@ void vtkDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: "
      << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Point Insertion Order: " << this->PointInsertionOrder << "\n";
 }
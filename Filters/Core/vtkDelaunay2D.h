@@ -214,6 +214,33 @@ public:
                    VTK_DELAUNAY_XY_PLANE,VTK_BEST_FITTING_PLANE);
   vtkGetMacro(ProjectionPlaneMode,int);
 
+//BTX
+  // Orders in which the points are inserted.
+  enum InsertionOrderType
+  {
+    INPUT_ORDER=0,
+    SPATIAL_ORDER=1
+  };
+//ETX
+
+  // Description:
+  // Specify the order in which points are inserted into the triangulation.
+  // INPUT_ORDER (the default) inserts the points as they appear in the
+  // input. SPATIAL_ORDER inserts them in biased randomized insertion order:
+  // rounds of geometrically increasing size, each sorted along a Hilbert
+  // curve in the projection plane. Since the search for the triangle
+  // containing a point starts from the triangle of the previous point,
+  // this keeps the searches short and makes the triangulation of large
+  // point sets (e.g., terrain) much faster. Constraints are handled
+  // identically. Degenerate configurations may be triangulated
+  // differently than with INPUT_ORDER.
+  vtkSetClampMacro(PointInsertionOrder,int,INPUT_ORDER,SPATIAL_ORDER);
+  vtkGetMacro(PointInsertionOrder,int);
+  void SetPointInsertionOrderToInputOrder()
+    {this->SetPointInsertionOrder(INPUT_ORDER);}
+  void SetPointInsertionOrderToSpatialOrder()
+    {this->SetPointInsertionOrder(SPATIAL_ORDER);}
+
 protected:
   vtkDelaunay2D();
   ~vtkDelaunay2D();
@@ -230,6 +257,7 @@ protected:
   vtkAbstractTransform *Transform;
 
   int ProjectionPlaneMode; //selects the plane in 3D where the Delaunay triangulation will be computed.
+  int PointInsertionOrder;
 
 private:
   vtkPolyData *Mesh; //the created mesh
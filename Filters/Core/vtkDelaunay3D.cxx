@@ -23,6 +23,7 @@
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
+#include "vtkSpatialPointOrder.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
@@ -146,6 +147,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->PointInsertionOrder = vtkDelaunay3D::INPUT_ORDER;
   this->Locator = NULL;
   this->TetraArray = NULL;
 
@@ -489,20 +491,30 @@ int vtkDelaunay3D::RequestData(
   Mesh = this->InitPointInsertion(center, this->Offset*tol,
                                   numPoints, points);
 
+  // Optionally compute a spatially coherent insertion order. The point
+  // ids are unchanged; only the order in which they are visited differs.
+  vtkIdType *order = NULL;
+  if ( this->PointInsertionOrder == vtkDelaunay3D::SPATIAL_ORDER )
+    {
+    order = new vtkIdType[numPoints];
+    vtkSpatialPointOrder::ComputeBRIO(inPoints, 3, order);
+    }
+
   // Insert each point into triangulation. Points laying "inside"
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
   // tetrahedra.
-  for (ptId=0; ptId < numPoints; ptId++)
+  for (i=0; i < numPoints; i++)
     {
+    ptId = ( order ? order[i] : i );
     inPoints->GetPoint(ptId,x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if ( ! (ptId % 250) )
+    if ( ! (i % 250) )
       {
-      vtkDebugMacro(<<"point #" << ptId);
-      this->UpdateProgress (static_cast<double>(ptId)/numPoints);
+      vtkDebugMacro(<<"point #" << i);
+      this->UpdateProgress (static_cast<double>(i)/numPoints);
       if (this->GetAbortExecute())
         {
         break;
@@ -510,6 +522,7 @@ int vtkDelaunay3D::RequestData(
       }
 
     }//for all points
+  delete [] order;
 
   this->EndPointInsertion();
 
@@ -1056,6 +1069,7 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
     }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Point Insertion Order: " << this->PointInsertionOrder << "\n";
 }
 
 //--------------------------------------------------------------------------
@@ -166,6 +166,32 @@ public:
   vtkGetMacro(BoundingTriangulation,int);
   vtkBooleanMacro(BoundingTriangulation,int);
 
+//BTX
+  // Orders in which the points are inserted.
+  enum InsertionOrderType
+  {
+    INPUT_ORDER=0,
+    SPATIAL_ORDER=1
+  };
+//ETX
+
+  // Description:
+  // Specify the order in which points are inserted into the triangulation.
+  // INPUT_ORDER (the default) inserts the points as they appear in the
+  // input. SPATIAL_ORDER inserts them in biased randomized insertion order:
+  // rounds of geometrically increasing size, each sorted along a Hilbert
+  // curve. Consecutive points are then close to each other, which makes
+  // point location and mesh updates much more local and greatly speeds up
+  // the triangulation of large point sets. The point ids of the output are
+  // the same in both cases, but degenerate configurations may be
+  // triangulated differently.
+  vtkSetClampMacro(PointInsertionOrder,int,INPUT_ORDER,SPATIAL_ORDER);
+  vtkGetMacro(PointInsertionOrder,int);
+  void SetPointInsertionOrderToInputOrder()
+    {this->SetPointInsertionOrder(INPUT_ORDER);}
+  void SetPointInsertionOrderToSpatialOrder()
+    {this->SetPointInsertionOrder(SPATIAL_ORDER);}
+
   // Description:
   // Set / get a spatial locator for merging points. By default,
   // an instance of vtkPointLocator is used.
@@ -236,6 +262,7 @@ protected:
   int BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  int PointInsertionOrder;
 
   vtkIncrementalPointLocator *Locator;  //help locate points faster
 
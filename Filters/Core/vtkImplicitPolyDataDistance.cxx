@@ -15,17 +15,385 @@
 #include "vtkImplicitPolyDataDistance.h"
 
 #include "vtkCellData.h"
-#include "vtkCellLocator.h"
-#include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
-#include "vtkPolygon.h"
+#include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkImplicitPolyDataDistance);
 
+//-----------------------------------------------------------------------------
+// A bounding volume hierarchy over the input triangles. Each node splits
+// its triangles at the median centroid along the longest axis of its
+// bounds; leaves hold a few triangles whose coordinates are stored
+// contiguously. Queries only read the hierarchy, so they are reentrant.
+class vtkImplicitPolyDataDistance::vtkTriangleBVH
+{
+public:
+  struct Node
+  {
+    double Bounds[6];
+    vtkIdType Start; // first triangle of the node
+    vtkIdType Count; // number of triangles of a leaf, zero for inner nodes
+    vtkIdType Child; // index of the first child, the second one follows
+  };
+
+  std::vector<Node> Nodes;
+  std::vector<vtkIdType> CellIds; // cell id of each triangle
+  std::vector<double> Coords;     // nine coordinates per triangle
+  int Depth;                      // number of levels of nodes
+
+  vtkTriangleBVH() : Depth(0) {}
+
+  void Build(vtkPolyData *input);
+  vtkIdType FindClosestPoint(const double x[3], double closest[3],
+                             double &dist2, double weights[3]) const;
+
+private:
+  void BuildNode(vtkIdType nodeId, vtkIdType start, vtkIdType end,
+                 int depth, const std::vector<double> &centers);
+};
+
+namespace
+{
+const vtkIdType VTK_BVH_LEAF_SIZE = 4;
+// Traversals of trees with more levels use a stack on the heap.
+const int VTK_BVH_STACK_SIZE = 128;
+
+// Orders triangle ids by one coordinate of their centers.
+class vtkCenterLess
+{
+public:
+  const double *Centers;
+  int Axis;
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    return this->Centers[3*a+this->Axis] < this->Centers[3*b+this->Axis];
+  }
+};
+
+// Squared distance from x to an axis aligned box.
+inline double vtkBoxDistance2(const double x[3], const double bounds[6])
+{
+  double d2 = 0.0;
+  for ( int i = 0; i < 3; i++ )
+    {
+    double d = ( x[i] < bounds[2*i] ? bounds[2*i] - x[i] :
+                 (x[i] > bounds[2*i+1] ? x[i] - bounds[2*i+1] : 0.0) );
+    d2 += d*d;
+    }
+  return d2;
+}
+
+// Closest point to p on triangle (a,b,c) and its barycentric coordinates
+// (Ericson, Real-Time Collision Detection, 5.1.5). Points in a vertex or
+// edge region get exactly zero weights for the other vertices.
+void vtkClosestPointOnTriangle(const double p[3], const double *a,
+                               const double *b, const double *c,
+                               double closest[3], double w[3])
+{
+  double ab[3], ac[3], ap[3], bp[3], cp[3];
+  for ( int i = 0; i < 3; i++ )
+    {
+    ab[i] = b[i] - a[i];
+    ac[i] = c[i] - a[i];
+    ap[i] = p[i] - a[i];
+    bp[i] = p[i] - b[i];
+    cp[i] = p[i] - c[i];
+    }
+
+  double d1 = vtkMath::Dot(ab, ap);
+  double d2 = vtkMath::Dot(ac, ap);
+  double d3 = vtkMath::Dot(ab, bp);
+  double d4 = vtkMath::Dot(ac, bp);
+  double d5 = vtkMath::Dot(ab, cp);
+  double d6 = vtkMath::Dot(ac, cp);
+  double va = d3*d6 - d5*d4;
+  double vb = d5*d2 - d1*d6;
+  double vc = d1*d4 - d3*d2;
+
+  if ( d1 <= 0.0 && d2 <= 0.0 )
+    {
+    w[0] = 1.0; w[1] = 0.0; w[2] = 0.0;
+    }
+  else if ( d3 >= 0.0 && d4 <= d3 )
+    {
+    w[0] = 0.0; w[1] = 1.0; w[2] = 0.0;
+    }
+  else if ( d6 >= 0.0 && d5 <= d6 )
+    {
+    w[0] = 0.0; w[1] = 0.0; w[2] = 1.0;
+    }
+  else if ( vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 )
+    {
+    double v = d1 / (d1 - d3);
+    w[0] = 1.0 - v; w[1] = v; w[2] = 0.0;
+    }
+  else if ( vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 )
+    {
+    double v = d2 / (d2 - d6);
+    w[0] = 1.0 - v; w[1] = 0.0; w[2] = v;
+    }
+  else if ( va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0 )
+    {
+    double v = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    w[0] = 0.0; w[1] = 1.0 - v; w[2] = v;
+    }
+  else if ( va + vb + vc > 0.0 )
+    {
+    double denom = 1.0 / (va + vb + vc);
+    w[1] = vb * denom;
+    w[2] = vc * denom;
+    w[0] = 1.0 - w[1] - w[2];
+    }
+  else // degenerate triangle
+    {
+    w[0] = 1.0; w[1] = 0.0; w[2] = 0.0;
+    }
+
+  for ( int i = 0; i < 3; i++ )
+    {
+    closest[i] = w[0]*a[i] + w[1]*b[i] + w[2]*c[i];
+    }
+}
+
+// Normal of a triangle of the input, either from the cell normals or
+// computed from its points.
+void vtkGetTriangleNormal(vtkPolyData *input, vtkDataArray *cnorms,
+                          vtkIdType cellId, double n[3])
+{
+  if ( cnorms )
+    {
+    cnorms->GetTuple(cellId, n);
+    return;
+    }
+  vtkIdType npts, *pts;
+  double x0[3], x1[3], x2[3];
+  input->GetCellPoints(cellId, npts, pts);
+  input->GetPoint(pts[0], x0);
+  input->GetPoint(pts[1], x1);
+  input->GetPoint(pts[2], x2);
+  vtkTriangle::ComputeNormal(x0, x1, x2, n);
+}
+}
+
+//-----------------------------------------------------------------------------
+void vtkImplicitPolyDataDistance::vtkTriangleBVH::Build(vtkPolyData *input)
+{
+  this->Nodes.clear();
+  this->CellIds.clear();
+  this->Coords.clear();
+  this->Depth = 0;
+
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType npts, *pts;
+  std::vector<double> centers;
+  centers.reserve(3*numCells);
+  this->CellIds.reserve(numCells);
+  double x[3];
+  for ( vtkIdType cellId = 0; cellId < numCells; cellId++ )
+    {
+    input->GetCellPoints(cellId, npts, pts);
+    if ( npts != 3 )
+      {
+      continue;
+      }
+    double c[3] = {0.0, 0.0, 0.0};
+    for ( int i = 0; i < 3; i++ )
+      {
+      input->GetPoint(pts[i], x);
+      c[0] += x[0]; c[1] += x[1]; c[2] += x[2];
+      }
+    centers.push_back(c[0] / 3.0);
+    centers.push_back(c[1] / 3.0);
+    centers.push_back(c[2] / 3.0);
+    this->CellIds.push_back(cellId);
+    }
+
+  vtkIdType numTris = static_cast<vtkIdType>(this->CellIds.size());
+  if ( numTris == 0 )
+    {
+    return;
+    }
+
+  // Sort the triangles through an index list, then gather the cell ids and
+  // coordinates in tree order.
+  std::vector<vtkIdType> cellIds;
+  cellIds.swap(this->CellIds);
+  this->CellIds.resize(numTris);
+  for ( vtkIdType i = 0; i < numTris; i++ )
+    {
+    this->CellIds[i] = i;
+    }
+  this->Nodes.reserve(2*(numTris/VTK_BVH_LEAF_SIZE) + 2);
+  this->Nodes.push_back(Node());
+  this->BuildNode(0, 0, numTris, 1, centers);
+
+  this->Coords.resize(9*numTris);
+  for ( vtkIdType i = 0; i < numTris; i++ )
+    {
+    this->CellIds[i] = cellIds[this->CellIds[i]];
+    input->GetCellPoints(this->CellIds[i], npts, pts);
+    for ( int j = 0; j < 3; j++ )
+      {
+      input->GetPoint(pts[j], &this->Coords[9*i+3*j]);
+      }
+    }
+
+  // Now that the triangles are in place, compute the node bounds bottom
+  // up (children always follow their parent).
+  for ( vtkIdType nodeId = static_cast<vtkIdType>(this->Nodes.size()) - 1;
+        nodeId >= 0; nodeId-- )
+    {
+    Node &node = this->Nodes[nodeId];
+    double *b = node.Bounds;
+    if ( node.Count > 0 )
+      {
+      b[0] = b[2] = b[4] = VTK_DOUBLE_MAX;
+      b[1] = b[3] = b[5] = -VTK_DOUBLE_MAX;
+      const double *p = &this->Coords[9*node.Start];
+      for ( vtkIdType k = 0; k < 3*node.Count; k++, p += 3 )
+        {
+        for ( int i = 0; i < 3; i++ )
+          {
+          b[2*i] = ( p[i] < b[2*i] ? p[i] : b[2*i] );
+          b[2*i+1] = ( p[i] > b[2*i+1] ? p[i] : b[2*i+1] );
+          }
+        }
+      }
+    else
+      {
+      const double *b1 = this->Nodes[node.Child].Bounds;
+      const double *b2 = this->Nodes[node.Child+1].Bounds;
+      for ( int i = 0; i < 3; i++ )
+        {
+        b[2*i] = ( b1[2*i] < b2[2*i] ? b1[2*i] : b2[2*i] );
+        b[2*i+1] = ( b1[2*i+1] > b2[2*i+1] ? b1[2*i+1] : b2[2*i+1] );
+        }
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkImplicitPolyDataDistance::vtkTriangleBVH::BuildNode(
+  vtkIdType nodeId, vtkIdType start, vtkIdType end, int depth,
+  const std::vector<double> &centers)
+{
+  this->Depth = ( depth > this->Depth ? depth : this->Depth );
+  this->Nodes[nodeId].Start = start;
+  if ( end - start <= VTK_BVH_LEAF_SIZE )
+    {
+    this->Nodes[nodeId].Count = end - start;
+    this->Nodes[nodeId].Child = -1;
+    return;
+    }
+
+  // Split along the longest extent of the triangle centers
+  double cmin[3] = {VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX};
+  double cmax[3] = {-VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX};
+  vtkIdType i;
+  for ( i = start; i < end; i++ )
+    {
+    const double *c = &centers[3*this->CellIds[i]];
+    for ( int j = 0; j < 3; j++ )
+      {
+      cmin[j] = ( c[j] < cmin[j] ? c[j] : cmin[j] );
+      cmax[j] = ( c[j] > cmax[j] ? c[j] : cmax[j] );
+      }
+    }
+  vtkCenterLess less;
+  less.Centers = &centers[0];
+  less.Axis = 0;
+  for ( int j = 1; j < 3; j++ )
+    {
+    if ( cmax[j] - cmin[j] > cmax[less.Axis] - cmin[less.Axis] )
+      {
+      less.Axis = j;
+      }
+    }
+  vtkIdType mid = start + (end - start) / 2;
+  std::nth_element(this->CellIds.begin() + start, this->CellIds.begin() + mid,
+                   this->CellIds.begin() + end, less);
+
+  vtkIdType child = static_cast<vtkIdType>(this->Nodes.size());
+  this->Nodes[nodeId].Count = 0;
+  this->Nodes[nodeId].Child = child;
+  this->Nodes.push_back(Node());
+  this->Nodes.push_back(Node());
+  this->BuildNode(child, start, mid, depth+1, centers);
+  this->BuildNode(child+1, mid, end, depth+1, centers);
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkImplicitPolyDataDistance::vtkTriangleBVH::FindClosestPoint(
+  const double x[3], double closest[3], double &dist2, double weights[3]) const
+{
+  vtkIdType cellId = -1;
+  dist2 = VTK_DOUBLE_MAX;
+  if ( this->Nodes.empty() )
+    {
+    return cellId;
+    }
+
+  // Each level leaves at most one sibling on the stack.
+  vtkIdType localStack[VTK_BVH_STACK_SIZE];
+  std::vector<vtkIdType> heapStack;
+  vtkIdType *stack = localStack;
+  if ( this->Depth + 1 > VTK_BVH_STACK_SIZE )
+    {
+    heapStack.resize(this->Depth + 1);
+    stack = &heapStack[0];
+    }
+  int top = 0;
+  stack[top++] = 0;
+  double p[3], w[3], d2;
+  while ( top > 0 )
+    {
+    const Node &node = this->Nodes[stack[--top]];
+    if ( vtkBoxDistance2(x, node.Bounds) >= dist2 )
+      {
+      continue;
+      }
+
+    if ( node.Count > 0 )
+      {
+      for ( vtkIdType t = node.Start; t < node.Start + node.Count; t++ )
+        {
+        const double *tri = &this->Coords[9*t];
+        vtkClosestPointOnTriangle(x, tri, tri+3, tri+6, p, w);
+        d2 = vtkMath::Distance2BetweenPoints(x, p);
+        if ( d2 < dist2 )
+          {
+          dist2 = d2;
+          cellId = this->CellIds[t];
+          closest[0] = p[0]; closest[1] = p[1]; closest[2] = p[2];
+          weights[0] = w[0]; weights[1] = w[1]; weights[2] = w[2];
+          }
+        }
+      }
+    else
+      {
+      // Visit the nearest child first
+      vtkIdType first = node.Child, second = node.Child + 1;
+      if ( vtkBoxDistance2(x, this->Nodes[second].Bounds) <
+           vtkBoxDistance2(x, this->Nodes[first].Bounds) )
+        {
+        std::swap(first, second);
+        }
+      stack[top++] = second;
+      stack[top++] = first;
+      }
+    }
+
+  return cellId;
+}
+
 //-----------------------------------------------------------------------------
 vtkImplicitPolyDataDistance::vtkImplicitPolyDataDistance()
 {
@@ -36,7 +404,7 @@ vtkImplicitPolyDataDistance::vtkImplicitPolyDataDistance()
   this->NoGradient[2] = 1.0;
 
   this->Input = NULL;
-  this->Locator = NULL;
+  this->Tree = new vtkTriangleBVH;
   this->Tolerance = 1e-12;
 }
 
@@ -56,22 +424,18 @@ void vtkImplicitPolyDataDistance::SetInput(vtkPolyData* input)
     triangleFilter->SetInputData( input );
     triangleFilter->Update();
 
+    if ( this->Input != NULL )
+      {
+      this->Input->UnRegister(this);
+      }
     this->Input = triangleFilter->GetOutput();
+    this->Input->Register(this);
 
     this->Input->BuildLinks();
     this->NoValue = this->Input->GetLength();
 
-    if (this->Locator != NULL)
-      {
-      this->Locator->Delete();
-      }
-    this->Locator = vtkCellLocator::New();
-    this->Locator->SetDataSet(this->Input);
-    this->Locator->SetTolerance(this->Tolerance);
-    this->Locator->SetNumberOfCellsPerBucket(10);
-    this->Locator->CacheCellBoundsOn();
-    this->Locator->AutomaticOn();
-    this->Locator->BuildLocator();
+    this->Tree->Build(this->Input);
+    this->Modified();
     }
 }
 
@@ -93,10 +457,11 @@ unsigned long vtkImplicitPolyDataDistance::GetMTime()
 //-----------------------------------------------------------------------------
 vtkImplicitPolyDataDistance::~vtkImplicitPolyDataDistance()
 {
-  if (this->Locator != NULL)
+  if (this->Input != NULL)
     {
-    this->Locator->Delete();
+    this->Input->UnRegister(this);
     }
+  delete this->Tree;
 }
 
 //-----------------------------------------------------------------------------
@@ -130,7 +495,6 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double n[3])
 
   double p[3];
   vtkIdType cellId;
-  int subId;
   double vlen2;
 
   vtkDataArray* cnorms = 0;
@@ -139,10 +503,10 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double n[3])
     cnorms = this->Input->GetCellData()->GetNormals();
     }
 
-  // Get point id of closest point in data set.
-  vtkSmartPointer<vtkGenericCell> cell =
-    vtkSmartPointer<vtkGenericCell>::New();
-  this->Locator->FindClosestPoint(x, p, cell, cellId, subId, vlen2);
+  // Get closest point on the surface and the barycentric weights of the
+  // closest triangle.
+  double weights[3];
+  cellId = this->Tree->FindClosestPoint(x, p, vlen2, weights);
 
   if (cellId != -1)	// point located
     {
@@ -154,9 +518,9 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double n[3])
       n[i] = (p[i] - x[i]) / (ret == 0. ? 1. : ret);
       }
 
-    double dist2, weights[3], pcoords[3], awnorm[3] = {0, 0, 0};
-    double closestPoint[3];
-    cell->EvaluatePosition(p, closestPoint, subId, pcoords, dist2, weights);
+    double awnorm[3] = {0, 0, 0};
+    vtkIdType npts, *cellPts;
+    this->Input->GetCellPoints(cellId, npts, cellPts);
 
     vtkIdList* idList = vtkIdList::New();
     int count = 0;
@@ -170,27 +534,20 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double n[3])
       // Compute face normal.
       // For count == 0, this is all we need.
       // For count = 1, we'll add in the normals from adjacent faces.
-      if ( cnorms )
-        {
-        cnorms->GetTuple(cellId, awnorm);
-        }
-      else
-        {
-        vtkPolygon::ComputeNormal(cell->Points, awnorm);
-        }
+      vtkGetTriangleNormal(this->Input, cnorms, cellId, awnorm);
       }
 
     // if weights contains 1 0s
     if ( count == 1 )
       {
       // ... edge ... get two adjacent faces, compute average normal
-      int a = -1, b = -1;
+      vtkIdType a = -1, b = -1;
       for ( int edge = 0; edge < 3; edge++ )
         {
         if ( fabs(weights[edge]) < this->Tolerance )
           {
-          a = cell->PointIds->GetId((edge + 1) % 3);
-          b = cell->PointIds->GetId((edge + 2) % 3);
+          a = cellPts[(edge + 1) % 3];
+          b = cellPts[(edge + 2) % 3];
           break;
           }
         }
@@ -199,6 +556,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double n[3])
         {
         vtkErrorMacro( << "Could not find edge when closest point is "
                        << "expected to be on an edge." );
+        idList->Delete();
         return this->NoValue;
         }
 
@@ -206,14 +564,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double n[3])
       for (int i = 0; i < idList->GetNumberOfIds(); i++)
         {
         double norm[3];
-        if (cnorms)
-          {
-          cnorms->GetTuple(idList->GetId(i), norm);
-          }
-        else
-          {
-          vtkPolygon::ComputeNormal(this->Input->GetCell(idList->GetId(i))->GetPoints(), norm);
-          }
+        vtkGetTriangleNormal(this->Input, cnorms, idList->GetId(i), norm);
         awnorm[0] += norm[0];
         awnorm[1] += norm[1];
         awnorm[2] += norm[2];
@@ -227,12 +578,12 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double n[3])
       // ... vertex ... this is the expensive case, get all adjacent
       // faces and compute sum(a_i * n_i) Angle-Weighted Pseudo
       // Normals, J. Andreas Baerentzen and Henrik Aanaes
-      int a = -1;
+      vtkIdType a = -1;
       for (int i = 0; i < 3; i++)
         {
         if ( fabs( weights[i] ) > this->Tolerance )
           {
-          a = cell->PointIds->GetId(i);
+          a = cellPts[i];
           }
         }
 
@@ -240,6 +591,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double n[3])
         {
         vtkErrorMacro( << "Could not find point when closest point is "
                        << "expected to be a point." );
+        idList->Delete();
         return this->NoValue;
         }
 
@@ -247,25 +599,20 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double n[3])
       for (int i = 0; i < idList->GetNumberOfIds(); i++)
         {
         double norm[3];
-        if ( cnorms )
-          {
-          cnorms->GetTuple(idList->GetId(i), norm);
-          }
-        else
-          {
-          vtkPolygon::ComputeNormal(this->Input->GetCell(idList->GetId(i))->GetPoints(), norm);
-          }
+        vtkGetTriangleNormal(this->Input, cnorms, idList->GetId(i), norm);
 
         // Compute angle at point a
-        int b = this->Input->GetCell(idList->GetId(i))->GetPointId(0);
-        int c = this->Input->GetCell(idList->GetId(i))->GetPointId(1);
+        vtkIdType *nbrPts;
+        this->Input->GetCellPoints(idList->GetId(i), npts, nbrPts);
+        vtkIdType b = nbrPts[0];
+        vtkIdType c = nbrPts[1];
         if (a == b)
           {
-          b = this->Input->GetCell(idList->GetId(i))->GetPointId(2);
+          b = nbrPts[2];
           }
         else if (a == c)
           {
-          c = this->Input->GetCell(idList->GetId(i))->GetPointId(2);
+          c = nbrPts[2];
           }
         double pa[3], pb[3], pc[3];
         this->Input->GetPoint(a, pa);
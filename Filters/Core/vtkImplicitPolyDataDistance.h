@@ -24,6 +24,12 @@
 // vtkPolyData have a distance of zero. The gradient of the function
 // is the angle-weighted pseudonormal at the nearest point.
 //
+// The closest point is found with a bounding volume hierarchy of the
+// input triangles that is built once by SetInput(). Evaluation does not
+// modify the object, so the function may be evaluated concurrently from
+// several threads (see vtkImplicitFunction::IsThreadSafe()); filters such
+// as vtkSampleFunction take advantage of this.
+//
 // Baerentzen, J. A. and Aanaes, H. (2005). Signed distance
 // computation using the angle weighted pseudonormal. IEEE
 // Transactions on Visualization and Computer Graphics, 11:243-253.
@@ -40,7 +46,6 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkImplicitFunction.h"
 
-class vtkCellLocator;
 class vtkPolyData;
 
 class VTKFILTERSCORE_EXPORT vtkImplicitPolyDataDistance : public vtkImplicitFunction
@@ -62,6 +67,11 @@ public:
   // Evaluate function gradient of nearest triangle to point x[3].
   void EvaluateGradient(double x[3], double g[3]);
 
+  // Description:
+  // Evaluation only reads the input and its bounding volume hierarchy,
+  // so it is thread safe.
+  bool IsThreadSafe() { return true; }
+
   // Description:
   // Set the input vtkPolyData used for the implicit function
   // evaluation.  Passes input through an internal instance of
@@ -82,7 +92,8 @@ public:
   vtkGetVector3Macro(NoGradient, double);
 
   // Description:
-  // Set/get the tolerance usued for the locator.
+  // Set/get the tolerance used to decide whether the closest point lies
+  // on an edge or a vertex of the closest triangle.
   vtkGetMacro(Tolerance, double);
   vtkSetMacro(Tolerance, double);
 
@@ -101,7 +112,11 @@ private:
   double Tolerance;
 
   vtkPolyData       *Input;
-  vtkCellLocator    *Locator;
+
+//BTX
+  class vtkTriangleBVH;
+  vtkTriangleBVH *Tree;
+//ETX
 
 };
 
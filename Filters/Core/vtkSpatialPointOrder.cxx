@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpatialPointOrder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpatialPointOrder.h"
+
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Bits per coordinate of the Hilbert curve, and the position of the round
+// number in the sort key above the Hilbert index.
+const int VTK_HILBERT_BITS = 16;
+const int VTK_ROUND_SHIFT = 3*VTK_HILBERT_BITS;
+
+// Smallest number of points in the first insertion round.
+const vtkIdType VTK_BRIO_MIN_ROUND_SIZE = 64;
+
+typedef std::pair<vtkTypeUInt64, vtkIdType> vtkSortKey;
+
+// Deterministic scrambling of a point id (a 32 bit integer mixer).
+inline unsigned int vtkHashId(vtkIdType id)
+{
+  unsigned int h = static_cast<unsigned int>(id);
+  h ^= h >> 16;
+  h *= 0x85ebca6bU;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35U;
+  h ^= h >> 16;
+  return h;
+}
+
+// Computes the sort key of a range of points.
+class vtkComputeKeys
+{
+public:
+  vtkPoints *Points;
+  int Dimension;
+  int NumberOfRounds;
+  double Origin[3];
+  double Scale[3];
+  vtkSortKey *Keys;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId) const
+  {
+    double x[3];
+    unsigned int ix[3];
+    const double maxCoord = static_cast<double>((1 << VTK_HILBERT_BITS) - 1);
+
+    for ( ; ptId < endPtId; ++ptId )
+      {
+      this->Points->GetPoint(ptId, x);
+      for ( int i = 0; i < 3; ++i )
+        {
+        double c = (x[i] - this->Origin[i]) * this->Scale[i];
+        c = ( c < 0.0 ? 0.0 : (c > maxCoord ? maxCoord : c) );
+        ix[i] = static_cast<unsigned int>(c);
+        }
+
+      // A point belongs to round r (counted from the last, largest round)
+      // with probability 2^-(r+1); the smallest rounds are inserted first.
+      unsigned int h = vtkHashId(ptId);
+      int level = 0;
+      while ( level < this->NumberOfRounds - 1 && (h & 1) )
+        {
+        h >>= 1;
+        ++level;
+        }
+      vtkTypeUInt64 round =
+        static_cast<vtkTypeUInt64>(this->NumberOfRounds - 1 - level);
+
+      this->Keys[ptId].first = (round << VTK_ROUND_SHIFT) |
+        vtkSpatialPointOrder::HilbertIndex(ix, this->Dimension,
+                                           VTK_HILBERT_BITS);
+      this->Keys[ptId].second = ptId;
+      }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+// Skilling's transposed Hilbert curve construction ("Programming the
+// Hilbert curve", AIP Conf. Proc. 707, 2004), followed by interleaving of
+// the transposed bits into a single index.
+vtkTypeUInt64 vtkSpatialPointOrder::HilbertIndex(unsigned int x[3], int dim,
+                                                 int bits)
+{
+  unsigned int X[3] = {x[0], x[1], x[2]};
+  unsigned int M = 1U << (bits - 1);
+  unsigned int P, Q, t;
+  int i;
+
+  // Inverse undo
+  for ( Q = M; Q > 1; Q >>= 1 )
+    {
+    P = Q - 1;
+    for ( i = 0; i < dim; ++i )
+      {
+      if ( X[i] & Q )
+        {
+        X[0] ^= P;
+        }
+      else
+        {
+        t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+        }
+      }
+    }
+
+  // Gray encode
+  for ( i = 1; i < dim; ++i )
+    {
+    X[i] ^= X[i-1];
+    }
+  t = 0;
+  for ( Q = M; Q > 1; Q >>= 1 )
+    {
+    if ( X[dim-1] & Q )
+      {
+      t ^= Q - 1;
+      }
+    }
+  for ( i = 0; i < dim; ++i )
+    {
+    X[i] ^= t;
+    }
+
+  vtkTypeUInt64 index = 0;
+  for ( int b = bits - 1; b >= 0; --b )
+    {
+    for ( i = 0; i < dim; ++i )
+      {
+      index = (index << 1) | ((X[i] >> b) & 1U);
+      }
+    }
+  return index;
+}
+
+//----------------------------------------------------------------------------
+void vtkSpatialPointOrder::ComputeBRIO(vtkPoints *pts, int dim,
+                                       vtkIdType *order)
+{
+  vtkIdType numPts = pts->GetNumberOfPoints();
+  if ( numPts < 1 )
+    {
+    return;
+    }
+  dim = ( dim < 2 ? 2 : (dim > 3 ? 3 : dim) );
+
+  vtkComputeKeys op;
+  op.Points = pts;
+  op.Dimension = dim;
+
+  // Quantize the bounding box, keeping its aspect ratio so the curve
+  // follows the actual point distribution.
+  double bounds[6];
+  pts->GetBounds(bounds);
+  double length = 0.0;
+  int i;
+  for ( i = 0; i < dim; ++i )
+    {
+    double l = bounds[2*i+1] - bounds[2*i];
+    length = ( l > length ? l : length );
+    }
+  double scale = ( length > 0.0 ?
+                   ((1 << VTK_HILBERT_BITS) - 1) / length : 0.0 );
+  for ( i = 0; i < 3; ++i )
+    {
+    op.Origin[i] = bounds[2*i];
+    op.Scale[i] = ( i < dim ? scale : 0.0 );
+    }
+
+  int numRounds = 1;
+  while ( numRounds < 15 && (numPts >> numRounds) >= VTK_BRIO_MIN_ROUND_SIZE )
+    {
+    ++numRounds;
+    }
+  op.NumberOfRounds = numRounds;
+
+  std::vector<vtkSortKey> keys(numPts);
+  op.Keys = &keys[0];
+  vtkSMPTools::For(0, numPts, op);
+
+  std::sort(keys.begin(), keys.end());
+
+  for ( vtkIdType ptId = 0; ptId < numPts; ++ptId )
+    {
+    order[ptId] = keys[ptId].second;
+    }
+}
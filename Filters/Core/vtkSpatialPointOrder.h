@@ -0,0 +1,49 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpatialPointOrder.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSpatialPointOrder - A utility class ordering points for insertion
+// .SECTION Description
+//  This is a simple utility class used by the incremental Delaunay filters
+//  to compute a biased randomized insertion order (BRIO) of their points.
+//  Points are assigned to rounds of geometrically increasing size using a
+//  deterministic hash of their id, and the points of each round are sorted
+//  along a Hilbert curve. Consecutive insertions are then spatially close,
+//  which keeps point location walks short, while the randomization of the
+//  rounds preserves the expected complexity of randomized insertion.
+// .SECTION See Also
+// vtkDelaunay2D vtkDelaunay3D
+
+#ifndef __vtkSpatialPointOrder_h
+#define __vtkSpatialPointOrder_h
+
+#include "vtkType.h" // for vtkIdType
+
+class vtkPoints;
+
+class vtkSpatialPointOrder
+{
+public:
+  // Fill order, which must hold pts->GetNumberOfPoints() entries, with the
+  // point ids in biased randomized insertion order. Only the first dim
+  // (2 or 3) coordinates of the points are considered. The sort keys are
+  // computed in parallel with vtkSMPTools.
+  static void ComputeBRIO(vtkPoints *pts, int dim, vtkIdType *order);
+
+  // Return the index of the integer coordinates x (each using bits bits)
+  // along a dim dimensional Hilbert curve.
+  static vtkTypeUInt64 HilbertIndex(unsigned int x[3], int dim, int bits);
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSpatialPointOrder.h
@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMemoryLimitDataSetStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that vtkMemoryLimitDataSetStreamer splits its input
+// into pieces that fit the memory limit and combines them into the same
+// cells as an unstreamed update, for polygonal and unstructured inputs.
+
+#include "vtkAppendFilter.h"
+#include "vtkMemoryLimitDataSetStreamer.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+int TestMemoryLimitDataSetStreamer(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(256);
+  sphere->SetPhiResolution(256);
+  sphere->Update();
+  vtkIdType numberOfCells = sphere->GetOutput()->GetNumberOfCells();
+  unsigned long size = sphere->GetOutput()->GetActualMemorySize();
+
+  int success = 1;
+
+  // Polygonal input.
+  vtkNew<vtkMemoryLimitDataSetStreamer> streamer;
+  streamer->SetInputConnection(sphere->GetOutputPort());
+  streamer->SetMemoryLimit(size / 8);
+  streamer->Update();
+  vtkPolyData* output = vtkPolyData::SafeDownCast(streamer->GetOutput());
+  if (!output)
+    {
+    cerr << "Expected a vtkPolyData output" << endl;
+    return TEST_FAILURE;
+    }
+  if (streamer->GetNumberOfPieces() < 8)
+    {
+    cerr << "Expected at least 8 pieces, got "
+         << streamer->GetNumberOfPieces() << endl;
+    success = 0;
+    }
+  if (output->GetNumberOfCells() != numberOfCells)
+    {
+    cerr << "Expected " << numberOfCells << " cells, got "
+         << output->GetNumberOfCells() << endl;
+    success = 0;
+    }
+
+  // The next update starts with the number of pieces found by probing.
+  int numberOfPieces = streamer->GetNumberOfPieces();
+  sphere->SetCenter(1.0, 0.0, 0.0);
+  streamer->Update();
+  if (streamer->GetNumberOfPieces() != numberOfPieces ||
+      streamer->GetOutput()->GetNumberOfCells() != numberOfCells)
+    {
+    cerr << "Second update differs: " << streamer->GetNumberOfPieces()
+         << " pieces, " << streamer->GetOutput()->GetNumberOfCells()
+         << " cells" << endl;
+    success = 0;
+    }
+
+  // No splitting when the input fits.
+  vtkNew<vtkMemoryLimitDataSetStreamer> unsplit;
+  unsplit->SetInputConnection(sphere->GetOutputPort());
+  unsplit->SetMemoryLimit(2 * size);
+  unsplit->Update();
+  if (unsplit->GetNumberOfPieces() != 1 ||
+      unsplit->GetOutput()->GetNumberOfCells() != numberOfCells)
+    {
+    cerr << "Unsplit update differs: " << unsplit->GetNumberOfPieces()
+         << " pieces, " << unsplit->GetOutput()->GetNumberOfCells()
+         << " cells" << endl;
+    success = 0;
+    }
+
+  // Unstructured input.
+  vtkNew<vtkAppendFilter> toGrid;
+  toGrid->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkMemoryLimitDataSetStreamer> gridStreamer;
+  gridStreamer->SetInputConnection(toGrid->GetOutputPort());
+  gridStreamer->SetMemoryLimit(size / 8);
+  gridStreamer->SetMaximumNumberOfPieces(4);
+  gridStreamer->Update();
+  vtkUnstructuredGrid* grid =
+    vtkUnstructuredGrid::SafeDownCast(gridStreamer->GetOutput());
+  if (!grid)
+    {
+    cerr << "Expected a vtkUnstructuredGrid output" << endl;
+    return TEST_FAILURE;
+    }
+  if (gridStreamer->GetNumberOfPieces() != 4 ||
+      grid->GetNumberOfCells() != numberOfCells)
+    {
+    cerr << "Unstructured update differs: "
+         << gridStreamer->GetNumberOfPieces() << " pieces, "
+         << grid->GetNumberOfCells() << " cells" << endl;
+    success = 0;
+    }
+
+  return success ? TEST_SUCCESS : TEST_FAILURE;
+}
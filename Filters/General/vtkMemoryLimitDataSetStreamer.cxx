@@ -0,0 +1,356 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryLimitDataSetStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryLimitDataSetStreamer.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkDataSet.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkMemoryLimitDataSetStreamer);
+
+//----------------------------------------------------------------------------
+// Partial results of the current update. Each partial result has a level:
+// pieces enter at level 0 and two partial results of the same level are
+// appended into one of the next level, so every piece is copied a
+// logarithmic number of times.
+class vtkMemoryLimitDataSetStreamerInternals
+{
+public:
+  std::vector<vtkSmartPointer<vtkDataSet> > Partials;
+  std::vector<int> Levels;
+};
+
+namespace
+{
+// Appends datasets into a new vtkPolyData or vtkUnstructuredGrid.
+vtkDataSet* vtkMemoryLimitDataSetStreamerAppend(vtkDataSet** inputs,
+                                                size_t numInputs,
+                                                bool polyData)
+{
+  vtkDataSet* output;
+  size_t i;
+  if (polyData)
+    {
+    vtkAppendPolyData* append = vtkAppendPolyData::New();
+    for (i = 0; i < numInputs; ++i)
+      {
+      append->AddInputData(vtkPolyData::SafeDownCast(inputs[i]));
+      }
+    append->Update();
+    output = vtkPolyData::New();
+    output->ShallowCopy(append->GetOutput());
+    append->Delete();
+    }
+  else
+    {
+    vtkAppendFilter* append = vtkAppendFilter::New();
+    for (i = 0; i < numInputs; ++i)
+      {
+      append->AddInputData(inputs[i]);
+      }
+    append->Update();
+    output = vtkUnstructuredGrid::New();
+    output->ShallowCopy(append->GetOutput());
+    append->Delete();
+    }
+  return output;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryLimitDataSetStreamer::vtkMemoryLimitDataSetStreamer()
+{
+  this->SetNumberOfInputPorts(1);
+  this->SetNumberOfOutputPorts(1);
+
+  // Set a default memory limit of 50 Megabytes
+  this->MemoryLimit = 50000;
+  this->InitialNumberOfPieces = 1;
+  this->MaximumNumberOfPieces = 1024;
+  this->NumberOfPieces = 0;
+  this->ProbedSize = 0;
+  this->Internals = new vtkMemoryLimitDataSetStreamerInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryLimitDataSetStreamer::~vtkMemoryLimitDataSetStreamer()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+vtkDataSet* vtkMemoryLimitDataSetStreamer::GetOutput()
+{
+  return this->GetOutput(0);
+}
+
+//----------------------------------------------------------------------------
+vtkDataSet* vtkMemoryLimitDataSetStreamer::GetOutput(int port)
+{
+  return vtkDataSet::SafeDownCast(this->GetOutputDataObject(port));
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::ProcessRequest(
+  vtkInformation* request,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  if(request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+    {
+    return this->RequestDataObject(request, inputVector, outputVector);
+    }
+
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::RequestDataObject(
+  vtkInformation*,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  vtkDataSet* input = vtkDataSet::GetData(inputVector[0]);
+  if (!input)
+    {
+    return 0;
+    }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (vtkPolyData::SafeDownCast(input))
+    {
+    if (!vtkPolyData::SafeDownCast(output))
+      {
+      output = vtkPolyData::New();
+      outInfo->Set(vtkDataObject::DATA_OBJECT(), output);
+      output->Delete();
+      }
+    }
+  else if (!vtkUnstructuredGrid::SafeDownCast(output))
+    {
+    output = vtkUnstructuredGrid::New();
+    outInfo->Set(vtkDataObject::DATA_OBJECT(), output);
+    output->Delete();
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::RequestUpdateExtent(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // At the start of an update, start probing from the number of pieces
+  // chosen by the previous update.
+  if (this->CurrentIndex == 0 && this->ProbedSize == 0)
+    {
+    int numPieces = this->NumberOfPieces > this->InitialNumberOfPieces ?
+      this->NumberOfPieces : this->InitialNumberOfPieces;
+    numPieces = numPieces < this->MaximumNumberOfPieces ?
+      numPieces : this->MaximumNumberOfPieces;
+    this->NumberOfPasses = static_cast<unsigned int>(numPieces);
+    }
+
+  // get the info object
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  int outPiece = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  int outNumPieces = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  int outGhostLevels = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+              outPiece * this->NumberOfPasses + this->CurrentIndex);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+              outNumPieces * this->NumberOfPasses);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(),
+              outGhostLevels);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkDataSet* input = vtkDataSet::GetData(inputVector[0]);
+
+  // A new update must not see the state of one that failed.
+  if (this->CurrentIndex == 0 &&
+      !request->Get(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING()))
+    {
+    this->ResetPasses();
+    }
+
+  // While probing, split the input further if its first piece does not
+  // fit, as long as splitting makes the pieces noticeably smaller.
+  if (this->CurrentIndex == 0 && this->MemoryLimit > 0 && input)
+    {
+    unsigned long size = input->GetActualMemorySize();
+    int numPieces = static_cast<int>(this->NumberOfPasses);
+    if (size > this->MemoryLimit &&
+        numPieces < this->MaximumNumberOfPieces &&
+        (this->ProbedSize == 0 || size < 0.8 * this->ProbedSize))
+      {
+      double ratio = static_cast<double>(size) / this->MemoryLimit;
+      double newNumPieces = ceil(numPieces * ratio);
+      if (newNumPieces > this->MaximumNumberOfPieces)
+        {
+        newNumPieces = this->MaximumNumberOfPieces;
+        }
+      vtkDebugMacro(<< "Piece of " << size << " KiB with " << numPieces
+                    << " pieces, trying " << newNumPieces << " pieces");
+      this->ProbedSize = size;
+      this->NumberOfPasses = static_cast<unsigned int>(newNumPieces);
+      request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+      return 1;
+      }
+    this->ProbedSize = 0;
+    }
+
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::ExecutePass(
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkDataSet* input = vtkDataSet::GetData(inputVector[0]);
+  if (!input)
+    {
+    this->ResetPasses();
+    this->CurrentIndex = 0;
+    return 0;
+    }
+  if (input->GetNumberOfPoints() == 0 && input->GetNumberOfCells() == 0)
+    {
+    return 1;
+    }
+
+  vtkDataSet* piece = input->NewInstance();
+  piece->ShallowCopy(input);
+  this->Internals->Partials.push_back(piece);
+  this->Internals->Levels.push_back(0);
+  piece->Delete();
+
+  // Append partial results of the same level.
+  bool polyData = vtkPolyData::GetData(outputVector) != 0;
+  std::vector<vtkSmartPointer<vtkDataSet> >& partials =
+    this->Internals->Partials;
+  std::vector<int>& levels = this->Internals->Levels;
+  size_t n = partials.size();
+  while (n >= 2 && levels[n - 1] == levels[n - 2])
+    {
+    vtkDataSet* inputs[2] = { partials[n - 2], partials[n - 1] };
+    vtkDataSet* merged =
+      vtkMemoryLimitDataSetStreamerAppend(inputs, 2, polyData);
+    partials[n - 2] = merged;
+    merged->Delete();
+    levels[n - 2]++;
+    partials.pop_back();
+    levels.pop_back();
+    --n;
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::PostExecute(
+  vtkInformationVector **vtkNotUsed(inputVector),
+  vtkInformationVector *outputVector)
+{
+  vtkDataSet* output = vtkDataSet::GetData(outputVector);
+  std::vector<vtkSmartPointer<vtkDataSet> >& partials =
+    this->Internals->Partials;
+
+  if (partials.empty())
+    {
+    output->Initialize();
+    }
+  else if (partials.size() == 1 && partials[0]->IsA(output->GetClassName()))
+    {
+    output->ShallowCopy(partials[0]);
+    }
+  else
+    {
+    std::vector<vtkDataSet*> inputs(partials.begin(), partials.end());
+    vtkDataSet* merged = vtkMemoryLimitDataSetStreamerAppend(
+      &inputs[0], inputs.size(), vtkPolyData::SafeDownCast(output) != 0);
+    output->ShallowCopy(merged);
+    merged->Delete();
+    }
+
+  partials.clear();
+  this->Internals->Levels.clear();
+  this->NumberOfPieces = static_cast<int>(this->NumberOfPasses);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryLimitDataSetStreamer::ResetPasses()
+{
+  this->Internals->Partials.clear();
+  this->Internals->Levels.clear();
+  this->ProbedSize = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryLimitDataSetStreamer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "MemoryLimit (in kb): " << this->MemoryLimit << endl;
+  os << indent << "InitialNumberOfPieces: "
+     << this->InitialNumberOfPieces << endl;
+  os << indent << "MaximumNumberOfPieces: "
+     << this->MaximumNumberOfPieces << endl;
+  os << indent << "NumberOfPieces: " << this->NumberOfPieces << endl;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::FillOutputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataSet");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+  return 1;
+}
@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryLimitDataSetStreamer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMemoryLimitDataSetStreamer - Streams any dataset pipeline in pieces that fit in memory.
+// .SECTION Description
+// vtkMemoryLimitDataSetStreamer initiates streaming by requesting pieces
+// (UPDATE_PIECE_NUMBER / UPDATE_NUMBER_OF_PIECES) from its input and
+// combining them into its output. Unlike vtkPolyDataStreamer, the number
+// of pieces is chosen automatically so that the input of each pass, which
+// is the largest piece the upstream pipeline produces at once, stays
+// under MemoryLimit.
+//
+// The number of pieces is found by probing: the first piece is requested
+// with InitialNumberOfPieces divisions, and if its actual memory size
+// exceeds MemoryLimit the pipeline is split further, proportionally to
+// the excess, and the first piece is requested again. Probing stops when
+// the piece fits, when MaximumNumberOfPieces is reached, or when
+// splitting no longer reduces the size of the piece by at least 20%
+// (for instance when a reader cannot split its data). Subsequent updates
+// start from the number of pieces chosen by the previous one.
+//
+// Pieces are combined incrementally: pieces of similar size are appended
+// together as they arrive, so the output is built with few copies.
+// Polygonal inputs are combined with vtkAppendPolyData into a vtkPolyData
+// output; other datasets are combined with vtkAppendFilter into a
+// vtkUnstructuredGrid output.
+//
+// .SECTION Caveats
+// MemoryLimit bounds the size of one piece, not the size of the output,
+// which holds the whole dataset. Points shared by several pieces are
+// duplicated in the output.
+//
+// .SECTION See Also
+// vtkPolyDataStreamer vtkMemoryLimitImageDataStreamer vtkStreamerBase
+
+#ifndef __vtkMemoryLimitDataSetStreamer_h
+#define __vtkMemoryLimitDataSetStreamer_h
+
+#include "vtkFiltersGeneralModule.h" // For export macro
+#include "vtkStreamerBase.h"
+
+class vtkDataSet;
+class vtkMemoryLimitDataSetStreamerInternals;
+
+class VTKFILTERSGENERAL_EXPORT vtkMemoryLimitDataSetStreamer : public vtkStreamerBase
+{
+public:
+  static vtkMemoryLimitDataSetStreamer *New();
+  vtkTypeMacro(vtkMemoryLimitDataSetStreamer,vtkStreamerBase);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Maximum size, in kibibytes, of a piece. The default is 50000 (about
+  // 50 megabytes).
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
+  // Description:
+  // Number of pieces the first update starts probing with. Setting it
+  // to a lower bound of the final count avoids executing the upstream
+  // pipeline on pieces that are too large. The default is 1.
+  vtkSetClampMacro(InitialNumberOfPieces, int, 1, VTK_INT_MAX);
+  vtkGetMacro(InitialNumberOfPieces, int);
+
+  // Description:
+  // Maximum number of pieces. The default is 1024.
+  vtkSetClampMacro(MaximumNumberOfPieces, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPieces, int);
+
+  // Description:
+  // Number of pieces the input was divided into during the last update.
+  vtkGetMacro(NumberOfPieces, int);
+
+  // Description:
+  // Get the output data object for a port on this algorithm.
+  vtkDataSet* GetOutput();
+  vtkDataSet* GetOutput(int);
+
+  // Description:
+  // see vtkAlgorithm for details
+  virtual int ProcessRequest(vtkInformation*,
+                             vtkInformationVector**,
+                             vtkInformationVector*);
+
+protected:
+  vtkMemoryLimitDataSetStreamer();
+  ~vtkMemoryLimitDataSetStreamer();
+
+  virtual int FillOutputPortInformation(int port, vtkInformation* info);
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+
+  virtual int RequestDataObject(vtkInformation*,
+                                vtkInformationVector**,
+                                vtkInformationVector*);
+  virtual int RequestUpdateExtent(vtkInformation*,
+                                  vtkInformationVector**,
+                                  vtkInformationVector*);
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector**,
+                          vtkInformationVector*);
+
+  virtual int ExecutePass(vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+  virtual int PostExecute(vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+
+  // Discard the partial results and the probing state so that the next
+  // update starts from scratch.
+  void ResetPasses();
+
+  unsigned long MemoryLimit;
+  int InitialNumberOfPieces;
+  int MaximumNumberOfPieces;
+  int NumberOfPieces;
+
+  // Size of the first piece with the previous number of pieces while
+  // probing, 0 otherwise.
+  unsigned long ProbedSize;
+
+private:
+  vtkMemoryLimitDataSetStreamerInternals* Internals;
+
+  vtkMemoryLimitDataSetStreamer(const vtkMemoryLimitDataSetStreamer&);  // Not implemented.
+  void operator=(const vtkMemoryLimitDataSetStreamer&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,218 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterReuse.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that vtkDataSetSurfaceFilter with ReuseTopology on
+// keeps the surface of an unstructured grid when only the point data of
+// the input changes, maps the new point and cell data correctly, and
+// extracts the surface again when a part of the geometry is replaced.
+
+#include "vtkCellData.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridAlgorithm.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Passes the structure of its input and adds point scalars x + Value and
+// cell scalars cellId + Value.
+class AddScalarsFilter : public vtkUnstructuredGridAlgorithm
+{
+public:
+  static AddScalarsFilter *New();
+  vtkTypeMacro(AddScalarsFilter,vtkUnstructuredGridAlgorithm);
+
+  vtkSetMacro(Value, double);
+
+protected:
+  AddScalarsFilter()
+  {
+    this->Value = 0.0;
+  }
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+  {
+    vtkUnstructuredGrid* input = vtkUnstructuredGrid::GetData(inputVector[0]);
+    vtkUnstructuredGrid* output = vtkUnstructuredGrid::GetData(outputVector);
+    output->CopyStructure(input);
+
+    vtkDoubleArray* pointScalars = vtkDoubleArray::New();
+    pointScalars->SetName("PointScalars");
+    pointScalars->SetNumberOfValues(input->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+      {
+      pointScalars->SetValue(i, input->GetPoint(i)[0] + this->Value);
+      }
+    output->GetPointData()->SetScalars(pointScalars);
+    pointScalars->Delete();
+
+    vtkDoubleArray* cellScalars = vtkDoubleArray::New();
+    cellScalars->SetName("CellScalars");
+    cellScalars->SetNumberOfValues(input->GetNumberOfCells());
+    for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+      {
+      cellScalars->SetValue(i, i + this->Value);
+      }
+    output->GetCellData()->SetScalars(cellScalars);
+    cellScalars->Delete();
+    return 1;
+  }
+
+  double Value;
+};
+vtkStandardNewMacro(AddScalarsFilter);
+
+namespace
+{
+// A row of hexahedra.
+void MakeGrid(vtkUnstructuredGrid* grid, int numberOfCells)
+{
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i <= numberOfCells; ++i)
+    {
+    points->InsertNextPoint(i, 0, 0);
+    points->InsertNextPoint(i, 1, 0);
+    points->InsertNextPoint(i, 1, 1);
+    points->InsertNextPoint(i, 0, 1);
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->Allocate(numberOfCells);
+  for (int i = 0; i < numberOfCells; ++i)
+    {
+    vtkIdType ids[8];
+    for (int j = 0; j < 4; ++j)
+      {
+      ids[j] = 4 * i + j;
+      ids[j + 4] = 4 * (i + 1) + j;
+      }
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+    }
+}
+
+// Whether the point and cell data of the surface match the input values.
+bool CheckAttributes(vtkPolyData* surface, double value)
+{
+  vtkDataArray* pointScalars = surface->GetPointData()->GetScalars();
+  vtkDataArray* cellScalars = surface->GetCellData()->GetScalars();
+  vtkIdTypeArray* cellIds = vtkIdTypeArray::SafeDownCast(
+    surface->GetCellData()->GetArray("vtkOriginalCellIds"));
+  if (!pointScalars || !cellScalars || !cellIds ||
+      pointScalars->GetNumberOfTuples() != surface->GetNumberOfPoints() ||
+      cellScalars->GetNumberOfTuples() != surface->GetNumberOfCells())
+    {
+    cerr << "Missing attributes" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < surface->GetNumberOfPoints(); ++i)
+    {
+    if (pointScalars->GetTuple1(i) != surface->GetPoint(i)[0] + value)
+      {
+      cerr << "Wrong point data for point " << i << endl;
+      return false;
+      }
+    }
+  for (vtkIdType i = 0; i < surface->GetNumberOfCells(); ++i)
+    {
+    if (cellScalars->GetTuple1(i) != cellIds->GetValue(i) + value)
+      {
+      cerr << "Wrong cell data for cell " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestDataSetSurfaceFilterReuse(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.GetPointer(), 3);
+
+  vtkNew<AddScalarsFilter> scalars;
+  scalars->SetInputData(grid.GetPointer());
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputConnection(scalars->GetOutputPort());
+  surface->ReuseTopologyOn();
+  surface->PassThroughCellIdsOn();
+  surface->Update();
+
+  vtkPolyData* output = surface->GetOutput();
+  vtkPoints* points = output->GetPoints();
+  vtkCellArray* polys = output->GetPolys();
+  if (output->GetNumberOfCells() != 14 || output->GetNumberOfPoints() != 16 ||
+      !CheckAttributes(output, 0.0))
+    {
+    cerr << "Unexpected surface" << endl;
+    return TEST_FAILURE;
+    }
+
+  // Only the attributes change: the surface is kept.
+  scalars->SetValue(10.0);
+  surface->Update();
+  output = surface->GetOutput();
+  if (output->GetPoints() != points || output->GetPolys() != polys ||
+      output->GetNumberOfCells() != 14 || !CheckAttributes(output, 10.0))
+    {
+    cerr << "The surface was not reused for new attributes" << endl;
+    return TEST_FAILURE;
+    }
+
+  // Points older than the cells of the next grid.
+  vtkNew<vtkUnstructuredGrid> shiftedGrid;
+  MakeGrid(shiftedGrid.GetPointer(), 4);
+  vtkPoints* shiftedPoints = shiftedGrid->GetPoints();
+  for (vtkIdType i = 0; i < shiftedPoints->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    shiftedPoints->GetPoint(i, x);
+    shiftedPoints->SetPoint(i, x[0], x[1], x[2] + 5.0);
+    }
+
+  // The geometry changes: the surface is extracted again.
+  MakeGrid(grid.GetPointer(), 4);
+  surface->Update();
+  output = surface->GetOutput();
+  if (output->GetPoints() == points || output->GetNumberOfCells() != 18 ||
+      output->GetNumberOfPoints() != 20 || !CheckAttributes(output, 10.0))
+    {
+    cerr << "The surface was reused for a new geometry" << endl;
+    return TEST_FAILURE;
+    }
+
+  // Swapping in the older points does not change the newest modification
+  // time of the geometry, but the surface must still be extracted again.
+  points = output->GetPoints();
+  grid->SetPoints(shiftedPoints);
+  surface->Update();
+  output = surface->GetOutput();
+  if (output->GetPoints() == points || output->GetNumberOfCells() != 18 ||
+      output->GetBounds()[4] != 5.0 || !CheckAttributes(output, 10.0))
+    {
+    cerr << "The surface was reused for older points" << endl;
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
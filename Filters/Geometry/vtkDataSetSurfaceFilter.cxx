@@ -20,6 +20,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkHexahedron.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -128,6 +129,19 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
   this->OriginalPointIdsName = NULL;
 
   this->NonlinearSubdivisionLevel = 1;
+
+  this->ReuseTopology = 0;
+  this->Surface = NULL;
+  this->SurfacePointIds = NULL;
+  this->SurfaceCellIds = NULL;
+  this->SurfaceGeometryMTime = 0;
+  for (int i = 0; i < 6; i++)
+    {
+    this->SurfaceGeometryParts[i] = NULL;
+    this->SurfaceGeometryPartMTimes[i] = 0;
+    }
+  this->SurfaceInputNumberOfPoints = 0;
+  this->SurfaceInputNumberOfCells = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -144,6 +158,7 @@ vtkDataSetSurfaceFilter::~vtkDataSetSurfaceFilter()
     }
   this->SetOriginalCellIdsName(NULL);
   this->SetOriginalPointIdsName(NULL);
+  this->ReleaseSurface();
 }
 
 //----------------------------------------------------------------------------
@@ -192,6 +207,11 @@ int vtkDataSetSurfaceFilter::RequestData(
     case  VTK_UNSTRUCTURED_GRID:
     case  VTK_UNSTRUCTURED_GRID_BASE:
       {
+      if (this->ReuseSurface(input, output))
+        {
+        output->CheckAttributes();
+        return 1;
+        }
       if (!this->UnstructuredGridExecute(
             input, output, outInfo->Get(
               vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS())))
@@ -1298,6 +1318,8 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "NonlinearSubdivisionLevel: "
      << this->NonlinearSubdivisionLevel << endl;
+  os << indent << "ReuseTopology: "
+     << (this->ReuseTopology ? "On\n" : "Off\n");
 }
 
 //========================================================================
@@ -1370,6 +1392,12 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
 
   vtkUnsignedCharArray* ghosts = vtkUnsignedCharArray::SafeDownCast(
     input->GetPointData()->GetArray("vtkGhostLevels"));
+
+  // Keeping the surface requires the maps to the input points and cells.
+  this->ReleaseSurface();
+  bool keepSurface = this->ReuseTopology && !handleSubdivision &&
+    !this->PieceInvariant && !ghosts;
+
   vtkCellArray *newVerts;
   vtkCellArray *newLines;
   vtkCellArray *newPolys;
@@ -1441,13 +1469,13 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   outputCD->CopyGlobalIdsOn();
   outputCD->CopyAllocate(inputCD, numCells, numCells/2);
 
-  if (this->PassThroughCellIds)
+  if (this->PassThroughCellIds || keepSurface)
     {
     this->OriginalCellIds = vtkIdTypeArray::New();
     this->OriginalCellIds->SetName(this->GetOriginalCellIdsName());
     this->OriginalCellIds->SetNumberOfComponents(1);
     }
-  if (this->PassThroughPointIds)
+  if (this->PassThroughPointIds || keepSurface)
     {
     this->OriginalPointIds = vtkIdTypeArray::New();
     this->OriginalPointIds->SetName(this->GetOriginalPointIdsName());
@@ -1983,6 +2011,27 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
 
   //free storage
   output->Squeeze();
+
+  if (keepSurface)
+    {
+    this->Surface = vtkPolyData::New();
+    this->Surface->CopyStructure(output);
+    this->SurfacePointIds = vtkIdList::New();
+    this->SurfacePointIds->SetNumberOfIds(output->GetNumberOfPoints());
+    std::copy(this->OriginalPointIds->GetPointer(0),
+              this->OriginalPointIds->GetPointer(0) +
+                output->GetNumberOfPoints(),
+              this->SurfacePointIds->GetPointer(0));
+    this->SurfaceCellIds = vtkIdList::New();
+    this->SurfaceCellIds->SetNumberOfIds(output->GetNumberOfCells());
+    std::copy(this->OriginalCellIds->GetPointer(0),
+              this->OriginalCellIds->GetPointer(0) +
+                output->GetNumberOfCells(),
+              this->SurfaceCellIds->GetPointer(0));
+    this->RecordSurfaceGeometry(dataSetInput);
+    this->SurfaceTime.Modified();
+    }
+
   if (this->OriginalCellIds != NULL)
     {
     this->OriginalCellIds->Delete();
@@ -2003,6 +2052,136 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkDataSetSurfaceFilter::ReuseSurface(vtkDataSet *input,
+                                          vtkPolyData *output)
+{
+  if (!this->ReuseTopology || !this->Surface ||
+      this->GetMTime() > this->SurfaceTime ||
+      !this->IsSurfaceGeometry(input) ||
+      input->GetPointData()->GetArray("vtkGhostLevels"))
+    {
+    return 0;
+    }
+
+  vtkIdType numPts = this->SurfacePointIds->GetNumberOfIds();
+  vtkIdType numCells = this->SurfaceCellIds->GetNumberOfIds();
+  vtkIdType numIds = (numPts > numCells ? numPts : numCells);
+  vtkIdList *outIds = vtkIdList::New();
+  outIds->SetNumberOfIds(numIds);
+  for (vtkIdType i = 0; i < numIds; i++)
+    {
+    outIds->SetId(i, i);
+    }
+
+  output->CopyStructure(this->Surface);
+
+  vtkPointData *outputPD = output->GetPointData();
+  outputPD->CopyGlobalIdsOn();
+  outputPD->CopyAllocate(input->GetPointData(), numPts);
+  outIds->SetNumberOfIds(numPts);
+  outputPD->CopyData(input->GetPointData(), this->SurfacePointIds, outIds);
+
+  vtkCellData *outputCD = output->GetCellData();
+  outputCD->CopyGlobalIdsOn();
+  outputCD->CopyAllocate(input->GetCellData(), numCells);
+  outIds->SetNumberOfIds(numCells);
+  outputCD->CopyData(input->GetCellData(), this->SurfaceCellIds, outIds);
+  outIds->Delete();
+
+  if (this->PassThroughCellIds)
+    {
+    vtkIdTypeArray *ids = vtkIdTypeArray::New();
+    ids->SetName(this->GetOriginalCellIdsName());
+    ids->SetNumberOfValues(numCells);
+    std::copy(this->SurfaceCellIds->GetPointer(0),
+              this->SurfaceCellIds->GetPointer(0) + numCells,
+              ids->GetPointer(0));
+    outputCD->AddArray(ids);
+    ids->Delete();
+    }
+  if (this->PassThroughPointIds)
+    {
+    vtkIdTypeArray *ids = vtkIdTypeArray::New();
+    ids->SetName(this->GetOriginalPointIdsName());
+    ids->SetNumberOfValues(numPts);
+    std::copy(this->SurfacePointIds->GetPointer(0),
+              this->SurfacePointIds->GetPointer(0) + numPts,
+              ids->GetPointer(0));
+    outputPD->AddArray(ids);
+    ids->Delete();
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// The points and cell arrays of an unstructured grid. They are all NULL
+// for other datasets, which only compare their geometry modification time.
+static void vtkDataSetSurfaceFilterGetGeometryParts(vtkDataSet *input,
+                                                    vtkObject *parts[6])
+{
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input);
+  parts[0] = grid ? grid->GetPoints() : NULL;
+  parts[1] = grid ? grid->GetCells() : NULL;
+  parts[2] = grid ? grid->GetCellTypesArray() : NULL;
+  parts[3] = grid ? grid->GetCellLocationsArray() : NULL;
+  parts[4] = grid ? grid->GetFaces() : NULL;
+  parts[5] = grid ? grid->GetFaceLocations() : NULL;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSetSurfaceFilter::RecordSurfaceGeometry(vtkDataSet *input)
+{
+  // The parts are not referenced. A part allocated again at the same
+  // address has a newer modification time than the recorded one.
+  vtkDataSetSurfaceFilterGetGeometryParts(input, this->SurfaceGeometryParts);
+  for (int i = 0; i < 6; i++)
+    {
+    vtkObject *part = this->SurfaceGeometryParts[i];
+    this->SurfaceGeometryPartMTimes[i] = part ? part->GetMTime() : 0;
+    }
+  this->SurfaceGeometryMTime = input->GetGeometryMTime();
+  this->SurfaceInputNumberOfPoints = input->GetNumberOfPoints();
+  this->SurfaceInputNumberOfCells = input->GetNumberOfCells();
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataSetSurfaceFilter::IsSurfaceGeometry(vtkDataSet *input)
+{
+  if (input->GetGeometryMTime() != this->SurfaceGeometryMTime ||
+      input->GetNumberOfPoints() != this->SurfaceInputNumberOfPoints ||
+      input->GetNumberOfCells() != this->SurfaceInputNumberOfCells)
+    {
+    return false;
+    }
+  vtkObject *parts[6];
+  vtkDataSetSurfaceFilterGetGeometryParts(input, parts);
+  for (int i = 0; i < 6; i++)
+    {
+    if (parts[i] != this->SurfaceGeometryParts[i] ||
+        (parts[i] && parts[i]->GetMTime() != this->SurfaceGeometryPartMTimes[i]))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSetSurfaceFilter::ReleaseSurface()
+{
+  if (this->Surface)
+    {
+    this->Surface->Delete();
+    this->Surface = NULL;
+    this->SurfacePointIds->Delete();
+    this->SurfacePointIds = NULL;
+    this->SurfaceCellIds->Delete();
+    this->SurfaceCellIds = NULL;
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::InitializeQuadHash(vtkIdType numPoints)
 {
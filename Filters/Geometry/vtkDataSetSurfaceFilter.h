@@ -31,6 +31,7 @@
 
 class vtkPointData;
 class vtkPoints;
+class vtkIdList;
 class vtkIdTypeArray;
 
 //BTX
@@ -112,6 +113,18 @@ public:
   vtkSetMacro(NonlinearSubdivisionLevel, int);
   vtkGetMacro(NonlinearSubdivisionLevel, int);
 
+  // Description:
+  // If on, the surface extracted from an unstructured grid is kept. When
+  // the geometry of the next input is unchanged, as reported by
+  // vtkDataSet::GetGeometryMTime(), only its point and cell data are
+  // copied onto the kept surface. This is the case of time steps of fields
+  // on a fixed mesh. It does not apply to subdivided nonlinear cells, to
+  // inputs with ghost levels nor when PieceInvariant is on. The default is
+  // off to conserve memory.
+  vtkSetMacro(ReuseTopology, int);
+  vtkGetMacro(ReuseTopology, int);
+  vtkBooleanMacro(ReuseTopology, int);
+
   // Description:
   // Direct access methods that can be used to use the this class as an
   // algorithm without using it as a filter.
@@ -246,6 +259,31 @@ protected:
 
   int NonlinearSubdivisionLevel;
 
+  // Description:
+  // Copy the point and cell data of the input onto the kept surface if it
+  // was extracted from the same geometry. Returns 0 if it was not.
+  int ReuseSurface(vtkDataSet *input, vtkPolyData *output);
+  void ReleaseSurface();
+
+  // Description:
+  // Record the points and cell arrays of the input the kept surface is
+  // extracted from, or compare the input with the recorded ones. The
+  // maximum of their modification times is not enough, since replacing
+  // a part by an older one leaves it unchanged.
+  void RecordSurfaceGeometry(vtkDataSet *input);
+  bool IsSurfaceGeometry(vtkDataSet *input);
+
+  int ReuseTopology;
+  vtkPolyData *Surface;
+  vtkIdList *SurfacePointIds;
+  vtkIdList *SurfaceCellIds;
+  unsigned long SurfaceGeometryMTime;
+  vtkObject *SurfaceGeometryParts[6];
+  unsigned long SurfaceGeometryPartMTimes[6];
+  vtkIdType SurfaceInputNumberOfPoints;
+  vtkIdType SurfaceInputNumberOfCells;
+  vtkTimeStamp SurfaceTime;
+
 private:
   vtkDataSetSurfaceFilter(const vtkDataSetSurfaceFilter&);  // Not implemented.
   void operator=(const vtkDataSetSurfaceFilter&);  // Not implemented.
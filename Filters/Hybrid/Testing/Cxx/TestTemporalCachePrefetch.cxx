@@ -0,0 +1,170 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTemporalCachePrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that vtkTemporalDataSetCache reads the time steps
+// following the requested one through its prefetch pipeline, serves them
+// without executing its input, and releases time steps beyond its memory
+// limit.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTemporalDataSetCache.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Produces time steps 0 to 9 made of 10000 points at x = t.
+class TemporalPointSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TemporalPointSource *New();
+  vtkTypeMacro(TemporalPointSource,vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  TemporalPointSource()
+  {
+    this->NumberOfExecutions = 0;
+    this->SetNumberOfInputPorts(0);
+  }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double times[10];
+    for (int i = 0; i < 10; ++i)
+      {
+      times[i] = i;
+      }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), times, 10);
+    double range[2] = {0.0, 9.0};
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+  {
+    this->NumberOfExecutions++;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    double time =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkPoints* points = vtkPoints::New();
+    points->SetNumberOfPoints(10000);
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+      {
+      points->SetPoint(i, time, i, 0.0);
+      }
+    output->SetPoints(points);
+    points->Delete();
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+};
+vtkStandardNewMacro(TemporalPointSource);
+
+namespace
+{
+bool CheckTime(vtkTemporalDataSetCache* cache, double time)
+{
+  cache->UpdateInformation();
+  cache->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), time);
+  cache->Update();
+  vtkPolyData* output = vtkPolyData::SafeDownCast(cache->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfPoints() != 10000 ||
+      output->GetPoint(0)[0] != time)
+    {
+    cerr << "Wrong output for time " << time << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestTemporalCachePrefetch(int, char*[])
+{
+  vtkNew<TemporalPointSource> source;
+  vtkNew<TemporalPointSource> prefetchSource;
+  vtkNew<vtkTemporalDataSetCache> cache;
+  cache->SetInputConnection(source->GetOutputPort());
+  cache->SetPrefetchInputConnection(prefetchSource->GetOutputPort());
+  cache->SetPrefetchSize(2);
+
+  int success = 1;
+  if (!CheckTime(cache.GetPointer(), 0.0))
+    {
+    return TEST_FAILURE;
+    }
+  cache->WaitForPrefetch();
+  if (!CheckTime(cache.GetPointer(), 1.0))
+    {
+    return TEST_FAILURE;
+    }
+  cache->WaitForPrefetch();
+  if (!CheckTime(cache.GetPointer(), 2.0))
+    {
+    return TEST_FAILURE;
+    }
+  cache->WaitForPrefetch();
+
+  // Time 0 is read by the input, 1 and 2 are read ahead, and 3 and 4 are
+  // read ahead for later requests.
+  if (source->NumberOfExecutions != 1 || cache->GetNumberOfPrefetchHits() != 2
+      || prefetchSource->NumberOfExecutions != 4)
+    {
+    cerr << "Expected 1 execution of the input, 4 of the prefetch pipeline "
+         << "and 2 hits, got " << source->NumberOfExecutions << ", "
+         << prefetchSource->NumberOfExecutions << " and "
+         << cache->GetNumberOfPrefetchHits() << endl;
+    success = 0;
+    }
+
+  // A time step holds about 117 KiB: a limit of 300 KiB keeps two of them,
+  // so time 2 is read again by the input.
+  cache->SetPrefetchSize(0);
+  cache->SetCacheMemoryLimit(300);
+  for (int i = 3; i <= 5; ++i)
+    {
+    if (!CheckTime(cache.GetPointer(), i))
+      {
+      return TEST_FAILURE;
+      }
+    }
+  int executions = source->NumberOfExecutions;
+  if (!CheckTime(cache.GetPointer(), 2.0) ||
+      source->NumberOfExecutions != executions + 1)
+    {
+    cerr << "The memory limit did not release the oldest time step" << endl;
+    success = 0;
+    }
+  executions = source->NumberOfExecutions;
+  if (!CheckTime(cache.GetPointer(), 5.0) ||
+      source->NumberOfExecutions != executions)
+    {
+    cerr << "The most recent time step was released" << endl;
+    success = 0;
+    }
+
+  return success ? TEST_SUCCESS : TEST_FAILURE;
+}
@@ -14,26 +14,241 @@
 =========================================================================*/
 #include "vtkTemporalDataSetCache.h"
 
+#include "vtkAlgorithmOutput.h"
+#include "vtkConditionVariable.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimeStamp.h"
 
+#include <algorithm>
+#include <deque>
+#include <set>
 #include <vector>
 
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkTemporalDataSetCache);
 
+//----------------------------------------------------------------------------
+// Reads time steps through the prefetch pipeline on a background thread.
+class vtkTemporalDataSetCachePrefetcher
+{
+public:
+  typedef std::map<double, vtkSmartPointer<vtkDataObject> > ReadyType;
+
+  vtkTemporalDataSetCachePrefetcher()
+    {
+    this->Threader = vtkMultiThreader::New();
+    this->ThreadId = -1;
+    this->Lock = vtkMutexLock::New();
+    this->Condition = vtkConditionVariable::New();
+    this->Busy = false;
+    this->BusyTime = 0.0;
+    this->StopThread = false;
+    this->Generation = 0;
+    }
+
+  ~vtkTemporalDataSetCachePrefetcher()
+    {
+    this->Stop();
+    this->Threader->Delete();
+    this->Condition->Delete();
+    this->Lock->Delete();
+    }
+
+  void SetConnection(vtkAlgorithmOutput* connection)
+    {
+    this->Stop();
+    this->Connection = connection;
+    this->Producer = connection ? connection->GetProducer() : 0;
+    this->Invalidate();
+    }
+
+  vtkAlgorithmOutput* GetConnection()
+    {
+    return this->Connection;
+    }
+
+  // Replace the time steps waiting to be read.
+  void Schedule(const std::vector<double>& times)
+    {
+    this->Lock->Lock();
+    this->Queue.clear();
+    for (size_t i = 0; i < times.size(); ++i)
+      {
+      if (this->Ready.find(times[i]) == this->Ready.end() &&
+          !(this->Busy && this->BusyTime == times[i]))
+        {
+        this->Queue.push_back(times[i]);
+        }
+      }
+    bool start = !this->Queue.empty() && this->ThreadId < 0;
+    this->Condition->Broadcast();
+    this->Lock->Unlock();
+
+    if (start)
+      {
+      this->ThreadId =
+        this->Threader->SpawnThread(vtkTemporalDataSetCachePrefetcher::Start,
+                                    this);
+      }
+    }
+
+  // Move the time steps read so far to ready.
+  void TakeReady(ReadyType& ready)
+    {
+    this->Lock->Lock();
+    ready.swap(this->Ready);
+    this->Ready.clear();
+    this->Lock->Unlock();
+    for (ReadyType::iterator it = ready.begin(); it != ready.end(); ++it)
+      {
+      this->Delivered.insert(it->first);
+      }
+    }
+
+  // Whether a time step was read ahead and not requested since.
+  bool TakeDelivered(double time)
+    {
+    return this->Delivered.erase(time) > 0;
+    }
+
+  // Discard everything read or scheduled so far.
+  void Invalidate()
+    {
+    this->Lock->Lock();
+    this->Queue.clear();
+    this->Ready.clear();
+    ++this->Generation;
+    this->Lock->Unlock();
+    this->Delivered.clear();
+    }
+
+  void Wait()
+    {
+    this->Lock->Lock();
+    while (this->ThreadId >= 0 && (this->Busy || !this->Queue.empty()))
+      {
+      this->Condition->Wait(this->Lock);
+      }
+    this->Lock->Unlock();
+    }
+
+private:
+  static VTK_THREAD_RETURN_TYPE Start(void* arg)
+    {
+    vtkMultiThreader::ThreadInfo* info =
+      static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    static_cast<vtkTemporalDataSetCachePrefetcher*>(info->UserData)->Run();
+    return VTK_THREAD_RETURN_VALUE;
+    }
+
+  void Run()
+    {
+    vtkAlgorithm* producer = this->Producer;
+    int port = this->Connection->GetIndex();
+    vtkStreamingDemandDrivenPipeline* sddp =
+      vtkStreamingDemandDrivenPipeline::SafeDownCast(producer->GetExecutive());
+
+    this->Lock->Lock();
+    while (!this->StopThread)
+      {
+      if (!sddp)
+        {
+        // Nothing can be read: drop the time steps so that Wait() returns.
+        this->Queue.clear();
+        this->Condition->Broadcast();
+        }
+      if (this->Queue.empty())
+        {
+        this->Condition->Wait(this->Lock);
+        continue;
+        }
+      double time = this->Queue.front();
+      this->Queue.pop_front();
+      this->Busy = true;
+      this->BusyTime = time;
+      unsigned long generation = this->Generation;
+      this->Lock->Unlock();
+
+      vtkSmartPointer<vtkDataObject> data;
+      if (sddp->UpdateInformation() && sddp->SetUpdateTimeStep(port, time) >= 0
+          && sddp->Update(port))
+        {
+        vtkDataObject* output = producer->GetOutputDataObject(port);
+        if (output)
+          {
+          data.TakeReference(output->NewInstance());
+          data->ShallowCopy(output);
+          data->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+          }
+        }
+
+      this->Lock->Lock();
+      if (data && generation == this->Generation)
+        {
+        this->Ready[time] = data;
+        }
+      this->Busy = false;
+      this->Condition->Broadcast();
+      }
+    this->Lock->Unlock();
+    }
+
+  void Stop()
+    {
+    if (this->ThreadId < 0)
+      {
+      return;
+      }
+    this->Lock->Lock();
+    this->StopThread = true;
+    this->Condition->Broadcast();
+    this->Lock->Unlock();
+    this->Threader->TerminateThread(this->ThreadId);
+    this->ThreadId = -1;
+    this->StopThread = false;
+    this->Busy = false;
+    }
+
+  vtkSmartPointer<vtkAlgorithmOutput> Connection;
+  // The connection does not keep its producer alive while it is read.
+  vtkSmartPointer<vtkAlgorithm> Producer;
+  vtkMultiThreader* Threader;
+  int ThreadId;
+  vtkMutexLock* Lock;
+  vtkConditionVariable* Condition;
+
+  std::deque<double> Queue;
+  ReadyType Ready;
+  std::set<double> Delivered;
+  bool Busy;
+  double BusyTime;
+  bool StopThread;
+
+  // Incremented when the scheduled time steps become invalid, so that the
+  // one being read is discarded.
+  unsigned long Generation;
+};
+
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkTemporalDataSetCache::vtkTemporalDataSetCache()
 {
   this->CacheSize = 10;
+  this->CacheMemoryLimit = 0;
+  this->PrefetchSize = 0;
+  this->NumberOfPrefetchHits = 0;
+  this->CachePipelineMTime = 0;
+  this->Prefetcher = new vtkTemporalDataSetCachePrefetcher;
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(1);
 }
@@ -41,6 +256,7 @@ vtkTemporalDataSetCache::vtkTemporalDataSetCache()
 //----------------------------------------------------------------------------
 vtkTemporalDataSetCache::~vtkTemporalDataSetCache()
 {
+  delete this->Prefetcher;
   CacheType::iterator pos = this->Cache.begin();
   for (; pos != this->Cache.end();)
     {
@@ -103,6 +319,152 @@ void vtkTemporalDataSetCache::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << endl;
+  os << indent << "PrefetchSize: " << this->PrefetchSize << endl;
+  os << indent << "NumberOfPrefetchHits: " << this->NumberOfPrefetchHits
+     << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::SetPrefetchInputConnection(
+  vtkAlgorithmOutput* output)
+{
+  if (this->Prefetcher->GetConnection() == output)
+    {
+    return;
+    }
+  if (output && !vtkStreamingDemandDrivenPipeline::SafeDownCast(
+        output->GetProducer()->GetExecutive()))
+    {
+    vtkErrorMacro("The prefetch pipeline must be driven by a "
+                  "vtkStreamingDemandDrivenPipeline.");
+    return;
+    }
+  this->Prefetcher->SetConnection(output);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkAlgorithmOutput* vtkTemporalDataSetCache::GetPrefetchInputConnection()
+{
+  return this->Prefetcher->GetConnection();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::WaitForPrefetch()
+{
+  this->Prefetcher->Wait();
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::AddToCache(double time, vtkDataObject* data,
+                                         unsigned long stamp)
+{
+  data->Register(this);
+  this->Cache[time] = std::pair<unsigned long, vtkDataObject *>(stamp, data);
+
+  unsigned long memorySize = 0;
+  CacheType::iterator pos;
+  if (this->CacheMemoryLimit > 0)
+    {
+    for (pos = this->Cache.begin(); pos != this->Cache.end(); ++pos)
+      {
+      memorySize += pos->second.second->GetActualMemorySize();
+      }
+    }
+
+  // Release the least recently used time steps beyond the limits.
+  while (this->Cache.size() > static_cast<unsigned long>(this->CacheSize) ||
+         (this->CacheMemoryLimit > 0 && memorySize > this->CacheMemoryLimit))
+    {
+    CacheType::iterator oldestpos = this->Cache.end();
+    for (pos = this->Cache.begin(); pos != this->Cache.end(); ++pos)
+      {
+      if (pos->first != time && (oldestpos == this->Cache.end() ||
+                                 pos->second.first < oldestpos->second.first))
+        {
+        oldestpos = pos;
+        }
+      }
+    if (oldestpos == this->Cache.end())
+      {
+      break;
+      }
+    if (this->CacheMemoryLimit > 0)
+      {
+      memorySize -= oldestpos->second.second->GetActualMemorySize();
+      }
+    oldestpos->second.second->UnRegister(this);
+    this->Cache.erase(oldestpos);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::UpdatePrefetch(vtkInformation* inInfo,
+                                             double requestedTime)
+{
+  vtkAlgorithmOutput* connection = this->Prefetcher->GetConnection();
+  if (!connection)
+    {
+    return;
+    }
+  if (this->GetNumberOfInputConnections(0) > 0 &&
+      connection->GetProducer() == this->GetInputAlgorithm(0, 0))
+    {
+    vtkErrorMacro("The prefetch pipeline must be distinct from the input.");
+    return;
+    }
+
+  // Time steps read ahead are more recent than anything in the cache, the
+  // requested one last so that it is not released.
+  vtkTemporalDataSetCachePrefetcher::ReadyType ready;
+  this->Prefetcher->TakeReady(ready);
+  vtkTemporalDataSetCachePrefetcher::ReadyType::iterator it;
+  for (int requested = 0; requested < 2; ++requested)
+    {
+    for (it = ready.begin(); it != ready.end(); ++it)
+      {
+      if ((it->first == requestedTime) != (requested == 1) ||
+          this->Cache.find(it->first) != this->Cache.end())
+        {
+        continue;
+        }
+      vtkTimeStamp stamp;
+      stamp.Modified();
+      this->AddToCache(it->first, it->second, stamp.GetMTime());
+      }
+    }
+  if (this->Prefetcher->TakeDelivered(requestedTime) &&
+      this->Cache.find(requestedTime) != this->Cache.end())
+    {
+    this->NumberOfPrefetchHits++;
+    }
+
+  if (this->PrefetchSize <= 0 ||
+      !inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+    {
+    return;
+    }
+
+  // Schedule the time steps that follow the requested one and are not
+  // cached yet.
+  int numberOfTimeSteps =
+    inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  double* timeSteps =
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  std::vector<double> times;
+  double* next = std::upper_bound(timeSteps, timeSteps + numberOfTimeSteps,
+                                  requestedTime);
+  double* last = next + std::min(this->PrefetchSize,
+    static_cast<int>(timeSteps + numberOfTimeSteps - next));
+  for (; next != last; ++next)
+    {
+    if (this->Cache.find(*next) == this->Cache.end())
+      {
+      times.push_back(*next);
+      }
+    }
+  this->Prefetcher->Schedule(times);
 }
 //----------------------------------------------------------------------------
 void vtkTemporalDataSetCache::SetCacheSize(int size)
@@ -188,6 +550,12 @@ int vtkTemporalDataSetCache
 
 
   unsigned long pmt = ddp->GetPipelineMTime();
+  if (pmt != this->CachePipelineMTime)
+    {
+    // The time steps read ahead may not match the modified pipeline.
+    this->Prefetcher->Invalidate();
+    this->CachePipelineMTime = pmt;
+    }
   for (pos = this->Cache.begin(); pos != this->Cache.end();)
     {
     if (pos->second.first < pmt)
@@ -230,6 +598,8 @@ int vtkTemporalDataSetCache
     double upTime =
       outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
 
+    this->UpdatePrefetch(inInfo, upTime);
+
     // do we have this time step?
     pos = this->Cache.find(upTime);
     if (pos == this->Cache.end())
@@ -329,37 +699,10 @@ int vtkTemporalDataSetCache::RequestData(
     CacheType::iterator pos1 = this->Cache.find(inTime);
     if (pos1 == this->Cache.end())
       {
-      // if we have room in the Cache then just add the new data
-      if (this->Cache.size() < static_cast<unsigned long>(this->CacheSize))
-        {
-        vtkDataObject* cachedData  = input->NewInstance();
-        cachedData->ShallowCopy(input);
-
-        this->Cache[inTime] =
-          std::pair<unsigned long, vtkDataObject *>
-          (outputUpdateTime, cachedData);
-        }
-      // no room in the cache, we need to get rid of something
-      else
-        {
-        // get rid of the oldest data in the cache
-        CacheType::iterator pos2 = this->Cache.begin();
-        CacheType::iterator oldestpos = this->Cache.begin();
-        for (; pos2 != this->Cache.end(); ++pos2)
-          {
-          if (pos2->second.first < oldestpos->second.first)
-            {
-            oldestpos = pos2;
-            }
-          }
-        //was there old data?
-        if (oldestpos->second.first < outputUpdateTime)
-          {
-          oldestpos->second.second->UnRegister(this);
-          this->Cache.erase(oldestpos);
-          }
-        // if no old data and no room then we are done
-        }
+      vtkDataObject* cachedData  = input->NewInstance();
+      cachedData->ShallowCopy(input);
+      this->AddToCache(inTime, cachedData, outputUpdateTime);
+      cachedData->Delete();
       }
     }
   return 1;
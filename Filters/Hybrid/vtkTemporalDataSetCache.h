@@ -16,6 +16,22 @@
 // .SECTION Description
 // vtkTemporalDataSetCache cache time step requests of a temporal dataset,
 // when cached data is requested it is returned using a shallow copy.
+//
+// The cache can also read time steps ahead on a background thread. Give it
+// a second, independent instance of the upstream pipeline (for instance a
+// second reader of the same files) with SetPrefetchInputConnection() and
+// set PrefetchSize. Whenever a time step is requested, the PrefetchSize
+// time steps that follow it are scheduled and the prefetch pipeline is
+// updated for them in the background; they are moved into the cache at
+// the next request, so that playing the time steps in order only waits
+// for the ones not yet read. The prefetch pipeline must not share
+// algorithms or data with the main pipeline, and must not be modified
+// while the cache is in use. Prefetched time steps are discarded when the
+// main pipeline is modified.
+//
+// The cache holds at most CacheSize time steps and, if CacheMemoryLimit is
+// set, at most that many kibibytes; the least recently used time steps are
+// released first.
 // .SECTION Thanks
 // Ken Martin (Kitware) and John Bidiscombe of
 // CSCS - Swiss National Supercomputing Centre
@@ -33,6 +49,9 @@
 #include "vtkAlgorithm.h"
 #include <map> // used for the cache
 
+class vtkAlgorithmOutput;
+class vtkTemporalDataSetCachePrefetcher;
+
 class VTKFILTERSHYBRID_EXPORT vtkTemporalDataSetCache : public vtkAlgorithm
 {
 public:
@@ -46,11 +65,47 @@ public:
   void SetCacheSize(int size);
   vtkGetMacro(CacheSize,int);
 
+  // Description:
+  // Maximum total size, in kibibytes, of the time steps retained in
+  // memory, as reported by vtkDataObject::GetActualMemorySize(). A value
+  // of 0, the default, means that only CacheSize limits the cache.
+  vtkSetMacro(CacheMemoryLimit,unsigned long);
+  vtkGetMacro(CacheMemoryLimit,unsigned long);
+
+  // Description:
+  // Number of time steps following the requested one to read ahead
+  // through the prefetch pipeline. The default is 0: nothing is read
+  // ahead.
+  vtkSetClampMacro(PrefetchSize,int,0,VTK_INT_MAX);
+  vtkGetMacro(PrefetchSize,int);
+
+  // Description:
+  // Output of the pipeline used to read time steps ahead. It must produce
+  // the same data as the input of the cache, and its producer must be
+  // driven by a vtkStreamingDemandDrivenPipeline.
+  void SetPrefetchInputConnection(vtkAlgorithmOutput* output);
+  vtkAlgorithmOutput* GetPrefetchInputConnection();
+
+  // Description:
+  // Block until the time steps scheduled for prefetching have been read.
+  void WaitForPrefetch();
+
+  // Description:
+  // Number of requested time steps that were found among the prefetched
+  // ones.
+  vtkGetMacro(NumberOfPrefetchHits,int);
+
 protected:
   vtkTemporalDataSetCache();
   ~vtkTemporalDataSetCache();
 
   int CacheSize;
+  unsigned long CacheMemoryLimit;
+  int PrefetchSize;
+  int NumberOfPrefetchHits;
+
+  // Pipeline modification time the cached data was checked against.
+  unsigned long CachePipelineMTime;
 
 //BTX
   typedef std::map<double,std::pair<unsigned long,vtkDataObject *> >
@@ -58,6 +113,18 @@ protected:
   CacheType Cache;
 //ETX
 
+  // Description:
+  // Add a time step to the cache and release the least recently used
+  // ones beyond the limits, but never the one just added.
+  void AddToCache(double time, vtkDataObject* data, unsigned long stamp);
+
+  // Description:
+  // Move the time steps read ahead into the cache, and schedule the ones
+  // following the requested time.
+  void UpdatePrefetch(vtkInformation* inInfo, double requestedTime);
+
+  vtkTemporalDataSetCachePrefetcher* Prefetcher;
+
 
   // Description:
   // see vtkAlgorithm for details
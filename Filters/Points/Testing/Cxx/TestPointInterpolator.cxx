@@ -0,0 +1,187 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPointInterpolator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCharArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGaussianKernel.h"
+#include "vtkImageData.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointInterpolator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSPHCubicKernel.h"
+#include "vtkSPHQuinticKernel.h"
+#include "vtkShepardKernel.h"
+#include "vtkStringArray.h"
+#include "vtkVoronoiKernel.h"
+
+#include <cmath>
+
+// Checks that the constant field and labels are reproduced and that the
+// linear field stays within the range of the source values.
+static int CheckOutput(vtkDataSet *output, const char *kernelName)
+{
+  vtkDataArray *constant = output->GetPointData()->GetArray("Constant");
+  vtkDataArray *linear = output->GetPointData()->GetArray("Linear");
+  vtkStringArray *labels = vtkStringArray::SafeDownCast(
+    output->GetPointData()->GetAbstractArray("Labels"));
+  if (!constant || !linear || !labels ||
+      constant->GetNumberOfTuples() != output->GetNumberOfPoints() ||
+      labels->GetNumberOfTuples() != output->GetNumberOfPoints())
+    {
+    cerr << kernelName << ": missing interpolated arrays\n";
+    return 1;
+    }
+
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    if (fabs(constant->GetTuple1(i) - 5.0) > 1.0e-6)
+      {
+      cerr << kernelName << ": constant field not reproduced at point "
+           << i << " (" << constant->GetTuple1(i) << ")\n";
+      return 1;
+      }
+    double value = linear->GetTuple1(i);
+    if (value < -1.0e-6 || value > 6.0 + 1.0e-6)
+      {
+      cerr << kernelName << ": value out of range at point " << i << "\n";
+      return 1;
+      }
+    if (labels->GetValue(i) != "Particle")
+      {
+      cerr << kernelName << ": label not reproduced at point " << i << "\n";
+      return 1;
+      }
+    }
+  return 0;
+}
+
+int TestPointInterpolator(int, char*[])
+{
+  vtkMath::RandomSeed(4321);
+
+  // A particle cloud carrying a constant and a linear field.
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> constant;
+  constant->SetName("Constant");
+  vtkNew<vtkDoubleArray> linear;
+  linear->SetName("Linear");
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("Labels");
+  double x[3];
+  for (int i = 0; i < 20000; ++i)
+    {
+    x[0] = vtkMath::Random();
+    x[1] = vtkMath::Random();
+    x[2] = vtkMath::Random();
+    points->InsertNextPoint(x);
+    constant->InsertNextValue(5.0);
+    linear->InsertNextValue(x[0] + 2.0*x[1] + 3.0*x[2]);
+    labels->InsertNextValue("Particle");
+    }
+  vtkNew<vtkPolyData> source;
+  source->SetPoints(points.GetPointer());
+  source->GetPointData()->AddArray(constant.GetPointer());
+  source->GetPointData()->AddArray(linear.GetPointer());
+  source->GetPointData()->AddArray(labels.GetPointer());
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(11, 11, 11);
+  image->SetSpacing(0.1, 0.1, 0.1);
+
+  vtkNew<vtkPointInterpolator> interpolator;
+  interpolator->SetInputData(image.GetPointer());
+  interpolator->SetSourceData(source.GetPointer());
+
+  int rval = 0;
+
+  vtkNew<vtkVoronoiKernel> voronoi;
+  interpolator->SetKernel(voronoi.GetPointer());
+  interpolator->Update();
+  rval += CheckOutput(interpolator->GetOutput(), "Voronoi");
+
+  vtkNew<vtkGaussianKernel> gaussian;
+  gaussian->SetRadius(0.1);
+  interpolator->SetKernel(gaussian.GetPointer());
+  interpolator->Update();
+  rval += CheckOutput(interpolator->GetOutput(), "Gaussian");
+
+  vtkNew<vtkShepardKernel> shepard;
+  shepard->SetKernelFootprintToNClosest();
+  shepard->SetNumberOfPoints(10);
+  interpolator->SetKernel(shepard.GetPointer());
+  interpolator->Update();
+  rval += CheckOutput(interpolator->GetOutput(), "Shepard");
+
+  vtkNew<vtkSPHCubicKernel> cubic;
+  cubic->SetSpatialStep(0.05);
+  cubic->NormalizeWeightsOn();
+  interpolator->SetKernel(cubic.GetPointer());
+  interpolator->Update();
+  rval += CheckOutput(interpolator->GetOutput(), "SPH cubic");
+
+  vtkNew<vtkSPHQuinticKernel> quintic;
+  quintic->SetSpatialStep(0.03);
+  quintic->NormalizeWeightsOn();
+  interpolator->SetKernel(quintic.GetPointer());
+  vtkNew<vtkKdTreePointLocator> kdTreeLocator;
+  interpolator->SetLocator(kdTreeLocator.GetPointer());
+  interpolator->Update();
+  rval += CheckOutput(interpolator->GetOutput(), "SPH quintic");
+
+  // A radius too small to find neighbors everywhere leaves points masked
+  // and set to the null value.
+  gaussian->SetRadius(0.005);
+  interpolator->SetKernel(gaussian.GetPointer());
+  interpolator->SetNullPointsStrategyToMaskPoints();
+  interpolator->SetNullValue(-1.0);
+  interpolator->Update();
+  vtkDataSet *output = interpolator->GetOutput();
+  vtkCharArray *mask = vtkCharArray::SafeDownCast(
+    output->GetPointData()->GetArray("vtkValidPointMask"));
+  if (!mask)
+    {
+    cerr << "Missing valid point mask\n";
+    return EXIT_FAILURE;
+    }
+  vtkIdType numMasked = 0;
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+    if (!mask->GetValue(i))
+      {
+      ++numMasked;
+      if (output->GetPointData()->GetArray("Linear")->GetTuple1(i) != -1.0)
+        {
+        cerr << "Masked point " << i << " not set to the null value\n";
+        rval++;
+        break;
+        }
+      }
+    }
+  if (numMasked == 0)
+    {
+    cerr << "Expected masked points\n";
+    rval++;
+    }
+
+  // The closest point strategy fills every point.
+  interpolator->SetNullPointsStrategyToClosestPoint();
+  interpolator->Update();
+  rval += CheckOutput(interpolator->GetOutput(), "Closest point");
+
+  return rval == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
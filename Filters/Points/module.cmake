@@ -0,0 +1,10 @@
+vtk_module(vtkFiltersPoints
+  GROUPS
+    StandAlone
+  DEPENDS
+    vtkCommonExecutionModel
+  TEST_DEPENDS
+    vtkTestingCore
+  KIT
+    vtkFilters
+  )
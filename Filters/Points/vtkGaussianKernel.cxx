@@ -0,0 +1,70 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGaussianKernel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkGaussianKernel.h"
+
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+
+#include <cmath>
+
+vtkStandardNewMacro(vtkGaussianKernel);
+
+//----------------------------------------------------------------------------
+vtkGaussianKernel::vtkGaussianKernel()
+{
+  this->Sharpness = 2.0;
+}
+
+//----------------------------------------------------------------------------
+vtkGaussianKernel::~vtkGaussianKernel()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkGaussianKernel::ComputeWeights(double x[3], vtkIdList *pIds,
+                                            vtkDoubleArray *weights)
+{
+  vtkIdType numPts = pIds->GetNumberOfIds();
+  weights->SetNumberOfTuples(numPts);
+  double *w = weights->GetPointer(0);
+  double y[3];
+  double f2 = ( this->Radius > 0.0 ?
+                (this->Sharpness * this->Sharpness) /
+                (this->Radius * this->Radius) : 0.0 );
+
+  for ( vtkIdType i = 0; i < numPts; ++i )
+    {
+    this->DataSet->GetPoint(pIds->GetId(i), y);
+    w[i] = exp(-f2 * vtkMath::Distance2BetweenPoints(x, y));
+    }
+
+  if ( this->NormalizeWeights )
+    {
+    vtkInterpolationKernel::Normalize(numPts, w);
+    }
+
+  return numPts;
+}
+
+//----------------------------------------------------------------------------
+void vtkGaussianKernel::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Sharpness: " << this->Sharpness << "\n";
+}
@@ -0,0 +1,60 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGaussianKernel.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkGaussianKernel - a spherical Gaussian interpolation kernel
+// .SECTION Description
+// vtkGaussianKernel weights each basis point by exp(-(s*r/R)^2), where r is
+// the distance to the interpolation position, R the kernel Radius and s
+// the Sharpness. This is the falloff used by vtkGaussianSplatter, applied
+// here by gathering neighbors rather than by splatting.
+
+// .SECTION See Also
+// vtkGeneralizedKernel vtkPointInterpolator vtkGaussianSplatter
+
+#ifndef __vtkGaussianKernel_h
+#define __vtkGaussianKernel_h
+
+#include "vtkFiltersPointsModule.h" // For export macro
+#include "vtkGeneralizedKernel.h"
+
+class VTKFILTERSPOINTS_EXPORT vtkGaussianKernel : public vtkGeneralizedKernel
+{
+public:
+  static vtkGaussianKernel *New();
+  vtkTypeMacro(vtkGaussianKernel,vtkGeneralizedKernel);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Compute the Gaussian weights of the basis points.
+  virtual vtkIdType ComputeWeights(double x[3], vtkIdList *pIds,
+                                   vtkDoubleArray *weights);
+
+  // Description:
+  // Control the falloff of the Gaussian relative to the Radius. Larger
+  // values concentrate the weight near the interpolation position.
+  vtkSetClampMacro(Sharpness,double,1.0,VTK_DOUBLE_MAX);
+  vtkGetMacro(Sharpness,double);
+
+protected:
+  vtkGaussianKernel();
+  ~vtkGaussianKernel();
+
+  double Sharpness;
+
+private:
+  vtkGaussianKernel(const vtkGaussianKernel&);  // Not implemented.
+  void operator=(const vtkGaussianKernel&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,86 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGeneralizedKernel.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkGeneralizedKernel - kernel with a configurable footprint
+// .SECTION Description
+// vtkGeneralizedKernel is an abstract interpolation kernel whose basis is
+// either all points within a radius of the interpolation position, or the
+// N closest points. Subclasses only define how a weight is derived from
+// the distance to each basis point.
+
+// .SECTION See Also
+// vtkInterpolationKernel vtkGaussianKernel vtkShepardKernel
+
+#ifndef __vtkGeneralizedKernel_h
+#define __vtkGeneralizedKernel_h
+
+#include "vtkFiltersPointsModule.h" // For export macro
+#include "vtkInterpolationKernel.h"
+
+class VTKFILTERSPOINTS_EXPORT vtkGeneralizedKernel :
+  public vtkInterpolationKernel
+{
+public:
+  vtkTypeMacro(vtkGeneralizedKernel,vtkInterpolationKernel);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Gather the basis of x according to the kernel footprint.
+  virtual vtkIdType ComputeBasis(double x[3], vtkIdList *pIds);
+
+//BTX
+  // The footprint of the kernel.
+  enum KernelStyle
+  {
+    RADIUS=0,
+    N_CLOSEST=1
+  };
+//ETX
+
+  // Description:
+  // Specify whether the basis is made of the points within Radius of the
+  // interpolation position (the default) or of the NumberOfPoints closest
+  // points.
+  vtkSetClampMacro(KernelFootprint,int,RADIUS,N_CLOSEST);
+  vtkGetMacro(KernelFootprint,int);
+  void SetKernelFootprintToRadius()
+    {this->SetKernelFootprint(RADIUS);}
+  void SetKernelFootprintToNClosest()
+    {this->SetKernelFootprint(N_CLOSEST);}
+
+  // Description:
+  // The radius of the kernel. It bounds the basis when the footprint is
+  // RADIUS and scales the weights of some kernels.
+  vtkSetClampMacro(Radius,double,0.0,VTK_DOUBLE_MAX);
+  vtkGetMacro(Radius,double);
+
+  // Description:
+  // The number of points in the basis when the footprint is N_CLOSEST.
+  vtkSetClampMacro(NumberOfPoints,int,1,VTK_INT_MAX);
+  vtkGetMacro(NumberOfPoints,int);
+
+protected:
+  vtkGeneralizedKernel();
+  ~vtkGeneralizedKernel();
+
+  int KernelFootprint;
+  double Radius;
+  int NumberOfPoints;
+
+private:
+  vtkGeneralizedKernel(const vtkGeneralizedKernel&);  // Not implemented.
+  void operator=(const vtkGeneralizedKernel&);  // Not implemented.
+};
+
+#endif
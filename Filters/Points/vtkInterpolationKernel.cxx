@@ -0,0 +1,107 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkInterpolationKernel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkInterpolationKernel.h"
+
+#include "vtkAbstractPointLocator.h"
+#include "vtkDataSet.h"
+#include "vtkPointData.h"
+
+//----------------------------------------------------------------------------
+vtkInterpolationKernel::vtkInterpolationKernel()
+{
+  this->NormalizeWeights = true;
+  this->Locator = NULL;
+  this->DataSet = NULL;
+  this->PointData = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkInterpolationKernel::~vtkInterpolationKernel()
+{
+  this->FreeStructures();
+}
+
+//----------------------------------------------------------------------------
+void vtkInterpolationKernel::FreeStructures()
+{
+  if ( this->Locator )
+    {
+    this->Locator->UnRegister(this);
+    this->Locator = NULL;
+    }
+  if ( this->DataSet )
+    {
+    this->DataSet->UnRegister(this);
+    this->DataSet = NULL;
+    }
+  if ( this->PointData )
+    {
+    this->PointData->UnRegister(this);
+    this->PointData = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkInterpolationKernel::Initialize(vtkAbstractPointLocator *loc,
+                                        vtkDataSet *ds, vtkPointData *pd)
+{
+  this->FreeStructures();
+
+  if ( loc )
+    {
+    loc->Register(this);
+    this->Locator = loc;
+    }
+  if ( ds )
+    {
+    ds->Register(this);
+    this->DataSet = ds;
+    }
+  if ( pd )
+    {
+    pd->Register(this);
+    this->PointData = pd;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkInterpolationKernel::Normalize(vtkIdType num, double *w)
+{
+  double sum = 0.0;
+  vtkIdType i;
+  for ( i = 0; i < num; ++i )
+    {
+    sum += w[i];
+    }
+  if ( sum != 0.0 )
+    {
+    for ( i = 0; i < num; ++i )
+      {
+      w[i] /= sum;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkInterpolationKernel::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Normalize Weights: "
+     << (this->NormalizeWeights ? "On\n" : "Off\n");
+  os << indent << "Locator: " << this->Locator << "\n";
+  os << indent << "DataSet: " << this->DataSet << "\n";
+  os << indent << "PointData: " << this->PointData << "\n";
+}
@@ -0,0 +1,100 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkInterpolationKernel.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkInterpolationKernel - base class for point interpolation kernels
+// .SECTION Description
+// vtkInterpolationKernel specifies an abstract interface for interpolation
+// kernels used by vtkPointInterpolator. A kernel is given a position x and
+// determines the set of source points (the basis) that contribute to x,
+// then computes a weight for each point of the basis. The weights are used
+// to combine the point data of the basis into the value at x.
+//
+// Kernels are initialized once per execution with the point locator, the
+// source dataset and its point data. After initialization, ComputeBasis()
+// and ComputeWeights() must be thread safe since they are invoked
+// concurrently by vtkPointInterpolator.
+
+// .SECTION See Also
+// vtkPointInterpolator vtkGeneralizedKernel vtkVoronoiKernel vtkSPHKernel
+
+#ifndef __vtkInterpolationKernel_h
+#define __vtkInterpolationKernel_h
+
+#include "vtkFiltersPointsModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAbstractPointLocator;
+class vtkDataSet;
+class vtkDoubleArray;
+class vtkIdList;
+class vtkPointData;
+
+class VTKFILTERSPOINTS_EXPORT vtkInterpolationKernel : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkInterpolationKernel,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Prepare the kernel for evaluation. The locator must have been built
+  // over the dataset ds, whose point data is pd. This method is not thread
+  // safe; it is called once before any basis or weights are computed.
+  virtual void Initialize(vtkAbstractPointLocator *loc, vtkDataSet *ds,
+                          vtkPointData *pd);
+
+  // Description:
+  // Given a position x, fill pIds with the ids of the source points that
+  // are used to interpolate at x. Returns the number of points found.
+  // This method must be thread safe once the kernel is initialized.
+  virtual vtkIdType ComputeBasis(double x[3], vtkIdList *pIds) = 0;
+
+  // Description:
+  // Given a position x and the basis pIds obtained from ComputeBasis(),
+  // compute one weight per point into weights. Returns the number of
+  // weights. This method must be thread safe once the kernel is
+  // initialized.
+  virtual vtkIdType ComputeWeights(double x[3], vtkIdList *pIds,
+                                   vtkDoubleArray *weights) = 0;
+
+  // Description:
+  // Indicate whether the weights are scaled so that they sum to one. This
+  // makes the interpolation exact for constant fields. Kernels whose
+  // weights are inherently normalized ignore this flag.
+  vtkSetMacro(NormalizeWeights,bool);
+  vtkGetMacro(NormalizeWeights,bool);
+  vtkBooleanMacro(NormalizeWeights,bool);
+
+protected:
+  vtkInterpolationKernel();
+  ~vtkInterpolationKernel();
+
+  bool NormalizeWeights;
+
+  vtkAbstractPointLocator *Locator;
+  vtkDataSet *DataSet;
+  vtkPointData *PointData;
+
+  // Releases the references taken by Initialize().
+  virtual void FreeStructures();
+
+  // Scales the first num weights so that they sum to one (when the sum is
+  // not zero).
+  static void Normalize(vtkIdType num, double *w);
+
+private:
+  vtkInterpolationKernel(const vtkInterpolationKernel&);  // Not implemented.
+  void operator=(const vtkInterpolationKernel&);  // Not implemented.
+};
+
+#endif
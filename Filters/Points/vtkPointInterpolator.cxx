@@ -0,0 +1,430 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPointInterpolator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPointInterpolator.h"
+
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkInterpolationKernel.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkVoronoiKernel.h"
+
+#include <vector>
+
+vtkStandardNewMacro(vtkPointInterpolator);
+vtkCxxSetObjectMacro(vtkPointInterpolator,Locator,vtkAbstractPointLocator);
+vtkCxxSetObjectMacro(vtkPointInterpolator,Kernel,vtkInterpolationKernel);
+
+namespace
+{
+// An output array and the source array it is interpolated from.
+struct vtkPointInterpolatorArrayPair
+{
+  vtkAbstractArray *From;
+  vtkAbstractArray *To;
+};
+
+typedef std::vector<vtkPointInterpolatorArrayPair> vtkPointInterpolatorArrays;
+
+// Interpolates a range of input points. The output arrays are allocated
+// up front so that each thread only writes the tuples it owns.
+class vtkPointInterpolatorOp
+{
+public:
+  vtkDataSet *Input;
+  vtkAbstractPointLocator *Locator;
+  vtkInterpolationKernel *Kernel;
+  vtkPointInterpolatorArrays *Arrays;
+  int Strategy;
+  char *Valid;
+  vtkSMPThreadLocalObject<vtkIdList> PIds;
+  vtkSMPThreadLocalObject<vtkDoubleArray> Weights;
+
+  void Interpolate(vtkIdType ptId, vtkIdList *pIds, double *weights)
+  {
+    vtkPointInterpolatorArrays::iterator it;
+    for ( it = this->Arrays->begin(); it != this->Arrays->end(); ++it )
+      {
+      it->To->InterpolateTuple(ptId, pIds, it->From, weights);
+      }
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkIdList *pIds = this->PIds.Local();
+    vtkDoubleArray *weights = this->Weights.Local();
+    vtkIdType numWeights;
+    double x[3], one = 1.0;
+
+    for ( ; ptId < endPtId; ++ptId )
+      {
+      this->Input->GetPoint(ptId, x);
+
+      numWeights = 0;
+      if ( this->Kernel->ComputeBasis(x, pIds) > 0 )
+        {
+        numWeights = this->Kernel->ComputeWeights(x, pIds, weights);
+        }
+
+      if ( numWeights > 0 )
+        {
+        this->Interpolate(ptId, pIds, weights->GetPointer(0));
+        this->Valid[ptId] = 1;
+        continue;
+        }
+
+      this->Valid[ptId] = 0;
+      if ( this->Strategy == vtkPointInterpolator::CLOSEST_POINT )
+        {
+        vtkIdType closest = this->Locator->FindClosestPoint(x);
+        if ( closest >= 0 )
+          {
+          pIds->SetNumberOfIds(1);
+          pIds->SetId(0, closest);
+          this->Interpolate(ptId, pIds, &one);
+          this->Valid[ptId] = 1;
+          }
+        }
+      }
+  }
+};
+
+// Whether tuples of the array can be interpolated concurrently. Bit,
+// string and variant arrays share state between tuples.
+bool vtkPointInterpolatorIsThreadSafe(vtkAbstractArray *array)
+{
+  return vtkDataArray::SafeDownCast(array) &&
+    array->GetDataType() != VTK_BIT && array->HasStandardMemoryLayout();
+}
+}
+
+//----------------------------------------------------------------------------
+vtkPointInterpolator::vtkPointInterpolator()
+{
+  this->SetNumberOfInputPorts(2);
+
+  this->Locator = vtkPointLocator::New();
+  this->Kernel = vtkVoronoiKernel::New();
+
+  this->NullPointsStrategy = vtkPointInterpolator::NULL_VALUE;
+  this->NullValue = 0.0;
+  this->ValidPointsMaskArrayName = NULL;
+  this->SetValidPointsMaskArrayName("vtkValidPointMask");
+
+  this->PassPointArrays = true;
+  this->PassCellArrays = true;
+  this->PassFieldArrays = true;
+}
+
+//----------------------------------------------------------------------------
+vtkPointInterpolator::~vtkPointInterpolator()
+{
+  this->SetLocator(NULL);
+  this->SetKernel(NULL);
+  this->SetValidPointsMaskArrayName(NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkPointInterpolator::SetSourceConnection(vtkAlgorithmOutput* algOutput)
+{
+  this->SetInputConnection(1, algOutput);
+}
+
+//----------------------------------------------------------------------------
+void vtkPointInterpolator::SetSourceData(vtkDataObject *input)
+{
+  this->SetInputData(1, input);
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject *vtkPointInterpolator::GetSource()
+{
+  if (this->GetNumberOfInputConnections(1) < 1)
+    {
+    return NULL;
+    }
+
+  return this->GetExecutive()->GetInputData(1, 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkPointInterpolator::Probe(vtkDataSet *input, vtkDataSet *source,
+                                 vtkDataSet *output)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData *sourcePD = source->GetPointData();
+  vtkPointData *outPD = output->GetPointData();
+
+  // Build the search structures once; the threaded queries only read them.
+  this->Locator->SetDataSet(source);
+  this->Locator->BuildLocator();
+  this->Kernel->Initialize(this->Locator, source, sourcePD);
+
+  // vtkDataSet::GetPoint(id, x) only reads the input, so the input points
+  // can be queried from several threads.
+  vtkPointData *interpPD = vtkPointData::New();
+  interpPD->InterpolateAllocate(sourcePD, numPts);
+  int i, numArrays = interpPD->GetNumberOfArrays();
+
+  // Pair each output array with its source array. The output arrays are
+  // allocated in the order of the source arrays they are copied from.
+  vtkPointInterpolatorArrays threadedArrays, serialArrays;
+  int numSourceArrays = sourcePD->GetNumberOfArrays(), j = 0;
+  for ( i = 0; i < numArrays; ++i )
+    {
+    vtkAbstractArray *to = interpPD->GetAbstractArray(i);
+    to->SetNumberOfTuples(numPts);
+    for ( ; j < numSourceArrays; ++j )
+      {
+      vtkAbstractArray *from = sourcePD->GetAbstractArray(j);
+      const char *fromName = from->GetName();
+      const char *toName = to->GetName();
+      if ( from->GetDataType() == to->GetDataType() &&
+           from->GetNumberOfComponents() == to->GetNumberOfComponents() &&
+           (fromName && toName ? !strcmp(fromName, toName) :
+            fromName == toName) )
+        {
+        break;
+        }
+      }
+    if ( j == numSourceArrays )
+      {
+      vtkErrorMacro(<<"No source array for output array " << i);
+      break;
+      }
+    vtkPointInterpolatorArrayPair pair;
+    pair.From = sourcePD->GetAbstractArray(j++);
+    pair.To = to;
+    if ( vtkPointInterpolatorIsThreadSafe(to) )
+      {
+      threadedArrays.push_back(pair);
+      }
+    else
+      {
+      serialArrays.push_back(pair);
+      }
+    }
+
+  vtkCharArray *mask = vtkCharArray::New();
+  mask->SetNumberOfTuples(numPts);
+  char *valid = mask->GetPointer(0);
+
+  vtkPointInterpolatorOp op;
+  op.Input = input;
+  op.Locator = this->Locator;
+  op.Kernel = this->Kernel;
+  op.Arrays = &threadedArrays;
+  op.Strategy = this->NullPointsStrategy;
+  op.Valid = valid;
+  vtkSMPTools::For(0, numPts, op);
+
+  // The arrays that cannot be written concurrently are interpolated on
+  // this thread.
+  if ( !serialArrays.empty() )
+    {
+    op.Arrays = &serialArrays;
+    op(0, numPts);
+    }
+
+  // Assign the null value to the points left without a basis.
+  for ( i = 0; i < numArrays; ++i )
+    {
+    vtkDataArray *da = vtkDataArray::SafeDownCast(interpPD->GetAbstractArray(i));
+    if ( !da )
+      {
+      continue;
+      }
+    int numComp = da->GetNumberOfComponents();
+    for ( vtkIdType ptId = 0; ptId < numPts; ++ptId )
+      {
+      if ( !valid[ptId] )
+        {
+        for ( int c = 0; c < numComp; ++c )
+          {
+          da->SetComponent(ptId, c, this->NullValue);
+          }
+        }
+      }
+    }
+
+  // Interpolated arrays replace input arrays with the same name.
+  if ( this->PassPointArrays )
+    {
+    outPD->PassData(input->GetPointData());
+    }
+  for ( i = 0; i < numArrays; ++i )
+    {
+    outPD->AddArray(interpPD->GetAbstractArray(i));
+    }
+  for ( int attr = 0; attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr )
+    {
+    vtkAbstractArray *aa = interpPD->GetAbstractAttribute(attr);
+    if ( aa && aa->GetName() )
+      {
+      outPD->SetActiveAttribute(aa->GetName(), attr);
+      }
+    }
+
+  if ( this->NullPointsStrategy == vtkPointInterpolator::MASK_POINTS )
+    {
+    mask->SetName(this->ValidPointsMaskArrayName);
+    outPD->AddArray(mask);
+    }
+
+  mask->Delete();
+  interpPD->Delete();
+}
+
+//----------------------------------------------------------------------------
+int vtkPointInterpolator::RequestData(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // get the info objects
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *sourceInfo = inputVector[1]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkDataSet *input = vtkDataSet::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkDataSet *source = vtkDataSet::SafeDownCast(
+    sourceInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkDataSet *output = vtkDataSet::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  if ( !this->Locator || !this->Kernel )
+    {
+    vtkErrorMacro(<<"Both a locator and a kernel are required");
+    return 0;
+    }
+
+  output->CopyStructure(input);
+  if ( !source || source->GetNumberOfPoints() < 1 )
+    {
+    vtkWarningMacro(<<"No source points to interpolate from");
+    if ( this->PassPointArrays )
+      {
+      output->GetPointData()->PassData(input->GetPointData());
+      }
+    }
+  else if ( input->GetNumberOfPoints() > 0 )
+    {
+    this->Probe(input, source, output);
+    }
+
+  if ( this->PassCellArrays )
+    {
+    output->GetCellData()->PassData(input->GetCellData());
+    }
+  if ( this->PassFieldArrays )
+    {
+    output->GetFieldData()->PassData(input->GetFieldData());
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPointInterpolator::RequestInformation(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // get the info objects
+  vtkInformation *sourceInfo = inputVector[1]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  // The extent comes from the input by default; the time steps are those
+  // of the source.
+  outInfo->CopyEntry(sourceInfo,
+                     vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  outInfo->CopyEntry(sourceInfo,
+                     vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPointInterpolator::RequestUpdateExtent(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *vtkNotUsed(outputVector))
+{
+  // The input receives the downstream request by default. The whole
+  // source is needed to interpolate any part of the input.
+  vtkInformation *sourceInfo = inputVector[1]->GetInformationObject(0);
+  sourceInfo->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), 0);
+  sourceInfo->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), 1);
+  sourceInfo->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), 0);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPointInterpolator::GetMTime()
+{
+  unsigned long mTime = this->Superclass::GetMTime();
+  unsigned long time;
+
+  if ( this->Locator != NULL )
+    {
+    time = this->Locator->GetMTime();
+    mTime = ( time > mTime ? time : mTime );
+    }
+  if ( this->Kernel != NULL )
+    {
+    time = this->Kernel->GetMTime();
+    mTime = ( time > mTime ? time : mTime );
+    }
+
+  return mTime;
+}
+
+//----------------------------------------------------------------------------
+void vtkPointInterpolator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  vtkDataObject *source = this->GetSource();
+  os << indent << "Source: " << source << "\n";
+  os << indent << "Locator: " << this->Locator << "\n";
+  os << indent << "Kernel: " << this->Kernel << "\n";
+  os << indent << "Null Points Strategy: " << this->NullPointsStrategy << "\n";
+  os << indent << "Null Value: " << this->NullValue << "\n";
+  os << indent << "Valid Points Mask Array Name: "
+     << (this->ValidPointsMaskArrayName ?
+         this->ValidPointsMaskArrayName : "(none)") << "\n";
+  os << indent << "Pass Point Arrays: "
+     << (this->PassPointArrays? "On" : " Off") << "\n";
+  os << indent << "Pass Cell Arrays: "
+     << (this->PassCellArrays? "On" : " Off") << "\n";
+  os << indent << "Pass Field Arrays: "
+     << (this->PassFieldArrays? "On" : " Off") << "\n";
+}
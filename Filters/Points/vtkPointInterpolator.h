@@ -0,0 +1,167 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPointInterpolator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPointInterpolator - interpolate point cloud data onto a dataset
+// .SECTION Description
+// vtkPointInterpolator interpolates the point data of a source dataset
+// (typically an unconnected point cloud such as particles) onto the points
+// of the input dataset, which can be of any type. For every input point a
+// point locator gathers nearby source points and an interpolation kernel
+// weights them; the output is the input with the interpolated point data.
+//
+// The kernel is pluggable: vtkVoronoiKernel (nearest point, the default),
+// vtkGaussianKernel, vtkShepardKernel, vtkSPHCubicKernel and
+// vtkSPHQuinticKernel are provided. Input points are processed in parallel
+// with vtkSMPTools, so the locator and kernel queries must be thread safe
+// once built, as is the case for vtkPointLocator and
+// vtkKdTreePointLocator.
+//
+// Input points for which the kernel finds no source points are handled
+// according to NullPointsStrategy: their values are set to NullValue, they
+// are additionally flagged in a validity mask array, or they take the
+// value of the closest source point.
+
+// .SECTION Caveats
+// The source is requested as a whole (piece 0 of 1) regardless of the
+// piece requested downstream.
+
+// .SECTION See Also
+// vtkInterpolationKernel vtkProbeFilter vtkGaussianSplatter
+// vtkShepardMethod
+
+#ifndef __vtkPointInterpolator_h
+#define __vtkPointInterpolator_h
+
+#include "vtkFiltersPointsModule.h" // For export macro
+#include "vtkDataSetAlgorithm.h"
+
+class vtkAbstractPointLocator;
+class vtkCharArray;
+class vtkInterpolationKernel;
+
+class VTKFILTERSPOINTS_EXPORT vtkPointInterpolator : public vtkDataSetAlgorithm
+{
+public:
+  static vtkPointInterpolator *New();
+  vtkTypeMacro(vtkPointInterpolator,vtkDataSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Specify the dataset whose point data is interpolated. Only its points
+  // and point data are used. Old style pipeline connection.
+  void SetSourceData(vtkDataObject *source);
+  vtkDataObject *GetSource();
+
+  // Description:
+  // Specify the source dataset with a pipeline connection.
+  void SetSourceConnection(vtkAlgorithmOutput* algOutput);
+
+  // Description:
+  // Specify the point locator used to find the basis points. The locator
+  // is built over the source. By default a vtkPointLocator is used.
+  void SetLocator(vtkAbstractPointLocator *locator);
+  vtkGetObjectMacro(Locator,vtkAbstractPointLocator);
+
+  // Description:
+  // Specify the interpolation kernel. By default a vtkVoronoiKernel is
+  // used.
+  void SetKernel(vtkInterpolationKernel *kernel);
+  vtkGetObjectMacro(Kernel,vtkInterpolationKernel);
+
+//BTX
+  enum Strategy
+  {
+    MASK_POINTS=0,
+    NULL_VALUE=1,
+    CLOSEST_POINT=2
+  };
+//ETX
+
+  // Description:
+  // Specify what happens to input points for which the kernel finds no
+  // source points. With NULL_VALUE (the default) the interpolated values
+  // are set to NullValue. MASK_POINTS does the same and also produces a
+  // char array named ValidPointsMaskArrayName that is zero for such points.
+  // CLOSEST_POINT uses the value of the closest source point instead.
+  vtkSetClampMacro(NullPointsStrategy,int,MASK_POINTS,CLOSEST_POINT);
+  vtkGetMacro(NullPointsStrategy,int);
+  void SetNullPointsStrategyToMaskPoints()
+    {this->SetNullPointsStrategy(MASK_POINTS);}
+  void SetNullPointsStrategyToNullValue()
+    {this->SetNullPointsStrategy(NULL_VALUE);}
+  void SetNullPointsStrategyToClosestPoint()
+    {this->SetNullPointsStrategy(CLOSEST_POINT);}
+
+  // Description:
+  // The value assigned to points without basis points.
+  vtkSetMacro(NullValue,double);
+  vtkGetMacro(NullValue,double);
+
+  // Description:
+  // The name of the validity mask produced with the MASK_POINTS strategy.
+  // Defaults to "vtkValidPointMask".
+  vtkSetStringMacro(ValidPointsMaskArrayName);
+  vtkGetStringMacro(ValidPointsMaskArrayName);
+
+  // Description:
+  // Indicate whether the point, cell and field data of the input are
+  // passed to the output. Interpolated arrays replace input point arrays
+  // with the same name. All are on by default.
+  vtkSetMacro(PassPointArrays,bool);
+  vtkGetMacro(PassPointArrays,bool);
+  vtkBooleanMacro(PassPointArrays,bool);
+  vtkSetMacro(PassCellArrays,bool);
+  vtkGetMacro(PassCellArrays,bool);
+  vtkBooleanMacro(PassCellArrays,bool);
+  vtkSetMacro(PassFieldArrays,bool);
+  vtkGetMacro(PassFieldArrays,bool);
+  vtkBooleanMacro(PassFieldArrays,bool);
+
+  // Description:
+  // Take the locator and kernel into account.
+  unsigned long GetMTime();
+
+protected:
+  vtkPointInterpolator();
+  ~vtkPointInterpolator();
+
+  vtkAbstractPointLocator *Locator;
+  vtkInterpolationKernel *Kernel;
+
+  int NullPointsStrategy;
+  double NullValue;
+  char *ValidPointsMaskArrayName;
+
+  bool PassPointArrays;
+  bool PassCellArrays;
+  bool PassFieldArrays;
+
+  virtual int RequestData(vtkInformation *, vtkInformationVector **,
+    vtkInformationVector *);
+  virtual int RequestInformation(vtkInformation *, vtkInformationVector **,
+    vtkInformationVector *);
+  virtual int RequestUpdateExtent(vtkInformation *, vtkInformationVector **,
+    vtkInformationVector *);
+
+  // Description:
+  // Interpolate the source point data onto the points of input and store
+  // the result in output, which already has the structure of input.
+  void Probe(vtkDataSet *input, vtkDataSet *source, vtkDataSet *output);
+
+private:
+  vtkPointInterpolator(const vtkPointInterpolator&);  // Not implemented.
+  void operator=(const vtkPointInterpolator&);  // Not implemented.
+};
+
+#endif
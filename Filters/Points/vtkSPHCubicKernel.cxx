@@ -0,0 +1,40 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSPHCubicKernel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSPHCubicKernel.h"
+
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+
+vtkStandardNewMacro(vtkSPHCubicKernel);
+
+//----------------------------------------------------------------------------
+vtkSPHCubicKernel::vtkSPHCubicKernel()
+{
+  this->CutoffFactor = 2.0;
+  this->Sigma[0] = 1.0 / 6.0;
+  this->Sigma[1] = 5.0 / (14.0 * vtkMath::Pi());
+  this->Sigma[2] = 1.0 / (4.0 * vtkMath::Pi());
+}
+
+//----------------------------------------------------------------------------
+vtkSPHCubicKernel::~vtkSPHCubicKernel()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkSPHCubicKernel::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+}
@@ -0,0 +1,63 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSPHCubicKernel.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSPHCubicKernel - cubic spline SPH kernel
+// .SECTION Description
+// vtkSPHCubicKernel is the M4 cubic B-spline kernel of Monaghan:
+// W(q) = sigma/h^d * ((2-q)^3 - 4(1-q)^3) for q < 1, sigma/h^d * (2-q)^3
+// for 1 <= q < 2 and zero beyond, where q = r/h.
+
+// .SECTION See Also
+// vtkSPHKernel vtkSPHQuinticKernel
+
+#ifndef __vtkSPHCubicKernel_h
+#define __vtkSPHCubicKernel_h
+
+#include "vtkFiltersPointsModule.h" // For export macro
+#include "vtkSPHKernel.h"
+
+class VTKFILTERSPOINTS_EXPORT vtkSPHCubicKernel : public vtkSPHKernel
+{
+public:
+  static vtkSPHCubicKernel *New();
+  vtkTypeMacro(vtkSPHCubicKernel,vtkSPHKernel);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Evaluate the cubic spline at q = r/h.
+  virtual double ComputeFunctionWeight(const double q)
+    {
+    double two = 2.0 - q;
+    if ( q >= 2.0 )
+      {
+      return 0.0;
+      }
+    if ( q >= 1.0 )
+      {
+      return two*two*two;
+      }
+    double one = 1.0 - q;
+    return two*two*two - 4.0*one*one*one;
+    }
+
+protected:
+  vtkSPHCubicKernel();
+  ~vtkSPHCubicKernel();
+
+private:
+  vtkSPHCubicKernel(const vtkSPHCubicKernel&);  // Not implemented.
+  void operator=(const vtkSPHCubicKernel&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,133 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSPHKernel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSPHKernel.h"
+
+#include "vtkAbstractPointLocator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+
+//----------------------------------------------------------------------------
+vtkSPHKernel::vtkSPHKernel()
+{
+  this->NormalizeWeights = false;
+  this->SpatialStep = 0.001;
+  this->Dimension = 3;
+  this->MassArrayName = NULL;
+  this->DensityArrayName = NULL;
+  this->CutoffFactor = 2.0;
+  this->Sigma[0] = this->Sigma[1] = this->Sigma[2] = 1.0;
+  this->Cutoff = 0.0;
+  this->NormFactor = 1.0;
+  this->DefaultVolume = 1.0;
+  this->MassArray = NULL;
+  this->DensityArray = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkSPHKernel::~vtkSPHKernel()
+{
+  this->SetMassArrayName(NULL);
+  this->SetDensityArrayName(NULL);
+}
+
+//----------------------------------------------------------------------------
+void vtkSPHKernel::Initialize(vtkAbstractPointLocator *loc, vtkDataSet *ds,
+                              vtkPointData *pd)
+{
+  this->Superclass::Initialize(loc, ds, pd);
+
+  double h = this->SpatialStep;
+  this->Cutoff = this->CutoffFactor * h;
+  this->DefaultVolume = pow(h, this->Dimension);
+  this->NormFactor = ( h > 0.0 ?
+                       this->Sigma[this->Dimension-1] / this->DefaultVolume :
+                       0.0 );
+
+  this->MassArray = NULL;
+  this->DensityArray = NULL;
+  if ( pd && this->MassArrayName && this->DensityArrayName )
+    {
+    this->MassArray = pd->GetArray(this->MassArrayName);
+    this->DensityArray = pd->GetArray(this->DensityArrayName);
+    if ( !this->MassArray || !this->DensityArray )
+      {
+      vtkWarningMacro(<<"Mass or density array not found, using the "
+                      "default particle volume");
+      this->MassArray = NULL;
+      this->DensityArray = NULL;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSPHKernel::ComputeBasis(double x[3], vtkIdList *pIds)
+{
+  this->Locator->FindPointsWithinRadius(this->Cutoff, x, pIds);
+  return pIds->GetNumberOfIds();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSPHKernel::ComputeWeights(double x[3], vtkIdList *pIds,
+                                       vtkDoubleArray *weights)
+{
+  vtkIdType numPts = pIds->GetNumberOfIds();
+  weights->SetNumberOfTuples(numPts);
+  double *w = weights->GetPointer(0);
+  double y[3], volume, density;
+  double invH = ( this->SpatialStep > 0.0 ? 1.0 / this->SpatialStep : 0.0 );
+  vtkIdType ptId;
+
+  for ( vtkIdType i = 0; i < numPts; ++i )
+    {
+    ptId = pIds->GetId(i);
+    this->DataSet->GetPoint(ptId, y);
+    volume = this->DefaultVolume;
+    if ( this->MassArray )
+      {
+      density = this->DensityArray->GetComponent(ptId, 0);
+      volume = ( density != 0.0 ?
+                 this->MassArray->GetComponent(ptId, 0) / density : 0.0 );
+      }
+    w[i] = volume * this->NormFactor * this->ComputeFunctionWeight(
+      sqrt(vtkMath::Distance2BetweenPoints(x, y)) * invH);
+    }
+
+  if ( this->NormalizeWeights )
+    {
+    vtkInterpolationKernel::Normalize(numPts, w);
+    }
+
+  return numPts;
+}
+
+//----------------------------------------------------------------------------
+void vtkSPHKernel::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Spatial Step: " << this->SpatialStep << "\n";
+  os << indent << "Dimension: " << this->Dimension << "\n";
+  os << indent << "Cutoff Factor: " << this->CutoffFactor << "\n";
+  os << indent << "Mass Array Name: "
+     << (this->MassArrayName ? this->MassArrayName : "(none)") << "\n";
+  os << indent << "Density Array Name: "
+     << (this->DensityArrayName ? this->DensityArrayName : "(none)") << "\n";
+}
@@ -0,0 +1,112 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSPHKernel.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSPHKernel - base class for smoothed particle hydrodynamics kernels
+// .SECTION Description
+// vtkSPHKernel implements the SPH interpolation A(x) = sum_j V_j A_j W(r/h)
+// where h is the SpatialStep (smoothing length), r the distance from x to
+// particle j and V_j the particle volume. The volume is mass/density when
+// both MassArrayName and DensityArrayName name arrays of the source point
+// data, and h^Dimension otherwise. The basis is every particle within
+// CutoffFactor*h of x. Subclasses provide the normalized kernel function
+// W and its cutoff.
+//
+// Unlike the generalized kernels the weights are not normalized by
+// default, since SPH weights carry the particle volumes.
+
+// .SECTION See Also
+// vtkSPHCubicKernel vtkSPHQuinticKernel vtkPointInterpolator
+
+#ifndef __vtkSPHKernel_h
+#define __vtkSPHKernel_h
+
+#include "vtkFiltersPointsModule.h" // For export macro
+#include "vtkInterpolationKernel.h"
+
+class vtkDataArray;
+
+class VTKFILTERSPOINTS_EXPORT vtkSPHKernel : public vtkInterpolationKernel
+{
+public:
+  vtkTypeMacro(vtkSPHKernel,vtkInterpolationKernel);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Resolve the mass and density arrays and compute the kernel
+  // normalization for the current SpatialStep and Dimension.
+  virtual void Initialize(vtkAbstractPointLocator *loc, vtkDataSet *ds,
+                          vtkPointData *pd);
+
+  // Description:
+  // The basis is every point within CutoffFactor*SpatialStep of x.
+  virtual vtkIdType ComputeBasis(double x[3], vtkIdList *pIds);
+
+  // Description:
+  // Compute the SPH weights V_j W(r/h) of the basis points.
+  virtual vtkIdType ComputeWeights(double x[3], vtkIdList *pIds,
+                                   vtkDoubleArray *weights);
+
+  // Description:
+  // Set the smoothing length h of the kernel.
+  vtkSetClampMacro(SpatialStep,double,0.0,VTK_DOUBLE_MAX);
+  vtkGetMacro(SpatialStep,double);
+
+  // Description:
+  // Set the spatial dimension of the data (1, 2 or 3). It selects the
+  // kernel normalization.
+  vtkSetClampMacro(Dimension,int,1,3);
+  vtkGetMacro(Dimension,int);
+
+  // Description:
+  // Name the source point data arrays holding particle mass and density.
+  vtkSetStringMacro(MassArrayName);
+  vtkGetStringMacro(MassArrayName);
+  vtkSetStringMacro(DensityArrayName);
+  vtkGetStringMacro(DensityArrayName);
+
+  // Description:
+  // Return the support of the kernel in units of SpatialStep.
+  vtkGetMacro(CutoffFactor,double);
+
+  // Description:
+  // Evaluate the unnormalized kernel function at q = r/h. Subclasses
+  // return zero for q beyond the cutoff.
+  virtual double ComputeFunctionWeight(const double q) = 0;
+
+protected:
+  vtkSPHKernel();
+  ~vtkSPHKernel();
+
+  double SpatialStep;
+  int Dimension;
+  char *MassArrayName;
+  char *DensityArrayName;
+
+  // Set by subclasses.
+  double CutoffFactor;
+  double Sigma[3]; // normalization per dimension
+
+  // Computed by Initialize().
+  double Cutoff;
+  double NormFactor;
+  double DefaultVolume;
+  vtkDataArray *MassArray;
+  vtkDataArray *DensityArray;
+
+private:
+  vtkSPHKernel(const vtkSPHKernel&);  // Not implemented.
+  void operator=(const vtkSPHKernel&);  // Not implemented.
+};
+
+#endif
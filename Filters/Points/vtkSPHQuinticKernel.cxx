@@ -0,0 +1,40 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSPHQuinticKernel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSPHQuinticKernel.h"
+
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+
+vtkStandardNewMacro(vtkSPHQuinticKernel);
+
+//----------------------------------------------------------------------------
+vtkSPHQuinticKernel::vtkSPHQuinticKernel()
+{
+  this->CutoffFactor = 3.0;
+  this->Sigma[0] = 1.0 / 120.0;
+  this->Sigma[1] = 7.0 / (478.0 * vtkMath::Pi());
+  this->Sigma[2] = 3.0 / (359.0 * vtkMath::Pi());
+}
+
+//----------------------------------------------------------------------------
+vtkSPHQuinticKernel::~vtkSPHQuinticKernel()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkSPHQuinticKernel::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+}
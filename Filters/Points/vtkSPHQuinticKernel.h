@@ -0,0 +1,70 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSPHQuinticKernel.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSPHQuinticKernel - quintic spline SPH kernel
+// .SECTION Description
+// vtkSPHQuinticKernel is the quintic spline kernel of Morris:
+// W(q) = sigma/h^d * ((3-q)^5 - 6(2-q)^5 + 15(1-q)^5) with each term only
+// present while positive, and zero for q >= 3, where q = r/h. It is
+// smoother than the cubic kernel at the cost of a wider support.
+
+// .SECTION See Also
+// vtkSPHKernel vtkSPHCubicKernel
+
+#ifndef __vtkSPHQuinticKernel_h
+#define __vtkSPHQuinticKernel_h
+
+#include "vtkFiltersPointsModule.h" // For export macro
+#include "vtkSPHKernel.h"
+
+class VTKFILTERSPOINTS_EXPORT vtkSPHQuinticKernel : public vtkSPHKernel
+{
+public:
+  static vtkSPHQuinticKernel *New();
+  vtkTypeMacro(vtkSPHQuinticKernel,vtkSPHKernel);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Evaluate the quintic spline at q = r/h.
+  virtual double ComputeFunctionWeight(const double q)
+    {
+    if ( q >= 3.0 )
+      {
+      return 0.0;
+      }
+    double three = 3.0 - q;
+    double w = three*three*three*three*three;
+    if ( q < 2.0 )
+      {
+      double two = 2.0 - q;
+      w -= 6.0*two*two*two*two*two;
+      if ( q < 1.0 )
+        {
+        double one = 1.0 - q;
+        w += 15.0*one*one*one*one*one;
+        }
+      }
+    return w;
+    }
+
+protected:
+  vtkSPHQuinticKernel();
+  ~vtkSPHQuinticKernel();
+
+private:
+  vtkSPHQuinticKernel(const vtkSPHQuinticKernel&);  // Not implemented.
+  void operator=(const vtkSPHQuinticKernel&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,80 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkShepardKernel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkShepardKernel.h"
+
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+
+#include <cmath>
+
+vtkStandardNewMacro(vtkShepardKernel);
+
+//----------------------------------------------------------------------------
+vtkShepardKernel::vtkShepardKernel()
+{
+  this->PowerParameter = 2.0;
+}
+
+//----------------------------------------------------------------------------
+vtkShepardKernel::~vtkShepardKernel()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkShepardKernel::ComputeWeights(double x[3], vtkIdList *pIds,
+                                           vtkDoubleArray *weights)
+{
+  vtkIdType numPts = pIds->GetNumberOfIds();
+  weights->SetNumberOfTuples(numPts);
+  double *w = weights->GetPointer(0);
+  double y[3], d2;
+  double halfPower = 0.5 * this->PowerParameter;
+
+  for ( vtkIdType i = 0; i < numPts; ++i )
+    {
+    this->DataSet->GetPoint(pIds->GetId(i), y);
+    d2 = vtkMath::Distance2BetweenPoints(x, y);
+    if ( d2 == 0.0 )
+      {
+      // Coincident point: interpolate its value exactly.
+      for ( vtkIdType j = 0; j < numPts; ++j )
+        {
+        w[j] = 0.0;
+        }
+      w[i] = 1.0;
+      return numPts;
+      }
+    w[i] = ( this->PowerParameter == 2.0 ? 1.0 / d2 :
+             1.0 / pow(d2, halfPower) );
+    }
+
+  if ( this->NormalizeWeights )
+    {
+    vtkInterpolationKernel::Normalize(numPts, w);
+    }
+
+  return numPts;
+}
+
+//----------------------------------------------------------------------------
+void vtkShepardKernel::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Power Parameter: " << this->PowerParameter << "\n";
+}
@@ -0,0 +1,59 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkShepardKernel.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkShepardKernel - inverse distance weighting interpolation kernel
+// .SECTION Description
+// vtkShepardKernel weights each basis point by 1/r^p, where r is the
+// distance to the interpolation position and p the PowerParameter; this
+// is the weighting of vtkShepardMethod. When the interpolation position
+// coincides with a basis point that point receives all of the weight.
+
+// .SECTION See Also
+// vtkGeneralizedKernel vtkPointInterpolator vtkShepardMethod
+
+#ifndef __vtkShepardKernel_h
+#define __vtkShepardKernel_h
+
+#include "vtkFiltersPointsModule.h" // For export macro
+#include "vtkGeneralizedKernel.h"
+
+class VTKFILTERSPOINTS_EXPORT vtkShepardKernel : public vtkGeneralizedKernel
+{
+public:
+  static vtkShepardKernel *New();
+  vtkTypeMacro(vtkShepardKernel,vtkGeneralizedKernel);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Compute the inverse distance weights of the basis points.
+  virtual vtkIdType ComputeWeights(double x[3], vtkIdList *pIds,
+                                   vtkDoubleArray *weights);
+
+  // Description:
+  // Set the power of the distance in the weighting function.
+  vtkSetClampMacro(PowerParameter,double,0.001,100);
+  vtkGetMacro(PowerParameter,double);
+
+protected:
+  vtkShepardKernel();
+  ~vtkShepardKernel();
+
+  double PowerParameter;
+
+private:
+  vtkShepardKernel(const vtkShepardKernel&);  // Not implemented.
+  void operator=(const vtkShepardKernel&);  // Not implemented.
+};
+
+#endif
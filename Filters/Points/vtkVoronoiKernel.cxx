@@ -0,0 +1,64 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkVoronoiKernel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkVoronoiKernel.h"
+
+#include "vtkAbstractPointLocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+
+vtkStandardNewMacro(vtkVoronoiKernel);
+
+//----------------------------------------------------------------------------
+vtkVoronoiKernel::vtkVoronoiKernel()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkVoronoiKernel::~vtkVoronoiKernel()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkVoronoiKernel::ComputeBasis(double x[3], vtkIdList *pIds)
+{
+  pIds->Reset();
+  vtkIdType ptId = this->Locator->FindClosestPoint(x);
+  if ( ptId >= 0 )
+    {
+    pIds->InsertNextId(ptId);
+    }
+  return pIds->GetNumberOfIds();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkVoronoiKernel::ComputeWeights(double vtkNotUsed(x)[3],
+                                           vtkIdList *pIds,
+                                           vtkDoubleArray *weights)
+{
+  vtkIdType numPts = pIds->GetNumberOfIds();
+  weights->SetNumberOfTuples(numPts);
+  for ( vtkIdType i = 0; i < numPts; ++i )
+    {
+    weights->SetValue(i, ( i == 0 ? 1.0 : 0.0 ));
+    }
+  return numPts;
+}
+
+//----------------------------------------------------------------------------
+void vtkVoronoiKernel::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+}
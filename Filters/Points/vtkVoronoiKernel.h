@@ -0,0 +1,55 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkVoronoiKernel.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkVoronoiKernel - nearest point interpolation kernel
+// .SECTION Description
+// vtkVoronoiKernel uses the single closest source point as the basis, so
+// the interpolated value is the value of the Voronoi cell containing the
+// interpolation position. It requires no scale parameter.
+
+// .SECTION See Also
+// vtkInterpolationKernel vtkPointInterpolator
+
+#ifndef __vtkVoronoiKernel_h
+#define __vtkVoronoiKernel_h
+
+#include "vtkFiltersPointsModule.h" // For export macro
+#include "vtkInterpolationKernel.h"
+
+class VTKFILTERSPOINTS_EXPORT vtkVoronoiKernel : public vtkInterpolationKernel
+{
+public:
+  static vtkVoronoiKernel *New();
+  vtkTypeMacro(vtkVoronoiKernel,vtkInterpolationKernel);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // The basis is the closest source point.
+  virtual vtkIdType ComputeBasis(double x[3], vtkIdList *pIds);
+
+  // Description:
+  // The closest point receives a weight of one.
+  virtual vtkIdType ComputeWeights(double x[3], vtkIdList *pIds,
+                                   vtkDoubleArray *weights);
+
+protected:
+  vtkVoronoiKernel();
+  ~vtkVoronoiKernel();
+
+private:
+  vtkVoronoiKernel(const vtkVoronoiKernel&);  // Not implemented.
+  void operator=(const vtkVoronoiKernel&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,273 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLZ4Compress.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that vtkLZ4DataCompressor restores data of various
+// sizes and redundancy, compresses redundant data, rejects corrupt input,
+// and reads and writes the blocks of the reference LZ4 implementation.
+
+#include "vtkLZ4DataCompressor.h"
+#include "vtkNew.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+// Blocks of the reference lz4 tool (v1.9.4), extracted from the frames
+// written by "lz4 -9 -BI --no-frame-crc" for the text and "lz4 -1 -BI
+// --no-frame-crc" for the noise. TextBlock is written by this
+// compressor and was checked with "lz4 -d"; for the noise, this
+// compressor writes the same block as the lz4 tool.
+const unsigned char TextBlockLZ4HC[] =
+{
+  0xff, 0x10, 0x56, 0x54, 0x4b, 0x20, 0x58, 0x4d, 0x4c, 0x20, 0x61, 0x70,
+  0x70, 0x65, 0x6e, 0x64, 0x65, 0x64, 0x20, 0x64, 0x61, 0x74, 0x61, 0x20,
+  0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x20, 0x30, 0x2c, 0x20, 0x1f, 0x00, 0x09,
+  0x1f, 0x31, 0x1f, 0x00, 0x0b, 0x1f, 0x32, 0x1f, 0x00, 0x0b, 0x1f, 0x33,
+  0x1f, 0x00, 0x0b, 0x1f, 0x34, 0x1f, 0x00, 0x0b, 0x1f, 0x35, 0x1f, 0x00,
+  0x0b, 0x3f, 0x36, 0x2c, 0x20, 0xd9, 0x00, 0x83, 0x50, 0x6b, 0x20, 0x34,
+  0x2c, 0x20
+};
+
+const unsigned char TextBlock[] =
+{
+  0xff, 0x10, 0x56, 0x54, 0x4b, 0x20, 0x58, 0x4d, 0x4c, 0x20, 0x61, 0x70,
+  0x70, 0x65, 0x6e, 0x64, 0x65, 0x64, 0x20, 0x64, 0x61, 0x74, 0x61, 0x20,
+  0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x20, 0x30, 0x2c, 0x20, 0x1f, 0x00, 0x09,
+  0x1f, 0x31, 0x1f, 0x00, 0x0b, 0x1f, 0x32, 0x1f, 0x00, 0x0b, 0x1f, 0x33,
+  0x1f, 0x00, 0x0b, 0x1f, 0x34, 0x1f, 0x00, 0x0b, 0x1f, 0x35, 0x1f, 0x00,
+  0x0b, 0x1f, 0x36, 0x1f, 0x00, 0x0b, 0x0f, 0xd9, 0x00, 0x67, 0x50, 0x6b,
+  0x20, 0x34, 0x2c, 0x20
+};
+
+const unsigned char NoiseBlock[] =
+{
+  0xff, 0xff, 0x1e, 0xdc, 0x04, 0x65, 0xaa, 0x1f, 0xad, 0x1d, 0x5a, 0xda,
+  0xe5, 0xac, 0x1b, 0x1e, 0x5f, 0x13, 0x70, 0x79, 0x6c, 0xfd, 0x10, 0xff,
+  0x19, 0xaf, 0x60, 0x1d, 0x04, 0xac, 0xb4, 0x1d, 0x02, 0x2b, 0x46, 0x78,
+  0x73, 0x3a, 0xf2, 0xdf, 0x5f, 0xae, 0xb7, 0x08, 0x59, 0xd1, 0xee, 0x39,
+  0x10, 0xcb, 0x48, 0x95, 0xb5, 0xcc, 0x89, 0x29, 0x11, 0xff, 0x06, 0xb6,
+  0x62, 0x2e, 0xdf, 0x3c, 0xf9, 0x35, 0xfd, 0x4b, 0x94, 0x28, 0xca, 0x09,
+  0x7c, 0x44, 0xb3, 0x02, 0x5e, 0x96, 0x5f, 0xb3, 0xea, 0x6d, 0xac, 0xd4,
+  0x2d, 0x81, 0x6e, 0x69, 0xaf, 0xe0, 0xe6, 0x87, 0x4c, 0x9c, 0x04, 0xe7,
+  0xd2, 0x36, 0x5d, 0x2c, 0x60, 0xc9, 0xea, 0xf4, 0x79, 0xf6, 0x86, 0xa0,
+  0xeb, 0x93, 0x26, 0xe4, 0x62, 0x12, 0xd5, 0x0d, 0xcb, 0xb3, 0x77, 0x15,
+  0x6a, 0x6a, 0x3a, 0x68, 0xba, 0x8e, 0xdb, 0x74, 0x08, 0x46, 0x9e, 0xf3,
+  0xce, 0xb3, 0x0a, 0xf8, 0xd0, 0xdd, 0x68, 0xbb, 0xf8, 0x5f, 0xfa, 0x24,
+  0xf2, 0xd2, 0xfc, 0x18, 0x87, 0xfb, 0x5c, 0x87, 0xba, 0xb4, 0x38, 0x32,
+  0xa5, 0x9b, 0x1b, 0x3d, 0x10, 0x7c, 0xf7, 0x78, 0xd6, 0x7f, 0xe2, 0x6d,
+  0xf8, 0x11, 0x91, 0x29, 0x7e, 0x93, 0x95, 0xcb, 0x12, 0xc5, 0x57, 0xce,
+  0x5a, 0xf1, 0xd4, 0x16, 0x18, 0xd7, 0x19, 0xbc, 0x04, 0x5b, 0x7e, 0x99,
+  0x65, 0xf1, 0xa2, 0x94, 0x71, 0xc4, 0x2a, 0xac, 0x6a, 0xa9, 0x38, 0xc4,
+  0x75, 0xc7, 0xad, 0x32, 0x38, 0x02, 0x1f, 0x05, 0x3b, 0x2c, 0x99, 0x1a,
+  0xfc, 0xeb, 0x15, 0xde, 0xcf, 0x68, 0xba, 0xe0, 0x7c, 0xbc, 0xd6, 0x1e,
+  0x97, 0x1b, 0x9a, 0x0b, 0x9d, 0xbe, 0x97, 0x63, 0xd3, 0x92, 0xfc, 0xaf,
+  0xdf, 0xa2, 0x8c, 0x97, 0x23, 0x45, 0x62, 0xeb, 0xdd, 0x07, 0x65, 0x70,
+  0xff, 0x58, 0x89, 0x6a, 0xcf, 0xf7, 0xca, 0xee, 0x3f, 0x1c, 0xe9, 0xe4,
+  0x0a, 0x68, 0xe5, 0xde, 0x93, 0x8d, 0x38, 0x9c, 0x7d, 0xbd, 0xd7, 0x5b,
+  0x09, 0xd4, 0xe7, 0xe2, 0x33, 0x44, 0x3f, 0x4a, 0x8c, 0xc4, 0xa1, 0x90,
+  0xd6, 0xb8, 0xb8, 0xdc, 0x61, 0x5f, 0xd1, 0x8e, 0x28, 0xbe, 0x59, 0x0e,
+  0xaa, 0x50, 0x1b, 0x2c, 0x01, 0xff, 0x1a, 0x1f, 0x78, 0x01, 0x00, 0xff,
+  0xff, 0xff, 0xd2, 0x50, 0x78, 0x78, 0x78, 0x78, 0x78
+};
+
+// Twelve phrases of the form "VTK XML appended data block i, ".
+std::vector<unsigned char> MakeText()
+{
+  std::string text;
+  for (int i = 0; i < 12; ++i)
+    {
+    char phrase[40];
+    sprintf(phrase, "VTK XML appended data block %d, ", i % 7);
+    text += phrase;
+    }
+  return std::vector<unsigned char>(text.begin(), text.end());
+}
+
+// 300 bytes of noise, repeated once, then 1000 bytes of 'x': literal
+// and match lengths that take several length bytes.
+std::vector<unsigned char> MakeNoise()
+{
+  std::vector<unsigned char> noise(300);
+  unsigned int seed = 12345;
+  for (size_t i = 0; i < noise.size(); ++i)
+    {
+    seed = seed * 1103515245u + 12345u;
+    noise[i] = static_cast<unsigned char>(seed >> 16);
+    }
+  std::vector<unsigned char> data(noise);
+  data.insert(data.end(), noise.begin(), noise.end());
+  data.insert(data.end(), 1000, 'x');
+  return data;
+}
+
+bool Decodes(vtkLZ4DataCompressor* compressor, const unsigned char* block,
+             size_t length, const std::vector<unsigned char>& data,
+             const char* name)
+{
+  std::vector<unsigned char> restored(data.size());
+  if (compressor->Uncompress(block, length, &restored[0], restored.size())
+      != data.size() || restored != data)
+    {
+    cerr << name << ": the reference block was not restored" << endl;
+    return false;
+    }
+  return true;
+}
+
+bool Encodes(vtkLZ4DataCompressor* compressor,
+             const std::vector<unsigned char>& data,
+             const unsigned char* block, size_t length, const char* name)
+{
+  std::vector<unsigned char> compressed(
+    compressor->GetMaximumCompressionSpace(data.size()));
+  size_t size = compressor->Compress(&data[0], data.size(), &compressed[0],
+                                     compressed.size());
+  if (size != length || memcmp(&compressed[0], block, length) != 0)
+    {
+    cerr << name << ": the block differs from the reference" << endl;
+    return false;
+    }
+  return true;
+}
+
+bool RoundTrip(vtkLZ4DataCompressor* compressor,
+               const std::vector<unsigned char>& data, const char* name,
+               size_t* compressedSize)
+{
+  size_t size = data.size();
+  const unsigned char* buffer = size ? &data[0] : 0;
+  std::vector<unsigned char> compressed(
+    compressor->GetMaximumCompressionSpace(size));
+  size_t length = compressor->Compress(buffer, size, &compressed[0],
+                                       compressed.size());
+  if (length == 0)
+    {
+    cerr << name << ": compression failed" << endl;
+    return false;
+    }
+  std::vector<unsigned char> restored(size + 1);
+  if (compressor->Uncompress(&compressed[0], length, &restored[0], size)
+      != size || (size && memcmp(&restored[0], buffer, size) != 0))
+    {
+    cerr << name << ": the data were not restored" << endl;
+    return false;
+    }
+  *compressedSize = length;
+  return true;
+}
+}
+
+int TestLZ4Compress(int, char*[])
+{
+  vtkNew<vtkLZ4DataCompressor> compressor;
+  size_t length;
+
+  // Blocks of the reference implementation.
+  std::vector<unsigned char> text = MakeText();
+  std::vector<unsigned char> noiseBlock = MakeNoise();
+  if (!Decodes(compressor.GetPointer(), TextBlockLZ4HC,
+               sizeof(TextBlockLZ4HC), text, "Text (lz4 -9)") ||
+      !Decodes(compressor.GetPointer(), NoiseBlock, sizeof(NoiseBlock),
+               noiseBlock, "Noise") ||
+      !Encodes(compressor.GetPointer(), text, TextBlock, sizeof(TextBlock),
+               "Text") ||
+      !Encodes(compressor.GetPointer(), noiseBlock, NoiseBlock,
+               sizeof(NoiseBlock), "Noise"))
+    {
+    return TEST_FAILURE;
+    }
+
+  // Small buffers are stored as literals.
+  for (size_t size = 0; size < 40; ++size)
+    {
+    std::vector<unsigned char> data(size);
+    for (size_t i = 0; i < size; ++i)
+      {
+      data[i] = static_cast<unsigned char>(i % 3);
+      }
+    if (!RoundTrip(compressor.GetPointer(), data, "Small", &length))
+      {
+      return TEST_FAILURE;
+      }
+    }
+
+  // A repeated byte makes matches overlapping their output.
+  std::vector<unsigned char> constant(100000, 7);
+  if (!RoundTrip(compressor.GetPointer(), constant, "Constant", &length))
+    {
+    return TEST_FAILURE;
+    }
+  if (length > 1000)
+    {
+    cerr << "Constant data compressed to " << length << " bytes" << endl;
+    return TEST_FAILURE;
+    }
+
+  // Pseudo-random data do not compress and need long literal runs.
+  std::vector<unsigned char> noise(100000);
+  unsigned int seed = 12345;
+  for (size_t i = 0; i < noise.size(); ++i)
+    {
+    seed = seed * 1103515245u + 12345u;
+    noise[i] = static_cast<unsigned char>(seed >> 16);
+    }
+  if (!RoundTrip(compressor.GetPointer(), noise, "Noise", &length))
+    {
+    return TEST_FAILURE;
+    }
+
+  // Noise repeated at distances below and above the window: only the
+  // first repetition can be found, the rest costs a length byte per 255
+  // literals.
+  std::vector<unsigned char> repeated(noise.begin(), noise.begin() + 1000);
+  repeated.insert(repeated.end(), noise.begin(), noise.end());
+  repeated.insert(repeated.end(), noise.begin(), noise.begin() + 1000);
+  compressor->SetAcceleration(4);
+  if (!RoundTrip(compressor.GetPointer(), repeated, "Repeated", &length))
+    {
+    return TEST_FAILURE;
+    }
+  if (length > repeated.size() - 500)
+    {
+    cerr << "Repeated data compressed to " << length << " bytes" << endl;
+    return TEST_FAILURE;
+    }
+
+  // Corrupt input and a wrong size are errors.
+  vtkUnsignedCharArray* compressed =
+    compressor->Compress(&constant[0], constant.size());
+  std::vector<unsigned char> restored(constant.size());
+  cerr << "Expecting errors:" << endl;
+  if (compressor->Uncompress(compressed->GetPointer(0),
+                             compressed->GetNumberOfTuples() - 1,
+                             &restored[0], restored.size()) != 0 ||
+      compressor->Uncompress(compressed->GetPointer(0),
+                             compressed->GetNumberOfTuples(),
+                             &restored[0], restored.size() - 1) != 0)
+    {
+    cerr << "Corrupt data were accepted" << endl;
+    compressed->Delete();
+    return TEST_FAILURE;
+    }
+  compressed->Delete();
+
+  return TEST_SUCCESS;
+}
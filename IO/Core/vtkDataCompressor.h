@@ -18,6 +18,10 @@
 // compression.  Subclasses provide one compression method and one
 // decompression method.  The public interface to all compressors
 // remains the same, and is defined by this class.
+//
+// The XML readers and writers compress and decompress several blocks
+// concurrently with the same compressor, so subclasses must not modify
+// their state while compressing or decompressing.
 
 #ifndef __vtkDataCompressor_h
 #define __vtkDataCompressor_h
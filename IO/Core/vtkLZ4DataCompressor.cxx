@@ -0,0 +1,303 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLZ4DataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLZ4DataCompressor.h"
+#include "vtkObjectFactory.h"
+
+#include <string.h>
+
+vtkStandardNewMacro(vtkLZ4DataCompressor);
+
+// The LZ4 block format is a sequence of
+//   token (literal length << 4 | match length - 4)
+//   [additional literal length bytes] literals
+//   offset (2 bytes, little endian)
+//   [additional match length bytes]
+// where a length of 15 in the token is followed by bytes added to it
+// until one is not 255.  The last sequence only has literals.  The last
+// 5 bytes of a block are literals and the last match starts at least 12
+// bytes before the end of the block.
+namespace
+{
+const size_t vtkLZ4MinMatch = 4;
+const size_t vtkLZ4LastLiterals = 5;
+const size_t vtkLZ4MatchFindLimit = 12;
+const size_t vtkLZ4MaxOffset = 65535;
+const int vtkLZ4HashBits = 12;
+
+inline vtkTypeUInt32 vtkLZ4Read32(const unsigned char* p)
+{
+  vtkTypeUInt32 value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline vtkTypeUInt32 vtkLZ4Hash(const unsigned char* p)
+{
+  return (vtkLZ4Read32(p) * 2654435761u) >> (32 - vtkLZ4HashBits);
+}
+
+// Write the additional bytes of a length larger than 14.
+inline unsigned char* vtkLZ4WriteLength(unsigned char* op, size_t length)
+{
+  for (length -= 15; length >= 255; length -= 255)
+    {
+    *op++ = 255;
+    }
+  *op++ = static_cast<unsigned char>(length);
+  return op;
+}
+
+// Read the additional bytes of a length of 15, or return false.
+inline bool vtkLZ4ReadLength(const unsigned char*& ip,
+                             const unsigned char* iend, size_t& length)
+{
+  unsigned char b;
+  do
+    {
+    if (ip >= iend)
+      {
+      return false;
+      }
+    b = *ip++;
+    length += b;
+    }
+  while (b == 255);
+  return true;
+}
+
+// Write a sequence of literals followed by a match, or only literals if
+// matchLength is 0.  Return NULL if the output is too small.
+unsigned char* vtkLZ4WriteSequence(unsigned char* op, unsigned char* oend,
+                                   const unsigned char* literals,
+                                   size_t literalLength, size_t offset,
+                                   size_t matchLength)
+{
+  // Worst case size of the sequence.
+  if (static_cast<size_t>(oend - op) <
+      1 + literalLength + literalLength / 255 + 1 + 2 + matchLength / 255 + 1)
+    {
+    return 0;
+    }
+
+  unsigned char* token = op++;
+  if (literalLength >= 15)
+    {
+    *token = 15 << 4;
+    op = vtkLZ4WriteLength(op, literalLength);
+    }
+  else
+    {
+    *token = static_cast<unsigned char>(literalLength << 4);
+    }
+  memcpy(op, literals, literalLength);
+  op += literalLength;
+
+  if (matchLength == 0)
+    {
+    return op;
+    }
+  *op++ = static_cast<unsigned char>(offset & 0xff);
+  *op++ = static_cast<unsigned char>(offset >> 8);
+  size_t length = matchLength - vtkLZ4MinMatch;
+  if (length >= 15)
+    {
+    *token |= 15;
+    op = vtkLZ4WriteLength(op, length);
+    }
+  else
+    {
+    *token |= static_cast<unsigned char>(length);
+    }
+  return op;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DataCompressor::vtkLZ4DataCompressor()
+{
+  this->Acceleration = 1;
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DataCompressor::~vtkLZ4DataCompressor()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkLZ4DataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Acceleration: " << this->Acceleration << endl;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+                                     size_t uncompressedSize,
+                                     unsigned char* compressedData,
+                                     size_t compressionSpace)
+{
+  const unsigned char* src = uncompressedData;
+  const unsigned char* iend = src + uncompressedSize;
+  const unsigned char* ip = src;
+  const unsigned char* anchor = src;
+  unsigned char* op = compressedData;
+  unsigned char* oend = op + compressionSpace;
+
+  if (uncompressedSize > vtkLZ4MatchFindLimit)
+    {
+    // Positions of the last occurrence of each hashed 4-byte sequence.
+    // The table is local so that blocks can be compressed concurrently.
+    size_t table[1 << vtkLZ4HashBits];
+    memset(table, 0, sizeof(table));
+
+    const unsigned char* mflimit = iend - vtkLZ4MatchFindLimit;
+    const unsigned char* matchlimit = iend - vtkLZ4LastLiterals;
+    ++ip;
+    while (ip <= mflimit)
+      {
+      vtkTypeUInt32 h = vtkLZ4Hash(ip);
+      const unsigned char* ref = src + table[h];
+      table[h] = ip - src;
+      if (static_cast<size_t>(ip - ref) > vtkLZ4MaxOffset ||
+          vtkLZ4Read32(ref) != vtkLZ4Read32(ip))
+        {
+        // Move faster through data that do not compress.
+        ip += this->Acceleration + ((ip - anchor) >> 6);
+        continue;
+        }
+
+      // Extend the match backward and forward.
+      while (ip > anchor && ref > src && ip[-1] == ref[-1])
+        {
+        --ip;
+        --ref;
+        }
+      size_t length = vtkLZ4MinMatch;
+      while (ip + length < matchlimit && ip[length] == ref[length])
+        {
+        ++length;
+        }
+
+      op = vtkLZ4WriteSequence(op, oend, anchor, ip - anchor, ip - ref,
+                               length);
+      if (!op)
+        {
+        vtkErrorMacro("Insufficient space to compress data.");
+        return 0;
+        }
+      ip += length;
+      anchor = ip;
+      table[vtkLZ4Hash(ip - 2)] = ip - 2 - src;
+      }
+    }
+
+  // The remaining data are literals.
+  op = vtkLZ4WriteSequence(op, oend, anchor, iend - anchor, 0, 0);
+  if (!op)
+    {
+    vtkErrorMacro("Insufficient space to compress data.");
+    return 0;
+    }
+  return static_cast<size_t>(op - compressedData);
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::UncompressBuffer(unsigned char const* compressedData,
+                                       size_t compressedSize,
+                                       unsigned char* uncompressedData,
+                                       size_t uncompressedSize)
+{
+  const unsigned char* ip = compressedData;
+  const unsigned char* iend = ip + compressedSize;
+  unsigned char* op = uncompressedData;
+  unsigned char* oend = op + uncompressedSize;
+
+  while (ip < iend)
+    {
+    unsigned char token = *ip++;
+
+    // Copy the literals.
+    size_t length = token >> 4;
+    if (length == 15 && !vtkLZ4ReadLength(ip, iend, length))
+      {
+      break;
+      }
+    if (length > static_cast<size_t>(iend - ip) ||
+        length > static_cast<size_t>(oend - op))
+      {
+      break;
+      }
+    memcpy(op, ip, length);
+    ip += length;
+    op += length;
+    if (ip == iend)
+      {
+      // This was the last sequence.
+      if (op != oend)
+        {
+        break;
+        }
+      return uncompressedSize;
+      }
+
+    // Copy the match, which may overlap the output.
+    if (iend - ip < 2)
+      {
+      break;
+      }
+    size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    length = token & 15;
+    if (length == 15 && !vtkLZ4ReadLength(ip, iend, length))
+      {
+      break;
+      }
+    length += vtkLZ4MinMatch;
+    if (offset == 0 ||
+        offset > static_cast<size_t>(op - uncompressedData) ||
+        length > static_cast<size_t>(oend - op))
+      {
+      break;
+      }
+    const unsigned char* match = op - offset;
+    if (offset >= length)
+      {
+      memcpy(op, match, length);
+      op += length;
+      }
+    else
+      {
+      for (unsigned char* end = op + length; op != end;)
+        {
+        *op++ = *match++;
+        }
+      }
+    }
+
+  vtkErrorMacro("LZ4 error while uncompressing data.");
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  // Data that do not compress are stored as literals, with one length
+  // byte per 255 bytes.
+  return size + size/255 + 16;
+}
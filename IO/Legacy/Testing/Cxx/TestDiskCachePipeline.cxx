@@ -0,0 +1,230 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDiskCachePipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that vtkDiskCachePipeline stores outputs on disk,
+// that an identical pipeline reads them back without executing, and that
+// changes to parameters, cache keys or update requests miss the cache.
+
+#include "vtkDiskCachePipeline.h"
+#include "vtkFloatArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+// Produces a line of points with a scalar array when NumberOfInputPorts
+// is 0, otherwise translates its input.
+class DiskCacheAlgorithm : public vtkPolyDataAlgorithm
+{
+public:
+  static DiskCacheAlgorithm *New();
+  vtkTypeMacro(DiskCacheAlgorithm,vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent)
+  {
+    this->Superclass::PrintSelf(os, indent);
+    os << indent << "Value: " << this->Value << endl;
+  }
+
+  vtkSetMacro(Value,double);
+
+  void SetSource()
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  double Value;
+  int NumberOfExecutions;
+
+protected:
+  DiskCacheAlgorithm()
+  {
+    this->Value = 1.0;
+    this->NumberOfExecutions = 0;
+  }
+
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector)
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    if (this->GetNumberOfInputPorts() == 0)
+      {
+      vtkPoints* points = vtkPoints::New();
+      vtkFloatArray* scalars = vtkFloatArray::New();
+      scalars->SetName("Scalars");
+      for (int i = 0; i < 100; ++i)
+        {
+        points->InsertNextPoint(this->Value * i, 0.0, 0.0);
+        scalars->InsertNextValue(i);
+        }
+      output->SetPoints(points);
+      output->GetPointData()->SetScalars(scalars);
+      points->Delete();
+      scalars->Delete();
+      }
+    else
+      {
+      vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+      vtkPoints* points = vtkPoints::New();
+      points->DeepCopy(input->GetPoints());
+      for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+        {
+        double x[3];
+        points->GetPoint(i, x);
+        x[1] += this->Value;
+        points->SetPoint(i, x);
+        }
+      output->SetPoints(points);
+      output->GetPointData()->PassData(input->GetPointData());
+      points->Delete();
+      }
+    this->NumberOfExecutions++;
+    return 1;
+  }
+
+private:
+  DiskCacheAlgorithm(const DiskCacheAlgorithm&);
+  void operator=(const DiskCacheAlgorithm&);
+};
+vtkStandardNewMacro(DiskCacheAlgorithm);
+
+// A source followed by a filter whose outputs are cached, as a separate
+// batch job would create it.
+class DiskCacheTestPipeline
+{
+public:
+  DiskCacheTestPipeline(const char* cacheDirectory)
+  {
+    this->Source->SetSource();
+    this->Executive->SetCacheDirectory(cacheDirectory);
+    this->Filter->SetExecutive(this->Executive.GetPointer());
+    this->Filter->SetInputConnection(this->Source->GetOutputPort());
+  }
+
+  vtkNew<DiskCacheAlgorithm> Source;
+  vtkNew<DiskCacheAlgorithm> Filter;
+  vtkNew<vtkDiskCachePipeline> Executive;
+};
+
+static int Check(const char* what, int value, int expected)
+{
+  if (value != expected)
+    {
+    cerr << what << ": expected " << expected << ", got " << value << endl;
+    return 0;
+    }
+  return 1;
+}
+
+int TestDiskCachePipeline(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string cacheDirectory = tempDir;
+  cacheDirectory += "/DiskCachePipeline";
+  delete [] tempDir;
+  vtksys::SystemTools::RemoveADirectory(cacheDirectory.c_str());
+
+  int success = 1;
+
+  // The first run executes and fills the cache.
+  DiskCacheTestPipeline first(cacheDirectory.c_str());
+  first.Filter->Update();
+  success &= Check("First run executions", first.Filter->NumberOfExecutions, 1);
+  success &= Check("First run misses",
+                   first.Executive->GetNumberOfCacheMisses(), 1);
+  vtkPolyData* expected = first.Filter->GetOutput();
+
+  // An identical pipeline reads the cached output without executing.
+  DiskCacheTestPipeline second(cacheDirectory.c_str());
+  second.Filter->Update();
+  success &= Check("Second run hits",
+                   second.Executive->GetNumberOfCacheHits(), 1);
+  success &= Check("Second run source executions",
+                   second.Source->NumberOfExecutions, 0);
+  success &= Check("Second run filter executions",
+                   second.Filter->NumberOfExecutions, 0);
+  vtkPolyData* cached = second.Filter->GetOutput();
+  success &= Check("Number of points", static_cast<int>(
+                     cached->GetNumberOfPoints()),
+                   static_cast<int>(expected->GetNumberOfPoints()));
+  double x[3];
+  cached->GetPoint(10, x);
+  if (x[0] != 10.0 || x[1] != 1.0 ||
+      !cached->GetPointData()->GetArray("Scalars") ||
+      cached->GetPointData()->GetArray("Scalars")->GetTuple1(10) != 10.0)
+    {
+    cerr << "The cached output differs from the computed one" << endl;
+    success = 0;
+    }
+
+  // Updating again does not touch the cache.
+  second.Filter->Update();
+  success &= Check("Up to date hits",
+                   second.Executive->GetNumberOfCacheHits(), 1);
+
+  // Changing an upstream parameter misses the cache.
+  second.Source->SetValue(2.0);
+  second.Filter->Update();
+  success &= Check("Modified source misses",
+                   second.Executive->GetNumberOfCacheMisses(), 1);
+  success &= Check("Modified source executions",
+                   second.Filter->NumberOfExecutions, 1);
+  second.Filter->GetOutput()->GetPoint(10, x);
+  success &= Check("Modified source point", static_cast<int>(x[0]), 20);
+
+  // So does changing the cache key of an algorithm.
+  DiskCacheTestPipeline third(cacheDirectory.c_str());
+  vtkDiskCachePipeline::SetCacheKey(third.Source.GetPointer(), "other");
+  third.Filter->Update();
+  success &= Check("Cache key misses",
+                   third.Executive->GetNumberOfCacheMisses(), 1);
+
+  // And requesting another piece.
+  DiskCacheTestPipeline fourth(cacheDirectory.c_str());
+  fourth.Filter->UpdateInformation();
+  vtkInformation* outInfo = fourth.Filter->GetOutputInformation(0);
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), 0);
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), 2);
+  fourth.Filter->Update();
+  success &= Check("Piece request misses",
+                   fourth.Executive->GetNumberOfCacheMisses(), 1);
+
+  // Outputs of in-memory data are not cached.
+  vtkNew<DiskCacheAlgorithm> filter;
+  vtkNew<vtkDiskCachePipeline> executive;
+  executive->SetCacheDirectory(cacheDirectory.c_str());
+  filter->SetExecutive(executive.GetPointer());
+  filter->SetInputData(expected);
+  filter->Update();
+  filter->Modified();
+  filter->Update();
+  success &= Check("In-memory input hits", executive->GetNumberOfCacheHits() +
+                   executive->GetNumberOfCacheMisses(), 0);
+  success &= Check("In-memory input executions", filter->NumberOfExecutions, 2);
+
+  vtksys::SystemTools::RemoveADirectory(cacheDirectory.c_str());
+  return success ? TEST_SUCCESS : TEST_FAILURE;
+}
@@ -0,0 +1,220 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIParsing.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that the values of an ASCII legacy file are read
+// exactly as operator>> reads them, for numbers of many forms, whether
+// they are parsed one at a time or in parallel blocks.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <vtksys/ios/sstream>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+const int NumberOfPoints = 30000;
+
+unsigned int Seed = 12345;
+unsigned int Random()
+{
+  Seed = Seed * 1103515245u + 12345u;
+  return (Seed >> 8) & 0xffffff;
+}
+
+// Make a real number token of one of many forms.
+std::string MakeReal()
+{
+  static const char* special[] =
+    {
+    "0", "-0", "1.", ".5", "-.25", "+3", "1e5", "1E-5", "2.5e+3", "1e30",
+    "1e-40", "0.000000000000000000000001", "123456789012345678901234",
+    "0.1", "3.4028234e38", "1.17549435e-38", "16777217", "9007199254740993",
+    "00012.5000", "-1e-22", "4.9406564584124654e-324"
+    };
+  char buffer[64];
+  unsigned int form = Random() % 8;
+  double value = (Random() / 16777216.0 - 0.5) * 2000;
+  int precision = 1 + static_cast<int>(Random() % 17);
+  switch (form)
+    {
+    case 0:
+      return special[Random() % (sizeof(special) / sizeof(special[0]))];
+    case 1:
+      sprintf(buffer, "%.*e", precision, value * 1e-15);
+      break;
+    case 2:
+      {
+      // Half way between two floats.
+      float f = static_cast<float>(value);
+      double half = static_cast<double>(f) +
+        (static_cast<double>(f) * (1.0 / 16777216.0));
+      sprintf(buffer, "%.17g", half);
+      break;
+      }
+    default:
+      sprintf(buffer, "%.*g", precision, value);
+      break;
+    }
+  return buffer;
+}
+
+// Make an integer token of one of many forms.
+std::string MakeInteger()
+{
+  static const char* special[] =
+    {"0", "-0", "+7", "2147483647", "-2147483647", "0012", "-5"};
+  char buffer[32];
+  if (Random() % 8 == 0)
+    {
+    return special[Random() % (sizeof(special) / sizeof(special[0]))];
+    }
+  sprintf(buffer, "%d", static_cast<int>(Random()) - 8388608);
+  return buffer;
+}
+
+template <class T>
+T Reference(const std::string& token)
+{
+  vtksys_ios::istringstream is(token.c_str());
+  is.imbue(std::locale::classic());
+  T value = 0;
+  is >> value;
+  return value;
+}
+
+template <class T>
+bool Compare(const std::vector<std::string>& tokens, T* values,
+             const char* name)
+{
+  for (size_t i = 0; i < tokens.size(); ++i)
+    {
+    T expected = Reference<T>(tokens[i]);
+    if (memcmp(&expected, values + i, sizeof(T)) != 0)
+      {
+      cerr << "Wrong value of " << name << " for \"" << tokens[i]
+           << "\"" << endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestLegacyASCIIParsing(int, char*[])
+{
+  std::vector<std::string> coordinates;
+  std::vector<std::string> reals;
+  std::vector<std::string> integers;
+  std::vector<std::string> bytes;
+  for (int i = 0; i < NumberOfPoints; ++i)
+    {
+    for (int c = 0; c < 3; ++c)
+      {
+      coordinates.push_back(MakeReal());
+      }
+    reals.push_back(MakeReal());
+    integers.push_back(MakeInteger());
+    char byte[8];
+    sprintf(byte, "%u", Random() % 256);
+    bytes.push_back(byte);
+    }
+
+  // Separate the values with various whitespace.
+  static const char* separators[] = {" ", "\n", "  ", "\t", "\r\n"};
+  vtksys_ios::ostringstream file;
+  file << "# vtk DataFile Version 3.0\nASCII parsing\nASCII\n"
+       << "DATASET POLYDATA\nPOINTS " << NumberOfPoints << " float\n";
+  for (size_t i = 0; i < coordinates.size(); ++i)
+    {
+    file << coordinates[i] << separators[i % 5];
+    }
+  file << "\nPOINT_DATA " << NumberOfPoints << "\nFIELD FieldData 3\n"
+       << "Reals 1 " << NumberOfPoints << " double\n";
+  for (size_t i = 0; i < reals.size(); ++i)
+    {
+    file << reals[i] << separators[(i + 1) % 5];
+    }
+  file << "\nIntegers 1 " << NumberOfPoints << " int\n";
+  for (size_t i = 0; i < integers.size(); ++i)
+    {
+    file << integers[i] << separators[(i + 2) % 5];
+    }
+  file << "\nBytes 1 " << NumberOfPoints << " unsigned_char\n";
+  for (size_t i = 0; i < bytes.size(); ++i)
+    {
+    file << bytes[i] << separators[(i + 3) % 5];
+    }
+  file << "\n";
+  std::string contents = file.str();
+
+  for (int parallel = 0; parallel < 2; ++parallel)
+    {
+    vtkNew<vtkPolyDataReader> reader;
+    reader->ReadFromInputStringOn();
+    reader->SetInputString(contents);
+    reader->SetReadASCIIDataInParallel(parallel);
+    reader->Update();
+    vtkPolyData* output = reader->GetOutput();
+
+    vtkFloatArray* points =
+      vtkFloatArray::SafeDownCast(output->GetPoints()->GetData());
+    vtkDoubleArray* realArray = vtkDoubleArray::SafeDownCast(
+      output->GetPointData()->GetArray("Reals"));
+    vtkIntArray* integerArray = vtkIntArray::SafeDownCast(
+      output->GetPointData()->GetArray("Integers"));
+    vtkUnsignedCharArray* byteArray = vtkUnsignedCharArray::SafeDownCast(
+      output->GetPointData()->GetArray("Bytes"));
+    if (!points || !realArray || !integerArray || !byteArray ||
+        output->GetNumberOfPoints() != NumberOfPoints ||
+        byteArray->GetNumberOfTuples() != NumberOfPoints)
+      {
+      cerr << "Missing data, parallel " << parallel << endl;
+      return TEST_FAILURE;
+      }
+
+    std::vector<unsigned char> byteValues;
+    for (size_t i = 0; i < bytes.size(); ++i)
+      {
+      byteValues.push_back(
+        static_cast<unsigned char>(Reference<int>(bytes[i])));
+      }
+    if (!Compare(coordinates, points->GetPointer(0), "points") ||
+        !Compare(reals, realArray->GetPointer(0), "Reals") ||
+        !Compare(integers, integerArray->GetPointer(0), "Integers") ||
+        memcmp(&byteValues[0], byteArray->GetPointer(0), bytes.size()) != 0)
+      {
+      cerr << "Parallel " << parallel << endl;
+      return TEST_FAILURE;
+      }
+    }
+
+  return TEST_SUCCESS;
+}
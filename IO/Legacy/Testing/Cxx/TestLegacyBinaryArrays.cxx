@@ -0,0 +1,166 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyBinaryArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that binary legacy files, which are read and
+// swapped in blocks, give back the arrays and cells that were written,
+// for arrays larger than a block and of every swapped word size.
+
+#include "vtkCellArray.h"
+#include "vtkCharArray.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkShortArray.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnsignedIntArray.h"
+#include "vtkUnsignedShortArray.h"
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+// More values than fit in one block for every word size.
+const vtkIdType NumberOfPoints = 100003;
+
+void AddArray(vtkPolyData* data, vtkDataArray* array, const char* name)
+{
+  array->SetName(name);
+  array->SetNumberOfTuples(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+    {
+    double offset = array->GetDataTypeMin() < 0 ? 100 : 0;
+    array->SetTuple1(i, (i * 37) % 251 - offset);
+    }
+  data->GetPointData()->AddArray(array);
+}
+
+bool Compare(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfPolys() != b->GetNumberOfPolys())
+    {
+    cerr << "Wrong number of points or cells" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+    {
+    double p[3];
+    double q[3];
+    a->GetPoint(i, p);
+    b->GetPoint(i, q);
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+      {
+      cerr << "Wrong point at " << i << endl;
+      return false;
+      }
+    }
+  vtkIdTypeArray* cells = a->GetPolys()->GetData();
+  vtkIdTypeArray* readCells = b->GetPolys()->GetData();
+  for (vtkIdType i = 0; i < cells->GetNumberOfTuples(); ++i)
+    {
+    if (cells->GetValue(i) != readCells->GetValue(i))
+      {
+      cerr << "Wrong cells at " << i << endl;
+      return false;
+      }
+    }
+  for (int k = 0; k < a->GetPointData()->GetNumberOfArrays(); ++k)
+    {
+    vtkDataArray* x = a->GetPointData()->GetArray(k);
+    vtkDataArray* y = b->GetPointData()->GetArray(x->GetName());
+    if (!y || y->GetDataType() != x->GetDataType() ||
+        y->GetNumberOfTuples() != x->GetNumberOfTuples())
+      {
+      cerr << "Wrong array " << x->GetName() << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < x->GetNumberOfTuples(); ++i)
+      {
+      if (x->GetTuple1(i) != y->GetTuple1(i))
+        {
+        cerr << "Wrong value of " << x->GetName() << " at " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestLegacyBinaryArrays(int, char*[])
+{
+  vtkNew<vtkPolyData> data;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+    {
+    points->InsertNextPoint(i, 0.5 * i, -0.25 * i);
+    }
+  for (vtkIdType i = 0; i + 2 < NumberOfPoints; i += 3)
+    {
+    polys->InsertNextCell(3);
+    polys->InsertCellPoint(i);
+    polys->InsertCellPoint(i + 1);
+    polys->InsertCellPoint(i + 2);
+    }
+  data->SetPoints(points.GetPointer());
+  data->SetPolys(polys.GetPointer());
+
+  vtkNew<vtkCharArray> chars;
+  vtkNew<vtkUnsignedCharArray> bytes;
+  vtkNew<vtkShortArray> shorts;
+  vtkNew<vtkUnsignedShortArray> unsignedShorts;
+  vtkNew<vtkIntArray> ints;
+  vtkNew<vtkUnsignedIntArray> unsignedInts;
+  vtkNew<vtkIdTypeArray> ids;
+  vtkNew<vtkFloatArray> floats;
+  vtkNew<vtkDoubleArray> doubles;
+  AddArray(data.GetPointer(), chars.GetPointer(), "Chars");
+  AddArray(data.GetPointer(), bytes.GetPointer(), "Bytes");
+  AddArray(data.GetPointer(), shorts.GetPointer(), "Shorts");
+  AddArray(data.GetPointer(), unsignedShorts.GetPointer(), "UnsignedShorts");
+  AddArray(data.GetPointer(), ints.GetPointer(), "Ints");
+  AddArray(data.GetPointer(), unsignedInts.GetPointer(), "UnsignedInts");
+  AddArray(data.GetPointer(), ids.GetPointer(), "Ids");
+  AddArray(data.GetPointer(), floats.GetPointer(), "Floats");
+  AddArray(data.GetPointer(), doubles.GetPointer(), "Doubles");
+
+  vtkNew<vtkPolyDataWriter> writer;
+  writer->SetInputData(data.GetPointer());
+  writer->SetFileTypeToBinary();
+  writer->WriteToOutputStringOn();
+  writer->Write();
+
+  vtkNew<vtkPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetBinaryInputString(writer->GetOutputString(),
+                               writer->GetOutputStringLength());
+  reader->ReadAllFieldsOn();
+  reader->Update();
+
+  if (!Compare(data.GetPointer(), reader->GetOutput()))
+    {
+    return TEST_FAILURE;
+    }
+  return TEST_SUCCESS;
+}
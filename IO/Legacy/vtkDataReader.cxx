@@ -34,6 +34,7 @@
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkShortArray.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
@@ -55,6 +56,12 @@
 #include <ctype.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 // I need a safe way to read a line of arbitrary length.  It exists on
 // some platforms but not others so I'm afraid I have to write it
 // myself.
@@ -121,6 +128,7 @@ vtkDataReader::vtkDataReader()
   this->ReadAllColorScalars = 0;
   this->ReadAllTCoords = 0;
   this->ReadAllFields = 0;
+  this->ReadASCIIDataInParallel = 0;
 
   this->SetNumberOfInputPorts(0);
   this->SetNumberOfOutputPorts(1);
@@ -268,156 +276,347 @@ int vtkDataReader::ReadString(char result[256])
   return 1;
 }
 
-// Internal function to read in an integer value.
-// Returns zero if there was an error.
-int vtkDataReader::Read(char *result)
+// ASCII values are parsed from whitespace separated tokens taken
+// directly from the stream buffer, which avoids the sentry and locale
+// overhead of operator>> for every value.  The common forms of integers
+// and real numbers are converted here.  Anything else is handed to a
+// stream with the classic locale, so the values are the same as those
+// read by operator>>.
+
+static inline bool vtkDataReaderIsSpace(int c)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' ||
+    c == '\v' || c == '\f';
+}
+
+// Read the next token into token.  Leaves the stream at the character
+// following the token, as operator>> does.  Returns false at the end of
+// the stream or for a token too long to be a number.
+static bool vtkDataReaderReadToken(istream* is, char token[256])
+{
+  typedef std::char_traits<char> traits;
+  if (!is->good())
     {
-    return 0;
+    is->setstate(ios::failbit);
+    return false;
+    }
+  std::streambuf* buffer = is->rdbuf();
+  traits::int_type c = buffer->sgetc();
+  while (!traits::eq_int_type(c, traits::eof()) && vtkDataReaderIsSpace(c))
+    {
+    c = buffer->snextc();
+    }
+  int length = 0;
+  while (!traits::eq_int_type(c, traits::eof()) && !vtkDataReaderIsSpace(c))
+    {
+    if (length == 255)
+      {
+      is->setstate(ios::failbit);
+      return false;
+      }
+    token[length++] = traits::to_char_type(c);
+    c = buffer->snextc();
+    }
+  token[length] = 0;
+  if (traits::eq_int_type(c, traits::eof()))
+    {
+    is->setstate(length ? ios::eofbit : ios::eofbit | ios::failbit);
     }
+  return length > 0;
+}
 
-  *result = (char) intData;
-  return 1;
+// Convert a token the way operator>> would.  The whole token must be
+// used.
+template <class T>
+static bool vtkDataReaderParseWithStream(const char* token, T* result)
+{
+  vtksys_ios::istringstream is(token);
+  is.imbue(std::locale::classic());
+  is >> *result;
+  return !is.fail() && (is.eof() || is.peek() == std::char_traits<char>::eof());
 }
 
-int vtkDataReader::Read(unsigned char *result)
+template <class T>
+static bool vtkDataReaderParseInteger(const char* token, T* result)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
+  const char* p = token;
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+')
     {
-    return 0;
+    ++p;
     }
+  if (*p < '0' || *p > '9')
+    {
+    return vtkDataReaderParseWithStream(token, result);
+    }
+  const vtkTypeUInt64 limit = (~static_cast<vtkTypeUInt64>(0) - 9) / 10;
+  vtkTypeUInt64 value = 0;
+  for (; *p >= '0' && *p <= '9'; ++p)
+    {
+    if (value > limit)
+      {
+      return vtkDataReaderParseWithStream(token, result);
+      }
+    value = value * 10 + static_cast<vtkTypeUInt64>(*p - '0');
+    }
+  if (*p || value > static_cast<vtkTypeUInt64>(std::numeric_limits<T>::max()) ||
+      (negative && !std::numeric_limits<T>::is_signed))
+    {
+    return vtkDataReaderParseWithStream(token, result);
+    }
+  *result = negative ? static_cast<T>(-static_cast<vtkTypeInt64>(value)) :
+    static_cast<T>(value);
+  return true;
+}
 
-  *result = (unsigned char) intData;
-  return 1;
+static bool vtkDataReaderStoreReal(double value, const char*, double* result)
+{
+  *result = value;
+  return true;
 }
 
-int vtkDataReader::Read(short *result)
+static bool vtkDataReaderStoreReal(double value, const char* token,
+                                   float* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  // Rounding the correctly rounded double to float gives the correctly
+  // rounded float, unless the double is exactly half way between two
+  // floats or outside the normal range of float.
+  double magnitude = fabs(value);
+  if (magnitude != 0)
     {
-    return 0;
+    int exponent;
+    double bits = ldexp(frexp(magnitude, &exponent), 25);
+    if (magnitude < FLT_MIN || magnitude > FLT_MAX ||
+        (bits == floor(bits) && fmod(bits, 2) == 1))
+      {
+      return vtkDataReaderParseWithStream(token, result);
+      }
     }
-  return 1;
+  *result = static_cast<float>(value);
+  return true;
 }
 
-int vtkDataReader::Read(unsigned short *result)
+// The fast conversion of real numbers needs double arithmetic that is
+// not carried out in extended precision.
+#if defined(FLT_EVAL_METHOD)
+# define VTK_DATA_READER_EXACT_DOUBLE (FLT_EVAL_METHOD == 0)
+#elif defined(__FLT_EVAL_METHOD__)
+# define VTK_DATA_READER_EXACT_DOUBLE (__FLT_EVAL_METHOD__ == 0)
+#elif defined(_M_X64) || defined(_M_ARM)
+# define VTK_DATA_READER_EXACT_DOUBLE 1
+#else
+# define VTK_DATA_READER_EXACT_DOUBLE 0
+#endif
+
+template <class T>
+static bool vtkDataReaderParseReal(const char* token, T* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+#if VTK_DATA_READER_EXACT_DOUBLE
+  // A mantissa of at most 53 bits scaled by an exact power of ten is
+  // correctly rounded by one multiplication or division.
+  static const double powers[23] =
     {
-    return 0;
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+  const vtkTypeUInt64 maxMantissa = static_cast<vtkTypeUInt64>(1) << 53;
+  const char* p = token;
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+')
+    {
+    ++p;
     }
-  return 1;
+  vtkTypeUInt64 mantissa = 0;
+  int exponent = 0;
+  bool digits = false;
+  for (; *p >= '0' && *p <= '9'; ++p, digits = true)
+    {
+    mantissa = mantissa * 10 + static_cast<vtkTypeUInt64>(*p - '0');
+    if (mantissa >= maxMantissa)
+      {
+      return vtkDataReaderParseWithStream(token, result);
+      }
+    }
+  if (*p == '.')
+    {
+    for (++p; *p >= '0' && *p <= '9'; ++p, digits = true)
+      {
+      mantissa = mantissa * 10 + static_cast<vtkTypeUInt64>(*p - '0');
+      --exponent;
+      if (mantissa >= maxMantissa)
+        {
+        return vtkDataReaderParseWithStream(token, result);
+        }
+      }
+    }
+  if (digits && (*p == 'e' || *p == 'E'))
+    {
+    ++p;
+    bool negativeExponent = (*p == '-');
+    if (*p == '-' || *p == '+')
+      {
+      ++p;
+      }
+    if (*p < '0' || *p > '9')
+      {
+      return vtkDataReaderParseWithStream(token, result);
+      }
+    int value = 0;
+    for (; *p >= '0' && *p <= '9' && value < 1000; ++p)
+      {
+      value = value * 10 + (*p - '0');
+      }
+    exponent += negativeExponent ? -value : value;
+    }
+  if (!digits || *p || (mantissa != 0 && (exponent < -22 || exponent > 22)))
+    {
+    return vtkDataReaderParseWithStream(token, result);
+    }
+  double value = static_cast<double>(mantissa);
+  if (exponent < 0)
+    {
+    value /= powers[-exponent];
+    }
+  else
+    {
+    value *= powers[exponent];
+    }
+  return vtkDataReaderStoreReal(negative ? -value : value, token, result);
+#else
+  return vtkDataReaderParseWithStream(token, result);
+#endif
 }
 
-int vtkDataReader::Read(int *result)
+// Convert a token to a value of the given type.  Characters are read
+// as integers.
+template <class T>
+static bool vtkDataReaderParse(const char* token, T* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  return vtkDataReaderParseInteger(token, result);
+}
+
+static bool vtkDataReaderParse(const char* token, char* result)
+{
+  int value;
+  if (!vtkDataReaderParseInteger(token, &value))
     {
-    return 0;
+    return false;
     }
-  return 1;
+  *result = static_cast<char>(value);
+  return true;
 }
 
-int vtkDataReader::Read(unsigned int *result)
+static bool vtkDataReaderParse(const char* token, unsigned char* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  int value;
+  if (!vtkDataReaderParseInteger(token, &value))
     {
-    return 0;
+    return false;
     }
-  return 1;
+  *result = static_cast<unsigned char>(value);
+  return true;
 }
 
-int vtkDataReader::Read(long *result)
+static bool vtkDataReaderParse(const char* token, float* result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
+  return vtkDataReaderParseReal(token, result);
+}
+
+static bool vtkDataReaderParse(const char* token, double* result)
+{
+  return vtkDataReaderParseReal(token, result);
+}
+
+template <class T>
+static int vtkDataReaderReadValue(istream* is, T* result)
+{
+  char token[256];
+  if (!vtkDataReaderReadToken(is, token))
+    {
+    return 0;
+    }
+  if (!vtkDataReaderParse(token, result))
     {
+    is->setstate(ios::failbit);
     return 0;
     }
   return 1;
 }
 
+// Internal function to read in an integer value.
+// Returns zero if there was an error.
+int vtkDataReader::Read(char *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(unsigned char *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(short *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(unsigned short *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(int *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(unsigned int *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
+int vtkDataReader::Read(long *result)
+{
+  return vtkDataReaderReadValue(this->IS, result);
+}
+
 int vtkDataReader::Read(unsigned long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 #if defined(VTK_TYPE_USE___INT64)
 int vtkDataReader::Read(__int64 *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned __int64 *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 #endif
 
 #if defined(VTK_TYPE_USE_LONG_LONG)
 int vtkDataReader::Read(long long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned long long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 #endif
 
 int vtkDataReader::Read(float *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 int vtkDataReader::Read(double *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-    {
-    return 0;
-    }
-  return 1;
+  return vtkDataReaderReadValue(this->IS, result);
 }
 
 
@@ -1350,9 +1549,35 @@ int vtkDataReader::ReadRowData(vtkTable *t, int numEdges)
   return 1;
 }
 
+// Read big-endian binary values and swap them with the given function.
+// The values are read in blocks, and each block is swapped right after
+// it is read while it is still in cache, instead of in a second pass
+// over the whole array.
+template <class T>
+int vtkReadSwappedBinaryData(istream *IS, T *data, size_t numValues,
+                             void (*swap)(void*, size_t))
+{
+  const size_t blockSize = swap ? 262144 / sizeof(T) : numValues;
+  for (size_t first = 0; first < numValues; first += blockSize)
+    {
+    size_t count = std::min(blockSize, numValues - first);
+    IS->read(reinterpret_cast<char *>(data + first), sizeof(T)*count);
+    if (IS->eof())
+      {
+      return 0;
+      }
+    if (swap)
+      {
+      swap(data + first, count);
+      }
+    }
+  return 1;
+}
+
 // General templated function to read data of various types.
 template <class T>
-int vtkReadBinaryData(istream *IS, T *data, int numTuples, int numComp)
+int vtkReadBinaryData(istream *IS, T *data, int numTuples, int numComp,
+                      void (*swap)(void*, size_t) = 0)
 {
   if (numTuples==0 || numComp==0)
     {
@@ -1363,8 +1588,8 @@ int vtkReadBinaryData(istream *IS, T *data, int numTuples, int numComp)
 
   // suck up newline
   IS->getline(line,256);
-  IS->read((char *)data, sizeof(T)*numComp*numTuples);
-  if (IS->eof())
+  if (!vtkReadSwappedBinaryData(IS, data,
+        static_cast<size_t>(numTuples)*numComp, swap))
     {
     vtkGenericWarningMacro(<<"Error reading binary data!");
     return 0;
@@ -1372,12 +1597,87 @@ int vtkReadBinaryData(istream *IS, T *data, int numTuples, int numComp)
   return 1;
 }
 
+// Parse the tokens of a block of ASCII values.
+template <class T>
+class vtkDataReaderParseFunctor
+{
+public:
+  const char* Tokens;
+  const size_t* Starts;
+  T* Data;
+  unsigned char* Failed;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      if (!vtkDataReaderParse(this->Tokens + this->Starts[i], this->Data + i))
+        {
+        this->Failed[i] = 1;
+        }
+      }
+    }
+};
+
+// Read the values in blocks.  The tokens of a block are taken from the
+// stream in order, then converted concurrently.
+template <class T>
+int vtkReadASCIIDataInParallel(istream *IS, T *data, vtkIdType numValues)
+{
+  const vtkIdType blockSize = 65536;
+  std::vector<char> tokens;
+  std::vector<size_t> starts;
+  std::vector<unsigned char> failed;
+  char token[256];
+  for (vtkIdType first = 0; first < numValues; first += blockSize)
+    {
+    vtkIdType count = std::min(blockSize, numValues - first);
+    tokens.clear();
+    starts.resize(count);
+    for (vtkIdType i = 0; i < count; ++i)
+      {
+      if (!vtkDataReaderReadToken(IS, token))
+        {
+        return 0;
+        }
+      starts[i] = tokens.size();
+      tokens.insert(tokens.end(), token, token + strlen(token) + 1);
+      }
+    failed.assign(count, 0);
+
+    vtkDataReaderParseFunctor<T> functor;
+    functor.Tokens = &tokens[0];
+    functor.Starts = &starts[0];
+    functor.Data = data + first;
+    functor.Failed = &failed[0];
+    vtkSMPTools::For(0, count, 4096, functor);
+    if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+      {
+      IS->setstate(ios::failbit);
+      return 0;
+      }
+    }
+  return 1;
+}
+
 // General templated function to read data of various types.
 template <class T>
 int vtkReadASCIIData(vtkDataReader *self, T *data, int numTuples, int numComp)
 {
   int i, j;
 
+  if (self->GetReadASCIIDataInParallel())
+    {
+    if (!vtkReadASCIIDataInParallel(self->GetIStream(), data,
+          static_cast<vtkIdType>(numTuples) * numComp))
+      {
+      vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
+        "datasize with declaration.");
+      return 0;
+      }
+    return 1;
+    }
+
   for (i=0; i<numTuples; i++)
     {
     for (j=0; j<numComp; j++)
@@ -1486,8 +1786,8 @@ vtkAbstractArray *vtkDataReader::ReadArray(const char *dataType, int numTuples,
     short *ptr = ((vtkShortArray *)array)->WritePointer(0,numTuples*numComp);
     if ( this->FileType == VTK_BINARY )
       {
-      vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap2BERange(ptr,numTuples*numComp);
+      vtkReadBinaryData(this->IS, ptr, numTuples, numComp,
+        vtkByteSwap::Swap2BERange);
       }
     else
       {
@@ -1502,8 +1802,8 @@ vtkAbstractArray *vtkDataReader::ReadArray(const char *dataType, int numTuples,
     unsigned short *ptr = ((vtkUnsignedShortArray *)array)->WritePointer(0,numTuples*numComp);
     if ( this->FileType == VTK_BINARY )
       {
-      vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap2BERange((short *)ptr,numTuples*numComp);
+      vtkReadBinaryData(this->IS, ptr, numTuples, numComp,
+        vtkByteSwap::Swap2BERange);
       }
     else
       {
@@ -1519,8 +1819,8 @@ vtkAbstractArray *vtkDataReader::ReadArray(const char *dataType, int numTuples,
     int *ptr = new int [numTuples*numComp];
     if ( this->FileType == VTK_BINARY )
       {
-      vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap4BERange(ptr,numTuples*numComp);
+      vtkReadBinaryData(this->IS, ptr, numTuples, numComp,
+        vtkByteSwap::Swap4BERange);
       }
     else
       {
@@ -1542,8 +1842,8 @@ vtkAbstractArray *vtkDataReader::ReadArray(const char *dataType, int numTuples,
     int *ptr = ((vtkIntArray *)array)->WritePointer(0,numTuples*numComp);
     if ( this->FileType == VTK_BINARY )
       {
-      vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap4BERange(ptr,numTuples*numComp);
+      vtkReadBinaryData(this->IS, ptr, numTuples, numComp,
+        vtkByteSwap::Swap4BERange);
       }
     else
       {
@@ -1558,8 +1858,8 @@ vtkAbstractArray *vtkDataReader::ReadArray(const char *dataType, int numTuples,
     unsigned int *ptr = ((vtkUnsignedIntArray *)array)->WritePointer(0,numTuples*numComp);
     if ( this->FileType == VTK_BINARY )
       {
-      vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap4BERange((int *)ptr,numTuples*numComp);
+      vtkReadBinaryData(this->IS, ptr, numTuples, numComp,
+        vtkByteSwap::Swap4BERange);
       }
     else
       {
@@ -1607,8 +1907,8 @@ vtkAbstractArray *vtkDataReader::ReadArray(const char *dataType, int numTuples,
     vtkTypeInt64 *ptr = ((vtkTypeInt64Array *)array)->WritePointer(0,numTuples*numComp);
     if ( this->FileType == VTK_BINARY )
       {
-      vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap8BERange(ptr,numTuples*numComp);
+      vtkReadBinaryData(this->IS, ptr, numTuples, numComp,
+        vtkByteSwap::Swap8BERange);
       }
 
     else
@@ -1627,8 +1927,8 @@ vtkAbstractArray *vtkDataReader::ReadArray(const char *dataType, int numTuples,
     vtkTypeUInt64 *ptr = ((vtkTypeUInt64Array *)array)->WritePointer(0,numTuples*numComp);
     if ( this->FileType == VTK_BINARY )
       {
-      vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap8BERange(ptr,numTuples*numComp);
+      vtkReadBinaryData(this->IS, ptr, numTuples, numComp,
+        vtkByteSwap::Swap8BERange);
       }
 
     else
@@ -1649,8 +1949,8 @@ vtkAbstractArray *vtkDataReader::ReadArray(const char *dataType, int numTuples,
     float *ptr = ((vtkFloatArray *)array)->WritePointer(0,numTuples*numComp);
     if ( this->FileType == VTK_BINARY )
       {
-      vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap4BERange(ptr,numTuples*numComp);
+      vtkReadBinaryData(this->IS, ptr, numTuples, numComp,
+        vtkByteSwap::Swap4BERange);
       }
     else
       {
@@ -1665,8 +1965,8 @@ vtkAbstractArray *vtkDataReader::ReadArray(const char *dataType, int numTuples,
     double *ptr = ((vtkDoubleArray *)array)->WritePointer(0,numTuples*numComp);
     if ( this->FileType == VTK_BINARY )
       {
-      vtkReadBinaryData(this->IS, ptr, numTuples, numComp);
-      vtkByteSwap::Swap8BERange(ptr,numTuples*numComp);
+      vtkReadBinaryData(this->IS, ptr, numTuples, numComp,
+        vtkByteSwap::Swap8BERange);
       }
     else
       {
@@ -2590,31 +2890,26 @@ int vtkDataReader::ReadLutData(vtkDataSetAttributes *a)
 int vtkDataReader::ReadCells(int size, int *data)
 {
   char line[256];
-  int i;
 
   if ( this->FileType == VTK_BINARY)
     {
     // suck up newline
     this->IS->getline(line,256);
-    this->IS->read((char *)data,sizeof(int)*size);
-    if (this->IS->eof())
+    if (!vtkReadSwappedBinaryData(this->IS, data, size,
+                                  vtkByteSwap::Swap4BERange))
       {
       vtkErrorMacro(<<"Error reading binary cell data!" << " for file: "
                     << (this->FileName?this->FileName:"(Null FileName)"));
       return 0;
       }
-    vtkByteSwap::Swap4BERange(data,size);
     }
   else // ascii
     {
-    for (i=0; i<size; i++)
+    if (!vtkReadASCIIData(this, data, size, 1))
       {
-      if (!this->Read(data+i))
-        {
-        vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
-                      << (this->FileName?this->FileName:"(Null FileName)"));
-        return 0;
-        }
+      vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
+                    << (this->FileName?this->FileName:"(Null FileName)"));
+      return 0;
       }
     }
 
@@ -2643,14 +2938,13 @@ int vtkDataReader::ReadCells(int size, int *data,
       {
       tmp = new int[size];
       }
-    this->IS->read((char *)tmp,sizeof(int)*size);
-    if (this->IS->eof())
+    if (!vtkReadSwappedBinaryData(this->IS, tmp, size,
+                                  vtkByteSwap::Swap4BERange))
       {
       vtkErrorMacro(<<"Error reading binary cell data!" << " for file: "
                     << (this->FileName?this->FileName:"(Null FileName)"));
       return 0;
       }
-    vtkByteSwap::Swap4BERange(tmp,size);
     if (tmp == data)
       {
       return 1;
@@ -3210,6 +3504,8 @@ void vtkDataReader::PrintSelf(ostream& os, vtkIndent indent)
     }
   os << indent << "ReadAllFields: "
      << (this->ReadAllFields ? "On" : "Off") << "\n";
+  os << indent << "ReadASCIIDataInParallel: "
+     << (this->ReadASCIIDataInParallel ? "On" : "Off") << "\n";
 
   os << indent << "InputStringLength: " << this->InputStringLength << endl;
 }
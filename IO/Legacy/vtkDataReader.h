@@ -223,6 +223,14 @@ public:
   vtkGetMacro(ReadAllFields,int);
   vtkBooleanMacro(ReadAllFields,int);
 
+  // Description:
+  // Parse large blocks of ASCII values with several threads.  The
+  // values are still taken from the file in order, and the result is
+  // the same as when parsing them one at a time.  Off by default.
+  vtkSetMacro(ReadASCIIDataInParallel,int);
+  vtkGetMacro(ReadASCIIDataInParallel,int);
+  vtkBooleanMacro(ReadASCIIDataInParallel,int);
+
   // Description:
   // Open a vtk data file. Returns zero if error.
   int OpenVTKFile();
@@ -405,6 +413,7 @@ protected:
   int ReadAllColorScalars;
   int ReadAllTCoords;
   int ReadAllFields;
+  int ReadASCIIDataInParallel;
 
   void InitializeCharacteristics();
   int CharacterizeFile(); //read entire file, storing important characteristics
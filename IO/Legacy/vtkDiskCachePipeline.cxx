@@ -0,0 +1,426 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDiskCachePipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDiskCachePipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkAlgorithmOutput.h"
+#include "vtkDataObject.h"
+#include "vtkErrorCode.h"
+#include "vtkGenericDataObjectReader.h"
+#include "vtkGenericDataObjectWriter.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationStringKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkTrivialProducer.h"
+
+#include <vtksys/MD5.h>
+#include <vtksys/SystemTools.hxx>
+#include <vtksys/ios/sstream>
+
+#include <cstdio>
+#include <map>
+#include <string>
+
+#ifdef _WIN32
+#include "vtkWindows.h"
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkDiskCachePipeline);
+
+vtkInformationKeyMacro(vtkDiskCachePipeline, CACHE_KEY, String);
+
+namespace
+{
+// Labels of the printed state that does not affect the outputs of an
+// algorithm.
+const char* vtkDiskCacheIgnoredLabels[] =
+{
+  "Debug:", "Modified Time:", "Reference Count:", "Registered Events:",
+  "Executive:", "ErrorCode:", "Information:", "AbortExecute:",
+  "Progress:", "Progress Text:", 0
+};
+
+// Prints the parameters of an algorithm, skipping the ignored labels and
+// the observers, and removing object addresses.
+void vtkDiskCachePrintParameters(vtkAlgorithm* algorithm, ostream& os)
+{
+  vtksys_ios::ostringstream printed;
+  algorithm->PrintSelf(printed, vtkIndent());
+  vtksys_ios::istringstream lines(printed.str());
+  std::string line;
+  size_t skipIndent = std::string::npos;
+  while (std::getline(lines, line))
+    {
+    size_t indent = line.find_first_not_of(' ');
+    if (indent == std::string::npos)
+      {
+      continue;
+      }
+    if (skipIndent != std::string::npos && indent > skipIndent)
+      {
+      continue;
+      }
+    skipIndent = std::string::npos;
+    bool ignored = false;
+    for (int i = 0; vtkDiskCacheIgnoredLabels[i] && !ignored; ++i)
+      {
+      ignored = line.compare(indent, strlen(vtkDiskCacheIgnoredLabels[i]),
+                             vtkDiskCacheIgnoredLabels[i]) == 0;
+      }
+    if (ignored)
+      {
+      if (line.compare(indent, 18, "Registered Events:") == 0)
+        {
+        skipIndent = indent;
+        }
+      continue;
+      }
+    size_t pos = 0;
+    while ((pos = line.find("0x", pos)) != std::string::npos)
+      {
+      size_t end = line.find_first_not_of("0123456789abcdefABCDEF", pos + 2);
+      line.erase(pos + 2, (end == std::string::npos ? line.size() : end) -
+                 (pos + 2));
+      pos += 2;
+      }
+    os << line << "\n";
+    }
+}
+
+// Describes an algorithm and everything upstream of it. Algorithms
+// reached twice are described once and referred to by their index.
+// Returns false if the pipeline reads in-memory data.
+bool vtkDiskCacheDescribe(vtkAlgorithm* algorithm, ostream& os,
+                          std::map<vtkAlgorithm*, size_t>& described)
+{
+  std::map<vtkAlgorithm*, size_t>::iterator it = described.find(algorithm);
+  if (it != described.end())
+    {
+    os << "algorithm " << it->second << "\n";
+    return true;
+    }
+  size_t index = described.size();
+  described[algorithm] = index;
+  if (vtkTrivialProducer::SafeDownCast(algorithm))
+    {
+    return false;
+    }
+
+  os << "algorithm " << index << " " << algorithm->GetClassName() << "\n";
+  vtkDiskCachePrintParameters(algorithm, os);
+  vtkInformation* info = algorithm->GetInformation();
+  if (info->Has(vtkDiskCachePipeline::CACHE_KEY()))
+    {
+    os << "key " << info->Get(vtkDiskCachePipeline::CACHE_KEY()) << "\n";
+    }
+  for (int i = 0; i < algorithm->GetNumberOfInputPorts(); ++i)
+    {
+    for (int j = 0; j < algorithm->GetNumberOfInputConnections(i); ++j)
+      {
+      vtkAlgorithmOutput* input = algorithm->GetInputConnection(i, j);
+      os << "input " << i << " " << j << " from port "
+         << input->GetIndex() << "\n";
+      if (!vtkDiskCacheDescribe(input->GetProducer(), os, described))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Describes the update request of each output.
+void vtkDiskCacheDescribeRequest(vtkInformationVector* outInfoVec,
+                                 ostream& os)
+{
+  os.precision(17);
+  for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+    {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    os << "output " << i;
+    vtkInformationIntegerKey* intKeys[] =
+    {
+      vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()
+    };
+    for (int k = 0; k < 3; ++k)
+      {
+      if (outInfo->Has(intKeys[k]))
+        {
+        os << " " << intKeys[k]->GetName() << " " << outInfo->Get(intKeys[k]);
+        }
+      }
+    vtkInformationIntegerVectorKey* vectorKeys[] =
+    {
+      vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+      vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES()
+    };
+    for (int k = 0; k < 2; ++k)
+      {
+      if (outInfo->Has(vectorKeys[k]))
+        {
+        os << " " << vectorKeys[k]->GetName();
+        int* values = outInfo->Get(vectorKeys[k]);
+        for (int v = 0; v < outInfo->Length(vectorKeys[k]); ++v)
+          {
+          os << " " << values[v];
+          }
+        }
+      }
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+      {
+      os << " UPDATE_TIME_STEP " <<
+        outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+      }
+    os << "\n";
+    }
+}
+
+std::string vtkDiskCacheFileName(const char* directory, const char* key,
+                                 int port)
+{
+  vtksys_ios::ostringstream name;
+  name << directory << "/" << key << "_" << port << ".vtk";
+  return name.str();
+}
+
+// A temporary name for the file, unique across the processes and hosts
+// that share the cache directory and across the writes of this process.
+std::string vtkDiskCacheTempFileName(const std::string& fileName)
+{
+  static unsigned long counter = 0;
+  char host[256] = "";
+#ifdef _WIN32
+  DWORD size = sizeof(host);
+  GetComputerNameA(host, &size);
+  unsigned long processId = GetCurrentProcessId();
+#else
+  gethostname(host, sizeof(host) - 1);
+  host[sizeof(host) - 1] = 0;
+  unsigned long processId = getpid();
+#endif
+  vtksys_ios::ostringstream name;
+  name << fileName << "." << host << "." << processId << "." << counter++
+       << ".tmp";
+  return name.str();
+}
+}
+
+//----------------------------------------------------------------------------
+vtkDiskCachePipeline::vtkDiskCachePipeline()
+{
+  this->CacheDirectory = 0;
+  this->NumberOfCacheHits = 0;
+  this->NumberOfCacheMisses = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkDiskCachePipeline::~vtkDiskCachePipeline()
+{
+  this->SetCacheDirectory(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkDiskCachePipeline::SetCacheKey(vtkAlgorithm* algorithm,
+                                       const char* key)
+{
+  if (algorithm)
+    {
+    algorithm->GetInformation()->Set(CACHE_KEY(), key);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkDiskCachePipeline::ProcessRequest(vtkInformation* request,
+                                         vtkInformationVector** inInfoVec,
+                                         vtkInformationVector* outInfoVec)
+{
+  if (!this->CacheDirectory || !this->Algorithm ||
+      !request->Has(REQUEST_DATA()))
+    {
+    return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+    }
+
+  int outputPort = -1;
+  if (request->Has(FROM_OUTPUT_PORT()))
+    {
+    outputPort = request->Get(FROM_OUTPUT_PORT());
+    }
+  if (!this->NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+    {
+    return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+    }
+
+  // Compute the key of the requested outputs.
+  vtksys_ios::ostringstream description;
+  std::map<vtkAlgorithm*, size_t> described;
+  if (!vtkDiskCacheDescribe(this->Algorithm, description, described))
+    {
+    return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+    }
+  vtkDiskCacheDescribeRequest(outInfoVec, description);
+  std::string text = description.str();
+  unsigned char digest[16];
+  char key[33];
+  key[32] = '\0';
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+  vtksysMD5_Append(md5, reinterpret_cast<const unsigned char*>(text.c_str()),
+                   static_cast<int>(text.size()));
+  vtksysMD5_Finalize(md5, digest);
+  vtksysMD5_DigestToHex(digest, key);
+  vtksysMD5_Delete(md5);
+
+  if (this->ReadFromCache(key, request, inInfoVec, outInfoVec))
+    {
+    vtkDebugMacro(<< "Read outputs of " << this->Algorithm->GetClassName()
+                  << " from the cache (" << key << ")");
+    this->NumberOfCacheHits++;
+    return 1;
+    }
+
+  this->NumberOfCacheMisses++;
+  int result = this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+  if (result && !this->Algorithm->GetAbortExecute())
+    {
+    this->WriteToCache(key, outInfoVec);
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkDiskCachePipeline::ReadFromCache(const char* key,
+                                        vtkInformation* request,
+                                        vtkInformationVector** inInfoVec,
+                                        vtkInformationVector* outInfoVec)
+{
+  int numOutputs = outInfoVec->GetNumberOfInformationObjects();
+  int i;
+  for (i = 0; i < numOutputs; ++i)
+    {
+    if (!vtksys::SystemTools::FileExists(
+          vtkDiskCacheFileName(this->CacheDirectory, key, i).c_str(), true))
+      {
+      return 0;
+      }
+    }
+
+  for (i = 0; i < numOutputs; ++i)
+    {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    vtkSmartPointer<vtkGenericDataObjectReader> reader =
+      vtkSmartPointer<vtkGenericDataObjectReader>::New();
+    reader->SetFileName(
+      vtkDiskCacheFileName(this->CacheDirectory, key, i).c_str());
+    reader->ReadAllScalarsOn();
+    reader->ReadAllVectorsOn();
+    reader->ReadAllNormalsOn();
+    reader->ReadAllTensorsOn();
+    reader->ReadAllColorScalarsOn();
+    reader->ReadAllTCoordsOn();
+    reader->ReadAllFieldsOn();
+    reader->Update();
+    vtkDataObject* cached = reader->GetOutput();
+    if (!data || !cached || !cached->IsA(data->GetClassName()))
+      {
+      vtkWarningMacro("Could not read output " << i << " of "
+                      << this->Algorithm->GetClassName()
+                      << " from the cache.");
+      return 0;
+      }
+    data->ShallowCopy(cached);
+    if (outInfo->Has(TIME_RANGE()) && outInfo->Has(UPDATE_TIME_STEP()))
+      {
+      data->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(),
+                                  outInfo->Get(UPDATE_TIME_STEP()));
+      }
+    }
+
+  // The outputs are now up to date, as if the algorithm had executed.
+  this->MarkOutputsGenerated(request, inInfoVec, outInfoVec);
+  for (i = 0; i < numOutputs; ++i)
+    {
+    outInfoVec->GetInformationObject(i)->Remove(DATA_NOT_GENERATED());
+    }
+  this->DataTime.Modified();
+  this->InformationTime.Modified();
+  this->DataObjectTime.Modified();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkDiskCachePipeline::WriteToCache(const char* key,
+                                        vtkInformationVector* outInfoVec)
+{
+  if (!vtksys::SystemTools::MakeDirectory(this->CacheDirectory))
+    {
+    vtkErrorMacro("Could not create the cache directory "
+                  << this->CacheDirectory);
+    return;
+    }
+
+  for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+    {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (!data)
+      {
+      continue;
+      }
+
+    // Write to a temporary file first so that other processes sharing
+    // the cache never read a partial file. If the rename fails because
+    // another process stored the same output meanwhile, keep its file.
+    std::string fileName =
+      vtkDiskCacheFileName(this->CacheDirectory, key, i);
+    std::string tempName = vtkDiskCacheTempFileName(fileName);
+    vtkSmartPointer<vtkGenericDataObjectWriter> writer =
+      vtkSmartPointer<vtkGenericDataObjectWriter>::New();
+    writer->SetInputData(data);
+    writer->SetFileName(tempName.c_str());
+    writer->SetFileTypeToBinary();
+    writer->Write();
+    if (writer->GetErrorCode() != vtkErrorCode::NoError ||
+        (rename(tempName.c_str(), fileName.c_str()) != 0 &&
+         !vtksys::SystemTools::FileExists(fileName.c_str(), true)))
+      {
+      vtkWarningMacro("Could not store output " << i << " of "
+                      << this->Algorithm->GetClassName()
+                      << " in the cache.");
+      }
+    vtksys::SystemTools::RemoveFile(tempName.c_str());
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkDiskCachePipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheDirectory: "
+     << (this->CacheDirectory ? this->CacheDirectory : "(none)") << endl;
+  os << indent << "NumberOfCacheHits: " << this->NumberOfCacheHits << endl;
+  os << indent << "NumberOfCacheMisses: " << this->NumberOfCacheMisses << endl;
+}
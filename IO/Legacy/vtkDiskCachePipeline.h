@@ -0,0 +1,115 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDiskCachePipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkDiskCachePipeline - Executive that caches outputs on disk
+// .SECTION Description
+// vtkDiskCachePipeline is a vtkCompositeDataPipeline that stores the
+// outputs of its algorithm in CacheDirectory and, when the same outputs
+// are requested again, possibly by another process, reads them back
+// instead of updating the inputs and executing the algorithm.
+//
+// Outputs are identified by a key computed from the state of the
+// pipeline: the class and printed parameters (see PrintSelf()) of the
+// algorithm and of every algorithm upstream of it, the CACHE_KEY()
+// string of these algorithms if set, and the update request of each
+// output (piece, number of pieces, ghost levels, extent, time step and
+// composite indices). Each output is stored as a binary legacy VTK file
+// named after the key. Without a CacheDirectory this executive behaves as
+// its superclass.
+//
+// .SECTION Caveats
+// Only parameters printed by PrintSelf() are seen, and object addresses
+// are ignored so that keys are the same across processes. Parameters
+// held by other objects, such as implicit functions or lookup tables,
+// and the contents of files read by readers are not part of the key: set
+// CACHE_KEY() on the algorithm to describe them, or clear the cache
+// directory when they change. Outputs of pipelines fed with in-memory
+// data (vtkTrivialProducer) are not cached.
+//
+// .SECTION See Also
+// vtkCachedStreamingDemandDrivenPipeline vtkGenericDataObjectWriter
+
+#ifndef __vtkDiskCachePipeline_h
+#define __vtkDiskCachePipeline_h
+
+#include "vtkIOLegacyModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkAlgorithm;
+class vtkInformationStringKey;
+
+class VTKIOLEGACY_EXPORT vtkDiskCachePipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkDiskCachePipeline* New();
+  vtkTypeMacro(vtkDiskCachePipeline,vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Directory where outputs are cached. It is created if needed. Caching
+  // is disabled when this is NULL, which is the default.
+  vtkSetStringMacro(CacheDirectory);
+  vtkGetStringMacro(CacheDirectory);
+
+  // Description:
+  // Key set in the information object of an algorithm (see
+  // vtkAlgorithm::GetInformation()) to describe parameters that are not
+  // printed by the algorithm. It is added to the cache key of the outputs
+  // of the algorithm and of every algorithm downstream of it.
+  static vtkInformationStringKey* CACHE_KEY();
+
+  // Description:
+  // Convenience method to set the CACHE_KEY() of an algorithm.
+  static void SetCacheKey(vtkAlgorithm* algorithm, const char* key);
+
+  // Description:
+  // Number of updates served from the cache and number of updates that
+  // executed the algorithm and stored its outputs in the cache.
+  vtkGetMacro(NumberOfCacheHits,int);
+  vtkGetMacro(NumberOfCacheMisses,int);
+
+  // Description:
+  // Generalized interface for asking the executive to fulfill update
+  // requests.
+  virtual int ProcessRequest(vtkInformation* request,
+                             vtkInformationVector** inInfo,
+                             vtkInformationVector* outInfo);
+
+protected:
+  vtkDiskCachePipeline();
+  ~vtkDiskCachePipeline();
+
+  // Description:
+  // Read the outputs stored under the given key. Returns 0 if one of them
+  // is not in the cache.
+  virtual int ReadFromCache(const char* key,
+                            vtkInformation* request,
+                            vtkInformationVector** inInfoVec,
+                            vtkInformationVector* outInfoVec);
+
+  // Description:
+  // Store the outputs under the given key.
+  virtual void WriteToCache(const char* key,
+                            vtkInformationVector* outInfoVec);
+
+  char* CacheDirectory;
+  int NumberOfCacheHits;
+  int NumberOfCacheMisses;
+
+private:
+  vtkDiskCachePipeline(const vtkDiskCachePipeline&);  // Not implemented.
+  void operator=(const vtkDiskCachePipeline&);  // Not implemented.
+};
+
+#endif
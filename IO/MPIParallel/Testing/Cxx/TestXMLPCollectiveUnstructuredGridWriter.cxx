@@ -0,0 +1,370 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLPCollectiveUnstructuredGridWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that the pieces of all processes written into a
+// few shared files with collective MPI-IO read back in order with
+// vtkXMLPUnstructuredGridReader, whether a process reads some of the
+// pieces or all of them, for raw and for encoded and compressed data,
+// and that no process writes when the pieces do not all have the same
+// arrays.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCommand.h"
+#include "vtkCommunicator.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkErrorCode.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridAlgorithm.h"
+#include "vtkXMLPCollectiveUnstructuredGridWriter.h"
+#include "vtkXMLPUnstructuredGridReader.h"
+
+#include <vtksys/ios/sstream>
+
+#include <cmath>
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+const int N = 20;
+const int PiecesPerProcess = 2;
+const int NumberOfFiles = 2;
+
+// Fill a strip of N x N points and quads for the given piece.
+void MakePiece(int piece, vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfComponents(2);
+  for (int j = 0; j < N; ++j)
+    {
+    for (int i = 0; i < N; ++i)
+      {
+      points->InsertNextPoint(i + piece * (N - 1), j, sin(0.1 * i) * j);
+      values->InsertNextValue(cos(0.03 * i + 0.02 * j) + piece);
+      ids->InsertNextTuple2(i, j + piece * N);
+      }
+    }
+  grid->Initialize();
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->SetScalars(values.GetPointer());
+  grid->GetPointData()->AddArray(ids.GetPointer());
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  grid->Allocate((N - 1) * (N - 1));
+  for (int j = 0; j < N - 1; ++j)
+    {
+    for (int i = 0; i < N - 1; ++i)
+      {
+      vtkIdType quad[4] = {j * N + i, j * N + i + 1, (j + 1) * N + i + 1,
+                           (j + 1) * N + i};
+      grid->InsertNextCell(VTK_QUAD, 4, quad);
+      cellIds->InsertNextValue(piece * N * N + j * N + i);
+      }
+    }
+  grid->GetCellData()->AddArray(cellIds.GetPointer());
+}
+
+bool CompareArray(vtkDataArray* a, vtkDataArray* b, vtkIdType start)
+{
+  if (!a || !b || a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    cerr << "Missing array" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+      {
+      if (a->GetComponent(i, c) != b->GetComponent(start + i, c))
+        {
+        cerr << "Wrong value of " << a->GetName() << " at " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Check that the output holds the pieces from first to end in order.
+bool CheckOutput(vtkUnstructuredGrid* output, int first, int end)
+{
+  int numberOfPieces = end - first;
+  if (output->GetNumberOfPoints() != numberOfPieces * N * N ||
+      output->GetNumberOfCells() != numberOfPieces * (N - 1) * (N - 1))
+    {
+    cerr << "Read " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfCells() << " cells for pieces " << first
+         << " to " << end << endl;
+    return false;
+    }
+  vtkNew<vtkUnstructuredGrid> piece;
+  for (int p = first; p < end; ++p)
+    {
+    MakePiece(p, piece.GetPointer());
+    vtkIdType firstPoint = (p - first) * N * N;
+    vtkIdType firstCell = (p - first) * (N - 1) * (N - 1);
+    if (!CompareArray(piece->GetPoints()->GetData(),
+                      output->GetPoints()->GetData(), firstPoint) ||
+        !CompareArray(piece->GetPointData()->GetArray("Values"),
+                      output->GetPointData()->GetArray("Values"),
+                      firstPoint) ||
+        !CompareArray(piece->GetPointData()->GetArray("Ids"),
+                      output->GetPointData()->GetArray("Ids"), firstPoint) ||
+        !CompareArray(piece->GetCellData()->GetArray("CellIds"),
+                      output->GetCellData()->GetArray("CellIds"), firstCell))
+      {
+      cerr << "Piece " << p << endl;
+      return false;
+      }
+    for (vtkIdType c = 0; c < piece->GetNumberOfCells(); ++c)
+      {
+      vtkIdType npts;
+      vtkIdType* pts;
+      vtkIdType outNpts;
+      vtkIdType* outPts;
+      piece->GetCellPoints(c, npts, pts);
+      output->GetCellPoints(firstCell + c, outNpts, outPts);
+      if (output->GetCellType(firstCell + c) != VTK_QUAD || npts != outNpts)
+        {
+        cerr << "Wrong cell " << c << " of piece " << p << endl;
+        return false;
+        }
+      for (vtkIdType k = 0; k < npts; ++k)
+        {
+        if (outPts[k] != firstPoint + pts[k])
+          {
+          cerr << "Wrong cell " << c << " of piece " << p << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+// Read the given update piece and check that it holds its pieces.
+bool ReadAndCheck(const std::string& fileName, int piece, int numberOfPieces,
+                  int totalNumberOfPieces)
+{
+  vtkNew<vtkXMLPUnstructuredGridReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+    reader->GetOutputInformation(0), piece, numberOfPieces, 0);
+  reader->Update();
+  int first = piece * totalNumberOfPieces / numberOfPieces;
+  int end = (piece + 1) * totalNumberOfPieces / numberOfPieces;
+  return CheckOutput(reader->GetOutput(), first, end);
+}
+}
+
+// Produce the piece requested by the pipeline, with an extra point data
+// array on the pieces from ExtraArrayPiece on.
+class vtkTestPieceSource : public vtkUnstructuredGridAlgorithm
+{
+public:
+  static vtkTestPieceSource* New();
+  vtkTypeMacro(vtkTestPieceSource, vtkUnstructuredGridAlgorithm);
+
+  vtkSetMacro(ExtraArrayPiece, int);
+
+protected:
+  vtkTestPieceSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->ExtraArrayPiece = -1;
+    }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+    {
+    outputVector->GetInformationObject(0)->Set(
+      CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+    }
+
+  virtual int RequestData(vtkInformation*, vtkInformationVector**,
+                          vtkInformationVector* outputVector)
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    int piece =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    vtkUnstructuredGrid* output = vtkUnstructuredGrid::GetData(outInfo);
+    MakePiece(piece, output);
+    if (this->ExtraArrayPiece >= 0 && piece >= this->ExtraArrayPiece)
+      {
+      vtkNew<vtkDoubleArray> extra;
+      extra->SetName("Extra");
+      extra->SetNumberOfTuples(output->GetNumberOfPoints());
+      extra->FillComponent(0, 1.0);
+      output->GetPointData()->AddArray(extra.GetPointer());
+      }
+    return 1;
+    }
+
+  int ExtraArrayPiece;
+
+private:
+  vtkTestPieceSource(const vtkTestPieceSource&);  // Not implemented.
+  void operator=(const vtkTestPieceSource&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkTestPieceSource);
+
+namespace
+{
+int Run(vtkMPIController* controller, int argc, char* argv[])
+{
+  int rank = controller->GetLocalProcessId();
+  int numberOfProcesses = controller->GetNumberOfProcesses();
+  int totalNumberOfPieces = PiecesPerProcess * numberOfProcesses;
+
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string baseName = tempDir;
+  baseName += "/TestXMLPCollectiveUnstructuredGridWriter";
+  delete [] tempDir;
+  std::string fileName = baseName + ".pvtu";
+
+  for (int run = 0; run < 2; ++run)
+    {
+    vtkNew<vtkTestPieceSource> source;
+    vtkNew<vtkXMLPCollectiveUnstructuredGridWriter> writer;
+    writer->SetInputConnection(source->GetOutputPort());
+    writer->SetController(controller);
+    writer->SetFileName(fileName.c_str());
+    writer->SetNumberOfFiles(NumberOfFiles);
+    writer->SetNumberOfPieces(totalNumberOfPieces);
+    writer->SetStartPiece(PiecesPerProcess * rank);
+    writer->SetEndPiece(PiecesPerProcess * (rank + 1) - 1);
+    writer->SetEncodeAppendedData(run);
+    if (!run)
+      {
+      writer->SetCompressorTypeToNone();
+      }
+    if (!writer->Write())
+      {
+      cerr << "Writing failed on process " << rank << endl;
+      return TEST_FAILURE;
+      }
+    controller->Barrier();
+
+    // Only the shared files are written.
+    if (rank == 0)
+      {
+      for (int file = 0; file <= NumberOfFiles; ++file)
+        {
+        vtksys_ios::ostringstream pieceFileName;
+        pieceFileName << baseName << "_" << file << ".vtu";
+        ifstream pieceFile(pieceFileName.str().c_str());
+        if (!pieceFile != (file == NumberOfFiles ||
+                           file >= numberOfProcesses))
+          {
+          cerr << "Wrong shared file " << pieceFileName.str() << endl;
+          return TEST_FAILURE;
+          }
+        }
+      }
+
+    // Read the pieces on another number of processes, and all of them
+    // on the first process.
+    if (!ReadAndCheck(fileName, rank, numberOfProcesses + 1,
+                      totalNumberOfPieces) ||
+        (rank == 0 &&
+         !ReadAndCheck(fileName, 0, 1, totalNumberOfPieces)))
+      {
+      cerr << "Encoded " << run << " on process " << rank << endl;
+      return TEST_FAILURE;
+      }
+    controller->Barrier();
+    }
+
+  // An extra array on the pieces of the last process, or on the last
+  // piece when there is only one process, makes every process fail.
+  vtkNew<vtkTestPieceSource> source;
+  source->SetExtraArrayPiece(numberOfProcesses > 1?
+                             PiecesPerProcess * (numberOfProcesses - 1) :
+                             PiecesPerProcess - 1);
+  vtkNew<vtkXMLPCollectiveUnstructuredGridWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetController(controller);
+  writer->SetFileName((baseName + "Mismatch.pvtu").c_str());
+  writer->SetNumberOfFiles(NumberOfFiles);
+  writer->SetNumberOfPieces(totalNumberOfPieces);
+  writer->SetStartPiece(PiecesPerProcess * rank);
+  writer->SetEndPiece(PiecesPerProcess * (rank + 1) - 1);
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  writer->AddObserver(vtkCommand::ErrorEvent, errorObserver.GetPointer());
+  writer->GetExecutive()->AddObserver(vtkCommand::ErrorEvent,
+                                      errorObserver.GetPointer());
+  writer->Write();
+  if (writer->GetErrorCode() == vtkErrorCode::NoError ||
+      !errorObserver->GetError())
+    {
+    cerr << "Pieces with different arrays were written on process "
+         << rank << endl;
+    return TEST_FAILURE;
+    }
+  controller->Barrier();
+  if (rank == 0)
+    {
+    ifstream summaryFile((baseName + "Mismatch.pvtu").c_str());
+    ifstream pieceFile((baseName + "Mismatch_0.vtu").c_str());
+    if (summaryFile || pieceFile)
+      {
+      cerr << "Files were left for pieces with different arrays" << endl;
+      return TEST_FAILURE;
+      }
+    }
+
+  return TEST_SUCCESS;
+}
+}
+
+int TestXMLPCollectiveUnstructuredGridWriter(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int result = Run(controller, argc, argv);
+  int allResult = result;
+  controller->AllReduce(&result, &allResult, 1, vtkCommunicator::MAX_OP);
+
+  vtkMultiProcessController::SetGlobalController(0);
+  controller->Finalize();
+  controller->Delete();
+  return allResult;
+}
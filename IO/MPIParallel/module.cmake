@@ -5,6 +5,7 @@ vtk_module(vtkIOMPIParallel
     MPI
   DEPENDS
     vtkIOGeometry
+    vtkIOParallelXML
     vtkParallelMPI
   PRIVATE_DEPENDS
     vtksys
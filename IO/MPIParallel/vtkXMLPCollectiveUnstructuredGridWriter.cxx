@@ -0,0 +1,636 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLPCollectiveUnstructuredGridWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkXMLPCollectiveUnstructuredGridWriter.h"
+
+#include "vtkBase64OutputStream.h"
+#include "vtkCellData.h"
+#include "vtkCommunicator.h"
+#include "vtkErrorCode.h"
+#include "vtkInformation.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkOutputStream.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnstructuredGrid.h"
+#define vtkXMLOffsetsManager_DoNotInclude
+#include "vtkXMLOffsetsManager.h"
+#undef vtkXMLOffsetsManager_DoNotInclude
+
+#include <vtksys/ios/sstream>
+
+#include <string>
+#include <vector>
+
+// Include the MPI headers and then determine if MPIIO is available.
+#include "vtkMPI.h"
+
+#ifdef MPI_VERSION
+#  if (MPI_VERSION >= 2)
+#    define VTK_USE_MPI_IO 1
+#  endif
+#endif
+#if !defined(VTK_USE_MPI_IO) && defined(ROMIO_VERSION)
+#  define VTK_USE_MPI_IO 1
+#endif
+#if !defined(VTK_USE_MPI_IO) && defined(MPI_SEEK_SET)
+#  define VTK_USE_MPI_IO 1
+#endif
+
+#ifdef VTK_USE_MPI_IO
+
+#include "vtkMPICommunicator.h"
+#include "vtkMPIController.h"
+
+// This macro can be wrapped around MPI function calls to report errors
+// and record them in the local variable result.  The calls are made
+// even after an error so that the processes keep making the same
+// collective calls.
+#define MPICall(funcall) \
+  { \
+  int __my_result = funcall; \
+  if (__my_result != MPI_SUCCESS) \
+    { \
+    char errormsg[MPI_MAX_ERROR_STRING]; \
+    int dummy; \
+    MPI_Error_string(__my_result, errormsg, &dummy); \
+    vtkErrorMacro(<< "Received error when calling" << endl \
+                  << #funcall << endl << endl \
+                  << errormsg); \
+    result = 0; \
+    } \
+  }
+
+//----------------------------------------------------------------------------
+// Write a buffer at an offset of a file with collective calls of at
+// most 1 GB each.  Every process of the file makes as many calls as
+// the process with the longest buffer needs.
+static int vtkXMLPCollectiveWriteAtAll(MPI_File file, vtkTypeInt64 offset,
+                                       const char* buffer,
+                                       vtkTypeInt64 length,
+                                       vtkTypeInt64 maximumLength)
+{
+  const vtkTypeInt64 blockSize = 1 << 30;
+  int result = MPI_SUCCESS;
+  for(vtkTypeInt64 done = 0; done < maximumLength; done += blockSize)
+    {
+    vtkTypeInt64 count = length - done;
+    count = count < 0? 0 : (count > blockSize? blockSize : count);
+    const char* data = count > 0? buffer + done : buffer;
+    int callResult =
+      MPI_File_write_at_all(file, static_cast<MPI_Offset>(offset + done),
+                            const_cast<char*>(data), static_cast<int>(count),
+                            MPI_BYTE, MPI_STATUS_IGNORE);
+    if(result == MPI_SUCCESS)
+      {
+      result = callResult;
+      }
+    }
+  return result;
+}
+
+#endif // VTK_USE_MPI_IO
+
+vtkStandardNewMacro(vtkXMLPCollectiveUnstructuredGridWriter);
+
+//----------------------------------------------------------------------------
+// An output stream buffer that keeps what is written in a vector, so that
+// the encoded pieces are written to the shared file without copying them.
+// Seeking is supported for the offsets forwarded into the header.
+class vtkXMLPCollectiveBuffer : public std::streambuf
+{
+public:
+  vtkXMLPCollectiveBuffer(): Position(0) {}
+
+  const char* GetData() const
+    {
+    return this->Data.empty()? 0 : &this->Data[0];
+    }
+  vtkTypeInt64 GetSize() const
+    {
+    return static_cast<vtkTypeInt64>(this->Data.size());
+    }
+
+  // Discard the contents and release their memory.
+  void Clear()
+    {
+    std::vector<char>().swap(this->Data);
+    this->Position = 0;
+    }
+
+protected:
+  virtual int_type overflow(int_type c)
+    {
+    if(traits_type::eq_int_type(c, traits_type::eof()))
+      {
+      return traits_type::not_eof(c);
+      }
+    char value = traits_type::to_char_type(c);
+    this->xsputn(&value, 1);
+    return c;
+    }
+
+  virtual std::streamsize xsputn(const char* s, std::streamsize n)
+    {
+    size_t end = this->Position + static_cast<size_t>(n);
+    if(end > this->Data.size())
+      {
+      this->Data.resize(end);
+      }
+    if(n > 0)
+      {
+      memcpy(&this->Data[this->Position], s, static_cast<size_t>(n));
+      }
+    this->Position = end;
+    return n;
+    }
+
+  virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                           std::ios_base::openmode which)
+    {
+    off_type base = 0;
+    if(dir == std::ios_base::cur)
+      {
+      base = static_cast<off_type>(this->Position);
+      }
+    else if(dir == std::ios_base::end)
+      {
+      base = static_cast<off_type>(this->Data.size());
+      }
+    return this->seekpos(pos_type(base + off), which);
+    }
+
+  virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+    {
+    off_type position = off_type(pos);
+    if(!(which & std::ios_base::out) || position < 0 ||
+       position > static_cast<off_type>(this->Data.size()))
+      {
+      return pos_type(off_type(-1));
+      }
+    this->Position = static_cast<size_t>(position);
+    return pos;
+    }
+
+private:
+  std::vector<char> Data;
+  size_t Position;
+};
+
+//----------------------------------------------------------------------------
+class vtkXMLPCollectiveUnstructuredGridWriterInternals
+{
+public:
+  vtkXMLPCollectiveUnstructuredGridWriterInternals():
+    Shared(false), WritingSharedFile(false), Header(&HeaderBuffer),
+    Data(&DataBuffer), FirstIndex(0) {}
+
+  // Whether the pieces are written to shared files, and whether the
+  // start of one is being written.
+  bool Shared;
+  bool WritingSharedFile;
+
+  // The XML elements and the appended data of the pieces of this
+  // process.  The offsets of the arrays are relative to the data of
+  // this process until the data of the other processes are known.
+  vtkXMLPCollectiveBuffer HeaderBuffer;
+  vtkXMLPCollectiveBuffer DataBuffer;
+  ostream Header;
+  ostream Data;
+  OffsetsManagerGroup Offsets;
+
+  // The arrays of the first piece of this process, which all pieces of
+  // all processes must have.
+  std::string ArraySignature;
+
+  // The index of the first piece of this process in its shared file,
+  // and the shared file of this process if it started that file.
+  int FirstIndex;
+  std::string StartedFileName;
+
+  // The shared file and the index in that file of every piece, known
+  // on the process that writes the summary file.
+  std::vector<int> PieceFiles;
+  std::vector<int> PieceIndices;
+};
+
+//----------------------------------------------------------------------------
+vtkXMLPCollectiveUnstructuredGridWriter::vtkXMLPCollectiveUnstructuredGridWriter()
+{
+  this->NumberOfFiles = 1;
+  this->Internals = new vtkXMLPCollectiveUnstructuredGridWriterInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkXMLPCollectiveUnstructuredGridWriter::~vtkXMLPCollectiveUnstructuredGridWriter()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPCollectiveUnstructuredGridWriter::PrintSelf(ostream& os,
+                                                        vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "NumberOfFiles: " << this->NumberOfFiles << "\n";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkXMLPCollectiveUnstructuredGridWriter::GetDataSetName()
+{
+  if(this->Internals->WritingSharedFile)
+    {
+    return "UnstructuredGrid";
+    }
+  return this->Superclass::GetDataSetName();
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLPCollectiveUnstructuredGridWriter::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLPCollectiveUnstructuredGridWriter::WritePieces()
+{
+  vtkXMLPCollectiveUnstructuredGridWriterInternals* internals = this->Internals;
+  internals->Shared = false;
+#ifdef VTK_USE_MPI_IO
+  internals->Shared = vtkMPIController::SafeDownCast(this->Controller) != 0;
+#endif
+  if(!internals->Shared)
+    {
+    return this->Superclass::WritePieces();
+    }
+
+  if(!this->PieceFileNameExtension)
+    {
+    this->PieceFileNameExtension = new char[5];
+    strcpy(this->PieceFileNameExtension, ".vtu");
+    }
+
+  // Encode the pieces of this process in memory.
+  internals->HeaderBuffer.Clear();
+  internals->Header.clear();
+  internals->Header.precision(11);
+  internals->Header.imbue(std::locale::classic());
+  internals->DataBuffer.Clear();
+  internals->Data.clear();
+  internals->Offsets.Allocate(0);
+  internals->StartedFileName.clear();
+  internals->ArraySignature.clear();
+  if(this->EncodeAppendedData)
+    {
+    vtkBase64OutputStream* base64 = vtkBase64OutputStream::New();
+    this->SetDataStream(base64);
+    base64->Delete();
+    }
+  else
+    {
+    vtkOutputStream* raw = vtkOutputStream::New();
+    this->SetDataStream(raw);
+    raw->Delete();
+    }
+  this->DataStream->SetStream(&internals->Data);
+  this->Stream = &internals->Header;
+
+  int result = 1;
+  for(int i = this->StartPiece; result && i <= this->EndPiece; ++i)
+    {
+    // The input is up to date for the first piece.  Request the others
+    // one at a time.
+    if(i > this->StartPiece)
+      {
+      int port;
+      vtkAlgorithm* producer = this->GetInputAlgorithm(0, 0, port);
+      producer->UpdateInformation();
+      vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+        producer->GetOutputInformation(port), i, this->NumberOfPieces,
+        this->GhostLevel);
+      producer->Update(port);
+      }
+    vtkUnstructuredGrid* piece =
+      vtkUnstructuredGrid::SafeDownCast(this->GetInput());
+    if(!piece)
+      {
+      vtkErrorMacro("No piece provided!");
+      result = 0;
+      continue;
+      }
+    std::string signature =
+      this->GetArraySignature(piece->GetPointData()) + "\n" +
+      this->GetArraySignature(piece->GetCellData());
+    if(i == this->StartPiece)
+      {
+      internals->ArraySignature = signature;
+      }
+    if(signature != internals->ArraySignature)
+      {
+      vtkErrorMacro("Piece " << i
+                    << " does not have the arrays of the first piece.");
+      result = 0;
+      continue;
+      }
+    result = this->WriteSpooledPiece(
+      piece, vtkIndent().GetNextIndent().GetNextIndent(), internals->Data,
+      &internals->Offsets);
+    this->UpdateProgressDiscrete(
+      0.5f * (i - this->StartPiece + 1) /
+      (this->EndPiece - this->StartPiece + 1));
+    }
+  this->Stream = 0;
+  this->DataStream->SetStream(0);
+
+  // Keep the data of every process a whole number of words long so that
+  // the data of the next process stay aligned.
+  while(static_cast<vtkTypeInt64>(internals->Data.tellp()) % 8 != 0)
+    {
+    internals->Data.put(0);
+    }
+
+  // The summary file describes the arrays once, so the pieces of every
+  // process must have the arrays of the first process with pieces.
+  int rank = this->Controller->GetLocalProcessId();
+  int numberOfProcesses = this->Controller->GetNumberOfProcesses();
+  int hasPieces = this->StartPiece <= this->EndPiece? rank : numberOfProcesses;
+  int firstWithPieces = numberOfProcesses;
+  this->Controller->AllReduce(&hasPieces, &firstWithPieces, 1,
+                              vtkCommunicator::MIN_OP);
+  if(firstWithPieces < numberOfProcesses)
+    {
+    vtkMultiProcessStream stream;
+    if(rank == firstWithPieces)
+      {
+      stream << internals->ArraySignature;
+      }
+    this->Controller->Broadcast(stream, firstWithPieces);
+    std::string firstSignature;
+    stream >> firstSignature;
+    if(result && hasPieces == rank &&
+       internals->ArraySignature != firstSignature)
+      {
+      vtkErrorMacro("Piece " << this->StartPiece
+                    << " does not have the arrays of the first piece.");
+      result = 0;
+      }
+    }
+
+  // The processes write the shared files only if all of them could
+  // encode their pieces.
+  int numberOfFiles = this->NumberOfFiles < numberOfProcesses?
+    this->NumberOfFiles : numberOfProcesses;
+  int file = static_cast<int>(
+    static_cast<vtkTypeInt64>(rank) * numberOfFiles / numberOfProcesses);
+  int allResult = 0;
+  this->Controller->AllReduce(&result, &allResult, 1,
+                              vtkCommunicator::MIN_OP);
+  if(allResult)
+    {
+    result = this->WriteSharedFile(file);
+    this->Controller->AllReduce(&result, &allResult, 1,
+                                vtkCommunicator::MIN_OP);
+    }
+  internals->HeaderBuffer.Clear();
+  internals->DataBuffer.Clear();
+  if(!allResult)
+    {
+    if(!internals->StartedFileName.empty())
+      {
+      this->DeleteAFile(internals->StartedFileName.c_str());
+      }
+    if(this->ErrorCode == vtkErrorCode::NoError)
+      {
+      this->SetErrorCode(vtkErrorCode::UnknownError);
+      }
+    return 0;
+    }
+
+  // Tell the process writing the summary file where every piece is.
+  int local[4] =
+    {this->StartPiece, this->EndPiece, file, internals->FirstIndex};
+  std::vector<int> all(4 * numberOfProcesses);
+  this->Controller->Gather(local, &all[0], 4, 0);
+  if(rank == 0)
+    {
+    internals->PieceFiles.assign(this->NumberOfPieces, -1);
+    internals->PieceIndices.assign(this->NumberOfPieces, -1);
+    for(int p = 0; p < numberOfProcesses; ++p)
+      {
+      int* pieces = &all[4 * p];
+      for(int i = pieces[0]; i <= pieces[1]; ++i)
+        {
+        if(i >= 0 && i < this->NumberOfPieces)
+          {
+          internals->PieceFiles[i] = pieces[2];
+          internals->PieceIndices[i] = pieces[3] + i - pieces[0];
+          }
+        }
+      }
+    }
+  this->UpdateProgressDiscrete(1);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPCollectiveUnstructuredGridWriter::WritePPieceAttributes(int index)
+{
+  vtkXMLPCollectiveUnstructuredGridWriterInternals* internals = this->Internals;
+  if(!internals->Shared ||
+     index >= static_cast<int>(internals->PieceFiles.size()) ||
+     internals->PieceFiles[index] < 0)
+    {
+    this->Superclass::WritePPieceAttributes(index);
+    return;
+    }
+  char* fileName = this->CreatePieceFileName(internals->PieceFiles[index]);
+  this->WriteStringAttribute("Source", fileName);
+  delete [] fileName;
+  this->WriteScalarAttribute("Index", internals->PieceIndices[index]);
+}
+
+//----------------------------------------------------------------------------
+#ifdef VTK_USE_MPI_IO
+int vtkXMLPCollectiveUnstructuredGridWriter::WriteSharedFile(int file)
+{
+  vtkXMLPCollectiveUnstructuredGridWriterInternals* internals = this->Internals;
+  int result = 1;
+
+  // Group the processes writing the same file in the order of the
+  // processes.
+  vtkMPIController* controller =
+    vtkMPIController::SafeDownCast(this->Controller);
+  vtkMPIController* group =
+    controller->PartitionController(file, controller->GetLocalProcessId());
+  vtkMPICommunicator* communicator =
+    vtkMPICommunicator::SafeDownCast(group->GetCommunicator());
+  MPI_Comm handle = *communicator->GetMPIComm()->GetHandle();
+  int groupRank = group->GetLocalProcessId();
+  int groupSize = group->GetNumberOfProcesses();
+
+  // Find where the header and the data of this process go from the
+  // sizes of those of all processes of the group.
+  vtkTypeInt64 sizes[3];
+  sizes[0] = internals->HeaderBuffer.GetSize();
+  sizes[1] = internals->DataBuffer.GetSize();
+  sizes[2] = this->EndPiece - this->StartPiece + 1;
+  if(sizes[2] < 0)
+    {
+    sizes[2] = 0;
+    }
+  std::vector<vtkTypeInt64> allSizes(3 * groupSize);
+  MPICall(MPI_Allgather(sizes, static_cast<int>(sizeof(sizes)), MPI_BYTE,
+                        &allSizes[0], static_cast<int>(sizeof(sizes)),
+                        MPI_BYTE, handle));
+  vtkTypeInt64 headerOffset = 0;
+  vtkTypeInt64 dataOffset = 0;
+  vtkTypeInt64 firstIndex = 0;
+  vtkTypeInt64 totals[2] = {0, 0};
+  vtkTypeInt64 maximums[2] = {0, 0};
+  for(int p = 0; p < groupSize; ++p)
+    {
+    if(p < groupRank)
+      {
+      headerOffset += allSizes[3 * p];
+      dataOffset += allSizes[3 * p + 1];
+      firstIndex += allSizes[3 * p + 2];
+      }
+    for(int k = 0; k < 2; ++k)
+      {
+      totals[k] += allSizes[3 * p + k];
+      if(allSizes[3 * p + k] > maximums[k])
+        {
+        maximums[k] = allSizes[3 * p + k];
+        }
+      }
+    }
+  internals->FirstIndex = static_cast<int>(firstIndex);
+
+  // Now that the data of the previous processes are known, make the
+  // offsets of the arrays relative to the appended data of the file.
+  this->Stream = &internals->Header;
+  for(unsigned int i = 0; i < internals->Offsets.GetNumberOfElements(); ++i)
+    {
+    OffsetsManager& offsets = internals->Offsets.GetElement(i);
+    this->ForwardAppendedDataOffset(offsets.GetPosition(0),
+                                    dataOffset + offsets.GetOffsetValue(0),
+                                    "offset");
+    }
+
+  // Every process lays out the parts written by the first process of
+  // the group: the start of the file before the headers, the start of
+  // the appended data on a word boundary after them, and the end of
+  // the file after the data.
+  internals->WritingSharedFile = true;
+  vtksys_ios::ostringstream start;
+  start.precision(11);
+  this->Stream = &start;
+  this->StartFile();
+  start << "  <" << this->GetDataSetName() << ">\n";
+
+  vtksys_ios::ostringstream appended;
+  this->Stream = &appended;
+  this->StartAppendedData();
+  vtksys_ios::ostringstream middle;
+  middle << "  </" << this->GetDataSetName() << ">\n";
+  vtkTypeInt64 position = static_cast<vtkTypeInt64>(start.str().size()) +
+    totals[0] + static_cast<vtkTypeInt64>(middle.str().size()) +
+    static_cast<vtkTypeInt64>(appended.str().size());
+  for(vtkTypeInt64 i = 0; i < (8 - position % 8) % 8; ++i)
+    {
+    middle << " ";
+    }
+  middle << appended.str();
+
+  vtksys_ios::ostringstream end;
+  this->Stream = &end;
+  this->EndAppendedData();
+  this->EndFile();
+  this->Stream = 0;
+  internals->WritingSharedFile = false;
+
+  std::string startString = start.str();
+  std::string middleString = middle.str();
+  std::string endString = end.str();
+  vtkTypeInt64 headerStart = static_cast<vtkTypeInt64>(startString.size());
+  vtkTypeInt64 dataStart = headerStart + totals[0] +
+    static_cast<vtkTypeInt64>(middleString.size());
+  vtkTypeInt64 fileSize = dataStart + totals[1] +
+    static_cast<vtkTypeInt64>(endString.size());
+
+  // Write the file collectively.
+  char* fileName = this->CreatePieceFileName(file, this->PathName);
+  MPI_File fileHandle;
+  int openResult = MPI_File_open(handle, fileName,
+                                 MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                                 MPI_INFO_NULL, &fileHandle);
+  if(openResult != MPI_SUCCESS)
+    {
+    vtkErrorMacro("Error opening file \"" << fileName << "\"");
+    this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+    delete [] fileName;
+    group->Delete();
+    return 0;
+    }
+  if(groupRank == 0)
+    {
+    internals->StartedFileName = fileName;
+    }
+  delete [] fileName;
+
+  MPICall(MPI_File_set_size(fileHandle, static_cast<MPI_Offset>(fileSize)));
+  if(groupRank == 0)
+    {
+    MPICall(MPI_File_write_at(fileHandle, 0,
+                              const_cast<char*>(startString.c_str()),
+                              static_cast<int>(startString.size()),
+                              MPI_BYTE, MPI_STATUS_IGNORE));
+    MPICall(MPI_File_write_at(fileHandle,
+                              static_cast<MPI_Offset>(headerStart + totals[0]),
+                              const_cast<char*>(middleString.c_str()),
+                              static_cast<int>(middleString.size()),
+                              MPI_BYTE, MPI_STATUS_IGNORE));
+    MPICall(MPI_File_write_at(fileHandle,
+                              static_cast<MPI_Offset>(dataStart + totals[1]),
+                              const_cast<char*>(endString.c_str()),
+                              static_cast<int>(endString.size()),
+                              MPI_BYTE, MPI_STATUS_IGNORE));
+    }
+  MPICall(vtkXMLPCollectiveWriteAtAll(fileHandle, headerStart + headerOffset,
+                                      internals->HeaderBuffer.GetData(),
+                                      sizes[0], maximums[0]));
+  MPICall(vtkXMLPCollectiveWriteAtAll(fileHandle, dataStart + dataOffset,
+                                      internals->DataBuffer.GetData(),
+                                      sizes[1], maximums[1]));
+  MPICall(MPI_File_close(&fileHandle));
+
+  group->Delete();
+  if(!result && this->ErrorCode == vtkErrorCode::NoError)
+    {
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+    }
+  return result;
+}
+#else // VTK_USE_MPI_IO
+int vtkXMLPCollectiveUnstructuredGridWriter::WriteSharedFile(int)
+{
+  vtkErrorMacro(<< "vtkXMLPCollectiveUnstructuredGridWriter::WriteSharedFile() "
+                << "called when MPIIO not available.");
+  return 0;
+}
+#endif // VTK_USE_MPI_IO
@@ -0,0 +1,87 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLPCollectiveUnstructuredGridWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkXMLPCollectiveUnstructuredGridWriter - Write a PVTK XML UnstructuredGrid file into a few shared files with MPI-IO.
+// .SECTION Description
+// vtkXMLPCollectiveUnstructuredGridWriter writes the PVTK XML
+// UnstructuredGrid file format like vtkXMLPUnstructuredGridWriter, but
+// instead of writing one file per piece it splits the processes of the
+// controller into NumberOfFiles groups of consecutive processes.  The
+// processes of a group write their pieces into one shared VTK XML
+// UnstructuredGrid file with collective MPI-IO calls, in the order of
+// the processes.  Each Piece element of the summary file names the
+// shared file of the piece and its index in that file with an Index
+// attribute, which vtkXMLPUnstructuredGridReader uses to read only
+// that piece.
+//
+// Every process encodes its pieces in memory before the collective
+// write, so the shared files are always written in appended mode.  All
+// pieces must have the same point and cell data arrays.  Polyhedral
+// cells are not supported.  When the controller is not a
+// vtkMPIController, or MPI-IO is not available, one file is written
+// per piece as the superclass does.
+
+// .SECTION See Also
+// vtkXMLPUnstructuredGridWriter vtkXMLPUnstructuredGridReader
+
+#ifndef __vtkXMLPCollectiveUnstructuredGridWriter_h
+#define __vtkXMLPCollectiveUnstructuredGridWriter_h
+
+#include "vtkIOMPIParallelModule.h" // For export macro
+#include "vtkXMLPUnstructuredGridWriter.h"
+
+class vtkUnstructuredGrid;
+class vtkXMLPCollectiveUnstructuredGridWriterInternals;
+
+class VTKIOMPIPARALLEL_EXPORT vtkXMLPCollectiveUnstructuredGridWriter : public vtkXMLPUnstructuredGridWriter
+{
+public:
+  static vtkXMLPCollectiveUnstructuredGridWriter* New();
+  vtkTypeMacro(vtkXMLPCollectiveUnstructuredGridWriter,vtkXMLPUnstructuredGridWriter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get/Set the number of shared files the pieces are written to.  It
+  // is limited to the number of processes.  The default is 1.
+  vtkSetClampMacro(NumberOfFiles, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfFiles, int);
+
+protected:
+  vtkXMLPCollectiveUnstructuredGridWriter();
+  ~vtkXMLPCollectiveUnstructuredGridWriter();
+
+  // see algorithm for more info
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+
+  // The shared files are UnstructuredGrid files.
+  const char* GetDataSetName();
+
+  // Write the pieces of all processes into the shared files.
+  virtual int WritePieces();
+  virtual void WritePPieceAttributes(int index);
+
+  // Write the encoded pieces of this process into the given shared file
+  // together with the other processes of its group.
+  int WriteSharedFile(int file);
+
+  int NumberOfFiles;
+
+private:
+  vtkXMLPCollectiveUnstructuredGridWriterInternals* Internals;
+
+  vtkXMLPCollectiveUnstructuredGridWriter(const vtkXMLPCollectiveUnstructuredGridWriter&);  // Not implemented.
+  void operator=(const vtkXMLPCollectiveUnstructuredGridWriter&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,174 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLBlockFilters.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that unstructured grids written with byte shuffling
+// and delta encoding are read back identically in both byte orders and
+// data modes, and that the transforms make the file smaller.
+
+#include "vtkCellArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <cmath>
+#include <string>
+#include <vtksys/SystemTools.hxx>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+const int N = 100;
+
+bool Compare(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfCells() != b->GetNumberOfCells())
+    {
+    cerr << "Wrong number of points or cells" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+    {
+    double p[3];
+    double q[3];
+    a->GetPoint(i, p);
+    b->GetPoint(i, q);
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2] ||
+        a->GetPointData()->GetArray("Values")->GetTuple1(i) !=
+        b->GetPointData()->GetArray("Values")->GetTuple1(i))
+      {
+      cerr << "Wrong point data at " << i << endl;
+      return false;
+      }
+    }
+  vtkIdTypeArray* ca = a->GetCells()->GetData();
+  vtkIdTypeArray* cb = b->GetCells()->GetData();
+  if (ca->GetNumberOfTuples() != cb->GetNumberOfTuples())
+    {
+    cerr << "Wrong connectivity size" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < ca->GetNumberOfTuples(); ++i)
+    {
+    if (ca->GetValue(i) != cb->GetValue(i))
+      {
+      cerr << "Wrong connectivity at " << i << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+unsigned long Write(vtkUnstructuredGrid* grid, const std::string& fileName,
+                    int byteOrder, int appended, int filters)
+{
+  vtkNew<vtkXMLUnstructuredGridWriter> writer;
+  writer->SetInputData(grid);
+  writer->SetFileName(fileName.c_str());
+  writer->SetByteOrder(byteOrder);
+  writer->SetByteShuffle(filters);
+  writer->SetDeltaEncoding(filters);
+  if (appended)
+    {
+    writer->SetDataModeToAppended();
+    writer->EncodeAppendedDataOff();
+    }
+  else
+    {
+    writer->SetDataModeToBinary();
+    }
+  if (!writer->Write())
+    {
+    return 0;
+    }
+  return vtksys::SystemTools::FileLength(fileName.c_str());
+}
+}
+
+int TestXMLBlockFilters(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestXMLBlockFilters.vtu";
+  delete [] tempDir;
+
+  // A grid of N x N points with smooth values and quads.
+  vtkNew<vtkUnstructuredGrid> grid;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> values;
+  values->SetName("Values");
+  for (int j = 0; j < N; ++j)
+    {
+    for (int i = 0; i < N; ++i)
+      {
+      points->InsertNextPoint(0.01 * i, 0.01 * j, sin(0.05 * i) * j);
+      values->InsertNextValue(static_cast<float>(cos(0.03 * i + 0.02 * j)));
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->AddArray(values.GetPointer());
+  grid->Allocate((N - 1) * (N - 1));
+  for (int j = 0; j < N - 1; ++j)
+    {
+    for (int i = 0; i < N - 1; ++i)
+      {
+      vtkIdType quad[4] = {j * N + i, j * N + i + 1, (j + 1) * N + i + 1,
+                           (j + 1) * N + i};
+      grid->InsertNextCell(VTK_QUAD, 4, quad);
+      }
+    }
+
+  for (int byteOrder = 0; byteOrder < 2; ++byteOrder)
+    {
+    for (int appended = 0; appended < 2; ++appended)
+      {
+      unsigned long plainSize =
+        Write(grid.GetPointer(), fileName, byteOrder, appended, 0);
+      unsigned long filteredSize =
+        Write(grid.GetPointer(), fileName, byteOrder, appended, 1);
+      if (!plainSize || !filteredSize)
+        {
+        cerr << "Writing failed" << endl;
+        return TEST_FAILURE;
+        }
+      if (filteredSize >= plainSize)
+        {
+        cerr << "Filtered file is not smaller: " << filteredSize
+             << " bytes instead of " << plainSize << endl;
+        return TEST_FAILURE;
+        }
+
+      vtkNew<vtkXMLUnstructuredGridReader> reader;
+      reader->SetFileName(fileName.c_str());
+      reader->Update();
+      if (!Compare(grid.GetPointer(), reader->GetOutput()))
+        {
+        cerr << "Byte order " << byteOrder << ", appended " << appended
+             << endl;
+        return TEST_FAILURE;
+        }
+      }
+    }
+
+  return TEST_SUCCESS;
+}
@@ -0,0 +1,208 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressedBlocks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that compressed XML data made of many blocks, which
+// are compressed and decompressed in batches, are read back identically,
+// in whole and for a sub-extent, in both byte orders and data modes,
+// with each compressor and with and without byte shuffling.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+double Value(int i, int j)
+{
+  return sin(0.1 * i) * cos(0.05 * j) + i;
+}
+
+// Read the image file and compare the values in the extent.
+bool ReadAndCompare(const std::string& fileName, int extent[6],
+                    const char* step)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SafeDownCast(reader->GetExecutive())
+    ->SetUpdateExtent(0, extent);
+  reader->Update();
+
+  vtkImageData* image = reader->GetOutput();
+  vtkDataArray* values = image->GetPointData()->GetArray("Values");
+  int* ext = image->GetExtent();
+  if (!values || ext[0] > extent[0] || ext[1] < extent[1] ||
+      ext[2] > extent[2] || ext[3] < extent[3])
+    {
+    cerr << step << ": the extent was not read" << endl;
+    return false;
+    }
+  for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+    for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+      int ijk[3] = {i, j, 0};
+      vtkIdType id = image->ComputePointId(ijk);
+      if (values->GetTuple1(id) != Value(i, j))
+        {
+        cerr << step << ": wrong value at " << i << ", " << j << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Write the image with the given compressor and byte shuffling and read
+// it back.
+bool WriteAndCompare(vtkImageData* image, const std::string& fileName,
+                     int compressor, int shuffle, int byteOrder,
+                     int appended)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetCompressorType(compressor);
+  writer->SetBlockSize(256);
+  writer->SetByteOrder(byteOrder);
+  writer->SetByteShuffle(shuffle);
+  if (appended)
+    {
+    writer->SetDataModeToAppended();
+    }
+  else
+    {
+    writer->SetDataModeToBinary();
+    }
+  if (!writer->Write())
+    {
+    cerr << "Writing failed" << endl;
+    return false;
+    }
+
+  int wholeExtent[6] = {0, 199, 0, 199, 0, 0};
+  int subExtent[6] = {20, 120, 30, 150, 0, 0};
+  if (!ReadAndCompare(fileName, wholeExtent, "Whole extent") ||
+      !ReadAndCompare(fileName, subExtent, "Sub-extent"))
+    {
+    cerr << "Compressor " << compressor << ", shuffle " << shuffle
+         << ", byte order " << byteOrder << ", appended " << appended
+         << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestXMLCompressedBlocks(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestXMLCompressedBlocks.vti";
+  delete [] tempDir;
+
+  // 200x200 doubles in blocks of 256 bytes make 1250 blocks.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 199, 0, 199, 0, 0);
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfValues(200 * 200);
+  for (int j = 0; j < 200; ++j)
+    {
+    for (int i = 0; i < 200; ++i)
+      {
+      values->SetValue(j * 200 + i, Value(i, j));
+      }
+    }
+  image->GetPointData()->AddArray(values.GetPointer());
+
+  int wholeExtent[6] = {0, 199, 0, 199, 0, 0};
+  int subExtent[6] = {20, 120, 30, 150, 0, 0};
+  for (int byteOrder = 0; byteOrder < 2; ++byteOrder)
+    {
+    for (int appended = 0; appended < 2; ++appended)
+      {
+      vtkNew<vtkXMLImageDataWriter> writer;
+      writer->SetInputData(image.GetPointer());
+      writer->SetFileName(fileName.c_str());
+      writer->SetCompressorTypeToZLib();
+      writer->SetBlockSize(256);
+      writer->SetByteOrder(byteOrder);
+      if (appended)
+        {
+        writer->SetDataModeToAppended();
+        }
+      else
+        {
+        writer->SetDataModeToBinary();
+        }
+      if (!writer->Write())
+        {
+        cerr << "Writing failed" << endl;
+        return TEST_FAILURE;
+        }
+
+      if (!ReadAndCompare(fileName, wholeExtent, "Whole extent") ||
+          !ReadAndCompare(fileName, subExtent, "Sub-extent"))
+        {
+        cerr << "Byte order " << byteOrder << ", appended " << appended
+             << endl;
+        return TEST_FAILURE;
+        }
+      }
+    }
+
+  for (int byteOrder = 0; byteOrder < 2; ++byteOrder)
+    {
+    for (int appended = 0; appended < 2; ++appended)
+      {
+      if (!WriteAndCompare(image.GetPointer(), fileName, vtkXMLWriter::LZ4,
+                           0, byteOrder, appended))
+        {
+        return TEST_FAILURE;
+        }
+      }
+    }
+
+  // Byte shuffling with each compressor.
+  int compressors[2] = {vtkXMLWriter::ZLIB, vtkXMLWriter::LZ4};
+  for (int c = 0; c < 2; ++c)
+    {
+    for (int appended = 0; appended < 2; ++appended)
+      {
+      for (int byteOrder = 0; byteOrder < 2; ++byteOrder)
+        {
+        if (!WriteAndCompare(image.GetPointer(), fileName, compressors[c],
+                             1, byteOrder, appended))
+          {
+          return TEST_FAILURE;
+          }
+        }
+      }
+    }
+
+  return TEST_SUCCESS;
+}
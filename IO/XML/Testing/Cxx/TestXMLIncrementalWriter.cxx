@@ -0,0 +1,306 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLIncrementalWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that an unstructured grid written one piece at a
+// time reads back as the pieces appended in order, for raw and encoded
+// appended data with and without compression, and that the spool file
+// is removed.  A piece that cannot be written makes the file fail.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkErrorCode.h"
+#include "vtkExecutive.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLIncrementalUnstructuredGridWriter.h"
+#include "vtkXMLUnstructuredGridReader.h"
+
+#include <vtksys/Directory.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <cmath>
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+const int N = 40;
+const int NumberOfPieces = 5;
+
+// Fill a strip of N x N points and quads for the given piece.
+void MakePiece(int piece, vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfComponents(2);
+  for (int j = 0; j < N; ++j)
+    {
+    for (int i = 0; i < N; ++i)
+      {
+      points->InsertNextPoint(i + piece * (N - 1), j, sin(0.1 * i) * j);
+      values->InsertNextValue(cos(0.03 * i + 0.02 * j) + piece);
+      ids->InsertNextTuple2(i, j + piece * N);
+      }
+    }
+  grid->Initialize();
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->SetScalars(values.GetPointer());
+  grid->GetPointData()->AddArray(ids.GetPointer());
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  grid->Allocate((N - 1) * (N - 1));
+  for (int j = 0; j < N - 1; ++j)
+    {
+    for (int i = 0; i < N - 1; ++i)
+      {
+      vtkIdType quad[4] = {j * N + i, j * N + i + 1, (j + 1) * N + i + 1,
+                           (j + 1) * N + i};
+      grid->InsertNextCell(VTK_QUAD, 4, quad);
+      cellIds->InsertNextValue(piece * N * N + j * N + i);
+      }
+    }
+  grid->GetCellData()->AddArray(cellIds.GetPointer());
+}
+
+bool CompareArray(vtkDataArray* a, vtkDataArray* b, vtkIdType start)
+{
+  if (!a || !b || a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    cerr << "Missing array" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+    {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+      {
+      if (a->GetComponent(i, c) != b->GetComponent(start + i, c))
+        {
+        cerr << "Wrong value of " << a->GetName() << " at " << i << endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+// Check that the output holds every piece in order.
+bool CheckOutput(vtkUnstructuredGrid* output)
+{
+  if (output->GetNumberOfPoints() != NumberOfPieces * N * N ||
+      output->GetNumberOfCells() != NumberOfPieces * (N - 1) * (N - 1))
+    {
+    cerr << "Read " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfCells() << " cells" << endl;
+    return false;
+    }
+  vtkNew<vtkUnstructuredGrid> piece;
+  for (int p = 0; p < NumberOfPieces; ++p)
+    {
+    MakePiece(p, piece.GetPointer());
+    vtkIdType firstPoint = p * N * N;
+    vtkIdType firstCell = p * (N - 1) * (N - 1);
+    if (!CompareArray(piece->GetPoints()->GetData(),
+                      output->GetPoints()->GetData(), firstPoint) ||
+        !CompareArray(piece->GetPointData()->GetArray("Values"),
+                      output->GetPointData()->GetArray("Values"),
+                      firstPoint) ||
+        !CompareArray(piece->GetPointData()->GetArray("Ids"),
+                      output->GetPointData()->GetArray("Ids"), firstPoint) ||
+        !CompareArray(piece->GetCellData()->GetArray("CellIds"),
+                      output->GetCellData()->GetArray("CellIds"), firstCell))
+      {
+      cerr << "Piece " << p << endl;
+      return false;
+      }
+    for (vtkIdType c = 0; c < piece->GetNumberOfCells(); ++c)
+      {
+      vtkIdType npts;
+      vtkIdType* pts;
+      vtkIdType outNpts;
+      vtkIdType* outPts;
+      piece->GetCellPoints(c, npts, pts);
+      output->GetCellPoints(firstCell + c, outNpts, outPts);
+      if (output->GetCellType(firstCell + c) != VTK_QUAD || npts != outNpts)
+        {
+        cerr << "Wrong cell " << c << " of piece " << p << endl;
+        return false;
+        }
+      for (vtkIdType k = 0; k < npts; ++k)
+        {
+        if (outPts[k] != firstPoint + pts[k])
+          {
+          cerr << "Wrong cell " << c << " of piece " << p << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return output->GetPointData()->GetScalars() ==
+    output->GetPointData()->GetArray("Values");
+}
+
+// Whether a spool file of the given output file is left in its directory.
+bool HasSpoolFile(const std::string& fileName)
+{
+  std::string prefix =
+    vtksys::SystemTools::GetFilenameName(fileName) + ".";
+  vtksys::Directory directory;
+  directory.Load(vtksys::SystemTools::GetFilenamePath(fileName).c_str());
+  for (unsigned long i = 0; i < directory.GetNumberOfFiles(); ++i)
+    {
+    std::string name = directory.GetFile(i);
+    if (name.compare(0, prefix.size(), prefix) == 0 &&
+        vtksys::SystemTools::StringEndsWith(name.c_str(), ".spool"))
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+// Whether the writer fails and leaves neither its file nor its spool.
+bool CheckFailure(vtkXMLIncrementalUnstructuredGridWriter* writer,
+                  int result, const std::string& fileName)
+{
+  if (result || writer->GetErrorCode() == vtkErrorCode::NoError ||
+      vtksys::SystemTools::FileExists(fileName.c_str()) ||
+      HasSpoolFile(fileName))
+    {
+    cerr << "Writing did not fail" << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestXMLIncrementalWriter(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestXMLIncrementalWriter.vtu";
+  delete [] tempDir;
+
+  for (int run = 0; run < 4; ++run)
+    {
+    int encoded = run & 1;
+    int compressed = (run >> 1) & 1;
+
+    vtkNew<vtkXMLIncrementalUnstructuredGridWriter> writer;
+    writer->SetFileName(fileName.c_str());
+    writer->SetEncodeAppendedData(encoded);
+    if (!compressed)
+      {
+      writer->SetCompressorTypeToNone();
+      }
+    if (!writer->Open())
+      {
+      cerr << "Opening failed" << endl;
+      return TEST_FAILURE;
+      }
+    for (int p = 0; p < NumberOfPieces; ++p)
+      {
+      // Each piece is released before the next one is made.
+      vtkNew<vtkUnstructuredGrid> piece;
+      MakePiece(p, piece.GetPointer());
+      if (!writer->WritePiece(piece.GetPointer()))
+        {
+        cerr << "Writing piece " << p << " failed" << endl;
+        return TEST_FAILURE;
+        }
+      }
+    if (!writer->Close() || writer->IsOpen() ||
+        writer->GetNumberOfPiecesWritten() != NumberOfPieces)
+      {
+      cerr << "Closing failed" << endl;
+      return TEST_FAILURE;
+      }
+
+    if (HasSpoolFile(fileName))
+      {
+      cerr << "The spool file was not removed" << endl;
+      return TEST_FAILURE;
+      }
+
+    vtkNew<vtkXMLUnstructuredGridReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    if (!CheckOutput(reader->GetOutput()))
+      {
+      cerr << "Encoded " << encoded << ", compressed " << compressed << endl;
+      return TEST_FAILURE;
+      }
+    }
+
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+
+  // A piece without the arrays of the first one.
+  vtkNew<vtkXMLIncrementalUnstructuredGridWriter> writer;
+  writer->AddObserver(vtkCommand::ErrorEvent, errorObserver.GetPointer());
+  writer->SetFileName(fileName.c_str());
+  vtkNew<vtkUnstructuredGrid> piece;
+  MakePiece(0, piece.GetPointer());
+  writer->Open();
+  writer->WritePiece(piece.GetPointer());
+  piece->GetCellData()->RemoveArray("CellIds");
+  int result = writer->WritePiece(piece.GetPointer());
+  result = writer->Close() || result;
+  if (!CheckFailure(writer.GetPointer(), result, fileName))
+    {
+    cerr << "Mismatched arrays" << endl;
+    return TEST_FAILURE;
+    }
+
+  // A polyhedral input written through the pipeline.
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(0, 1, 0);
+  points->InsertNextPoint(0, 0, 1);
+  vtkNew<vtkUnstructuredGrid> polyhedral;
+  polyhedral->SetPoints(points.GetPointer());
+  polyhedral->Allocate(1);
+  vtkIdType ids[4] = {0, 1, 2, 3};
+  vtkIdType faces[16] = {3, 0, 2, 1, 3, 0, 1, 3, 3, 0, 3, 2, 3, 1, 2, 3};
+  polyhedral->InsertNextCell(VTK_POLYHEDRON, 4, ids, 4, faces);
+  vtkNew<vtkXMLIncrementalUnstructuredGridWriter> pipelineWriter;
+  pipelineWriter->AddObserver(vtkCommand::ErrorEvent,
+                              errorObserver.GetPointer());
+  pipelineWriter->GetExecutive()->AddObserver(vtkCommand::ErrorEvent,
+                                              errorObserver.GetPointer());
+  pipelineWriter->SetFileName(fileName.c_str());
+  pipelineWriter->SetInputData(polyhedral.GetPointer());
+  pipelineWriter->Write();
+  if (!CheckFailure(pipelineWriter.GetPointer(), 0, fileName))
+    {
+    cerr << "Polyhedral input" << endl;
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
@@ -0,0 +1,181 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMappedAppendedData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that vtkXMLReader uses raw appended arrays in place
+// from a memory map of the file when MapAppendedData is on, that the
+// arrays stay valid after the reader is deleted, that modifying them does
+// not modify the file, and that other files are read normally.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationObjectBaseKey.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+const int N = 100;
+
+vtkSmartPointer<vtkImageData> Read(const std::string& fileName, int map)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetMapAppendedData(map);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool Compare(vtkImageData* image, vtkImageData* expected, bool mapped,
+             const char* step)
+{
+  const char* names[3] = {"Doubles", "Floats", "Ints"};
+  for (int a = 0; a < 3; ++a)
+    {
+    vtkDataArray* array = image->GetPointData()->GetArray(names[a]);
+    vtkDataArray* reference = expected->GetPointData()->GetArray(names[a]);
+    if (!array || array->GetNumberOfTuples() != reference->GetNumberOfTuples())
+      {
+      cerr << step << ": missing array " << names[a] << endl;
+      return false;
+      }
+    if (array->GetInformation()->Has(vtkXMLReader::MAPPED_FILE()) != mapped)
+      {
+      cerr << step << ": array " << names[a]
+           << (mapped ? " is not" : " is") << " mapped" << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+      {
+      for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+        {
+        if (array->GetComponent(i, c) != reference->GetComponent(i, c))
+          {
+          cerr << step << ": wrong value in " << names[a] << " at " << i
+               << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+bool Write(vtkImageData* image, const std::string& fileName, bool raw,
+           int byteOrder)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->SetEncodeAppendedData(!raw);
+  writer->SetByteOrder(byteOrder);
+  if (raw)
+    {
+    writer->SetCompressorTypeToNone();
+    }
+  return writer->Write() != 0;
+}
+}
+
+int TestXMLMappedAppendedData(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestXMLMappedAppendedData.vti";
+  delete [] tempDir;
+
+  // Arrays of several word sizes, so that some need padding in the file.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, N - 1, 0, N - 1, 0, 0);
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("Ints");
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("Doubles");
+  vtkNew<vtkFloatArray> floats;
+  floats->SetName("Floats");
+  floats->SetNumberOfComponents(3);
+  for (int i = 0; i < N * N; ++i)
+    {
+    ints->InsertNextValue(i * 7);
+    doubles->InsertNextValue(0.5 * i);
+    floats->InsertNextTuple3(i, -i, 0.25 * i);
+    }
+  image->GetPointData()->AddArray(ints.GetPointer());
+  image->GetPointData()->AddArray(doubles.GetPointer());
+  image->GetPointData()->AddArray(floats.GetPointer());
+
+#ifdef VTK_WORDS_BIGENDIAN
+  int machineOrder = vtkXMLWriter::BigEndian;
+  int otherOrder = vtkXMLWriter::LittleEndian;
+#else
+  int machineOrder = vtkXMLWriter::LittleEndian;
+  int otherOrder = vtkXMLWriter::BigEndian;
+#endif
+
+  if (!Write(image.GetPointer(), fileName, true, machineOrder))
+    {
+    cerr << "Writing failed" << endl;
+    return TEST_FAILURE;
+    }
+
+  // The arrays outlive the reader.
+  vtkSmartPointer<vtkImageData> mapped = Read(fileName, 1);
+  if (!Compare(mapped, image.GetPointer(), true, "Mapped"))
+    {
+    return TEST_FAILURE;
+    }
+
+  // Writing to the arrays does not modify the file.
+  vtkDataArray* mappedInts = mapped->GetPointData()->GetArray("Ints");
+  mappedInts->SetComponent(0, 0, -1);
+  if (mappedInts->GetComponent(0, 0) != -1)
+    {
+    cerr << "The mapped array cannot be modified" << endl;
+    return TEST_FAILURE;
+    }
+  if (!Compare(Read(fileName, 0), image.GetPointer(), false, "Modified"))
+    {
+    return TEST_FAILURE;
+    }
+
+  // The file must not be modified while arrays use it.
+  mapped = 0;
+
+  // Arrays in another byte order or encoded are read.
+  if (!Write(image.GetPointer(), fileName, true, otherOrder) ||
+      !Compare(Read(fileName, 1), image.GetPointer(), false, "Swapped"))
+    {
+    return TEST_FAILURE;
+    }
+  if (!Write(image.GetPointer(), fileName, false, machineOrder) ||
+      !Compare(Read(fileName, 1), image.GetPointer(), false, "Encoded"))
+    {
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
@@ -0,0 +1,254 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLParallelArrayRead.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that reading the arrays of a piece concurrently
+// gives the same data as reading them one after another, for
+// unstructured grids of one and several pieces in all data modes, and
+// for images read whole and in part.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <cmath>
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+const int N = 60;
+
+bool CompareArrays(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    cerr << "Wrong number of arrays" << endl;
+    return false;
+    }
+  for (int k = 0; k < a->GetNumberOfArrays(); ++k)
+    {
+    vtkDataArray* x = a->GetArray(k);
+    vtkDataArray* y = b->GetArray(x->GetName());
+    if (!y || x->GetDataType() != y->GetDataType() ||
+        x->GetNumberOfTuples() != y->GetNumberOfTuples())
+      {
+      cerr << "Wrong array " << x->GetName() << endl;
+      return false;
+      }
+    for (vtkIdType i = 0; i < x->GetNumberOfTuples(); ++i)
+      {
+      for (int c = 0; c < x->GetNumberOfComponents(); ++c)
+        {
+        if (x->GetComponent(i, c) != y->GetComponent(i, c))
+          {
+          cerr << "Wrong value of " << x->GetName() << " at " << i << endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+bool Compare(vtkDataSet* a, vtkDataSet* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfCells() != b->GetNumberOfCells())
+    {
+    cerr << "Wrong number of points or cells" << endl;
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+    {
+    double p[3];
+    double q[3];
+    a->GetPoint(i, p);
+    b->GetPoint(i, q);
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+      {
+      cerr << "Wrong point at " << i << endl;
+      return false;
+      }
+    }
+  return CompareArrays(a->GetPointData(), b->GetPointData()) &&
+    CompareArrays(a->GetCellData(), b->GetCellData());
+}
+
+bool ReadGrid(const std::string& fileName)
+{
+  vtkNew<vtkXMLUnstructuredGridReader> serial;
+  serial->SetFileName(fileName.c_str());
+  serial->Update();
+  vtkNew<vtkXMLUnstructuredGridReader> parallel;
+  parallel->SetFileName(fileName.c_str());
+  parallel->ReadArraysInParallelOn();
+  parallel->Update();
+  return serial->GetOutput()->GetNumberOfPoints() >= N * N &&
+    Compare(serial->GetOutput(), parallel->GetOutput());
+}
+
+bool ReadImage(const std::string& fileName, int extent[6])
+{
+  vtkNew<vtkXMLImageDataReader> serial;
+  vtkNew<vtkXMLImageDataReader> parallel;
+  parallel->ReadArraysInParallelOn();
+  vtkXMLImageDataReader* readers[2] =
+    {serial.GetPointer(), parallel.GetPointer()};
+  for (int r = 0; r < 2; ++r)
+    {
+    readers[r]->SetFileName(fileName.c_str());
+    readers[r]->UpdateInformation();
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(
+      readers[r]->GetExecutive())->SetUpdateExtent(0, extent);
+    readers[r]->Update();
+    }
+  return serial->GetOutput()->GetNumberOfPoints() > 0 &&
+    Compare(serial->GetOutput(), parallel->GetOutput());
+}
+}
+
+int TestXMLParallelArrayRead(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string gridFileName = tempDir;
+  gridFileName += "/TestXMLParallelArrayRead.vtu";
+  std::string imageFileName = tempDir;
+  imageFileName += "/TestXMLParallelArrayRead.vti";
+  delete [] tempDir;
+
+  // A grid of N x N points with point and cell data of several types.
+  vtkNew<vtkUnstructuredGrid> grid;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> values;
+  values->SetName("Values");
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfComponents(2);
+  for (int j = 0; j < N; ++j)
+    {
+    for (int i = 0; i < N; ++i)
+      {
+      points->InsertNextPoint(0.01 * i, 0.01 * j, sin(0.05 * i) * j);
+      values->InsertNextValue(static_cast<float>(cos(0.03 * i + 0.02 * j)));
+      ids->InsertNextTuple2(i, j);
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->AddArray(values.GetPointer());
+  grid->GetPointData()->AddArray(ids.GetPointer());
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  grid->Allocate((N - 1) * (N - 1));
+  for (int j = 0; j < N - 1; ++j)
+    {
+    for (int i = 0; i < N - 1; ++i)
+      {
+      vtkIdType quad[4] = {j * N + i, j * N + i + 1, (j + 1) * N + i + 1,
+                           (j + 1) * N + i};
+      grid->InsertNextCell(VTK_QUAD, 4, quad);
+      cellValues->InsertNextValue(sin(0.1 * i) + j);
+      }
+    }
+  grid->GetCellData()->AddArray(cellValues.GetPointer());
+
+  for (int run = 0; run < 16; ++run)
+    {
+    int mode = run & 3;
+    int compressed = (run >> 2) & 1;
+    int pieces = ((run >> 3) & 1) + 1;
+
+    vtkNew<vtkXMLUnstructuredGridWriter> writer;
+    writer->SetInputData(grid.GetPointer());
+    writer->SetFileName(gridFileName.c_str());
+    writer->SetNumberOfPieces(pieces);
+    if (!compressed)
+      {
+      writer->SetCompressorTypeToNone();
+      }
+    switch (mode)
+      {
+      case 0: writer->SetDataModeToAscii(); break;
+      case 1: writer->SetDataModeToBinary(); break;
+      case 2: writer->SetDataModeToAppended(); break;
+      case 3:
+        writer->SetDataModeToAppended();
+        writer->EncodeAppendedDataOff();
+        break;
+      }
+    if (!writer->Write())
+      {
+      cerr << "Writing failed" << endl;
+      return TEST_FAILURE;
+      }
+    if (!ReadGrid(gridFileName))
+      {
+      cerr << "Mode " << mode << ", compressed " << compressed
+           << ", pieces " << pieces << endl;
+      return TEST_FAILURE;
+      }
+    }
+
+  // An image with point and cell data, read whole and in part.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, N - 1, 0, N - 1, 0, 0);
+  vtkNew<vtkDoubleArray> imageValues;
+  imageValues->SetName("Values");
+  vtkNew<vtkIntArray> imageCellIds;
+  imageCellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    imageValues->InsertNextValue(sin(0.01 * i));
+    }
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+    {
+    imageCellIds->InsertNextValue(static_cast<int>(i));
+    }
+  image->GetPointData()->AddArray(imageValues.GetPointer());
+  image->GetCellData()->AddArray(imageCellIds.GetPointer());
+
+  vtkNew<vtkXMLImageDataWriter> imageWriter;
+  imageWriter->SetInputData(image.GetPointer());
+  imageWriter->SetFileName(imageFileName.c_str());
+  if (!imageWriter->Write())
+    {
+    cerr << "Writing failed" << endl;
+    return TEST_FAILURE;
+    }
+  int wholeExtent[6] = {0, N - 1, 0, N - 1, 0, 0};
+  int subExtent[6] = {5, 40, 10, 50, 0, 0};
+  if (!ReadImage(imageFileName, wholeExtent) ||
+      !ReadImage(imageFileName, subExtent))
+    {
+    cerr << "Image reading failed" << endl;
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
@@ -0,0 +1,206 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLPieceSelection.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This test verifies that the pieces of a file outside of the region or
+// the value range requested from the reader are skipped, and that all
+// the points inside are still read along with valid cells, also when a
+// point lies just inside the requested region.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <string>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILURE 1
+
+namespace
+{
+// Count the points with an x coordinate or an elevation of at least min.
+vtkIdType CountAbove(vtkPolyData* data, bool elevation, double min)
+{
+  vtkDataArray* values = data->GetPointData()->GetArray("Elevation");
+  vtkIdType count = 0;
+  for (vtkIdType i = 0; i < data->GetNumberOfPoints(); ++i)
+    {
+    double value = elevation ? values->GetTuple1(i) : data->GetPoint(i)[0];
+    if (value >= min)
+      {
+      ++count;
+      }
+    }
+  return count;
+}
+
+bool CellsAreValid(vtkPolyData* data)
+{
+  vtkCellArray* polys = data->GetPolys();
+  vtkIdType npts;
+  vtkIdType* pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+    {
+    for (vtkIdType i = 0; i < npts; ++i)
+      {
+      if (pts[i] < 0 || pts[i] >= data->GetNumberOfPoints())
+        {
+        return false;
+        }
+      }
+    }
+  return data->GetNumberOfPolys() > 0;
+}
+
+// Read the file restricted to x or the elevation of at least min, and
+// check that fewer points are read but none of those above min is lost.
+bool ReadSubset(const std::string& fileName, vtkPolyData* whole,
+                bool elevation, double min, bool expectSkipped)
+{
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  if (elevation)
+    {
+    reader->SetReadRangeArrayName("Elevation");
+    reader->SetReadRange(min, 1);
+    }
+  else
+    {
+    reader->SetReadBounds(min, 1, -1, 1, -1, 1);
+    }
+  reader->Update();
+  vtkPolyData* subset = reader->GetOutput();
+
+  vtkIdType expected = whole->GetNumberOfPoints();
+  if ((expectSkipped && subset->GetNumberOfPoints() >= expected) ||
+      (!expectSkipped && subset->GetNumberOfPoints() != expected))
+    {
+    cerr << "Read " << subset->GetNumberOfPoints() << " points of "
+         << expected << endl;
+    return false;
+    }
+  if (CountAbove(subset, elevation, min) != CountAbove(whole, elevation, min))
+    {
+    cerr << "Points in the subset were not read" << endl;
+    return false;
+    }
+  if (!CellsAreValid(subset))
+    {
+    cerr << "Invalid cells" << endl;
+    return false;
+    }
+  return true;
+}
+
+// Write a piece whose largest x has more significant digits than the
+// other written values, and read it with a region starting just below.
+bool ReadExactBounds(const std::string& fileName)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(0.30000000000049, 0, 0);
+  vtkNew<vtkPolyData> data;
+  data->SetPoints(points.GetPointer());
+
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetInputData(data.GetPointer());
+  writer->SetFileName(fileName.c_str());
+  writer->SetWritePieceBounds(1);
+  writer->SetDataModeToAppended();
+  writer->Write();
+
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetReadBounds(0.3000000000003, 1, -1, 1, -1, 1);
+  reader->Update();
+  if (reader->GetOutput()->GetNumberOfPoints() != 2)
+    {
+    cerr << "The piece just inside the region was skipped" << endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int TestXMLPieceSelection(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = tempDir;
+  fileName += "/TestXMLPieceSelection.vtp";
+  delete [] tempDir;
+
+  // The sphere source splits the sphere around the z axis into pieces,
+  // and the elevation grows along x.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(16);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(-0.5, 0, 0);
+  elevation->SetHighPoint(0.5, 0, 0);
+
+  for (int run = 0; run < 4; ++run)
+    {
+    int appended = run & 1;
+    int bounds = (run >> 1) & 1;
+
+    vtkNew<vtkXMLPolyDataWriter> writer;
+    writer->SetInputConnection(elevation->GetOutputPort());
+    writer->SetFileName(fileName.c_str());
+    writer->SetNumberOfPieces(8);
+    writer->SetWritePieceBounds(bounds);
+    if (appended)
+      {
+      writer->SetDataModeToAppended();
+      }
+    else
+      {
+      writer->SetDataModeToAscii();
+      }
+    if (!writer->Write())
+      {
+      cerr << "Writing failed" << endl;
+      return TEST_FAILURE;
+      }
+
+    vtkNew<vtkXMLPolyDataReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    vtkPolyData* whole = reader->GetOutput();
+
+    // Without bounds in the file, all pieces are read.
+    if (!ReadSubset(fileName, whole, false, 0.3, bounds != 0) ||
+        !ReadSubset(fileName, whole, true, 0.9, true))
+      {
+      cerr << "Appended " << appended << ", bounds " << bounds << endl;
+      return TEST_FAILURE;
+      }
+    }
+
+  if (!ReadExactBounds(fileName))
+    {
+    return TEST_FAILURE;
+    }
+
+  return TEST_SUCCESS;
+}
@@ -25,9 +25,66 @@
 #include "vtkXMLDataParser.h"
 #include "vtkInformationVector.h"
 #include "vtkInformation.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <cassert>
+#include <locale>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// The whole data of an array of the current piece read ahead.
+struct vtkXMLDataReaderPreloadedArray
+{
+  vtkXMLDataElement* Element;
+  int DataType;
+  size_t WordSize;
+  size_t NumberOfValues;
+  // Allocated with malloc.  Null until read or if the read failed.
+  void* Values;
+  bool Pending;
+};
+
+class vtkXMLDataReaderPreloadedArrays
+{
+public:
+  ~vtkXMLDataReaderPreloadedArrays()
+    {
+    this->Release(false);
+    }
+
+  vtkXMLDataReaderPreloadedArray* Find(vtkXMLDataElement* da)
+    {
+    for(size_t i = 0; i < this->Arrays.size(); ++i)
+      {
+      if(this->Arrays[i].Element == da && !this->Arrays[i].Pending)
+        {
+        return &this->Arrays[i];
+        }
+      }
+    return 0;
+    }
+
+  // Free the arrays, except those waiting to be read if keepPending.
+  void Release(bool keepPending)
+    {
+    std::vector<vtkXMLDataReaderPreloadedArray> pending;
+    for(size_t i = 0; i < this->Arrays.size(); ++i)
+      {
+      if(keepPending && this->Arrays[i].Pending)
+        {
+        pending.push_back(this->Arrays[i]);
+        }
+      else
+        {
+        free(this->Arrays[i].Values);
+        }
+      }
+    this->Arrays.swap(pending);
+    }
+
+  std::vector<vtkXMLDataReaderPreloadedArray> Arrays;
+};
 
 
 //----------------------------------------------------------------------------
@@ -51,6 +108,7 @@ vtkXMLDataReader::vtkXMLDataReader()
   this->PointDataOffset = NULL;
   this->CellDataTimeStep = NULL;
   this->CellDataOffset = NULL;
+  this->PreloadedArrays = new vtkXMLDataReaderPreloadedArrays;
 }
 
 //----------------------------------------------------------------------------
@@ -75,6 +133,7 @@ vtkXMLDataReader::~vtkXMLDataReader()
     delete[] this->CellDataTimeStep;
     delete[] this->CellDataOffset;
     }
+  delete this->PreloadedArrays;
 }
 
 //----------------------------------------------------------------------------
@@ -101,6 +160,13 @@ void vtkXMLDataReader::DestroyXMLParser()
   this->Superclass::DestroyXMLParser();
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLDataReader::CloseVTKFile()
+{
+  this->PreloadedArrays->Release(false);
+  this->Superclass::CloseVTKFile();
+}
+
 
 
 //----------------------------------------------------------------------------
@@ -408,15 +474,12 @@ int vtkXMLDataReader::ReadPieceData()
   vtkXMLDataElement* ePointData = this->PointDataElements[this->Piece];
   vtkXMLDataElement* eCellData = this->CellDataElements[this->Piece];
 
-  // Split current progress range over number of arrays.  This assumes
-  // that each array contributes approximately the same amount of data
-  // within this piece.
-  float progressRange[2] = {0,0};
-  int currentArray=0;
-  int numArrays = this->NumberOfPointArrays + this->NumberOfCellArrays;
-  this->GetProgressRange(progressRange);
+  // The data read ahead for the previous piece are no longer needed.
+  this->PreloadedArrays->Release(true);
 
-  // Read the data for this piece from each array.
+  // Find the arrays to read for this piece.
+  std::vector<vtkXMLDataElement*> elements;
+  std::vector<vtkAbstractArray*> arrays;
   int i;
   if(ePointData)
     {
@@ -437,22 +500,13 @@ int vtkXMLDataReader::ReadPieceData()
         int needToRead = this->PointDataNeedToReadTimeStep(eNested);
         if( needToRead )
           {
-          // Set the range of progress for this array.
-          this->SetProgressRange(progressRange, currentArray++, numArrays);
-
-          // Read the array.
-          if(!this->ReadArrayForPoints(eNested, pointData->GetAbstractArray(a++)))
-            {
-            vtkErrorMacro("Cannot read point data array \""
-              << pointData->GetArray(a-1)->GetName() << "\" from "
-              << ePointData->GetName() << " in piece " << this->Piece
-              << ".  The data array in the element may be too short.");
-            return 0;
-            }
+          elements.push_back(eNested);
+          arrays.push_back(pointData->GetAbstractArray(a++));
           }
         }
       }
     }
+  size_t numPointArrays = elements.size();
   if(eCellData)
     {
     int a=0;
@@ -472,23 +526,66 @@ int vtkXMLDataReader::ReadPieceData()
         int needToRead = this->CellDataNeedToReadTimeStep(eNested);
         if( needToRead )
           {
-          // Set the range of progress for this array.
-          this->SetProgressRange(progressRange, currentArray++, numArrays);
-
-          // Read the array.
-          if(!this->ReadArrayForCells(eNested, cellData->GetAbstractArray(a++)))
-            {
-            vtkErrorMacro("Cannot read cell data array \""
-              << cellData->GetAbstractArray(a-1)->GetName() << "\" from "
-              << ePointData->GetName() << " in piece " << this->Piece
-              << ".  The data array in the element may be too short.");
-            return 0;
-            }
+          elements.push_back(eNested);
+          arrays.push_back(cellData->GetAbstractArray(a++));
           }
         }
       }
     }
 
+  // Read the arrays read whole ahead, together with those added by
+  // subclasses.
+  if(this->ReadArraysInParallel)
+    {
+    vtkIdType numPoints = this->GetNumberOfPointsToPreload();
+    vtkIdType numCells = this->GetNumberOfCellsToPreload();
+    for(size_t k=0; k < elements.size(); ++k)
+      {
+      vtkIdType numTuples = k < numPointArrays? numPoints : numCells;
+      if(numTuples >= 0)
+        {
+        this->AddArrayToPreload(elements[k], arrays[k],
+                                numTuples*arrays[k]->GetNumberOfComponents());
+        }
+      }
+    }
+  this->PreloadArrays();
+
+  // Split current progress range over number of arrays.  This assumes
+  // that each array contributes approximately the same amount of data
+  // within this piece.
+  float progressRange[2] = {0,0};
+  int numArrays = this->NumberOfPointArrays + this->NumberOfCellArrays;
+  this->GetProgressRange(progressRange);
+
+  // Read the data for this piece from each array.
+  for(size_t k=0; (k < elements.size() && !this->AbortExecute); ++k)
+    {
+    // Set the range of progress for this array.
+    this->SetProgressRange(progressRange, static_cast<int>(k), numArrays);
+
+    // Read the array.
+    if(k < numPointArrays)
+      {
+      if(!this->ReadArrayForPoints(elements[k], arrays[k]))
+        {
+        vtkErrorMacro("Cannot read point data array \""
+          << arrays[k]->GetName() << "\" from "
+          << ePointData->GetName() << " in piece " << this->Piece
+          << ".  The data array in the element may be too short.");
+        return 0;
+        }
+      }
+    else if(!this->ReadArrayForCells(elements[k], arrays[k]))
+      {
+      vtkErrorMacro("Cannot read cell data array \""
+        << arrays[k]->GetName() << "\" from "
+        << eCellData->GetName() << " in piece " << this->Piece
+        << ".  The data array in the element may be too short.");
+      return 0;
+      }
+    }
+
   if(this->AbortExecute)
     {
     return 0;
@@ -553,26 +650,22 @@ int vtkXMLDataReader::ReadArrayForCells(vtkXMLDataElement* da,
 }
 
 //----------------------------------------------------------------------------
-template <class iterT>
-int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da,
-  vtkXMLDataParser* xmlparser, vtkIdType arrayIndex,
-  iterT* iter, vtkIdType startIndex, vtkIdType numValues)
+static int vtkXMLDataReaderReadData(vtkXMLDataElement* da,
+  vtkXMLDataParser* xmlparser, void* data, vtkIdType startIndex,
+  vtkIdType numValues, int dataType)
 {
-  if (!iter)
+  size_t num = numValues;
+  int result;
+  if(!xmlparser->SetBlockFilters(da->GetAttribute("filter")))
     {
     return 0;
     }
-  vtkAbstractArray* array = iter->GetArray();
-  // For all contiguous arrays (except vtkBitArray).
-  size_t num = numValues;
-  int result;
-  void* data = array->GetVoidPointer(arrayIndex);
   if(da->GetAttribute("offset"))
     {
     vtkTypeInt64 offset = 0;
     da->GetScalarAttribute("offset", offset);
     result = (xmlparser->ReadAppendedData(offset, data, startIndex,
-        numValues, array->GetDataType()) == num);
+        numValues, dataType) == num);
     }
   else
     {
@@ -583,11 +676,153 @@ int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da,
       isAscii = 0;
       }
     result = (xmlparser->ReadInlineData(da, isAscii, data,
-        startIndex, numValues, array->GetDataType()) == num);
+        startIndex, numValues, dataType) == num);
     }
+  xmlparser->SetBlockFilters(0);
   return result;
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkXMLDataReader::GetNumberOfPointsToPreload()
+{
+  return this->GetNumberOfPoints();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkXMLDataReader::GetNumberOfCellsToPreload()
+{
+  return this->GetNumberOfCells();
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLDataReader::AddArrayToPreload(vtkXMLDataElement* da,
+                                         vtkAbstractArray* array,
+                                         vtkIdType numValues)
+{
+  // Another stream can only be opened on a file.
+  int dataType = array->GetDataType();
+  if(!this->ReadArraysInParallel || !this->IsReadingFile() ||
+     numValues <= 0 || dataType == VTK_BIT || dataType == VTK_STRING ||
+     !vtkDataArray::SafeDownCast(array))
+    {
+    return;
+    }
+
+  // Arrays used in place from a memory map are not read at all.
+  vtkTypeInt64 offset = 0;
+  if(this->MapAppendedData && da->GetScalarAttribute("offset", offset) &&
+     !da->GetAttribute("filter") &&
+     this->XMLParser->FindRawAppendedData(offset, numValues, dataType) >= 0)
+    {
+    return;
+    }
+
+  vtkXMLDataReaderPreloadedArray preloaded;
+  preloaded.Element = da;
+  preloaded.DataType = dataType;
+  preloaded.WordSize = array->GetDataTypeSize();
+  preloaded.NumberOfValues = numValues;
+  preloaded.Values = 0;
+  preloaded.Pending = true;
+  this->PreloadedArrays->Arrays.push_back(preloaded);
+}
+
+//----------------------------------------------------------------------------
+// Reads arrays, each with its own parser and stream of the file.
+class vtkXMLDataReaderPreloadFunctor
+{
+public:
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for(vtkIdType i = begin; i < end; ++i)
+      {
+      vtkXMLDataReaderPreloadedArray& preloaded = *this->Arrays[i];
+#ifdef _WIN32
+      ifstream stream(this->FileName, ios::binary | ios::in);
+#else
+      ifstream stream(this->FileName, ios::in);
+#endif
+      stream.imbue(std::locale::classic());
+      vtkXMLDataParser* parser = this->Parsers[i];
+      parser->SetStream(&stream);
+      preloaded.Values =
+        malloc(preloaded.NumberOfValues * preloaded.WordSize);
+      if(preloaded.Values && stream &&
+         !vtkXMLDataReaderReadData(preloaded.Element, parser,
+                                   preloaded.Values, 0,
+                                   preloaded.NumberOfValues,
+                                   preloaded.DataType))
+        {
+        // ReadArrayValues reads it again and reports the error.
+        free(preloaded.Values);
+        preloaded.Values = 0;
+        }
+      parser->SetStream(0);
+      }
+    }
+
+  const char* FileName;
+  vtkXMLDataReaderPreloadedArray** Arrays;
+  vtkXMLDataParser** Parsers;
+};
+
+//----------------------------------------------------------------------------
+void vtkXMLDataReader::PreloadArrays()
+{
+  std::vector<vtkXMLDataReaderPreloadedArray*> pending;
+  std::vector<vtkXMLDataParser*> parsers;
+  for(size_t i = 0; i < this->PreloadedArrays->Arrays.size(); ++i)
+    {
+    vtkXMLDataReaderPreloadedArray& preloaded =
+      this->PreloadedArrays->Arrays[i];
+    if(preloaded.Pending)
+      {
+      preloaded.Pending = false;
+      pending.push_back(&preloaded);
+      parsers.push_back(vtkXMLDataParser::New());
+      parsers.back()->CopyDataSettings(this->XMLParser);
+      }
+    }
+  if(pending.empty())
+    {
+    return;
+    }
+
+  vtkXMLDataReaderPreloadFunctor functor;
+  functor.FileName = this->FileName;
+  functor.Arrays = &pending[0];
+  functor.Parsers = &parsers[0];
+  vtkSMPTools::For(0, static_cast<vtkIdType>(pending.size()), 1, functor);
+
+  for(size_t i = 0; i < parsers.size(); ++i)
+    {
+    parsers[i]->Delete();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLDataReader::ReleasePreloadedArrays()
+{
+  this->PreloadedArrays->Release(false);
+}
+
+//----------------------------------------------------------------------------
+template <class iterT>
+int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da,
+  vtkXMLDataParser* xmlparser, vtkIdType arrayIndex,
+  iterT* iter, vtkIdType startIndex, vtkIdType numValues)
+{
+  if (!iter)
+    {
+    return 0;
+    }
+  vtkAbstractArray* array = iter->GetArray();
+  // For all contiguous arrays (except vtkBitArray).
+  return vtkXMLDataReaderReadData(da, xmlparser,
+    array->GetVoidPointer(arrayIndex), startIndex, numValues,
+    array->GetDataType());
+}
+
 //----------------------------------------------------------------------------
 VTK_TEMPLATE_SPECIALIZE
 int vtkXMLDataReaderReadArrayValues(
@@ -699,6 +934,58 @@ int vtkXMLDataReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayInde
     }
   this->InReadData = 1;
   int result;
+
+  // Use the values read ahead by PreloadArrays.
+  vtkXMLDataReaderPreloadedArray* preloaded = this->PreloadedArrays->Find(da);
+  if (preloaded && preloaded->Values &&
+      preloaded->DataType == array->GetDataType() && startIndex >= 0 &&
+      static_cast<size_t>(startIndex + numValues) <= preloaded->NumberOfValues)
+    {
+    bool all = (startIndex == 0 &&
+                static_cast<size_t>(numValues) == preloaded->NumberOfValues);
+    if (all && arrayIndex == 0 &&
+        numValues == array->GetNumberOfTuples()*array->GetNumberOfComponents())
+      {
+      // Hand the whole buffer over to the array.
+      array->SetVoidArray(preloaded->Values, numValues, 0);
+      }
+    else
+      {
+      memcpy(array->GetVoidPointer(arrayIndex),
+             static_cast<char*>(preloaded->Values) +
+             startIndex*preloaded->WordSize,
+             numValues*preloaded->WordSize);
+      if (all)
+        {
+        free(preloaded->Values);
+        }
+      }
+    if (all)
+      {
+      preloaded->Values = 0;
+      }
+    array->Modified();
+    this->InReadData = 0;
+    return 1;
+    }
+
+  // Use whole arrays stored raw in the appended data in place.
+  if (this->MapAppendedData && arrayIndex == 0 && startIndex == 0 &&
+      numValues == array->GetNumberOfTuples()*array->GetNumberOfComponents()
+      && da->GetAttribute("offset") && !da->GetAttribute("filter"))
+    {
+    vtkTypeInt64 offset = 0;
+    da->GetScalarAttribute("offset", offset);
+    vtkTypeInt64 position = this->XMLParser->FindRawAppendedData(
+      offset, numValues, array->GetDataType());
+    if (position >= 0 && this->MapArray(array, position, numValues))
+      {
+      array->Modified();
+      this->InReadData = 0;
+      return 1;
+      }
+    }
+
   // All arrays types except vtkBitArray.
   vtkArrayIterator* iter = array->NewIterator();
   switch (array->GetDataType())
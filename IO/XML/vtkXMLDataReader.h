@@ -27,6 +27,8 @@
 #include "vtkIOXMLModule.h" // For export macro
 #include "vtkXMLReader.h"
 
+class vtkXMLDataReaderPreloadedArrays;
+
 class VTKIOXML_EXPORT vtkXMLDataReader : public vtkXMLReader
 {
 public:
@@ -41,6 +43,10 @@ public:
   // Get the number of cells in the output.
   virtual vtkIdType GetNumberOfCells()=0;
 
+  // Description:
+  // Get the number of pieces in the file.  Valid after UpdateInformation.
+  vtkGetMacro(NumberOfPieces, int);
+
   // For the specified port, copy the information this reader sets up in
   // SetupOutputInformation to outInfo
   virtual void CopyOutputInformation(vtkInformation *outInfo, int port);
@@ -53,6 +59,7 @@ protected:
   virtual void CreateXMLParser();
   virtual void DestroyXMLParser();
   virtual void SetupOutputInformation(vtkInformation *outInfo);
+  virtual void CloseVTKFile();
 
   int ReadPrimaryElement(vtkXMLDataElement* ePrimary);
   void SetupOutputData();
@@ -84,6 +91,20 @@ protected:
   int ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
     vtkIdType startIndex, vtkIdType numValues);
 
+  // Get the number of point/cell tuples stored in the arrays of the
+  // current piece when ReadArrayForPoints/ReadArrayForCells read them
+  // whole, or -1 when they read part of them.
+  virtual vtkIdType GetNumberOfPointsToPreload();
+  virtual vtkIdType GetNumberOfCellsToPreload();
+
+  // Add the numValues values of an array of the current piece to the
+  // data read by the next call to PreloadArrays.  With
+  // ReadArraysInParallel on, PreloadArrays reads them concurrently and
+  // ReadArrayValues then takes them from memory.
+  void AddArrayToPreload(vtkXMLDataElement* da, vtkAbstractArray* array,
+                         vtkIdType numValues);
+  void PreloadArrays();
+  void ReleasePreloadedArrays();
 
 
   // Callback registered with the DataProgressObserver.
@@ -126,6 +147,9 @@ protected:
   int CellDataNeedToReadTimeStep(vtkXMLDataElement *eNested);
 
 private:
+  // The data of the arrays of the current piece read ahead.
+  vtkXMLDataReaderPreloadedArrays* PreloadedArrays;
+
   vtkXMLDataReader(const vtkXMLDataReader&);  // Not implemented.
   void operator=(const vtkXMLDataReader&);  // Not implemented.
 };
@@ -0,0 +1,363 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLIncrementalUnstructuredGridWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkXMLIncrementalUnstructuredGridWriter.h"
+
+#include "vtkBase64OutputStream.h"
+#include "vtkCellData.h"
+#include "vtkErrorCode.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+#include "vtkOutputStream.h"
+#include "vtkPointData.h"
+#include "vtkUnstructuredGrid.h"
+#define vtkXMLOffsetsManager_DoNotInclude
+#include "vtkXMLOffsetsManager.h"
+#undef vtkXMLOffsetsManager_DoNotInclude
+
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include "vtkWindows.h"
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkXMLIncrementalUnstructuredGridWriter);
+
+//----------------------------------------------------------------------------
+class vtkXMLIncrementalUnstructuredGridWriterInternals
+{
+public:
+  vtkXMLIncrementalUnstructuredGridWriterInternals(): Open(false) {}
+
+  bool Open;
+  std::string SpoolFileName;
+  ofstream Spool;
+
+  // The XML elements of the pieces written so far, and of the current one.
+  std::string Pieces;
+  vtksys_ios::ostringstream Header;
+
+  // The arrays of the first piece, which all later pieces must have.
+  std::string ArraySignatures[2];
+};
+
+//----------------------------------------------------------------------------
+vtkXMLIncrementalUnstructuredGridWriter::vtkXMLIncrementalUnstructuredGridWriter()
+{
+  this->NumberOfPiecesWritten = 0;
+  this->Internals = new vtkXMLIncrementalUnstructuredGridWriterInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkXMLIncrementalUnstructuredGridWriter::~vtkXMLIncrementalUnstructuredGridWriter()
+{
+  // A file that was never closed is abandoned.
+  if(this->Internals->Open)
+    {
+    this->Internals->Spool.close();
+    this->DeleteAFile(this->Internals->SpoolFileName.c_str());
+    this->Stream = 0;
+    this->DataStream->SetStream(0);
+    }
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLIncrementalUnstructuredGridWriter::PrintSelf(ostream& os,
+                                                        vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "NumberOfPiecesWritten: "
+     << this->NumberOfPiecesWritten << "\n";
+}
+
+//----------------------------------------------------------------------------
+vtkUnstructuredGrid* vtkXMLIncrementalUnstructuredGridWriter::GetInput()
+{
+  return static_cast<vtkUnstructuredGrid*>(this->Superclass::GetInput());
+}
+
+//----------------------------------------------------------------------------
+const char* vtkXMLIncrementalUnstructuredGridWriter::GetDataSetName()
+{
+  return "UnstructuredGrid";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkXMLIncrementalUnstructuredGridWriter::GetDefaultFileExtension()
+{
+  return "vtu";
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLIncrementalUnstructuredGridWriter::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLIncrementalUnstructuredGridWriter::WriteInternal()
+{
+  if(!this->Open())
+    {
+    return 0;
+    }
+  int result = this->WritePiece(this->GetInput());
+  return this->Close() && result;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLIncrementalUnstructuredGridWriter::IsOpen()
+{
+  return this->Internals->Open? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLIncrementalUnstructuredGridWriter::Open()
+{
+  vtkXMLIncrementalUnstructuredGridWriterInternals* internals = this->Internals;
+  this->SetErrorCode(vtkErrorCode::NoError);
+  if(internals->Open)
+    {
+    vtkErrorMacro("Open called twice without Close.");
+    return 0;
+    }
+  if(!this->FileName || this->WriteToOutputString)
+    {
+    vtkErrorMacro("Writer called with no FileName set.");
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return 0;
+    }
+
+  // Keep the spool next to the output file so that it is on a file
+  // system that has room for the output.  Its name is unique among the
+  // writers of the same output file.
+  static unsigned long spoolCounter = 0;
+#ifdef _WIN32
+  unsigned long processId = GetCurrentProcessId();
+#else
+  unsigned long processId = getpid();
+#endif
+  vtksys_ios::ostringstream spoolFileName;
+  spoolFileName << this->FileName << "." << processId << "."
+                << spoolCounter++ << ".spool";
+  internals->SpoolFileName = spoolFileName.str();
+#ifdef _WIN32
+  internals->Spool.open(internals->SpoolFileName.c_str(),
+                        ios::out | ios::binary);
+#else
+  internals->Spool.open(internals->SpoolFileName.c_str(), ios::out);
+#endif
+  if(!internals->Spool)
+    {
+    internals->Spool.clear();
+    vtkErrorMacro("Error opening spool file \""
+                  << internals->SpoolFileName << "\"");
+    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 0;
+    }
+  internals->Open = true;
+  internals->Pieces.clear();
+  internals->ArraySignatures[0].clear();
+  internals->ArraySignatures[1].clear();
+  this->NumberOfPiecesWritten = 0;
+
+  // Only appended data can be produced before the header is known.
+  this->DataMode = vtkXMLWriter::Appended;
+  if(this->EncodeAppendedData)
+    {
+    vtkBase64OutputStream* base64 = vtkBase64OutputStream::New();
+    this->SetDataStream(base64);
+    base64->Delete();
+    }
+  else
+    {
+    vtkOutputStream* raw = vtkOutputStream::New();
+    this->SetDataStream(raw);
+    raw->Delete();
+    }
+  this->DataStream->SetStream(&internals->Spool);
+
+  internals->Header.precision(11);
+  internals->Header.imbue(std::locale::classic());
+  this->Stream = &internals->Header;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLIncrementalUnstructuredGridWriter::CheckArrays(
+  vtkDataSetAttributes* dsa, int cellData)
+{
+  std::string& signature = this->Internals->ArraySignatures[cellData];
+  if(this->NumberOfPiecesWritten == 0)
+    {
+    signature = this->GetArraySignature(dsa);
+    return 1;
+    }
+  return this->GetArraySignature(dsa) == signature? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLIncrementalUnstructuredGridWriter::WritePiece(
+  vtkUnstructuredGrid* piece)
+{
+  vtkXMLIncrementalUnstructuredGridWriterInternals* internals = this->Internals;
+  if(!internals->Open)
+    {
+    vtkErrorMacro("WritePiece called before Open.");
+    return 0;
+    }
+  if(this->ErrorCode != vtkErrorCode::NoError)
+    {
+    return 0;
+    }
+  // A piece that cannot be written makes the whole file fail, since
+  // the file would otherwise silently miss it.
+  if(!piece)
+    {
+    vtkErrorMacro("No piece provided!");
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+    return 0;
+    }
+  if(!this->CheckArrays(piece->GetPointData(), 0) ||
+     !this->CheckArrays(piece->GetCellData(), 1))
+    {
+    vtkErrorMacro("Piece " << this->NumberOfPiecesWritten
+                  << " does not have the arrays of the first piece.");
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+    return 0;
+    }
+
+  // The header of the piece is kept aside until it is known that all
+  // of its data could be written.  The offsets of its arrays are those
+  // in the spool, which WriteOutputFile copies to the appended data.
+  internals->Header.str("");
+  OffsetsManagerGroup offsets;
+  int result = this->WriteSpooledPiece(
+    piece, vtkIndent().GetNextIndent().GetNextIndent(), internals->Spool,
+    &offsets);
+  for(unsigned int i = 0; result && i < offsets.GetNumberOfElements(); ++i)
+    {
+    this->ForwardAppendedDataOffset(offsets.GetElement(i).GetPosition(0),
+                                    offsets.GetElement(i).GetOffsetValue(0),
+                                    "offset");
+    }
+
+  if(!result || this->ErrorCode != vtkErrorCode::NoError)
+    {
+    if(this->ErrorCode == vtkErrorCode::NoError)
+      {
+      this->SetErrorCode(vtkErrorCode::UnknownError);
+      }
+    return 0;
+    }
+
+  internals->Pieces += internals->Header.str();
+  ++this->NumberOfPiecesWritten;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLIncrementalUnstructuredGridWriter::Close()
+{
+  vtkXMLIncrementalUnstructuredGridWriterInternals* internals = this->Internals;
+  if(!internals->Open)
+    {
+    vtkErrorMacro("Close called before Open.");
+    return 0;
+    }
+  internals->Open = false;
+  this->Stream = 0;
+  this->DataStream->SetStream(0);
+
+  internals->Spool.close();
+  int result = this->ErrorCode == vtkErrorCode::NoError &&
+    !internals->Spool.fail();
+  if(result)
+    {
+    result = this->WriteOutputFile();
+    }
+  this->DeleteAFile(internals->SpoolFileName.c_str());
+  internals->Pieces.clear();
+
+  if(!result)
+    {
+    vtkErrorMacro("Error writing file \"" << this->FileName << "\"");
+    this->DeleteAFile(this->FileName);
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLIncrementalUnstructuredGridWriter::WriteOutputFile()
+{
+  if(!this->OpenFile())
+    {
+    return 0;
+    }
+  ostream& os = *(this->Stream);
+  os.precision(11);
+
+  int result = this->StartFile();
+  if(result)
+    {
+    vtkIndent indent = vtkIndent().GetNextIndent();
+    os << indent << "<" << this->GetDataSetName() << ">\n";
+    os << this->Internals->Pieces;
+    os << indent << "</" << this->GetDataSetName() << ">\n";
+
+    // Start the appended data on a boundary of the largest word size.
+    std::string start = "  <AppendedData encoding=\"";
+    start += this->EncodeAppendedData? "base64" : "raw";
+    start += "\">\n   _";
+    vtkTypeInt64 position =
+      static_cast<vtkTypeInt64>(os.tellp()) + start.size();
+    for(vtkTypeInt64 i = 0; i < (8 - position % 8) % 8; ++i)
+      {
+      os << " ";
+      }
+    os << start;
+    this->AppendedDataPosition = os.tellp();
+
+    // Copy the spool into the file.
+    ifstream spool(this->Internals->SpoolFileName.c_str(),
+                   ios::in | ios::binary);
+    std::vector<char> buffer(1 << 20);
+    while(spool && os)
+      {
+      spool.read(&buffer[0], buffer.size());
+      os.write(&buffer[0], spool.gcount());
+      }
+    if(!spool.eof() || os.fail())
+      {
+      this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+      result = 0;
+      }
+    }
+  if(result)
+    {
+    this->EndAppendedData();
+    result = this->ErrorCode == vtkErrorCode::NoError && this->EndFile();
+    }
+
+  this->CloseFile();
+  this->Stream = 0;
+  return result;
+}
@@ -0,0 +1,109 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLIncrementalUnstructuredGridWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkXMLIncrementalUnstructuredGridWriter - Write a VTK XML UnstructuredGrid file one piece at a time.
+// .SECTION Description
+// vtkXMLIncrementalUnstructuredGridWriter writes the VTK XML
+// UnstructuredGrid file format from pieces handed to it as they are
+// produced, so that a file larger than the available memory can be
+// written.  Call Open(), then WritePiece() once per piece, then
+// Close().  Only the piece being written is needed in memory.
+//
+// The arrays of each piece are encoded and compressed as they arrive
+// and kept in a spool file next to the output file.  The format needs
+// the XML description of all pieces before the appended data, so
+// Close() writes the description and then copies the spool into the
+// output file.  The data are always written in appended mode.  All
+// pieces must have the same point and cell data arrays.  Polyhedral
+// cells are not supported.
+//
+// When used as a pipeline writer, the input is written as one piece.
+
+// .SECTION See Also
+// vtkXMLUnstructuredGridWriter
+
+#ifndef __vtkXMLIncrementalUnstructuredGridWriter_h
+#define __vtkXMLIncrementalUnstructuredGridWriter_h
+
+#include "vtkIOXMLModule.h" // For export macro
+#include "vtkXMLWriter.h"
+
+class vtkDataSetAttributes;
+class vtkUnstructuredGrid;
+class vtkXMLIncrementalUnstructuredGridWriterInternals;
+
+class VTKIOXML_EXPORT vtkXMLIncrementalUnstructuredGridWriter : public vtkXMLWriter
+{
+public:
+  vtkTypeMacro(vtkXMLIncrementalUnstructuredGridWriter,vtkXMLWriter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkXMLIncrementalUnstructuredGridWriter* New();
+
+  // Description:
+  // Get/Set the writer's input.
+  vtkUnstructuredGrid* GetInput();
+
+  // Description:
+  // Get the default file extension for files written by this writer.
+  const char* GetDefaultFileExtension();
+
+  // Description:
+  // Start a new file named by FileName.  Returns 1 on success.
+  int Open();
+
+  // Description:
+  // Encode the arrays of the given piece into the spool file.  The
+  // piece is not referenced after the call returns.  Returns 1 on
+  // success.  After a failure, Close() fails and removes the file.
+  int WritePiece(vtkUnstructuredGrid* piece);
+
+  // Description:
+  // Write the output file from the pieces written since Open() and
+  // remove the spool file.  Returns 1 on success.
+  int Close();
+
+  // Description:
+  // Return whether Open() has been called without a matching Close().
+  int IsOpen();
+
+  // Description:
+  // Get the number of pieces written since Open().
+  vtkGetMacro(NumberOfPiecesWritten, int);
+
+protected:
+  vtkXMLIncrementalUnstructuredGridWriter();
+  ~vtkXMLIncrementalUnstructuredGridWriter();
+
+  // see algorithm for more info
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+
+  virtual int WriteInternal();
+  const char* GetDataSetName();
+
+  // Check that the arrays of a piece match those of the first piece.
+  int CheckArrays(vtkDataSetAttributes* dsa, int cellData);
+
+  // Write the output file from the piece headers and the spool.
+  int WriteOutputFile();
+
+  int NumberOfPiecesWritten;
+
+private:
+  vtkXMLIncrementalUnstructuredGridWriterInternals* Internals;
+
+  vtkXMLIncrementalUnstructuredGridWriter(const vtkXMLIncrementalUnstructuredGridWriter&);  // Not implemented.
+  void operator=(const vtkXMLIncrementalUnstructuredGridWriter&);  // Not implemented.
+};
+
+#endif
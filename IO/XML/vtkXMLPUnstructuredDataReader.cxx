@@ -206,7 +206,11 @@ void vtkXMLPUnstructuredDataReader::SetupUpdateExtent(int piece,
       this->PieceReaders[i]->UpdateInformation();
       vtkXMLUnstructuredDataReader* pReader =
         static_cast<vtkXMLUnstructuredDataReader*>(this->PieceReaders[i]);
-      pReader->SetupUpdateExtent(0, 1, this->UpdateGhostLevel);
+      int filePiece;
+      int numberOfFilePieces;
+      this->GetPieceUpdateExtent(i, filePiece, numberOfFilePieces);
+      pReader->SetupUpdateExtent(filePiece, numberOfFilePieces,
+                                 this->UpdateGhostLevel);
       }
     }
 
@@ -214,6 +218,23 @@ void vtkXMLPUnstructuredDataReader::SetupUpdateExtent(int piece,
   this->SetupOutputTotals();
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLPUnstructuredDataReader::GetPieceUpdateExtent(
+  int piece, int& filePiece, int& numberOfFilePieces)
+{
+  // A piece is its whole file unless an Index attribute selects one of
+  // the pieces of a file shared by several, as written by
+  // vtkXMLPCollectiveUnstructuredGridWriter.
+  filePiece = 0;
+  numberOfFilePieces = 1;
+  int index;
+  if(this->PieceElements[piece]->GetScalarAttribute("Index", index))
+    {
+    filePiece = index;
+    numberOfFilePieces = this->PieceReaders[piece]->GetNumberOfPieces();
+    }
+}
+
 //----------------------------------------------------------------------------
 int
 vtkXMLPUnstructuredDataReader::ReadPrimaryElement(vtkXMLDataElement* ePrimary)
@@ -323,9 +344,18 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
 int vtkXMLPUnstructuredDataReader::ReadPieceData()
 {
   // Use the internal reader to read the piece.
+  int filePiece;
+  int numberOfFilePieces;
+  this->GetPieceUpdateExtent(this->Piece, filePiece, numberOfFilePieces);
+  if(filePiece < 0 || filePiece >= numberOfFilePieces)
+    {
+    vtkErrorMacro("Piece " << this->Piece << " refers to piece " << filePiece
+                  << " of a file with " << numberOfFilePieces << " pieces.");
+    return 0;
+    }
   vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
     this->PieceReaders[this->Piece]->GetOutputInformation(0),
-    0, 1, this->UpdateGhostLevel);
+    filePiece, numberOfFilePieces, this->UpdateGhostLevel);
   this->PieceReaders[this->Piece]->Update();
 
   vtkPointSet* input = this->GetPieceInputAsPointSet(this->Piece);
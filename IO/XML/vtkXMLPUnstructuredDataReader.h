@@ -71,6 +71,12 @@ protected:
   int ReadPrimaryElement(vtkXMLDataElement* ePrimary);
   void SetupUpdateExtent(int piece, int numberOfPieces, int ghostLevel);
 
+  // Get the piece of its file that forms the given piece, as an update
+  // extent of the piece reader.  Valid after UpdateInformation of the
+  // piece reader.
+  void GetPieceUpdateExtent(int piece, int& filePiece,
+                            int& numberOfFilePieces);
+
   int ReadPieceData();
   void CopyCellArray(vtkIdType totalNumberOfCells, vtkCellArray* inCells,
                      vtkCellArray* outCells);
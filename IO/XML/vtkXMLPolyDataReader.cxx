@@ -133,6 +133,10 @@ void vtkXMLPolyDataReader::SetupOutputTotals()
   this->TotalNumberOfPolys = 0;
   for(i=this->StartPiece; i < this->EndPiece; ++i)
     {
+    if(!this->IsPieceSelected(i))
+      {
+      continue;
+      }
     this->TotalNumberOfCells += (this->NumberOfVerts[i] +
                                  this->NumberOfLines[i] +
                                  this->NumberOfStrips[i] +
@@ -15,6 +15,7 @@
 #include "vtkXMLReader.h"
 
 #include "vtkCallbackCommand.h"
+#include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataCompressor.h"
 #include "vtkDataSet.h"
@@ -24,8 +25,10 @@
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
 #include "vtkXMLFileReadTester.h"
+#include "vtkLZ4DataCompressor.h"
 #include "vtkZLibDataCompressor.h"
 #include "vtkInformation.h"
+#include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationVector.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkInformationQuadratureSchemeDefinitionVectorKey.h"
@@ -37,6 +40,128 @@
 #include <cassert>
 #include <locale> // C++ locale
 
+#if defined(_WIN32) && !defined(__CYGWIN__)
+# include "vtkWindows.h"
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+vtkInformationKeyMacro(vtkXMLReader, MAPPED_FILE, ObjectBase);
+
+//----------------------------------------------------------------------------
+// A memory map of a file.  Data arrays used in place keep a reference
+// to it so that the map stays valid as long as they exist.
+class vtkXMLReaderMappedFile : public vtkObject
+{
+public:
+  static vtkXMLReaderMappedFile* New();
+  vtkTypeMacro(vtkXMLReaderMappedFile, vtkObject);
+
+  // Map the whole file.  The pages are copy-on-write so that writing
+  // to the arrays does not modify the file.
+  bool Map(const char* fileName);
+
+  unsigned char* GetData() { return this->Data; }
+  vtkTypeUInt64 GetSize() { return this->Size; }
+
+protected:
+  vtkXMLReaderMappedFile()
+    {
+    this->Data = 0;
+    this->Size = 0;
+    }
+  ~vtkXMLReaderMappedFile();
+
+  unsigned char* Data;
+  vtkTypeUInt64 Size;
+
+private:
+  vtkXMLReaderMappedFile(const vtkXMLReaderMappedFile&);  // Not implemented.
+  void operator=(const vtkXMLReaderMappedFile&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkXMLReaderMappedFile);
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+bool vtkXMLReaderMappedFile::Map(const char* fileName)
+{
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, 0,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+  if(file == INVALID_HANDLE_VALUE)
+    {
+    return false;
+    }
+  LARGE_INTEGER size;
+  if(!GetFileSizeEx(file, &size) || size.QuadPart <= 0 ||
+     static_cast<vtkTypeUInt64>(size.QuadPart) >
+     static_cast<vtkTypeUInt64>(static_cast<size_t>(-1)))
+    {
+    CloseHandle(file);
+    return false;
+    }
+  HANDLE mapping = CreateFileMappingA(file, 0, PAGE_WRITECOPY, 0, 0, 0);
+  CloseHandle(file);
+  if(!mapping)
+    {
+    return false;
+    }
+  void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+  CloseHandle(mapping);
+  if(!data)
+    {
+    return false;
+    }
+  this->Data = static_cast<unsigned char*>(data);
+  this->Size = static_cast<vtkTypeUInt64>(size.QuadPart);
+  return true;
+}
+
+vtkXMLReaderMappedFile::~vtkXMLReaderMappedFile()
+{
+  if(this->Data)
+    {
+    UnmapViewOfFile(this->Data);
+    }
+}
+#else
+bool vtkXMLReaderMappedFile::Map(const char* fileName)
+{
+  int fd = open(fileName, O_RDONLY);
+  if(fd < 0)
+    {
+    return false;
+    }
+  struct stat fs;
+  if(fstat(fd, &fs) != 0 || fs.st_size <= 0 ||
+     static_cast<vtkTypeUInt64>(fs.st_size) >
+     static_cast<vtkTypeUInt64>(static_cast<size_t>(-1)))
+    {
+    close(fd);
+    return false;
+    }
+  size_t size = static_cast<size_t>(fs.st_size);
+  void* data = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data == MAP_FAILED)
+    {
+    return false;
+    }
+  this->Data = static_cast<unsigned char*>(data);
+  this->Size = size;
+  return true;
+}
+
+vtkXMLReaderMappedFile::~vtkXMLReaderMappedFile()
+{
+  if(this->Data)
+    {
+    munmap(this->Data, static_cast<size_t>(this->Size));
+    }
+}
+#endif
+
 //-----------------------------------------------------------------------------
 static void ReadStringVersion(const char* version, int& major, int& minor)
 {
@@ -85,8 +210,11 @@ vtkXMLReader::vtkXMLReader()
   this->Stream = 0;
   this->FileStream = 0;
   this->StringStream = 0;
+  this->MappedFile = 0;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->MapAppendedData = 0;
+  this->ReadArraysInParallel = 0;
   this->XMLParser = 0;
   this->FieldDataElement = 0;
   this->PointDataArraySelection = vtkDataArraySelection::New();
@@ -143,6 +271,10 @@ vtkXMLReader::~vtkXMLReader()
   this->CellDataArraySelection->Delete();
   this->PointDataArraySelection->Delete();
   delete[] this->TimeSteps;
+  if(this->MappedFile)
+    {
+    this->MappedFile->Delete();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -163,6 +295,9 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "Stream: (none)\n";
     }
+  os << indent << "MapAppendedData: " << this->MapAppendedData << "\n";
+  os << indent << "ReadArraysInParallel: " << this->ReadArraysInParallel
+     << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << ","
@@ -329,6 +464,53 @@ void vtkXMLReader::CloseVTKFile()
     delete this->FileStream;
     this->FileStream = 0;
     }
+  if(this->MappedFile)
+    {
+    // Arrays used in place keep their own reference.
+    this->MappedFile->Delete();
+    this->MappedFile = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLReader::IsReadingFile()
+{
+  return this->FileStream && this->Stream == this->FileStream;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLReader::MapArray(vtkAbstractArray* array, vtkTypeInt64 position,
+                           vtkIdType numValues)
+{
+  // Only files this reader opened are mapped.
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  if(!dataArray || dataArray->GetDataType() == VTK_BIT || numValues <= 0 ||
+     !this->IsReadingFile())
+    {
+    return 0;
+    }
+
+  if(!this->MappedFile)
+    {
+    // Remember a failure to map the file until it is closed.
+    this->MappedFile = vtkXMLReaderMappedFile::New();
+    this->MappedFile->Map(this->FileName);
+    }
+  unsigned char* data = this->MappedFile->GetData();
+  vtkTypeUInt64 wordSize = dataArray->GetDataTypeSize();
+  vtkTypeUInt64 length = static_cast<vtkTypeUInt64>(numValues) * wordSize;
+  if(!data || position < 0 ||
+     static_cast<vtkTypeUInt64>(position) > this->MappedFile->GetSize() ||
+     length > this->MappedFile->GetSize() - position ||
+     reinterpret_cast<size_t>(data + position) % wordSize != 0)
+    {
+    return 0;
+    }
+
+  dataArray->SetVoidArray(data + position, numValues, 1);
+  dataArray->GetInformation()->Set(vtkXMLReader::MAPPED_FILE(),
+                                   this->MappedFile);
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -382,12 +564,16 @@ void vtkXMLReader::SetupCompressor(const char* type)
   vtkObject* object = vtkInstantiator::CreateInstance(type);
   vtkDataCompressor* compressor = vtkDataCompressor::SafeDownCast(object);
 
-  // In static builds, the vtkZLibDataCompressor may not have been
-  // registered with the vtkInstantiator.  Check for it here.
+  // In static builds, the compressors may not have been registered
+  // with the vtkInstantiator.  Check for them here.
   if(!compressor && (strcmp(type, "vtkZLibDataCompressor") == 0))
     {
     compressor = vtkZLibDataCompressor::New();
     }
+  if(!compressor && (strcmp(type, "vtkLZ4DataCompressor") == 0))
+    {
+    compressor = vtkLZ4DataCompressor::New();
+    }
 
   if(!compressor)
     {
@@ -35,6 +35,8 @@ class vtkXMLDataElement;
 class vtkXMLDataParser;
 class vtkInformationVector;
 class vtkInformation;
+class vtkInformationObjectBaseKey;
+class vtkXMLReaderMappedFile;
 
 class VTKIOXML_EXPORT vtkXMLReader : public vtkAlgorithm
 {
@@ -54,6 +56,35 @@ public:
   vtkBooleanMacro(ReadFromInputString,int);
   void SetInputString(std::string s) { this->InputString = s; }
 
+  // Description:
+  // Get/Set whether data arrays stored raw and uncompressed in the
+  // appended data section of a file are used in place from a memory
+  // map of the file instead of being read.  This only applies to whole
+  // arrays in the byte order of this machine and aligned to their word
+  // size in the file.  The arrays use copy-on-write memory, so
+  // modifying them does not modify the file, and keep the file mapped
+  // as long as they exist.  The file must not be modified meanwhile.
+  // The default is off.
+  vtkSetMacro(MapAppendedData, int);
+  vtkGetMacro(MapAppendedData, int);
+  vtkBooleanMacro(MapAppendedData, int);
+
+  // Description:
+  // Get/Set whether the binary and ascii data of the arrays of a piece
+  // are read and decoded concurrently, each through its own stream of
+  // the file, before being stored in the output.  This only applies
+  // when reading a file, to arrays read whole, and uses memory for the
+  // data of the arrays of one piece until they are stored.  The
+  // default is off.
+  vtkSetMacro(ReadArraysInParallel, int);
+  vtkGetMacro(ReadArraysInParallel, int);
+  vtkBooleanMacro(ReadArraysInParallel, int);
+
+  // Description:
+  // Key holding the memory map of the file used by a data array read in
+  // place.
+  static vtkInformationObjectBaseKey* MAPPED_FILE();
+
   // Description:
   // Test whether the file with the given name can be read by this
   // reader.
@@ -168,6 +199,16 @@ protected:
   virtual void CreateXMLParser();
   virtual void DestroyXMLParser();
   void SetupCompressor(const char* type);
+
+  // Use numValues values at the given position in the file in place
+  // as the storage of the array.  Returns 0 if the file cannot be
+  // mapped or the values are not suitably aligned.
+  int MapArray(vtkAbstractArray* array, vtkTypeInt64 position,
+               vtkIdType numValues);
+
+  // Whether the input is the file named by FileName opened by this
+  // reader, which may then be opened again to read it concurrently.
+  int IsReadingFile();
   int CanReadFileVersionString(const char* version);
 
   // Description:
@@ -233,6 +274,12 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether raw appended data are used in place.
+  int MapAppendedData;
+
+  // Whether the arrays of a piece are read concurrently.
+  int ReadArraysInParallel;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
@@ -301,6 +348,8 @@ private:
   ifstream* FileStream;
   // The stream used to read the input if it is in a string.
   std::istringstream* StringStream;
+  // The memory map of the file while it is open, if used.
+  vtkXMLReaderMappedFile* MappedFile;
   int TimeStepWasReadOnce;
 
   int FileMajorVersion;
@@ -336,6 +336,33 @@ void vtkXMLStructuredDataReader::ReadXMLData()
   this->SetOutputExtent(this->UpdateExtent);
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkXMLStructuredDataReader::GetNumberOfPointsToPreload()
+{
+  // Only pieces read whole are read ahead.
+  int* pieceExtent = this->PieceExtents + this->Piece*6;
+  for(int i=0; i < 6; ++i)
+    {
+    if(this->SubExtent[i] != pieceExtent[i])
+      {
+      return -1;
+      }
+    }
+  int* dims = this->PiecePointDimensions + this->Piece*3;
+  return static_cast<vtkIdType>(dims[0])*dims[1]*dims[2];
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkXMLStructuredDataReader::GetNumberOfCellsToPreload()
+{
+  if(this->GetNumberOfPointsToPreload() < 0)
+    {
+    return -1;
+    }
+  int* dims = this->PieceCellDimensions + this->Piece*3;
+  return static_cast<vtkIdType>(dims[0])*dims[1]*dims[2];
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLStructuredDataReader::ReadArrayForPoints(vtkXMLDataElement* da,
                                                    vtkAbstractArray* outArray)
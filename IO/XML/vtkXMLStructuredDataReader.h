@@ -100,6 +100,8 @@ protected:
     vtkAbstractArray* outArray);
   virtual int ReadArrayForCells(vtkXMLDataElement* da,
     vtkAbstractArray* outArray);
+  virtual vtkIdType GetNumberOfPointsToPreload();
+  virtual vtkIdType GetNumberOfCellsToPreload();
 
   // Internal utility methods.
   int ReadPiece(vtkXMLDataElement* ePiece);
@@ -24,6 +24,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <cassert>
+#include <vector>
 
 
 //----------------------------------------------------------------------------
@@ -31,11 +32,20 @@ vtkXMLUnstructuredDataReader::vtkXMLUnstructuredDataReader()
 {
   this->PointElements = 0;
   this->NumberOfPoints = 0;
+  this->PieceBounds = 0;
   this->TotalNumberOfPoints = 0;
   this->TotalNumberOfCells = 0;
 
   this->PointsTimeStep = -1;  //invalid state
   this->PointsOffset = static_cast<unsigned long>(-1);
+
+  for(int i=0; i < 6; ++i)
+    {
+    this->ReadBounds[i] = (i % 2)? -1 : 1;
+    }
+  this->ReadRangeArrayName = 0;
+  this->ReadRange[0] = 0;
+  this->ReadRange[1] = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -45,12 +55,22 @@ vtkXMLUnstructuredDataReader::~vtkXMLUnstructuredDataReader()
     {
     this->DestroyPieces();
     }
+  this->SetReadRangeArrayName(0);
 }
 
 //----------------------------------------------------------------------------
 void vtkXMLUnstructuredDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ReadBounds: " << this->ReadBounds[0] << " "
+     << this->ReadBounds[1] << " " << this->ReadBounds[2] << " "
+     << this->ReadBounds[3] << " " << this->ReadBounds[4] << " "
+     << this->ReadBounds[5] << "\n";
+  os << indent << "ReadRangeArrayName: "
+     << (this->ReadRangeArrayName? this->ReadRangeArrayName : "(none)")
+     << "\n";
+  os << indent << "ReadRange: " << this->ReadRange[0] << " "
+     << this->ReadRange[1] << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -175,13 +195,53 @@ void vtkXMLUnstructuredDataReader::SetupEmptyOutput()
   this->GetCurrentOutput()->Initialize();
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLUnstructuredDataReader::IsPieceSelected(int piece)
+{
+  // Skip pieces outside of the region.
+  double* bounds = this->PieceBounds + piece*6;
+  for(int a=0; a < 3; ++a)
+    {
+    if(this->ReadBounds[2*a] <= this->ReadBounds[2*a+1] &&
+       bounds[2*a] <= bounds[2*a+1] &&
+       (bounds[2*a+1] < this->ReadBounds[2*a] ||
+        bounds[2*a] > this->ReadBounds[2*a+1]))
+      {
+      return 0;
+      }
+    }
+
+  // Skip pieces where the array has no value in the range.
+  if(this->ReadRangeArrayName)
+    {
+    vtkXMLDataElement* eData[2] =
+      {this->PointDataElements[piece], this->CellDataElements[piece]};
+    for(int i=0; i < 2; ++i)
+      {
+      vtkXMLDataElement* da = eData[i]?
+        this->FindDataArrayWithName(eData[i], this->ReadRangeArrayName) : 0;
+      double range[2];
+      if(da && da->GetScalarAttribute("RangeMin", range[0]) &&
+         da->GetScalarAttribute("RangeMax", range[1]) &&
+         (range[1] < this->ReadRange[0] || range[0] > this->ReadRange[1]))
+        {
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLUnstructuredDataReader::SetupOutputTotals()
 {
   this->TotalNumberOfPoints = 0;
   for(int i=this->StartPiece; i < this->EndPiece; ++i)
     {
-    this->TotalNumberOfPoints += this->NumberOfPoints[i];
+    if(this->IsPieceSelected(i))
+      {
+      this->TotalNumberOfPoints += this->NumberOfPoints[i];
+      }
     }
   this->StartPoint = 0;
 }
@@ -272,9 +332,12 @@ void vtkXMLUnstructuredDataReader::ReadXMLData()
   for(i=this->StartPiece; i < this->EndPiece; ++i)
     {
     int index = i-this->StartPiece;
-    fractions[index+1] = (fractions[index] +
-                          this->GetNumberOfPointsInPiece(i) +
-                          this->GetNumberOfCellsInPiece(i));
+    fractions[index+1] = fractions[index];
+    if(this->IsPieceSelected(i))
+      {
+      fractions[index+1] += (this->GetNumberOfPointsInPiece(i) +
+                             this->GetNumberOfCellsInPiece(i));
+      }
     }
   if(fractions[this->EndPiece-this->StartPiece] == 0)
     {
@@ -290,6 +353,12 @@ void vtkXMLUnstructuredDataReader::ReadXMLData()
   for(i=this->StartPiece; (i < this->EndPiece && !this->AbortExecute &&
                            !this->DataError); ++i)
     {
+    // Skipped pieces are not in the output.
+    if(!this->IsPieceSelected(i))
+      {
+      continue;
+      }
+
     // Set the range of progress for this piece.
     this->SetProgressRange(progressRange, i-this->StartPiece, fractions);
 
@@ -310,11 +379,16 @@ void vtkXMLUnstructuredDataReader::SetupPieces(int numPieces)
   this->Superclass::SetupPieces(numPieces);
   this->NumberOfPoints = new vtkIdType[numPieces];
   this->PointElements = new vtkXMLDataElement*[numPieces];
+  this->PieceBounds = new double[numPieces*6];
   for(int i=0;i < numPieces; ++i)
     {
     this->PointElements[i] = 0;
     this->NumberOfPoints[i] = 0;
     }
+  for(int i=0;i < numPieces*6; ++i)
+    {
+    this->PieceBounds[i] = (i % 2)? -1 : 1;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -322,8 +396,10 @@ void vtkXMLUnstructuredDataReader::DestroyPieces()
 {
   delete [] this->PointElements;
   delete [] this->NumberOfPoints;
+  delete [] this->PieceBounds;
   this->PointElements = 0;
   this->NumberOfPoints = 0;
+  this->PieceBounds = 0;
   this->Superclass::DestroyPieces();
 }
 
@@ -419,6 +495,16 @@ int vtkXMLUnstructuredDataReader::ReadPiece(vtkXMLDataElement* ePiece)
     return 0;
     }
 
+  // The bounds are optional.
+  double bounds[6];
+  if(ePiece->GetVectorAttribute("Bounds", 6, bounds) == 6)
+    {
+    for(int a=0; a < 6; ++a)
+      {
+      this->PieceBounds[this->Piece*6+a] = bounds[a];
+      }
+    }
+
   // Find the Points element in the piece.
   int i;
   this->PointElements[this->Piece] = 0;
@@ -477,22 +563,12 @@ int vtkXMLUnstructuredDataReader::ReadPieceData()
       1
     };
 
-  // Set the range of progress for the superclass.
-  this->SetProgressRange(progressRange, 0, fractions);
-
-  // Let the superclass read its data.
-  if(!this->Superclass::ReadPieceData())
-    {
-    return 0;
-    }
-
   vtkPointSet* output = vtkPointSet::SafeDownCast(this->GetCurrentOutput());
 
-  // Set the range of progress for the Points.
-  this->SetProgressRange(progressRange, 1, fractions);
-
-  // Read the points array.
+  // Find the points arrays to read and let the superclass read them
+  // ahead with its arrays.
   vtkXMLDataElement* ePoints = this->PointElements[this->Piece];
+  std::vector<vtkXMLDataElement*> pointsToRead;
   if(ePoints)
     {
     for(int i=0;(i < ePoints->GetNumberOfNestedElements() &&
@@ -509,18 +585,39 @@ int vtkXMLUnstructuredDataReader::ReadPieceData()
       int needToRead = this->PointsNeedToReadTimeStep(eNested);
       if( needToRead )
         {
-        // Read the array.
-        if(!this->ReadArrayForPoints(eNested, output->GetPoints()->GetData()))
-          {
-          vtkErrorMacro("Cannot read points array from " << ePoints->GetName()
-            << " in piece " << this->Piece
-            << ".  The data array in the element may be too short.");
-          return 0;
-          }
+        vtkDataArray* points = output->GetPoints()->GetData();
+        pointsToRead.push_back(eNested);
+        this->AddArrayToPreload(eNested, points,
+          this->GetNumberOfPointsToPreload()*points->GetNumberOfComponents());
         }
       }
     }
 
+  // Set the range of progress for the superclass.
+  this->SetProgressRange(progressRange, 0, fractions);
+
+  // Let the superclass read its data.
+  if(!this->Superclass::ReadPieceData())
+    {
+    return 0;
+    }
+
+  // Set the range of progress for the Points.
+  this->SetProgressRange(progressRange, 1, fractions);
+
+  // Read the points array.
+  for(size_t i=0;(i < pointsToRead.size() && !this->AbortExecute);++i)
+    {
+    if(!this->ReadArrayForPoints(pointsToRead[i],
+                                 output->GetPoints()->GetData()))
+      {
+      vtkErrorMacro("Cannot read points array from " << ePoints->GetName()
+        << " in piece " << this->Piece
+        << ".  The data array in the element may be too short.");
+      return 0;
+      }
+    }
+
   return 1;
 }
 
@@ -663,9 +760,14 @@ int vtkXMLUnstructuredDataReader::ReadCellArray(vtkIdType numberOfCells,
 
   // Allocate memory in the output connectivity array.
   vtkIdType curSize = 0;
-  if (this->Piece > this->StartPiece && outCells->GetData())
+  bool previousPieceRead = false;
+  for (int p = this->StartPiece; p < this->Piece && !previousPieceRead; ++p)
     {
-    // Refer to BUG #12202 and BUG #12690. The (this->Piece > this->StartPiece)
+    previousPieceRead = this->IsPieceSelected(p) != 0;
+    }
+  if (previousPieceRead && outCells->GetData())
+    {
+    // Refer to BUG #12202 and BUG #12690. The previousPieceRead
     // check ensures that when we are reading mulitple timesteps, we don't end
     // up appending to existing cell arrays infinitely. An earlier version of
     // the fix assumed that vtkXMLUnstructuredDataReader read only 1 piece at a
@@ -917,6 +1019,18 @@ int vtkXMLUnstructuredDataReader::ReadFaceArray(vtkIdType numberOfCells,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkXMLUnstructuredDataReader::GetNumberOfPointsToPreload()
+{
+  return this->GetNumberOfPointsInPiece(this->Piece);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkXMLUnstructuredDataReader::GetNumberOfCellsToPreload()
+{
+  return this->GetNumberOfCellsInPiece(this->Piece);
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLUnstructuredDataReader::ReadArrayForPoints(vtkXMLDataElement* da,
                                                      vtkAbstractArray* outArray)
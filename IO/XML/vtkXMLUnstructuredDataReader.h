@@ -52,6 +52,28 @@ public:
   // actually reading data.
   void SetupUpdateExtent(int piece, int numberOfPieces, int ghostLevel);
 
+  // Description:
+  // Get/Set the region to read.  Pieces whose Bounds attribute, written
+  // by vtkXMLUnstructuredDataWriter with WritePieceBounds on, lies
+  // outside of the region are skipped without reading their data.
+  // Pieces without bounds are always read.  The region is unset when
+  // its minimum is larger than its maximum on an axis, which is the
+  // default.
+  vtkSetVector6Macro(ReadBounds, double);
+  vtkGetVector6Macro(ReadBounds, double);
+
+  // Description:
+  // Get/Set the name of a point or cell data array and the range of its
+  // values to read.  Pieces where the RangeMin and RangeMax attributes
+  // of the array lie outside of the range are skipped without reading
+  // their data.  For arrays of several components these are the range
+  // of the magnitude of the tuples.  No piece is skipped this way when
+  // the name is NULL, which is the default.
+  vtkSetStringMacro(ReadRangeArrayName);
+  vtkGetStringMacro(ReadRangeArrayName);
+  vtkSetVector2Macro(ReadRange, double);
+  vtkGetVector2Macro(ReadRange, double);
+
   // For the specified port, copy the information this reader sets up in
   // SetupOutputInformation to outInfo
   virtual void CopyOutputInformation(vtkInformation *outInfo, int port);
@@ -93,12 +115,18 @@ protected:
 
   // Read a data array whose tuples coorrespond to points.
   virtual int ReadArrayForPoints(vtkXMLDataElement* da, vtkAbstractArray* outArray);
+  virtual vtkIdType GetNumberOfPointsToPreload();
+  virtual vtkIdType GetNumberOfCellsToPreload();
 
   // Get the number of points/cells in the given piece.  Valid after
   // UpdateInformation.
   virtual vtkIdType GetNumberOfPointsInPiece(int piece);
   virtual vtkIdType GetNumberOfCellsInPiece(int piece)=0;
 
+  // Whether the given piece is read according to ReadBounds and
+  // ReadRange.  Skipped pieces are left out of the output.
+  int IsPieceSelected(int piece);
+
   // The update request.
   int UpdatePiece;
   int UpdateNumberOfPieces;
@@ -115,6 +143,14 @@ protected:
   vtkXMLDataElement** PointElements;
   vtkIdType* NumberOfPoints;
 
+  // The bounds of each piece, unset if unknown.
+  double* PieceBounds;
+
+  // The region and value range to read.
+  double ReadBounds[6];
+  char* ReadRangeArrayName;
+  double ReadRange[2];
+
   int PointsTimeStep;
   unsigned long PointsOffset;
   int PointsNeedToReadTimeStep(vtkXMLDataElement *eNested);
@@ -43,6 +43,7 @@ vtkXMLUnstructuredDataWriter::vtkXMLUnstructuredDataWriter()
   this->NumberOfPieces = 1;
   this->WritePiece = -1;
   this->GhostLevel = 0;
+  this->WritePieceBounds = 0;
   this->CellPoints = vtkIdTypeArray::New();
   this->CellOffsets = vtkIdTypeArray::New();
   this->CellPoints->SetName("connectivity");
@@ -80,6 +81,7 @@ void vtkXMLUnstructuredDataWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfPieces: " << this->NumberOfPieces << "\n";
   os << indent << "WritePiece: " << this->WritePiece << "\n";
   os << indent << "GhostLevel: " << this->GhostLevel << "\n";
+  os << indent << "WritePieceBounds: " << this->WritePieceBounds << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -231,6 +233,7 @@ int vtkXMLUnstructuredDataWriter::ProcessRequest(vtkInformation* request,
 void vtkXMLUnstructuredDataWriter::AllocatePositionArrays()
 {
   this->NumberOfPointsPositions = new vtkTypeInt64[this->NumberOfPieces];
+  this->BoundsPositions = new vtkTypeInt64[this->NumberOfPieces];
 
   this->PointsOM->Allocate(this->NumberOfPieces, this->NumberOfTimeSteps);
   this->PointDataOM->Allocate(this->NumberOfPieces);
@@ -241,6 +244,7 @@ void vtkXMLUnstructuredDataWriter::AllocatePositionArrays()
 void vtkXMLUnstructuredDataWriter::DeletePositionArrays()
 {
   delete [] this->NumberOfPointsPositions;
+  delete [] this->BoundsPositions;
 }
 
 //----------------------------------------------------------------------------
@@ -419,6 +423,26 @@ void vtkXMLUnstructuredDataWriter::WriteInlinePieceAttributes()
   vtkPointSet* input = this->GetInputAsPointSet();
   this->WriteScalarAttribute("NumberOfPoints",
                              input->GetNumberOfPoints());
+  if(this->WritePieceBounds && this->NumberOfTimeSteps == 1)
+    {
+    this->WritePieceBoundsAttribute();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLUnstructuredDataWriter::WritePieceBoundsAttribute()
+{
+  vtkPointSet* input = this->GetInputAsPointSet();
+  if(input->GetNumberOfPoints() > 0)
+    {
+    // Write the bounds exactly.  At the precision of the other values a
+    // bound could be rounded inward, and readers selecting pieces by
+    // bounds would skip a piece that has points in the requested region.
+    ostream& os = *(this->Stream);
+    std::streamsize precision = os.precision(17);
+    this->WriteVectorAttribute("Bounds", 6, input->GetBounds());
+    os.precision(precision);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -464,6 +488,13 @@ void vtkXMLUnstructuredDataWriter::WriteAppendedPieceAttributes(int index)
 {
   this->NumberOfPointsPositions[index] =
     this->ReserveAttributeSpace("NumberOfPoints");
+  this->BoundsPositions[index] = -1;
+  if(this->WritePieceBounds && this->NumberOfTimeSteps == 1)
+    {
+    // Six doubles of 17 significant digits, which take at most 24
+    // characters with sign and exponent, and the spaces between them.
+    this->BoundsPositions[index] = this->ReserveAttributeSpace("Bounds", 150);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -505,6 +536,15 @@ void vtkXMLUnstructuredDataWriter::WriteAppendedPieceData(int index)
     {
     return;
     }
+  if(this->BoundsPositions[index] >= 0)
+    {
+    os.seekp(std::streampos(this->BoundsPositions[index]));
+    this->WritePieceBoundsAttribute();
+    if (this->ErrorCode == vtkErrorCode::OutOfDiskSpaceError)
+      {
+      return;
+      }
+    }
   os.seekp(returnPosition);
 
   // Split progress among point data, cell data, and point arrays.
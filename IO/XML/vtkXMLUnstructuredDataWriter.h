@@ -53,6 +53,16 @@ public:
   vtkSetMacro(GhostLevel, int);
   vtkGetMacro(GhostLevel, int);
 
+  // Description:
+  // Get/Set whether the bounds of the points of each piece are written
+  // in the Bounds attribute of its element, so that readers asked for a
+  // region can skip the pieces outside without reading them.  Bounds
+  // are not written for files of several time steps.  The default is
+  // off.
+  vtkSetMacro(WritePieceBounds, int);
+  vtkGetMacro(WritePieceBounds, int);
+  vtkBooleanMacro(WritePieceBounds, int);
+
   // See the vtkAlgorithm for a desciption of what these do
   int ProcessRequest(vtkInformation*,
                      vtkInformationVector**,
@@ -76,6 +86,7 @@ protected:
 
   virtual int WriteInlineMode(vtkIndent indent);
   virtual void WriteInlinePieceAttributes();
+  void WritePieceBoundsAttribute();
   virtual void WriteInlinePiece(vtkIndent indent);
 
   virtual void WriteAppendedPieceAttributes(int index);
@@ -143,8 +154,12 @@ protected:
   // The ghost level on each piece.
   int GhostLevel;
 
+  // Whether the bounds of each piece are written.
+  int WritePieceBounds;
+
   // Positions of attributes for each piece.
   vtkTypeInt64* NumberOfPointsPositions;
+  vtkTypeInt64* BoundsPositions;
 
   // For TimeStep support
   OffsetsManagerGroup *PointsOM;
@@ -92,7 +92,10 @@ void vtkXMLUnstructuredGridReader::SetupOutputTotals()
   this->TotalNumberOfCells = 0;
   for(i=this->StartPiece; i < this->EndPiece; ++i)
     {
-    this->TotalNumberOfCells += this->NumberOfCells[i];
+    if(this->IsPieceSelected(i))
+      {
+      this->TotalNumberOfCells += this->NumberOfCells[i];
+      }
     }
 
   // Data reading will start at the beginning of the output.
@@ -17,20 +17,27 @@
 #include "vtkArrayIteratorIncludes.h"
 #include "vtkBase64OutputStream.h"
 #include "vtkByteSwap.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCommand.h"
 #include "vtkDataArray.h"
 #include "vtkDataArrayIteratorMacro.h"
 #include "vtkDataSet.h"
 #include "vtkErrorCode.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkNew.h"
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkZLibDataCompressor.h"
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
@@ -38,6 +45,9 @@
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
+#define vtkXMLDataFilterPrivate_DoNotInclude
+#include "vtkXMLDataFilterPrivate.h"
+#undef vtkXMLDataFilterPrivate_DoNotInclude
 #include "vtkXMLDataElement.h"
 #include "vtkInformationQuadratureSchemeDefinitionVectorKey.h"
 #include "vtkQuadratureSchemeDefinition.h"
@@ -47,6 +57,7 @@
 
 #include <cassert>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 # include <unistd.h> /* unlink */
@@ -86,6 +97,46 @@ public:
    }
 };
 
+//----------------------------------------------------------------------------
+// Blocks of data are compressed in batches, concurrently, and written in
+// order once the whole batch is compressed.
+class vtkXMLWriterCompressionBatch
+{
+public:
+  // Number of blocks compressed together.
+  enum { Capacity = 64 };
+
+  vtkXMLWriterCompressionBatch() : Blocks(Capacity), Compressed(Capacity)
+    {
+    this->Compressor = 0;
+    this->Filters = 0;
+    this->WordSize = 1;
+    this->Swap = false;
+    this->Count = 0;
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      std::vector<unsigned char>& block = this->Blocks[i];
+      vtkXMLDataFilter::Encode(this->Filters, &block[0],
+                               block.size() / this->WordSize,
+                               this->WordSize, this->Swap);
+      this->Compressed[i].TakeReference(
+        this->Compressor->Compress(&block[0], block.size()));
+      }
+    }
+
+  vtkDataCompressor* Compressor;
+  int Filters;
+  size_t WordSize;
+  bool Swap;
+  std::vector<std::vector<unsigned char> > Blocks;
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray> > Compressed;
+  size_t Count;
+};
+
 //----------------------------------------------------------------------------
 // Specialize for cases where IterType is ValueType* (common case for
 // vtkDataArrayTemplate subclasses). The last arg is to help less-robust
@@ -314,8 +365,11 @@ vtkXMLWriter::vtkXMLWriter()
 
   // Initialize compression data.
   this->BlockSize = 32768; //2^15
+  this->ByteShuffle = 0;
+  this->DeltaEncoding = 0;
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = 0;
+  this->CompressionBatch = new vtkXMLWriterCompressionBatch;
   this->Int32IdTypeBuffer = 0;
   this->ByteSwapBuffer = 0;
 
@@ -361,6 +415,7 @@ vtkXMLWriter::~vtkXMLWriter()
 
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
+  delete this->CompressionBatch;
 }
 
 //----------------------------------------------------------------------------
@@ -377,17 +432,38 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
     return;
     }
 
+  const char* className;
   if (compressorType == ZLIB)
     {
-    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZLibDataCompressor"))
-      {
-      this->Compressor->Delete();
-      }
+    className = "vtkZLibDataCompressor";
+    }
+  else if (compressorType == LZ4)
+    {
+    className = "vtkLZ4DataCompressor";
+    }
+  else
+    {
+    vtkErrorMacro("Unknown compressor type " << compressorType);
+    return;
+    }
 
-    this->Compressor = vtkZLibDataCompressor::New();
-    this->Modified();
+  if (this->Compressor && this->Compressor->IsA(className))
+    {
     return;
     }
+  if (this->Compressor)
+    {
+    this->Compressor->Delete();
+    }
+  if (compressorType == LZ4)
+    {
+    this->Compressor = vtkLZ4DataCompressor::New();
+    }
+  else
+    {
+    this->Compressor = vtkZLibDataCompressor::New();
+    }
+  this->Modified();
 }
 
 //----------------------------------------------------------------------------
@@ -434,6 +510,8 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
     }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "ByteShuffle: " << this->ByteShuffle << "\n";
+  os << indent << "DeltaEncoding: " << this->DeltaEncoding << "\n";
   if(this->Stream)
     {
     os << indent << "Stream: " << this->Stream << "\n";
@@ -1139,6 +1217,16 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       {
       return 0;
       }
+
+    // Transform the blocks as recorded in the array element.
+    vtkXMLWriterCompressionBatch* batch = this->CompressionBatch;
+    batch->Filters = this->GetBlockFilters(a);
+    batch->WordSize = outWordSize;
+#ifdef VTK_WORDS_BIGENDIAN
+    batch->Swap = this->ByteOrder != vtkXMLWriter::BigEndian;
+#else
+    batch->Swap = this->ByteOrder != vtkXMLWriter::LittleEndian;
+#endif
     // Start writing the data.
     int result = this->DataStream->StartWriting();
 
@@ -1148,6 +1236,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
       }
 
+    // Write the blocks still waiting for compression.
+    if (!this->FlushCompressionBlocks())
+      {
+      result = 0;
+      }
+
     // Finish writing the data.
     if(result && !this->DataStream->EndWriting())
       {
@@ -1477,26 +1571,64 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
+  // Queue the block.  The blocks are compressed concurrently once the
+  // batch is full.
+  vtkXMLWriterCompressionBatch* batch = this->CompressionBatch;
+  batch->Blocks[batch->Count++].assign(data, data + size);
+  if (batch->Count < vtkXMLWriterCompressionBatch::Capacity)
+    {
+    return 1;
+    }
+  return this->FlushCompressionBlocks();
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  vtkXMLWriterCompressionBatch* batch = this->CompressionBatch;
+  size_t count = batch->Count;
+  batch->Count = 0;
+  if (count == 0)
+    {
+    return 1;
+    }
+
   // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  batch->Compressor = this->Compressor;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(count), 1, *batch);
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+  int result = 1;
+  for (size_t i = 0; i < count; ++i)
+    {
+    vtkUnsignedCharArray* outputArray = batch->Compressed[i];
+    if (!outputArray)
+      {
+      result = 0;
+      continue;
+      }
+
+    // Find the compressed size.
+    size_t outputSize = outputArray->GetNumberOfTuples();
+    unsigned char* outputPointer = outputArray->GetPointer(0);
+
+    // Write the compressed data.
+    if (result && !this->DataStream->Write(outputPointer, outputSize))
+      {
+      result = 0;
+      }
+
+    // Store the resulting compressed size in the compression header.
+    this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
+
+    batch->Compressed[i] = 0;
+    }
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
   this->Stream->flush();
   if (this->Stream->fail())
     {
     this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 0;
     }
-
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
-
-  outputArray->Delete();
-
   return result;
 }
 
@@ -1542,6 +1674,41 @@ size_t vtkXMLWriter::GetOutputWordTypeSize(int dataType)
   return this->GetWordTypeSize(dataType);
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLWriter::GetBlockFilters(vtkAbstractArray* a)
+{
+  // The transforms apply to the words of compressed data.
+  int wordType = a->GetDataType();
+  if(!this->Compressor || wordType == VTK_STRING || wordType == VTK_BIT)
+    {
+    return 0;
+    }
+  int filters = 0;
+  if(this->DeltaEncoding && wordType != VTK_FLOAT && wordType != VTK_DOUBLE)
+    {
+    filters |= vtkXMLDataFilter::Delta;
+    }
+  if(this->ByteShuffle && this->GetOutputWordTypeSize(wordType) > 1)
+    {
+    filters |= vtkXMLDataFilter::Shuffle;
+    }
+  return filters;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkXMLWriter::GetArraySignature(vtkDataSetAttributes* dsa)
+{
+  vtksys_ios::ostringstream signature;
+  signature << dsa->GetNumberOfArrays();
+  for(int i=0; i < dsa->GetNumberOfArrays(); ++i)
+    {
+    vtkAbstractArray* a = dsa->GetAbstractArray(i);
+    signature << "\n" << (a->GetName()? a->GetName() : "") << " "
+              << a->GetDataType() << " " << a->GetNumberOfComponents();
+    }
+  return signature.str();
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 size_t vtkXMLWriterGetWordTypeSize(T*)
@@ -1942,6 +2109,11 @@ void vtkXMLWriter::WriteArrayAppended(
 
   //
   offs.GetPosition(timestep) = this->ReserveAttributeSpace("offset");
+  if(const char* filters =
+     vtkXMLDataFilter::GetName(this->GetBlockFilters(a)))
+    {
+    this->WriteStringAttribute("filter", filters);
+    }
 
   // Write information in the recognized keys associated with this array.
   vtkInformation *info=a->GetInformation();
@@ -1988,10 +2160,186 @@ void vtkXMLWriter::WriteArrayAppendedData(vtkAbstractArray* a,
                                           vtkTypeInt64 pos,
                                           vtkTypeInt64& lastoffset)
 {
+  // Align raw uncompressed words in the file so that readers can use
+  // them in place.  Readers locate arrays by offset, so the padding is
+  // skipped.
+  if(!this->EncodeAppendedData && !this->Compressor)
+    {
+    vtkTypeInt64 wordSize = static_cast<vtkTypeInt64>(
+      this->GetOutputWordTypeSize(a->GetDataType()));
+    vtkTypeInt64 dataPosition =
+      static_cast<vtkTypeInt64>(this->Stream->tellp()) + this->HeaderType/8;
+    vtkTypeInt64 padding = (wordSize - dataPosition % wordSize) % wordSize;
+    for(vtkTypeInt64 i = 0; i < padding; ++i)
+      {
+      this->Stream->put(0);
+      }
+    }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLWriter::WriteSpooledPiece(vtkUnstructuredGrid* piece,
+                                    vtkIndent indent, ostream& data,
+                                    OffsetsManagerGroup* offsets)
+{
+  if(piece->GetFaces())
+    {
+    vtkErrorMacro("Polyhedral cells are not supported.");
+    return 0;
+    }
+
+  // Split the cells into connectivity and offsets as the file stores
+  // them.  Only this piece is converted at a time.
+  vtkNew<vtkIdTypeArray> cellPoints;
+  vtkNew<vtkIdTypeArray> cellOffsets;
+  vtkCellArray* cells = piece->GetCells();
+  vtkIdType numberOfCells = cells? cells->GetNumberOfCells() : 0;
+  if(numberOfCells > 0)
+    {
+    vtkIdTypeArray* connectivity = cells->GetData();
+    cellPoints->SetNumberOfTuples(
+      connectivity->GetNumberOfTuples() - numberOfCells);
+    cellOffsets->SetNumberOfTuples(numberOfCells);
+    vtkIdType* inCell = connectivity->GetPointer(0);
+    vtkIdType* outCellPoints = cellPoints->GetPointer(0);
+    vtkIdType offset = 0;
+    for(vtkIdType i=0; i < numberOfCells; ++i)
+      {
+      vtkIdType numberOfPoints = *inCell++;
+      memcpy(outCellPoints + offset, inCell, sizeof(vtkIdType)*numberOfPoints);
+      inCell += numberOfPoints;
+      offset += numberOfPoints;
+      cellOffsets->SetValue(i, offset);
+      }
+    }
+  vtkUnsignedCharArray* types = piece->GetCellTypesArray();
+  vtkNew<vtkUnsignedCharArray> noTypes;
+  if(!types || numberOfCells == 0)
+    {
+    types = noTypes.GetPointer();
+    }
+
+  ostream& os = *(this->Stream);
+  vtkIndent nextIndent = indent.GetNextIndent();
+  os << indent << "<Piece";
+  this->WriteScalarAttribute("NumberOfPoints", piece->GetNumberOfPoints());
+  this->WriteScalarAttribute("NumberOfCells", numberOfCells);
+  os << ">\n";
+
+  int result =
+    this->WriteSpooledAttributes(piece->GetPointData(), "PointData",
+                                 nextIndent, data, offsets) &&
+    this->WriteSpooledAttributes(piece->GetCellData(), "CellData",
+                                 nextIndent, data, offsets);
+
+  os << nextIndent << "<Points>\n";
+  if(result && piece->GetPoints())
+    {
+    result = this->WriteSpooledArray(piece->GetPoints()->GetData(),
+                                     nextIndent.GetNextIndent(), data,
+                                     offsets);
+    }
+  os << nextIndent << "</Points>\n";
+
+  os << nextIndent << "<Cells>\n";
+  result = result &&
+    this->WriteSpooledArray(cellPoints.GetPointer(),
+                            nextIndent.GetNextIndent(), data, offsets,
+                            "connectivity") &&
+    this->WriteSpooledArray(cellOffsets.GetPointer(),
+                            nextIndent.GetNextIndent(), data, offsets,
+                            "offsets") &&
+    this->WriteSpooledArray(types, nextIndent.GetNextIndent(), data,
+                            offsets, "types");
+  os << nextIndent << "</Cells>\n";
+  os << indent << "</Piece>\n";
+
+  return result && this->ErrorCode == vtkErrorCode::NoError;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::WriteSpooledAttributes(vtkDataSetAttributes* dsa,
+                                         const char* name, vtkIndent indent,
+                                         ostream& data,
+                                         OffsetsManagerGroup* offsets)
+{
+  ostream& os = *(this->Stream);
+  char** names = this->CreateStringArray(dsa->GetNumberOfArrays());
+
+  os << indent << "<" << name;
+  this->WriteAttributeIndices(dsa, names);
+  os << ">\n";
+
+  int result = 1;
+  for(int i=0; result && i < dsa->GetNumberOfArrays(); ++i)
+    {
+    result = this->WriteSpooledArray(dsa->GetAbstractArray(i),
+                                     indent.GetNextIndent(), data, offsets,
+                                     names[i]);
+    }
+
+  os << indent << "</" << name << ">\n";
+  this->DestroyStringArray(dsa->GetNumberOfArrays(), names);
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::WriteSpooledArray(vtkAbstractArray* a, vtkIndent indent,
+                                    ostream& data,
+                                    OffsetsManagerGroup* offsets,
+                                    const char* alternateName)
+{
+  // Align raw uncompressed words as WriteArrayAppendedData does.  The
+  // data stream starts on a word boundary of the appended data, so the
+  // alignment is kept in the file.
+  if(!this->EncodeAppendedData && !this->Compressor)
+    {
+    vtkTypeInt64 wordSize = static_cast<vtkTypeInt64>(
+      this->GetOutputWordTypeSize(a->GetDataType()));
+    vtkTypeInt64 dataPosition =
+      static_cast<vtkTypeInt64>(data.tellp()) + this->HeaderType/8;
+    vtkTypeInt64 padding = (wordSize - dataPosition % wordSize) % wordSize;
+    for(vtkTypeInt64 i = 0; i < padding; ++i)
+      {
+      data.put(0);
+      }
+    }
+  vtkTypeInt64 offset = static_cast<vtkTypeInt64>(data.tellp());
+
+  ostream* header = this->Stream;
+  this->Stream = &data;
+  int result = this->WriteBinaryData(a);
+  this->Stream = header;
+  if(!result)
+    {
+    return 0;
+    }
+
+  unsigned int index = offsets->GetNumberOfElements();
+  offsets->Allocate(index + 1);
+  OffsetsManager& offs = offsets->GetElement(index);
+  offs.Allocate(1);
+  offs.GetOffsetValue(0) = offset;
+
+  this->WriteArrayHeader(a, indent, alternateName, 0, 0);
+  if(vtkDataArray* da = vtkDataArray::SafeDownCast(a))
+    {
+    double* range = da->GetRange(-1);
+    this->WriteScalarAttribute("RangeMin", range[0]);
+    this->WriteScalarAttribute("RangeMax", range[1]);
+    }
+  offs.GetPosition(0) = this->ReserveAttributeSpace("offset");
+  if(const char* filters =
+     vtkXMLDataFilter::GetName(this->GetBlockFilters(a)))
+    {
+    this->WriteStringAttribute("filter", filters);
+    }
+  this->WriteArrayFooter(*header, indent, a, 1);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLWriter::WriteArrayHeader(vtkAbstractArray* a,  vtkIndent indent,
                                         const char* alternateName,
@@ -2130,6 +2478,14 @@ void vtkXMLWriter::WriteArrayInline(
     this->WriteScalarAttribute("RangeMin",da->GetRange(-1)[0]);
     this->WriteScalarAttribute("RangeMax",da->GetRange(-1)[1]);
     }
+  if(this->DataMode == vtkXMLWriter::Binary)
+    {
+    if(const char* filters =
+       vtkXMLDataFilter::GetName(this->GetBlockFilters(a)))
+      {
+      this->WriteStringAttribute("filter", filters);
+      }
+    }
   // Close the header
   os << ">\n";
   // Write recognized information keys associated with this array.
@@ -40,7 +40,9 @@ class vtkOutputStream;
 class vtkPointData;
 class vtkPoints;
 class vtkFieldData;
+class vtkUnstructuredGrid;
 class vtkXMLDataHeader;
+class vtkXMLWriterCompressionBatch;
 //BTX
 class vtkStdString;
 class OffsetsManager;      // one per piece/per time
@@ -122,6 +124,7 @@ public:
   // Description:
   // Get/Set the compressor used to compress binary and appended data
   // before writing to the file.  Default is a vtkZLibDataCompressor.
+  // Blocks are compressed concurrently using vtkSMPTools.
   virtual void SetCompressor(vtkDataCompressor*);
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
 
@@ -129,12 +132,14 @@ public:
   enum CompressorType
     {
     NONE,
-    ZLIB
+    ZLIB,
+    LZ4
     };
 //ETX
 
   // Description:
   // Convenience functions to set the compressor to certain known types.
+  // LZ4 compresses less than ZLib but is much faster to write and read.
   void SetCompressorType(int compressorType);
   void SetCompressorTypeToNone()
     {
@@ -144,6 +149,10 @@ public:
     {
     this->SetCompressorType(ZLIB);
     }
+  void SetCompressorTypeToLZ4()
+    {
+    this->SetCompressorType(LZ4);
+    }
 
   // Description:
   // Get/Set the block size used in compression.  When reading, this
@@ -153,6 +162,26 @@ public:
   virtual void SetBlockSize(size_t blockSize);
   vtkGetMacro(BlockSize, size_t);
 
+  // Description:
+  // Get/Set whether the bytes of each block of binary data are grouped
+  // by their position in the words before compression.  This makes
+  // floating point data compress much better.  It is ignored when there
+  // is no compressor.  The default is off.
+  vtkSetMacro(ByteShuffle, int);
+  vtkGetMacro(ByteShuffle, int);
+  vtkBooleanMacro(ByteShuffle, int);
+
+  // Description:
+  // Get/Set whether integer data are stored as the differences of
+  // consecutive values before compression.  This makes slowly varying
+  // data such as cell offsets and connectivity compress much better.
+  // It is ignored when there is no compressor.  The default is off.
+  // The transforms are recorded in the file; readers of VTK versions
+  // without them cannot read the arrays.
+  vtkSetMacro(DeltaEncoding, int);
+  vtkGetMacro(DeltaEncoding, int);
+  vtkBooleanMacro(DeltaEncoding, int);
+
   // Description:
   // Get/Set the data mode used for the file's data.  The options are
   // vtkXMLWriter::Ascii, vtkXMLWriter::Binary, and
@@ -287,10 +316,15 @@ protected:
   // Compression information.
   vtkDataCompressor* Compressor;
   size_t BlockSize;
+  int ByteShuffle;
+  int DeltaEncoding;
   size_t CompressionBlockNumber;
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
 
+  // Blocks waiting to be compressed concurrently.
+  vtkXMLWriterCompressionBatch* CompressionBatch;
+
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
   vtkOutputStream* DataStream;
@@ -380,6 +414,22 @@ protected:
   void WriteArrayAppendedData(vtkAbstractArray* a, vtkTypeInt64 pos,
                               vtkTypeInt64 &lastoffset);
 
+  // Methods for writers that encode the appended data of a piece before
+  // the rest of the file is known.  The XML elements go to Stream and
+  // the array data to the given data stream, which the caller must start
+  // on a word boundary of the appended data.  Each array reserves its
+  // "offset" attribute and adds an element to the offsets group with
+  // that position and the offset of the array in the data stream, to be
+  // forwarded once the caller knows where the data go.
+  int WriteSpooledPiece(vtkUnstructuredGrid* piece, vtkIndent indent,
+                        ostream& data, OffsetsManagerGroup* offsets);
+  int WriteSpooledAttributes(vtkDataSetAttributes* dsa, const char* name,
+                             vtkIndent indent, ostream& data,
+                             OffsetsManagerGroup* offsets);
+  int WriteSpooledArray(vtkAbstractArray* a, vtkIndent indent,
+                        ostream& data, OffsetsManagerGroup* offsets,
+                        const char* alternateName=0);
+
   // Methods for writing points, point data, and cell data.
   void WriteFieldData(vtkIndent indent);
   void WriteFieldDataInline(vtkFieldData* fd, vtkIndent indent);
@@ -422,11 +472,21 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
   size_t GetOutputWordTypeSize(int dataType);
 
+  // Get the transforms applied to the blocks of the array before
+  // compression, as vtkXMLDataFilter flags.
+  int GetBlockFilters(vtkAbstractArray* a);
+
+  // Describe the arrays of point or cell data by their names, types and
+  // numbers of components, for writers whose pieces must all have the
+  // same arrays.
+  static std::string GetArraySignature(vtkDataSetAttributes* dsa);
+
   char** CreateStringArray(int numStrings);
   void DestroyStringArray(int numStrings, char** strings);
 
@@ -0,0 +1,199 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkXMLDataFilterPrivate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkXMLDataFilterPrivate_DoNotInclude
+# error "do not include unless you know what you are doing"
+#endif
+
+#ifndef __vtkXMLDataFilterPrivate_h
+#define __vtkXMLDataFilterPrivate_h
+
+#include "vtkType.h"
+#include <string.h>
+#include <vector>
+
+// Reversible transforms of the uncompressed blocks of binary data that
+// make them compress better.  Shared by vtkXMLWriter and
+// vtkXMLDataParser to encode blocks before compression and decode them
+// after decompression.  The blocks hold whole words in the byte order
+// of the file, which is not the byte order of the machine when swap is
+// true.  The filters of an array are recorded in the "filter" attribute
+// of its element.
+class vtkXMLDataFilter
+{
+public:
+  enum
+    {
+    // Replace integers by their difference with the previous one.
+    Delta = 1,
+    // Group the bytes of the words by their position in the word.
+    Shuffle = 2
+    };
+
+  // Get the attribute value for a set of filters, or 0 for none.
+  static const char* GetName(int filters)
+    {
+    switch(filters)
+      {
+      case Delta: return "delta";
+      case Shuffle: return "shuffle";
+      case Delta|Shuffle: return "delta shuffle";
+      }
+    return 0;
+    }
+
+  // Get the set of filters named by an attribute value, or -1 if a
+  // filter is unknown.
+  static int Parse(const char* name)
+    {
+    int filters = 0;
+    while(name && *name)
+      {
+      const char* end = strchr(name, ' ');
+      size_t length = end ? static_cast<size_t>(end - name) : strlen(name);
+      if(length == 5 && strncmp(name, "delta", 5) == 0)
+        {
+        filters |= Delta;
+        }
+      else if(length == 7 && strncmp(name, "shuffle", 7) == 0)
+        {
+        filters |= Shuffle;
+        }
+      else if(length > 0)
+        {
+        return -1;
+        }
+      name = end ? end + 1 : 0;
+      }
+    return filters;
+    }
+
+  // Transform a block of numWords words of wordSize bytes in place
+  // before compression.
+  static void Encode(int filters, unsigned char* block, size_t numWords,
+                     size_t wordSize, bool swap)
+    {
+    if(filters & Delta)
+      {
+      DeltaBlock(block, numWords, wordSize, swap, true);
+      }
+    if(filters & Shuffle)
+      {
+      ShuffleBytes(block, numWords, wordSize, true);
+      }
+    }
+
+  // Restore a block transformed by Encode after decompression.
+  static void Decode(int filters, unsigned char* block, size_t numWords,
+                     size_t wordSize, bool swap)
+    {
+    if(filters & Shuffle)
+      {
+      ShuffleBytes(block, numWords, wordSize, false);
+      }
+    if(filters & Delta)
+      {
+      DeltaBlock(block, numWords, wordSize, swap, false);
+      }
+    }
+
+private:
+  template <class T>
+  static T Load(const unsigned char* p, bool swap)
+    {
+    unsigned char b[sizeof(T)];
+    for(size_t i = 0; i < sizeof(T); ++i)
+      {
+      b[i] = p[swap ? sizeof(T) - 1 - i : i];
+      }
+    T value;
+    memcpy(&value, b, sizeof(T));
+    return value;
+    }
+
+  template <class T>
+  static void Store(unsigned char* p, T value, bool swap)
+    {
+    unsigned char b[sizeof(T)];
+    memcpy(b, &value, sizeof(T));
+    for(size_t i = 0; i < sizeof(T); ++i)
+      {
+      p[i] = b[swap ? sizeof(T) - 1 - i : i];
+      }
+    }
+
+  // Differences use unsigned arithmetic so that they wrap around for
+  // signed and unsigned integers alike.
+  template <class T>
+  static void DeltaWords(unsigned char* block, size_t numWords, bool swap,
+                         bool encode)
+    {
+    T previous = 0;
+    for(size_t i = 0; i < numWords; ++i)
+      {
+      unsigned char* p = block + i * sizeof(T);
+      T value = Load<T>(p, swap);
+      if(encode)
+        {
+        Store<T>(p, static_cast<T>(value - previous), swap);
+        previous = value;
+        }
+      else
+        {
+        previous = static_cast<T>(previous + value);
+        Store<T>(p, previous, swap);
+        }
+      }
+    }
+
+  static void DeltaBlock(unsigned char* block, size_t numWords,
+                         size_t wordSize, bool swap, bool encode)
+    {
+    switch(wordSize)
+      {
+      case 1: DeltaWords<vtkTypeUInt8>(block, numWords, swap, encode); break;
+      case 2: DeltaWords<vtkTypeUInt16>(block, numWords, swap, encode); break;
+      case 4: DeltaWords<vtkTypeUInt32>(block, numWords, swap, encode); break;
+      case 8: DeltaWords<vtkTypeUInt64>(block, numWords, swap, encode); break;
+      }
+    }
+
+  static void ShuffleBytes(unsigned char* block, size_t numWords,
+                           size_t wordSize, bool encode)
+    {
+    if(wordSize < 2 || numWords < 2)
+      {
+      return;
+      }
+    std::vector<unsigned char> copy(block, block + numWords * wordSize);
+    for(size_t i = 0; i < numWords; ++i)
+      {
+      for(size_t j = 0; j < wordSize; ++j)
+        {
+        if(encode)
+          {
+          block[j * numWords + i] = copy[i * wordSize + j];
+          }
+        else
+          {
+          block[i * wordSize + j] = copy[j * numWords + i];
+          }
+        }
+      }
+    }
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkXMLDataFilterPrivate.h
@@ -20,20 +20,34 @@
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
+#define vtkXMLDataFilterPrivate_DoNotInclude
+#include "vtkXMLDataFilterPrivate.h"
+#undef vtkXMLDataFilterPrivate_DoNotInclude
 
 #include <vtksys/auto_ptr.hxx>
 #include <vtksys/ios/sstream>
 
+#include <algorithm>
+#include <vector>
+
 #include "vtkXMLUtilities.h"
 
 
 vtkStandardNewMacro(vtkXMLDataParser);
 vtkCxxSetObjectMacro(vtkXMLDataParser, Compressor, vtkDataCompressor);
 
+// The byte order of this machine.
+#ifdef VTK_WORDS_BIGENDIAN
+static const int vtkXMLDataParserMachineOrder = vtkXMLDataParser::BigEndian;
+#else
+static const int vtkXMLDataParserMachineOrder = vtkXMLDataParser::LittleEndian;
+#endif
+
 //----------------------------------------------------------------------------
 vtkXMLDataParser::vtkXMLDataParser()
 {
@@ -49,6 +63,7 @@ vtkXMLDataParser::vtkXMLDataParser()
 
   this->BlockCompressedSizes = 0;
   this->BlockStartOffsets = 0;
+  this->BlockFilters = 0;
   this->Compressor = 0;
 
   this->AsciiDataBuffer = 0;
@@ -264,6 +279,19 @@ int vtkXMLDataParser::CheckPrimaryAttributes()
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLDataParser::CopyDataSettings(vtkXMLDataParser* parser)
+{
+  this->AppendedDataPosition = parser->AppendedDataPosition;
+  this->ByteOrder = parser->ByteOrder;
+  this->HeaderType = parser->HeaderType;
+  this->SetCompressor(parser->Compressor);
+
+  // Decode the appended data the same way.
+  this->AppendedDataStream->Delete();
+  this->AppendedDataStream = parser->AppendedDataStream->NewInstance();
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLDataParser::FindAppendedDataPosition()
 {
@@ -465,6 +493,20 @@ void vtkXMLDataParser::PerformByteSwap(void* data, size_t numWords,
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::SetBlockFilters(const char* filters)
+{
+  int blockFilters = vtkXMLDataFilter::Parse(filters);
+  if(blockFilters < 0)
+    {
+    vtkErrorMacro("Unknown filter in \"" << filters << "\".");
+    this->BlockFilters = 0;
+    return 0;
+    }
+  this->BlockFilters = blockFilters;
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLDataParser::ReadCompressionHeader()
 {
@@ -548,7 +590,8 @@ size_t vtkXMLDataParser::FindBlockSize(vtkTypeUInt64 block)
 }
 
 //----------------------------------------------------------------------------
-int vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block, unsigned char* buffer)
+int vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block, unsigned char* buffer,
+                                size_t wordSize)
 {
   size_t uncompressedSize = this->FindBlockSize(block);
   size_t compressedSize = this->BlockCompressedSizes[block];
@@ -571,15 +614,106 @@ int vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block, unsigned char* buffer)
                                  buffer, uncompressedSize);
 
   delete [] readBuffer;
-  return result > 0;
+  if(result == 0)
+    {
+    return 0;
+    }
+  vtkXMLDataFilter::Decode(this->BlockFilters, buffer,
+                           uncompressedSize / wordSize, wordSize,
+                           this->ByteOrder != vtkXMLDataParserMachineOrder);
+  return 1;
 }
 
 //----------------------------------------------------------------------------
-unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
+// Number of complete blocks read and decompressed together.
+static const vtkTypeUInt64 vtkXMLDataParserBlockBatchSize = 64;
+
+// Decompresses consecutive blocks of the same size concurrently.
+class vtkXMLDataParserUncompressFunctor
+{
+public:
+  void operator()(vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      unsigned char* output = this->Output + i * this->BlockSize;
+      this->Results[i] =
+        this->Compressor->Uncompress(this->Input + this->InputOffsets[i],
+                                     this->InputSizes[i],
+                                     output, this->BlockSize) > 0;
+      if (this->Results[i])
+        {
+        vtkXMLDataFilter::Decode(this->Filters, output,
+                                 this->BlockSize / this->WordSize,
+                                 this->WordSize, this->Swap);
+        }
+      }
+    }
+
+  vtkDataCompressor* Compressor;
+  int Filters;
+  size_t WordSize;
+  bool Swap;
+  const unsigned char* Input;
+  const size_t* InputOffsets;
+  const size_t* InputSizes;
+  unsigned char* Output;
+  size_t BlockSize;
+  unsigned char* Results;
+};
+
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(vtkTypeUInt64 firstBlock,
+                                 vtkTypeUInt64 endBlock,
+                                 unsigned char* buffer,
+                                 size_t wordSize)
+{
+  // The compressed blocks are stored one after another.  Read them at
+  // once and decompress them concurrently.
+  size_t numBlocks = endBlock - firstBlock;
+  std::vector<size_t> offsets(numBlocks);
+  size_t compressedSize = 0;
+  for (size_t i = 0; i < numBlocks; ++i)
+    {
+    offsets[i] = compressedSize;
+    compressedSize += this->BlockCompressedSizes[firstBlock+i];
+    }
+
+  if(!this->DataStream->Seek(this->BlockStartOffsets[firstBlock]))
+    {
+    return 0;
+    }
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if(compressedSize > 0 &&
+     this->DataStream->Read(&readBuffer[0], compressedSize) < compressedSize)
+    {
+    return 0;
+    }
+
+  std::vector<unsigned char> results(numBlocks);
+  vtkXMLDataParserUncompressFunctor functor;
+  functor.Compressor = this->Compressor;
+  functor.Filters = this->BlockFilters;
+  functor.WordSize = wordSize;
+  functor.Swap = this->ByteOrder != vtkXMLDataParserMachineOrder;
+  functor.Input = compressedSize > 0 ? &readBuffer[0] : 0;
+  functor.InputOffsets = &offsets[0];
+  functor.InputSizes = this->BlockCompressedSizes + firstBlock;
+  functor.Output = buffer;
+  functor.BlockSize = this->BlockUncompressedSize;
+  functor.Results = &results[0];
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, functor);
+
+  return std::find(results.begin(), results.end(), 0) == results.end();
+}
+
+//----------------------------------------------------------------------------
+unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block,
+                                           size_t wordSize)
 {
   unsigned char* decompressBuffer =
     new unsigned char[this->FindBlockSize(block)];
-  if(!this->ReadBlock(block, decompressBuffer))
+  if(!this->ReadBlock(block, decompressBuffer, wordSize))
     {
     delete [] decompressBuffer;
     return 0;
@@ -718,7 +852,7 @@ size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
   if(firstBlock == lastBlock)
     {
     // Everything fits in one block.
-    unsigned char* blockBuffer = this->ReadBlock(firstBlock);
+    unsigned char* blockBuffer = this->ReadBlock(firstBlock, wordSize);
     if(!blockBuffer) { return 0; }
     size_t n = endBlockOffset - beginBlockOffset;
     memcpy(data, blockBuffer+beginBlockOffset, n);
@@ -736,7 +870,7 @@ size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
     size_t blockSize = this->FindBlockSize(firstBlock);
 
     // Read the first block.
-    unsigned char* blockBuffer = this->ReadBlock(firstBlock);
+    unsigned char* blockBuffer = this->ReadBlock(firstBlock, wordSize);
     if(!blockBuffer)
       {
       return 0;
@@ -755,18 +889,29 @@ size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
     // Report progress.
     this->UpdateProgress(float(outputPointer-data)/length);
 
-    unsigned int currentBlock = firstBlock+1;
-    for(;currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // The blocks between the first and the last are complete.  Read
+    // them in batches.
+    vtkTypeUInt64 currentBlock = firstBlock+1;
+    while(currentBlock != lastBlock && !this->Abort)
       {
-      // Read this block.
-      if(!this->ReadBlock(currentBlock, outputPointer)) { return 0; }
+      vtkTypeUInt64 endBlock =
+        std::min(currentBlock+vtkXMLDataParserBlockBatchSize, lastBlock);
 
-      // Byte swap this block.  Note that blockSize will always be an
+      // Read these blocks.
+      if(!this->ReadBlocks(currentBlock, endBlock, outputPointer,
+                            wordSize))
+        {
+        return 0;
+        }
+
+      // Byte swap these blocks.  Note that blockSize will always be an
       // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      size_t batchSize = (endBlock-currentBlock)*blockSize;
+      this->PerformByteSwap(outputPointer, batchSize / wordSize, wordSize);
 
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += batchSize;
+      currentBlock = endBlock;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer-data)/length);
@@ -775,7 +920,7 @@ size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
     // Now read the final block, which is incomplete if it exists.
     if(endBlockOffset > 0 && !this->Abort)
       {
-      blockBuffer = this->ReadBlock(lastBlock);
+      blockBuffer = this->ReadBlock(lastBlock, wordSize);
       if(!blockBuffer)
         {
         return 0;
@@ -911,6 +1056,38 @@ size_t vtkXMLDataParser::ReadAppendedData(vtkTypeInt64 offset,
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkXMLDataParser::FindRawAppendedData(vtkTypeInt64 offset,
+                                                   size_t numWords,
+                                                   int wordType)
+{
+  size_t wordSize = this->GetWordTypeSize(wordType);
+  if(this->Compressor || this->AppendedDataStream->IsA("vtkBase64InputStream")
+     || (wordSize > 1 && this->ByteOrder != vtkXMLDataParserMachineOrder))
+    {
+    return -1;
+    }
+
+  // Read the length of the data.
+  vtksys::auto_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  vtkTypeInt64 position = this->AppendedDataPosition + offset;
+  this->SeekG(position);
+  this->Stream->read(reinterpret_cast<char*>(uh->Data()),
+                     static_cast<std::streamsize>(uh->DataSize()));
+  if(this->Stream->gcount() != static_cast<std::streamsize>(uh->DataSize()))
+    {
+    this->Stream->clear();
+    return -1;
+    }
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+  if(uh->Get(0) < static_cast<vtkTypeUInt64>(numWords) * wordSize)
+    {
+    return -1;
+    }
+  return position + static_cast<vtkTypeInt64>(uh->DataSize());
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
@@ -73,6 +73,15 @@ public:
   { return this->ReadAppendedData(offset, buffer, startWord, numWords,
                                     VTK_CHAR); }
 
+  // Description:
+  // Find the position in the file of numWords words stored raw and
+  // uncompressed in the byte order of this machine in the appended data
+  // section at the given offset, so that they can be used in place.
+  // Returns -1 if the data are encoded, compressed, in another byte
+  // order or shorter.
+  vtkTypeInt64 FindRawAppendedData(vtkTypeInt64 offset, size_t numWords,
+                                   int wordType);
+
   // Description:
   // Read from an ascii data section starting at the current position in
   // the stream.  Returns the number of words read.
@@ -92,6 +101,13 @@ public:
   virtual void SetCompressor(vtkDataCompressor*);
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
 
+  // Description:
+  // Set the transforms applied to the uncompressed blocks of the
+  // compressed binary data read next, as named by the "filter"
+  // attribute of the array element.  NULL means none.  Returns 0 if a
+  // filter is unknown.
+  int SetBlockFilters(const char* filters);
+
   // Description:
   // Get the size of a word of the given type.
   size_t GetWordTypeSize(int wordType);
@@ -138,6 +154,14 @@ public:
     return this->AppendedDataPosition;
   }
 
+  // Description:
+  // Copy from another parser what is needed to read the data of the
+  // elements it parsed: the position and encoding of the appended data,
+  // the byte order, the header type and the compressor.  Give this
+  // parser its own stream of the same file to read the data
+  // concurrently with the other one.
+  void CopyDataSettings(vtkXMLDataParser* parser);
+
 protected:
   vtkXMLDataParser();
   ~vtkXMLDataParser();
@@ -164,8 +188,11 @@ protected:
   // Data reading methods.
   void ReadCompressionHeader();
   size_t FindBlockSize(vtkTypeUInt64 block);
-  int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
-  unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer,
+                size_t wordSize);
+  unsigned char* ReadBlock(vtkTypeUInt64 block, size_t wordSize);
+  int ReadBlocks(vtkTypeUInt64 firstBlock, vtkTypeUInt64 endBlock,
+                 unsigned char* buffer, size_t wordSize);
   size_t ReadUncompressedData(unsigned char* data,
                               vtkTypeUInt64 startWord,
                               size_t numWords,
@@ -223,6 +250,7 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  int BlockFilters;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
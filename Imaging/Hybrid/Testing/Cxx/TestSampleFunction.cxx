@@ -1,7 +1,12 @@
 #include <vtkSmartPointer.h>
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkPointData.h>
 #include <vtkSampleFunction.h>
 #include <vtkSphere.h>
 
+#include <cmath>
+
 #include "vtkTestErrorObserver.h"
 
 int TestSampleFunction(int, char *[])
@@ -67,6 +72,23 @@ int TestSampleFunction(int, char *[])
   sf2->Update();
   sf2->Print(std::cout);
 
+  // The sphere is thread safe, so it was sampled in parallel; check the
+  // samples against the function.
+  vtkImageData *image = sf2->GetOutput();
+  vtkDataArray *samples = image->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    double x[3];
+    image->GetPoint(i, x);
+    double expected = static_cast<float>(sphere->FunctionValue(x));
+    if (std::abs(samples->GetComponent(i, 0) - expected) > 1.0e-6)
+      {
+      std::cout << "Sample " << i << " is " << samples->GetComponent(i, 0)
+                << ", expected " << expected << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
   vtkSmartPointer<vtkSampleFunction> sf3 =
     vtkSmartPointer<vtkSampleFunction>::New();
   sf3->SetSampleDimensions(51,52,1);
@@ -25,10 +25,62 @@
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 
 vtkStandardNewMacro(vtkSampleFunction);
 vtkCxxSetObjectMacro(vtkSampleFunction,ImplicitFunction,vtkImplicitFunction);
 
+namespace
+{
+// Samples the implicit function (and optionally its gradient) on a range of
+// z slices of the output extent. Each slice writes its own tuples only.
+class vtkSampleFunctionOp
+{
+public:
+  vtkImplicitFunction *Function;
+  vtkDataArray *Scalars;
+  float *Normals;
+  const int *Extent;
+  const double *Origin;
+  const double *Spacing;
+
+  void operator()(vtkIdType k, vtkIdType endK) const
+  {
+    const int *ext = this->Extent;
+    vtkIdType sliceSize = static_cast<vtkIdType>(ext[1] - ext[0] + 1) *
+      (ext[3] - ext[2] + 1);
+    vtkIdType idx = (k - ext[4]) * sliceSize;
+    double p[3], n[3];
+    for ( ; k < endK; k++ )
+      {
+      p[2] = this->Origin[2] + k*this->Spacing[2];
+      for ( int j=ext[2]; j <= ext[3]; j++ )
+        {
+        p[1] = this->Origin[1] + j*this->Spacing[1];
+        for ( int i=ext[0]; i <= ext[1]; i++, idx++ )
+          {
+          p[0] = this->Origin[0] + i*this->Spacing[0];
+          this->Scalars->SetComponent(idx, 0,
+                                      this->Function->FunctionValue(p));
+          if ( this->Normals )
+            {
+            this->Function->FunctionGradient(p, n);
+            n[0] *= -1;
+            n[1] *= -1;
+            n[2] *= -1;
+            vtkMath::Normalize(n);
+            float *normal = this->Normals + 3*idx;
+            normal[0] = static_cast<float>(n[0]);
+            normal[1] = static_cast<float>(n[1]);
+            normal[2] = static_cast<float>(n[2]);
+            }
+          }
+        }
+      }
+  }
+};
+}
+
 vtkSampleFunction::vtkSampleFunction()
 {
   this->ModelBounds[0] = -1.0;
@@ -184,10 +236,8 @@ int vtkSampleFunction::RequestInformation (
 
 void vtkSampleFunction::ExecuteDataWithInformation(vtkDataObject *outp, vtkInformation *outInfo)
 {
-  vtkIdType idx, i, j, k;
   vtkFloatArray *newNormals=NULL;
   vtkIdType numPts;
-  double p[3], s;
   vtkImageData *output=this->GetOutput();
   int* extent =
     this->GetExecutive()->GetOutputInformation(0)->Get(
@@ -209,52 +259,40 @@ void vtkSampleFunction::ExecuteDataWithInformation(vtkDataObject *outp, vtkInfor
 
   numPts = newScalars->GetNumberOfTuples();
 
-  // Traverse all points evaluating implicit function at each point
+  // Traverse all points evaluating implicit function (and its gradient, if
+  // normal computation is turned on) at each point. Thread safe functions
+  // are evaluated in parallel over the z slices.
   //
   double spacing[3];
   output->GetSpacing(spacing);
 
-  for ( idx=0, k=extent[4]; k <= extent[5]; k++ )
-    {
-    p[2] = this->ModelBounds[4] + k*spacing[2];
-    for ( j=extent[2]; j <= extent[3]; j++ )
-      {
-      p[1] = this->ModelBounds[2] + j*spacing[1];
-      for ( i=extent[0]; i <= extent[1]; i++ )
-        {
-        p[0] = this->ModelBounds[0] + i*spacing[0];
-        s = this->ImplicitFunction->FunctionValue(p);
-        newScalars->SetTuple1(idx++,s);
-        }
-      }
-    }
-
-  // If normal computation turned on, compute them
-  //
   if ( this->ComputeNormals )
     {
-    double n[3];
     newNormals = vtkFloatArray::New();
     newNormals->SetNumberOfComponents(3);
     newNormals->SetNumberOfTuples(numPts);
-    for ( idx=0, k=extent[4]; k <= extent[5]; k++ )
-      {
-      p[2] = this->ModelBounds[4] + k*spacing[2];
-      for ( j=extent[2]; j <= extent[3]; j++ )
-        {
-        p[1] = this->ModelBounds[2] + j*spacing[1];
-        for ( i=extent[0]; i <= extent[1]; i++ )
-          {
-          p[0] = this->ModelBounds[0] + i*spacing[0];
-          this->ImplicitFunction->FunctionGradient(p, n);
-          n[0] *= -1;
-          n[1] *= -1;
-          n[2] *= -1;
-          vtkMath::Normalize(n);
-          newNormals->SetTuple(idx++,n);
-          }
-        }
-      }
+    }
+
+  vtkSampleFunctionOp op;
+  op.Function = this->ImplicitFunction;
+  op.Scalars = newScalars;
+  op.Normals = ( newNormals ? newNormals->GetPointer(0) : NULL );
+  op.Extent = extent;
+  op.Spacing = spacing;
+
+  double origin[3];
+  origin[0] = this->ModelBounds[0];
+  origin[1] = this->ModelBounds[2];
+  origin[2] = this->ModelBounds[4];
+  op.Origin = origin;
+
+  if ( this->ImplicitFunction->IsThreadSafe() )
+    {
+    vtkSMPTools::For(extent[4], extent[5]+1, op);
+    }
+  else
+    {
+    op(extent[4], extent[5]+1);
     }
 
   newScalars->SetName(this->ScalarArrayName);